@@ -2,7 +2,10 @@
 
 #include "../resource.h"
 
+#include <Foundation/StringUtils.hpp>
 #include <choreograph/Choreograph.h>
+#include <fstream>
+#include <iterator>
 #include <windows.h>
 #include <tchar.h>
 
@@ -10,6 +13,7 @@ namespace PathFinder
 {
 
     Application::Application(int argc, char** argv)
+        : mStartupTimestamp{ std::chrono::steady_clock::now() }
     {
         CreateEngineWindow();
 
@@ -21,7 +25,7 @@ namespace PathFinder
         mWindowsInputHandler = std::make_unique<InputHandlerWindows>(mInput.get(), mWindowHandle);
         mCameraInteractor = std::make_unique<CameraInteractor>(&mScene->MainCamera(), mInput.get());
         mDisplaySettingsController = std::make_unique<DisplaySettingsController>(mRenderEngine->SelectedAdapter(), mRenderEngine->SwapChain(), mWindowHandle);
-        mUIDependencies = std::make_unique<UIDependencies>(mRenderEngine->ResourceStorage(), &mRenderEngine->PreRenderEvent(), &mRenderEngine->PostRenderEvent(), mScene.get());
+        mUIDependencies = std::make_unique<UIDependencies>(mRenderEngine->ResourceStorage(), mRenderEngine->Telemetry(), mCmdLineParser->MemoryTelemetryCSVPath(), &mRenderEngine->PreRenderEvent(), &mRenderEngine->PostRenderEvent(), mScene.get());
         mUIManager = std::make_unique<UIManager>(mInput.get(), mUIDependencies.get(), mRenderEngine->ResourceProducer());
         mUIEntryPoint = std::make_unique<UIEntryPoint>(mUIManager.get());
         mContentMediator = std::make_unique<RenderPassContentMediator>(&mUIManager->GPUStorage(), &mScene->GPUStorage(), mScene.get(), mInput.get(), mDisplaySettingsController.get(), mSettingsController.get());
@@ -38,9 +42,22 @@ namespace PathFinder
         mUIEntryPoint->CreateMandatoryViewControllers();
 
         // Temporary to load demo Scene until proper UI is implemented
-        mMeshLoader = std::make_unique<MeshLoader>(mCmdLineParser->ExecutableFolderPath() / "MediaResources/Models/");
+        mMeshLoader = std::make_unique<MeshLoader>(mCmdLineParser->ExecutableFolderPath() / "MediaResources/Models/", mCmdLineParser->ExecutableFolderPath() / "CookedMeshes");
         mMaterialLoader = std::make_unique<MaterialLoader>(mCmdLineParser->ExecutableFolderPath(), mRenderEngine->AssetStorage(), mRenderEngine->ResourceProducer());
         LoadDemoScene();
+
+        // Any instance can end up occluded in an older Hi-Z and drawn in the second phase
+        mOcclusionCullingPass.SetMaxCandidateCount((uint32_t)mScene->MeshInstances().size());
+
+        // Meshlets of every instance are culled when all of them are visible at LOD 0
+        uint32_t meshletCount = 0;
+
+        for (const MeshInstance& instance : mScene->MeshInstances())
+        {
+            meshletCount += (uint32_t)mScene->Meshes()[instance.AssociatedMesh()].Meshlets().size();
+        }
+
+        mMeshletCullingPass.SetMaxVisibleMeshletCount(meshletCount);
     }
 
     void Application::RunMessageLoop()
@@ -61,6 +78,17 @@ namespace PathFinder
             mInput->FinalizeInput();
             mRenderEngine->Render();
             mInput->Clear();
+
+            if (!mIsStartupReported)
+            {
+                ReportStartupStatistics();
+                mIsStartupReported = true;
+            }
+        }
+
+        if (mCmdLineParser->ShouldExportMemoryTelemetryOnExit())
+        {
+            mRenderEngine->Telemetry()->ExportCSV(mCmdLineParser->MemoryTelemetryCSVPath());
         }
     }
 
@@ -106,7 +134,11 @@ namespace PathFinder
     {
         mRenderEngine->SetContentMediator(mContentMediator.get());
         mRenderEngine->AddRenderPass(&mCommonSetupPass);
+        mRenderEngine->AddRenderPass(&mMeshletCullingPass);
         mRenderEngine->AddRenderPass(&mGBufferPass);
+        mRenderEngine->AddRenderPass(&mHiZGenerationPass);
+        mRenderEngine->AddRenderPass(&mOcclusionCullingPass);
+        mRenderEngine->AddRenderPass(&mGBufferSecondPhasePass);
         mRenderEngine->AddRenderPass(&mRgnSeedGenerationPass);
         mRenderEngine->AddRenderPass(&mShadingPass);
         mRenderEngine->AddRenderPass(&mDenoiserPreBlurPass);
@@ -148,11 +180,33 @@ namespace PathFinder
         mSettingsController->SetEnabled(!interactingWithUI);
         mSettingsController->ApplyVolatileSettings();
 
+        mScene->UpdateMeshInstanceBVH();
+        mScene->CullMeshInstances();
+        mScene->SelectMeshInstanceLODs(float(viewportSize.Height));
+
+        // Materials have to stop referring to replaced textures before the next streaming update destroys them
+        mScene->ReportMaterialTextureUsage(mMaterialLoader->TextureStreaming(), float(viewportSize.Height));
+
+        if (mScene->ReplaceMaterialTextures(mMaterialLoader->TextureStreaming().Update()))
+        {
+            mScene->GPUStorage().UpdateMaterialTextures();
+        }
+
         mScene->GPUStorage().UploadInstances();
+        mScene->GPUStorage().UploadMeshInstanceDrawCommands();
         mScene->RemapEntityIDs();
 
-        // Top RT needs to be rebuilt every frame
-        mRenderEngine->AddTopRayTracingAccelerationStructure(&mScene->GPUStorage().TopAccelerationStructure());
+        // Bottom RT structures are built once and compacted later, a few at a time
+        for (const PathFinder::BottomRTAS* bottomRTAS : mScene->GPUStorage().ScheduledBottomAccelerationStructures())
+        {
+            mRenderEngine->AddBottomRayTracingAccelerationStructure(bottomRTAS);
+        }
+
+        // Top RT is rebuilt or refitted only when instances change
+        if (mScene->GPUStorage().TopAccelerationStructureStatistics().LastOperation != PathFinder::TopRTASOperation::None)
+        {
+            mRenderEngine->AddTopRayTracingAccelerationStructure(&mScene->GPUStorage().TopAccelerationStructure());
+        }
 
         mGlobalConstants.PipelineRTResolution = {
             mRenderEngine->RenderSurface().Dimensions().Width,
@@ -183,163 +237,261 @@ namespace PathFinder
 
     void Application::PerformPostRenderActions()
     {
+        mScene->GPUStorage().ReadbackBottomAccelerationStructureCompactedSizes();
+        ReadbackHiZPyramid();
+    }
+
+    void Application::ReadbackHiZPyramid()
+    {
+        const PipelineResourceStorageResource* hiZ = mRenderEngine->ResourceStorage()->GetPerResourceData(ResourceNames::HiZ);
+        const PipelineResourceStorageResource* hiZInfo = mRenderEngine->ResourceStorage()->GetPerResourceData(ResourceNames::HiZInfo);
+
+        if (!hiZ || !hiZInfo) return;
+
+        // Both buffers are exported by the same pass, so read back data belongs to the same frame
+        hiZInfo->Buffer->Read<HiZInfo>([this, hiZ](const HiZInfo* info)
+        {
+            if (!info) return;
+
+            hiZ->Buffer->Read<float>([this, info](const float* baseLevelDepth)
+            {
+                if (!baseLevelDepth) return;
+
+                mScene->UpdateHiZPyramid(
+                    baseLevelDepth,
+                    Geometry::Dimensions{ info->ViewportSize.x, info->ViewportSize.y },
+                    info->BaseTexelSize,
+                    info->View,
+                    info->ViewProjection,
+                    info->FrameNumber);
+            });
+        });
+    }
+
+    void Application::ReportStartupStatistics() const
+    {
+        using namespace std::chrono;
+
+        auto startupTime = duration_cast<milliseconds>(steady_clock::now() - mStartupTimestamp);
+        const ShaderManager::Statistics& shaders = mRenderEngine->ShaderLoadingStatistics();
+
+        // Cold starts compile shaders, warm ones load every binary from the cache
+        std::string report = StringFormat(
+            "Startup (%s): %lld ms, %u shaders compiled in %lld ms, %u loaded from cache in %lld ms\n",
+            shaders.CompiledObjectCount == 0 ? "warm" : "cold",
+            (long long)startupTime.count(),
+            shaders.CompiledObjectCount,
+            (long long)duration_cast<milliseconds>(shaders.CompilationTime).count(),
+            shaders.CachedObjectCount,
+            (long long)duration_cast<milliseconds>(shaders.CacheLoadTime).count());
+
+        const ResourceLoader::Statistics& textures = mMaterialLoader->TextureLoadStatistics();
+
+        report += StringFormat(
+            "Textures: %u loaded, %.1f MB in %lld ms, %.1f MB/s\n",
+            textures.TextureCount,
+            textures.LoadedBytes / 1e6,
+            (long long)duration_cast<milliseconds>(textures.LoadTime).count(),
+            textures.Throughput);
+
+        const MeshLoader::Statistics& meshes = mMeshLoader->GetStatistics();
+
+        // Meshes of files loaded from cache were cooked earlier, only imported ones add to generation times
+        report += StringFormat(
+            "Meshes (last load): %u files, %u from cache, %llu meshes in %lld ms, %llu meshlets generated in %lld ms, %llu LODs generated in %lld ms\n",
+            meshes.FileCount,
+            meshes.FilesLoadedFromCache,
+            (unsigned long long)meshes.MeshCount,
+            (long long)duration_cast<milliseconds>(meshes.LoadTime).count(),
+            (unsigned long long)meshes.MeshletCount,
+            (long long)duration_cast<milliseconds>(meshes.MeshletGenerationTime).count(),
+            (unsigned long long)meshes.LODCount,
+            (long long)duration_cast<milliseconds>(meshes.LODGenerationTime).count());
+
+        OutputDebugStringA(report.c_str());
     }
 
     void Application::LoadDemoScene()
     {
-        // This function is temporary until proper scene UI and serialization is implemented 
+        // This function is temporary until proper scene UI is implemented 
         //
         
+        // Scene is built from source assets once and loaded from the scene file afterwards.
+        // File name carries DemoSceneVersion, which has to be incremented for changes made here to take effect.
+        // "-rebuild_demo_scene" rebuilds and rewrites the file of the current version regardless.
+        std::filesystem::path demoScenePath = mCmdLineParser->ExecutableFolderPath() / StringFormat("Scenes/Demo.v%u.pfscene", DemoSceneVersion);
 
-        PathFinder::Material& metalMaterial = mScene->AddMaterial(mMaterialLoader->LoadMaterial(
-            "/MediaResources/Textures/Metal07/Metal07_col.dds",
-            "/MediaResources/Textures/Metal07/Metal07_nrm.dds",
-            "/MediaResources/Textures/Metal07/Metal07_rgh.dds",
-            "/MediaResources/Textures/Metal07/Metal07_met.dds"));
-
-        PathFinder::Material& concrete19Material = mScene->AddMaterial(mMaterialLoader->LoadMaterial(
-            "/MediaResources/Textures/Concrete19/Concrete19_col.dds",
-            "/MediaResources/Textures/Concrete19/Concrete19_nrm.dds",
-            "/MediaResources/Textures/Concrete19/Concrete19_rgh.dds"));
-
-        PathFinder::Material& charcoalMaterial = mScene->AddMaterial(mMaterialLoader->LoadMaterial(
-            "/MediaResources/Textures/Charcoal/charcoal-albedo2.dds",
-            "/MediaResources/Textures/Charcoal/charcoal-normal.dds",
-            "/MediaResources/Textures/Charcoal/charcoal-roughness.dds"));
-
-        PathFinder::Material& grimyMetalMaterial = mScene->AddMaterial(mMaterialLoader->LoadMaterial(
-            "/MediaResources/Textures/GrimyMetal/grimy-metal-albedo.dds",
-            "/MediaResources/Textures/GrimyMetal/grimy-metal-normal-dx.dds",
-            "/MediaResources/Textures/GrimyMetal/grimy-metal-roughness.dds",
-            "/MediaResources/Textures/GrimyMetal/grimy-metal-metalness.dds"));
-
-        PathFinder::Material& marble006Material = mScene->AddMaterial(mMaterialLoader->LoadMaterial(
-            "/MediaResources/Textures/Marble006/Marble006_4K_Color.dds",
-            "/MediaResources/Textures/Marble006/Marble006_4K_Normal.dds",
-            "/MediaResources/Textures/Marble006/Marble006_4K_Roughness.dds"));
-
-        PathFinder::Material& marbleTilesMaterial = mScene->AddMaterial(mMaterialLoader->LoadMaterial(
-            "/MediaResources/Textures/MarbleTiles/Marble_tiles_02_4K_Base_Color.dds",
-            "/MediaResources/Textures/MarbleTiles/Marble_tiles_02_4K_Normal.dds",
-            "/MediaResources/Textures/MarbleTiles/Marble_tiles_02_4K_Roughness.dds"));
-
-        PathFinder::Material& redPlasticMaterial = mScene->AddMaterial(mMaterialLoader->LoadMaterial(
-            "/MediaResources/Textures/RedPlastic/plasticpattern1-albedo.dds",
-            "/MediaResources/Textures/RedPlastic/plasticpattern1-normal2b.dds",
-            "/MediaResources/Textures/RedPlastic/plasticpattern1-roughness2.dds"));
-
-        PathFinder::Material& rustedIronMaterial = mScene->AddMaterial(mMaterialLoader->LoadMaterial(
-            "/MediaResources/Textures/RustedIron/rustediron2_basecolor.dds",
-            "/MediaResources/Textures/RustedIron/rustediron2_normal.dds",
-            "/MediaResources/Textures/RustedIron/rustediron2_roughness.dds",
-            "/MediaResources/Textures/RustedIron/rustediron2_metallic.dds"));
-
-        PathFinder::Material& scuffedTitamiumMaterial = mScene->AddMaterial(mMaterialLoader->LoadMaterial(
-            "/MediaResources/Textures/ScuffedTitanium/Titanium-Scuffed_basecolor.dds",
-            "/MediaResources/Textures/ScuffedTitanium/Titanium-Scuffed_normal.dds",
-            "/MediaResources/Textures/ScuffedTitanium/Titanium-Scuffed_roughness.dds",
-            "/MediaResources/Textures/ScuffedTitanium/Titanium-Scuffed_metallic.dds"));
-
-        PathFinder::Mesh& plane = mScene->AddMesh(std::move(mMeshLoader->Load("plane.obj").back()));
+        if (!mCmdLineParser->ShouldRebuildDemoScene() && mScene->Deserialize(demoScenePath, *mMeshLoader, *mMaterialLoader))
+        {
+            if (mCmdLineParser->ShouldVerifySceneRoundTrip())
+            {
+                VerifySceneRoundTrip(demoScenePath);
+            }
+
+            mMaterialLoader->PackTextures(mScene->Materials());
+            mScene->GPUStorage().UploadMeshes();
+            mScene->GPUStorage().UploadMaterials();
+            return;
+        }
+
+        // Materials are loaded together, so that their textures are read in parallel and shared when identical
+        std::vector<PathFinder::Material> materials = mMaterialLoader->LoadMaterials({
+            {
+                "/MediaResources/Textures/Metal07/Metal07_col.dds",
+                "/MediaResources/Textures/Metal07/Metal07_nrm.dds",
+                "/MediaResources/Textures/Metal07/Metal07_rgh.dds",
+                "/MediaResources/Textures/Metal07/Metal07_met.dds" },
+            {
+                "/MediaResources/Textures/Concrete19/Concrete19_col.dds",
+                "/MediaResources/Textures/Concrete19/Concrete19_nrm.dds",
+                "/MediaResources/Textures/Concrete19/Concrete19_rgh.dds" },
+            {
+                "/MediaResources/Textures/Charcoal/charcoal-albedo2.dds",
+                "/MediaResources/Textures/Charcoal/charcoal-normal.dds",
+                "/MediaResources/Textures/Charcoal/charcoal-roughness.dds" },
+            {
+                "/MediaResources/Textures/GrimyMetal/grimy-metal-albedo.dds",
+                "/MediaResources/Textures/GrimyMetal/grimy-metal-normal-dx.dds",
+                "/MediaResources/Textures/GrimyMetal/grimy-metal-roughness.dds",
+                "/MediaResources/Textures/GrimyMetal/grimy-metal-metalness.dds" },
+            {
+                "/MediaResources/Textures/Marble006/Marble006_4K_Color.dds",
+                "/MediaResources/Textures/Marble006/Marble006_4K_Normal.dds",
+                "/MediaResources/Textures/Marble006/Marble006_4K_Roughness.dds" },
+            {
+                "/MediaResources/Textures/MarbleTiles/Marble_tiles_02_4K_Base_Color.dds",
+                "/MediaResources/Textures/MarbleTiles/Marble_tiles_02_4K_Normal.dds",
+                "/MediaResources/Textures/MarbleTiles/Marble_tiles_02_4K_Roughness.dds" },
+            {
+                "/MediaResources/Textures/RedPlastic/plasticpattern1-albedo.dds",
+                "/MediaResources/Textures/RedPlastic/plasticpattern1-normal2b.dds",
+                "/MediaResources/Textures/RedPlastic/plasticpattern1-roughness2.dds" },
+            {
+                "/MediaResources/Textures/RustedIron/rustediron2_basecolor.dds",
+                "/MediaResources/Textures/RustedIron/rustediron2_normal.dds",
+                "/MediaResources/Textures/RustedIron/rustediron2_roughness.dds",
+                "/MediaResources/Textures/RustedIron/rustediron2_metallic.dds" },
+            {
+                "/MediaResources/Textures/ScuffedTitanium/Titanium-Scuffed_basecolor.dds",
+                "/MediaResources/Textures/ScuffedTitanium/Titanium-Scuffed_normal.dds",
+                "/MediaResources/Textures/ScuffedTitanium/Titanium-Scuffed_roughness.dds",
+                "/MediaResources/Textures/ScuffedTitanium/Titanium-Scuffed_metallic.dds" } });
+
+        PathFinder::MaterialHandle metalMaterial = mScene->AddMaterial(std::move(materials[0]));
+        PathFinder::MaterialHandle concrete19Material = mScene->AddMaterial(std::move(materials[1]));
+        PathFinder::MaterialHandle charcoalMaterial = mScene->AddMaterial(std::move(materials[2]));
+        PathFinder::MaterialHandle grimyMetalMaterial = mScene->AddMaterial(std::move(materials[3]));
+        PathFinder::MaterialHandle marble006Material = mScene->AddMaterial(std::move(materials[4]));
+        PathFinder::MaterialHandle marbleTilesMaterial = mScene->AddMaterial(std::move(materials[5]));
+        PathFinder::MaterialHandle redPlasticMaterial = mScene->AddMaterial(std::move(materials[6]));
+        PathFinder::MaterialHandle rustedIronMaterial = mScene->AddMaterial(std::move(materials[7]));
+        PathFinder::MaterialHandle scuffedTitamiumMaterial = mScene->AddMaterial(std::move(materials[8]));
+
+        // Meshes are loaded together and then added in a fixed order, so handles don't depend on load timing
+        std::vector<std::vector<PathFinder::Mesh>> loadedMeshes = mMeshLoader->LoadFiles({ "plane.obj", "cube.obj", "sphere1.obj", "sphere2.obj", "sphere3.obj" });
+
+        PathFinder::MeshHandle plane = mScene->AddMesh(std::move(loadedMeshes[0].back()));
 
         for (float x = -100; x < 100; x += 20)
         {
             for (float z = -100; z < 100; z += 20)
             {
-                PathFinder::MeshInstance& planeInstance = mScene->AddMeshInstance({ &plane, &concrete19Material });
+                PathFinder::MeshInstanceHandle planeInstance = mScene->AddMeshInstance({ plane, concrete19Material });
                 Geometry::Transformation t;
                 t.Translation = glm::vec3{ x, -3.50207, z };
-                planeInstance.SetTransformation(t);
+                mScene->MeshInstances()[planeInstance].SetTransformation(t);
             }
         }
 
-        PathFinder::Mesh& cube = mScene->AddMesh(std::move(mMeshLoader->Load("cube.obj").back()));
-        PathFinder::MeshInstance& cubeInstance = mScene->AddMeshInstance({ &cube, &metalMaterial });
+        PathFinder::MeshHandle cube = mScene->AddMesh(std::move(loadedMeshes[1].back()));
+        PathFinder::MeshInstanceHandle cubeInstance = mScene->AddMeshInstance({ cube, metalMaterial });
+
+        PathFinder::MeshHandle sphereType1 = mScene->AddMesh(std::move(loadedMeshes[2].back()));
+        PathFinder::MeshInstanceHandle sphereType1Instance0 = mScene->AddMeshInstance({ sphereType1, marbleTilesMaterial });
 
-        PathFinder::Mesh& sphereType1 = mScene->AddMesh(std::move(mMeshLoader->Load("sphere1.obj").back()));
-        PathFinder::MeshInstance& sphereType1Instance0 = mScene->AddMeshInstance({ &sphereType1, &marbleTilesMaterial });
+        PathFinder::MeshHandle sphereType2 = mScene->AddMesh(std::move(loadedMeshes[3].back()));
+        PathFinder::MeshInstanceHandle sphereType2Instance0 = mScene->AddMeshInstance({ sphereType2, marbleTilesMaterial });
 
-        PathFinder::Mesh& sphereType2 = mScene->AddMesh(std::move(mMeshLoader->Load("sphere2.obj").back()));
-        PathFinder::MeshInstance& sphereType2Instance0 = mScene->AddMeshInstance({ &sphereType2, &marbleTilesMaterial });
+        PathFinder::MeshHandle sphereType3 = mScene->AddMesh(std::move(loadedMeshes[4].back()));
+        PathFinder::MeshInstanceHandle sphereType3Instance0 = mScene->AddMeshInstance({ sphereType3, grimyMetalMaterial });
+        PathFinder::MeshInstanceHandle sphereType3Instance1 = mScene->AddMeshInstance({ sphereType3, redPlasticMaterial });
+        PathFinder::MeshInstanceHandle sphereType3Instance2 = mScene->AddMeshInstance({ sphereType3, marble006Material });
+        PathFinder::MeshInstanceHandle sphereType3Instance3 = mScene->AddMeshInstance({ sphereType3, charcoalMaterial });
+        PathFinder::MeshInstanceHandle sphereType3Instance4 = mScene->AddMeshInstance({ sphereType3, concrete19Material });
+        PathFinder::MeshInstanceHandle sphereType3Instance5 = mScene->AddMeshInstance({ sphereType3, metalMaterial });
 
-        PathFinder::Mesh& sphereType3 = mScene->AddMesh(std::move(mMeshLoader->Load("sphere3.obj").back()));
-        PathFinder::MeshInstance& sphereType3Instance0 = mScene->AddMeshInstance({ &sphereType3, &grimyMetalMaterial });
-        PathFinder::MeshInstance& sphereType3Instance1 = mScene->AddMeshInstance({ &sphereType3, &redPlasticMaterial });
-        PathFinder::MeshInstance& sphereType3Instance2 = mScene->AddMeshInstance({ &sphereType3, &marble006Material });
-        PathFinder::MeshInstance& sphereType3Instance3 = mScene->AddMeshInstance({ &sphereType3, &charcoalMaterial });
-        PathFinder::MeshInstance& sphereType3Instance4 = mScene->AddMeshInstance({ &sphereType3, &concrete19Material });
-        PathFinder::MeshInstance& sphereType3Instance5 = mScene->AddMeshInstance({ &sphereType3, &metalMaterial });
+        auto& meshInstances = mScene->MeshInstances();
 
-        Geometry::Transformation t = cubeInstance.Transformation();
+        Geometry::Transformation t = meshInstances[cubeInstance].Transformation();
         t.Rotation = glm::angleAxis(glm::radians(45.0f), glm::normalize(glm::vec3(1.0, 0.0, 1.0)));
         t.Translation = glm::vec3{ -4.88, 3.25, -3.42 };
         t.Scale = glm::vec3{ 0/*2.0f*/ };
-        cubeInstance.SetTransformation(t);
+        meshInstances[cubeInstance].SetTransformation(t);
 
         //t.Scale = glm::vec3{ 0.1f }; // Large version
         //t.Translation = glm::vec3{ 0.0, -2, -4.0 }; // Large version
         t.Scale = glm::vec3{ 0.11f };
         t.Translation = glm::vec3{ -6.0, 8.0, -4.0 };
-        sphereType1Instance0.SetTransformation(t);
+        meshInstances[sphereType1Instance0].SetTransformation(t);
 
         // Small sphere
         t.Scale = glm::vec3{ 0/*0.21f*/ };
         t.Translation = glm::vec3{ 6.0, -14.0, -9.0 };
-        sphereType2Instance0.SetTransformation(t);
+        meshInstances[sphereType2Instance0].SetTransformation(t);
 
         // Normal spheres
         t.Scale = glm::vec3{ 0.12 };
         t.Translation = glm::vec3{ 9.0, 2.0, -17.5 };
-        sphereType3Instance0.SetTransformation(t);
+        meshInstances[sphereType3Instance0].SetTransformation(t);
 
         t.Scale = glm::vec3{ 0.085 };
         t.Translation = glm::vec3{ 8.88, 1.2, 0.1 };
-        sphereType3Instance1.SetTransformation(t);
+        meshInstances[sphereType3Instance1].SetTransformation(t);
 
         t.Scale = glm::vec3{ 0.15 };
         t.Translation = glm::vec3{ 3.88, 3, -23.77 };
-        sphereType3Instance2.SetTransformation(t);
+        meshInstances[sphereType3Instance2].SetTransformation(t);
 
         t.Scale = glm::vec3{ 0.1 };
         t.Translation = glm::vec3{ -13.2, 1.5, -18.6 };
-        sphereType3Instance3.SetTransformation(t);
+        meshInstances[sphereType3Instance3].SetTransformation(t);
 
         t.Scale = glm::vec3{ 0.09 };
         t.Translation = glm::vec3{ -4.07, 1.25, -19.25 };
-        sphereType3Instance4.SetTransformation(t);
+        meshInstances[sphereType3Instance4].SetTransformation(t);
 
         t.Scale = glm::vec3{ 0.1 };
         t.Translation = glm::vec3{ 12.47, 1.7, -9.26 };
-        sphereType3Instance5.SetTransformation(t);
+        meshInstances[sphereType3Instance5].SetTransformation(t);
 
         Foundation::Color light0Color{ 255.0 / 255, 241.0 / 255, 224.1 / 255 };
         Foundation::Color light1Color{ 64.0 / 255, 156.0 / 255, 255.0 / 255 };
         Foundation::Color light2Color{ 255.0 / 255, 147.0 / 255, 41.0 / 255 };
         Foundation::Color light3Color{ 250.0 / 255, 110.0 / 255, 100.0 / 255 };
 
-        auto sphereLight0 = mScene->EmplaceSphericalLight();
-        sphereLight0->SetRadius(7);
-        sphereLight0->SetPosition({ 10.65, 12.0, -4.6 });
-        sphereLight0->SetColor(light0Color);
-        sphereLight0->SetLuminousPower(100000);
-
-        auto sphereLight1 = mScene->EmplaceSphericalLight();
-        sphereLight1->SetRadius(7.5);
-        sphereLight1->SetPosition({ -10.65, 12.0, -4.6 });
-        sphereLight1->SetColor(light1Color);
-        sphereLight1->SetLuminousPower(100000);
-
-        //auto sphereLight2 = mScene->EmplaceSphericalLight();
-        //sphereLight2->SetRadius(6);
-        //sphereLight2->SetPosition({ -5.3, 4.43, -4.76 });
-        //sphereLight2->SetColor(light2Color);
-        //sphereLight2->SetLuminousPower(300000);
-
-        //auto sphereLight3 = mScene->EmplaceSphericalLight();
-        //sphereLight3->SetRadius(8);
-        //sphereLight3->SetPosition({ -5.3, 4.43, -4.76 });
-        //sphereLight3->SetColor(light3Color);
-        //sphereLight3->SetLuminousPower(300000);
+        PathFinder::SphericalLight& sphereLight0 = mScene->SphericalLights()[mScene->EmplaceSphericalLight()];
+        sphereLight0.SetRadius(7);
+        sphereLight0.SetPosition({ 10.65, 12.0, -4.6 });
+        sphereLight0.SetColor(light0Color);
+        sphereLight0.SetLuminousPower(100000);
+
+        PathFinder::SphericalLight& sphereLight1 = mScene->SphericalLights()[mScene->EmplaceSphericalLight()];
+        sphereLight1.SetRadius(7.5);
+        sphereLight1.SetPosition({ -10.65, 12.0, -4.6 });
+        sphereLight1.SetColor(light1Color);
+        sphereLight1.SetLuminousPower(100000);
+
+        //PathFinder::SphericalLight& sphereLight2 = mScene->SphericalLights()[mScene->EmplaceSphericalLight()];
+        //sphereLight2.SetRadius(6);
+        //sphereLight2.SetPosition({ -5.3, 4.43, -4.76 });
+        //sphereLight2.SetColor(light2Color);
+        //sphereLight2.SetLuminousPower(300000);
+
+        //PathFinder::SphericalLight& sphereLight3 = mScene->SphericalLights()[mScene->EmplaceSphericalLight()];
+        //sphereLight3.SetRadius(8);
+        //sphereLight3.SetPosition({ -5.3, 4.43, -4.76 });
+        //sphereLight3.SetColor(light3Color);
+        //sphereLight3.SetLuminousPower(300000);
 
         PathFinder::Camera& camera = mScene->MainCamera();
         camera.SetFarPlane(500);
@@ -355,14 +507,56 @@ namespace PathFinder
         //sceneManipulatorVC->CameraVM.SetCamera(&mScene->MainCamera());
         //sceneManipulatorVC->EntityVM.SetScene(&scene);
 
+        mScene->Serialize(demoScenePath);
+
+        if (mCmdLineParser->ShouldVerifySceneRoundTrip())
+        {
+            VerifySceneRoundTrip(demoScenePath);
+        }
+
+        mMaterialLoader->PackTextures(mScene->Materials());
         mScene->GPUStorage().UploadMeshes();
         mScene->GPUStorage().UploadMaterials();
+    }
+
+    void Application::VerifySceneRoundTrip(const std::filesystem::path& scenePath)
+    {
+        // A scene file read into an empty scene and written again has to stay byte for byte the same,
+        // otherwise Serialize and Deserialize disagree on some part of the scene
+        std::filesystem::path roundTripPath = scenePath;
+        roundTripPath.replace_extension(".roundtrip.pfscene");
+
+        Scene roundTripScene{ mCmdLineParser->ExecutableFolderPath(), mRenderEngine->Device(), mRenderEngine->ResourceProducer() };
 
-        // Build bottom AS only once. A production-level application would build every frame
-        for (const PathFinder::BottomRTAS& bottomRTAS : mScene->GPUStorage().BottomAccelerationStructures())
+        // File is read in two calls, the second one has to reuse meshes and materials of the first instead of duplicating them
+        bool isRoundTripWritten =
+            roundTripScene.Deserialize(scenePath, *mMeshLoader, *mMaterialLoader, SceneChunk::Meshes | SceneChunk::Materials) &&
+            roundTripScene.Deserialize(scenePath, *mMeshLoader, *mMaterialLoader) &&
+            roundTripScene.Serialize(roundTripPath);
+
+        auto readFile = [](const std::filesystem::path& path)
         {
-            mRenderEngine->AddBottomRayTracingAccelerationStructure(&bottomRTAS);
-        }
+            std::ifstream stream{ path, std::ios::binary };
+            return std::string{ std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+        };
+
+        bool isRoundTripExact = isRoundTripWritten && readFile(scenePath) == readFile(roundTripPath);
+
+        std::error_code error;
+        std::filesystem::remove(roundTripPath, error);
+
+        std::string report = StringFormat(
+            "Scene round trip of %s: %s, %llu meshes, %llu materials, %llu instances, %llu lights\n",
+            scenePath.filename().string().c_str(),
+            isRoundTripExact ? "identical" : "DIFFERENT",
+            (unsigned long long)roundTripScene.Meshes().size(),
+            (unsigned long long)roundTripScene.Materials().size(),
+            (unsigned long long)roundTripScene.MeshInstances().size(),
+            (unsigned long long)roundTripScene.TotalLightCount());
+
+        OutputDebugStringA(report.c_str());
+
+        assert_format(isRoundTripExact, "Scene file ", scenePath.filename().string(), " changes when read and written again");
     }
 
 }
@@ -13,6 +13,10 @@
 #include <Utility/DisplaySettingsController.hpp>
 
 #include "RenderPipeline/RenderPasses/GBufferRenderPass.hpp"
+#include "RenderPipeline/RenderPasses/HiZGenerationRenderPass.hpp"
+#include "RenderPipeline/RenderPasses/OcclusionCullingRenderPass.hpp"
+#include "RenderPipeline/RenderPasses/MeshletCullingRenderPass.hpp"
+#include "RenderPipeline/RenderPasses/GBufferSecondPhaseRenderPass.hpp"
 #include "RenderPipeline/RenderPasses/BackBufferOutputPass.hpp"
 #include "RenderPipeline/RenderPasses/RngSeedGenerationRenderPass.hpp"
 #include "RenderPipeline/RenderPasses/ShadingRenderPass.hpp"
@@ -43,6 +47,9 @@
 #include <Scene/MeshLoader.hpp>
 #include <Scene/MaterialLoader.hpp>
 
+#include <chrono>
+#include <filesystem>
+
 namespace PathFinder
 {
    
@@ -59,7 +66,10 @@ namespace PathFinder
         void InjectRenderPasses();
         void PerformPreRenderActions();
         void PerformPostRenderActions();
+        void ReadbackHiZPyramid();
         void LoadDemoScene();
+        void VerifySceneRoundTrip(const std::filesystem::path& scenePath);
+        void ReportStartupStatistics() const;
 
         HWND mWindowHandle;
         WNDCLASSEX mWindowClass;
@@ -78,7 +88,11 @@ namespace PathFinder
         std::unique_ptr<RenderPassContentMediator> mContentMediator;
 
         CommonSetupRenderPass mCommonSetupPass;
+        MeshletCullingRenderPass mMeshletCullingPass;
         GBufferRenderPass mGBufferPass;
+        HiZGenerationRenderPass mHiZGenerationPass;
+        OcclusionCullingRenderPass mOcclusionCullingPass;
+        GBufferSecondPhaseRenderPass mGBufferSecondPhasePass;
         RngSeedGenerationRenderPass mRgnSeedGenerationPass;
         ShadingRenderPass mShadingPass;
         DenoiserPreBlurRenderPass mDenoiserPreBlurPass;
@@ -104,6 +118,13 @@ namespace PathFinder
         GlobalRootConstants mGlobalConstants;
         PerFrameRootConstants mPerFrameConstants;
 
+        // Startup lasts until the first frame is rendered, since pipeline states are compiled during it
+        std::chrono::steady_clock::time_point mStartupTimestamp;
+        bool mIsStartupReported = false;
+
+        // Incremented whenever LoadDemoScene changes what it builds, so that scene files of older versions are not loaded
+        inline static const uint32_t DemoSceneVersion = 1;
+
         // Temporary to load demo scene
         std::unique_ptr<MeshLoader> mMeshLoader;
         std::unique_ptr<MaterialLoader> mMaterialLoader;
@@ -2,8 +2,13 @@
 
 #include <sstream>
 #include <cassert>
+#include <cstdlib>
 
+#ifdef _WIN32
 #include <windows.h>
+#else
+#include <iostream>
+#endif
 
 template< typename... Args >
 inline void print_assertion(Args&&... args)
@@ -15,7 +20,11 @@ inline void print_assertion(Args&&... args)
     //{
     (ss << ... << args) << std::endl;
     //}
+#ifdef _WIN32
     OutputDebugString(ss.str().c_str()); 
+#else
+    std::cerr << ss.str();
+#endif
     abort();
 }
 
@@ -0,0 +1,77 @@
+#include "FileWriting.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+namespace Foundation
+{
+
+    namespace
+    {
+        std::filesystem::path UniqueTemporaryPath(const std::filesystem::path& destination)
+        {
+            static std::atomic<uint64_t> WriteCounter{ 0 };
+
+            // Thread and counter tell apart writers within the process, clock ticks tell apart processes
+            uint64_t threadHash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+            uint64_t ticks = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+
+            std::stringstream suffix;
+            suffix << "." << std::hex << threadHash << "." << ticks << "." << WriteCounter++ << ".tmp";
+
+            std::filesystem::path temporaryPath = destination;
+            temporaryPath += suffix.str();
+            return temporaryPath;
+        }
+    }
+
+    bool WriteFileAtomically(const std::filesystem::path& destination, const std::function<void(std::ostream&)>& write)
+    {
+        std::error_code error;
+
+        if (destination.has_parent_path())
+        {
+            std::filesystem::create_directories(destination.parent_path(), error);
+        }
+
+        std::filesystem::path temporaryPath = UniqueTemporaryPath(destination);
+        bool isWritten = false;
+
+        {
+            std::ofstream stream{ temporaryPath, std::ios::binary | std::ios::trunc };
+
+            if (stream)
+            {
+                write(stream);
+                stream.flush();
+                isWritten = (bool)stream;
+            }
+        }
+
+        if (isWritten)
+        {
+            std::filesystem::rename(temporaryPath, destination, error);
+            isWritten = !error;
+        }
+
+        if (!isWritten)
+        {
+            std::filesystem::remove(temporaryPath, error);
+        }
+
+        return isWritten;
+    }
+
+    bool WriteFileAtomically(const std::filesystem::path& destination, const void* contents, uint64_t size)
+    {
+        return WriteFileAtomically(destination, [contents, size](std::ostream& stream)
+        {
+            stream.write(reinterpret_cast<const char*>(contents), size);
+        });
+    }
+
+}
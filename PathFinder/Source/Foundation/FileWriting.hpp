@@ -0,0 +1,18 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <ostream>
+#include <cstdint>
+
+namespace Foundation
+{
+
+    /// Writes a file under a temporary name next to the destination and renames it into place once written in full,
+    /// so readers never see a partial file. Temporary names are unique per call, so concurrent writers of the same destination
+    /// don't overwrite each other's data, and the temporary file is removed whenever writing or renaming fails.
+    /// Missing parent folders are created. Returns false if the destination wasn't replaced.
+    bool WriteFileAtomically(const std::filesystem::path& destination, const std::function<void(std::ostream&)>& write);
+    bool WriteFileAtomically(const std::filesystem::path& destination, const void* contents, uint64_t size);
+
+}
@@ -0,0 +1,112 @@
+#include "MemoryMappedFile.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <utility>
+
+namespace Foundation
+{
+
+    MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& path)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE) return;
+
+        mFile = file;
+
+        LARGE_INTEGER fileSize{};
+
+        // Zero sized files can't be mapped
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            Close();
+            return;
+        }
+
+        mMapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (!mMapping)
+        {
+            Close();
+            return;
+        }
+
+        mData = static_cast<const uint8_t*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+        mSize = mData ? uint64_t(fileSize.QuadPart) : 0;
+
+        if (!mData) Close();
+#else
+        int file = open(path.c_str(), O_RDONLY);
+
+        if (file < 0) return;
+
+        struct stat fileStat{};
+
+        // Zero sized files can't be mapped. Mapping stays valid after the descriptor is closed.
+        if (fstat(file, &fileStat) == 0 && fileStat.st_size > 0)
+        {
+            void* data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+            if (data != MAP_FAILED)
+            {
+                mData = static_cast<const uint8_t*>(data);
+                mSize = uint64_t(fileStat.st_size);
+            }
+        }
+
+        close(file);
+#endif
+    }
+
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        Close();
+    }
+
+    MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other)
+        : mFile{ std::exchange(other.mFile, nullptr) },
+        mMapping{ std::exchange(other.mMapping, nullptr) },
+        mData{ std::exchange(other.mData, nullptr) },
+        mSize{ std::exchange(other.mSize, 0) } {}
+
+    MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other)
+    {
+        if (this != &other)
+        {
+            Close();
+
+            mFile = std::exchange(other.mFile, nullptr);
+            mMapping = std::exchange(other.mMapping, nullptr);
+            mData = std::exchange(other.mData, nullptr);
+            mSize = std::exchange(other.mSize, 0);
+        }
+
+        return *this;
+    }
+
+    void MemoryMappedFile::Close()
+    {
+#ifdef _WIN32
+        if (mData) UnmapViewOfFile(mData);
+        if (mMapping) CloseHandle(mMapping);
+        if (mFile) CloseHandle(mFile);
+#else
+        if (mData) munmap(const_cast<uint8_t*>(mData), mSize);
+#endif
+
+        mData = nullptr;
+        mMapping = nullptr;
+        mFile = nullptr;
+        mSize = 0;
+    }
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <filesystem>
+#include <cstdint>
+
+namespace Foundation
+{
+
+    /// Read-only view of a whole file mapped into address space.
+    /// Pages are brought in by the OS on first access, so only touched parts of the file are read.
+    class MemoryMappedFile
+    {
+    public:
+        MemoryMappedFile() = default;
+        MemoryMappedFile(const std::filesystem::path& path);
+        ~MemoryMappedFile();
+
+        MemoryMappedFile(MemoryMappedFile&& other);
+        MemoryMappedFile& operator=(MemoryMappedFile&& other);
+
+        MemoryMappedFile(const MemoryMappedFile& other) = delete;
+        MemoryMappedFile& operator=(const MemoryMappedFile& other) = delete;
+
+        void Close();
+
+    private:
+        // Windows handles, stored untyped to keep windows.h out of the header. POSIX mapping needs no handles.
+        void* mFile = nullptr;
+        void* mMapping = nullptr;
+
+        const uint8_t* mData = nullptr;
+        uint64_t mSize = 0;
+
+    public:
+        // Empty and missing files are never open
+        inline bool IsOpen() const { return mData != nullptr; }
+        inline const uint8_t* Data() const { return mData; }
+        inline uint64_t Size() const { return mSize; }
+    };
+
+}
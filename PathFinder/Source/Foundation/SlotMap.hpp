@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+
+namespace Foundation
+{
+
+    template <class T>
+    struct SlotMapHandle
+    {
+        inline static const uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+        uint32_t Index = InvalidIndex;
+        uint32_t Generation = 0;
+
+        bool IsValid() const { return Index != InvalidIndex; }
+        bool operator==(const SlotMapHandle& that) const { return Index == that.Index && Generation == that.Generation; }
+        bool operator!=(const SlotMapHandle& that) const { return !(*this == that); }
+
+        template <typename S>
+        void serialize(S& s)
+        {
+            s.value4b(Index);
+            s.value4b(Generation);
+        }
+    };
+
+    /// Stores elements contiguously for cache friendly iteration
+    /// and hands out generational handles that survive insertions and removals.
+    /// Removal moves the last element into the freed spot, so element order is not preserved
+    /// and pointers/references to elements are invalidated by any insertion or removal.
+    template <class T>
+    class SlotMap
+    {
+    public:
+        using Handle = SlotMapHandle<T>;
+        using Iterator = typename std::vector<T>::iterator;
+        using ConstIterator = typename std::vector<T>::const_iterator;
+
+        template <class... Args>
+        Handle Emplace(Args&&... args);
+
+        Handle Insert(T&& value);
+        bool Erase(Handle handle);
+        void Clear();
+        void Reserve(uint64_t capacity);
+
+        bool Contains(Handle handle) const;
+
+        // Returns nullptr for stale or invalid handles
+        T* Get(Handle handle);
+        const T* Get(Handle handle) const;
+
+        T& operator[](Handle handle);
+        const T& operator[](Handle handle) const;
+
+        // Handle of an element at a position in dense storage
+        Handle HandleAt(uint64_t denseIndex) const;
+
+    private:
+        struct Slot
+        {
+            // Index into dense storage when occupied, next free slot otherwise
+            uint32_t DenseIndexOrNextFree = Handle::InvalidIndex;
+            uint32_t Generation = 0;
+        };
+
+        uint32_t AcquireSlot();
+
+        std::vector<T> mValues;
+        std::vector<uint32_t> mDenseToSlot;
+        std::vector<Slot> mSlots;
+        uint32_t mFreeSlotHead = Handle::InvalidIndex;
+
+    public:
+        inline Iterator begin() { return mValues.begin(); }
+        inline Iterator end() { return mValues.end(); }
+        inline ConstIterator begin() const { return mValues.begin(); }
+        inline ConstIterator end() const { return mValues.end(); }
+        inline auto size() const { return mValues.size(); }
+        inline bool empty() const { return mValues.empty(); }
+        inline T* data() { return mValues.data(); }
+        inline const T* data() const { return mValues.data(); }
+    };
+
+}
+
+#include "SlotMap.inl"
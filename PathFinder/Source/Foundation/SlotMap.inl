@@ -0,0 +1,139 @@
+#include "Assert.hpp"
+
+namespace Foundation
+{
+
+    template <class T>
+    template <class... Args>
+    typename SlotMap<T>::Handle SlotMap<T>::Emplace(Args&&... args)
+    {
+        uint32_t slotIndex = AcquireSlot();
+        Slot& slot = mSlots[slotIndex];
+
+        slot.DenseIndexOrNextFree = (uint32_t)mValues.size();
+        mValues.emplace_back(std::forward<Args>(args)...);
+        mDenseToSlot.push_back(slotIndex);
+
+        return { slotIndex, slot.Generation };
+    }
+
+    template <class T>
+    typename SlotMap<T>::Handle SlotMap<T>::Insert(T&& value)
+    {
+        return Emplace(std::move(value));
+    }
+
+    template <class T>
+    bool SlotMap<T>::Erase(Handle handle)
+    {
+        if (!Contains(handle))
+        {
+            return false;
+        }
+
+        Slot& slot = mSlots[handle.Index];
+        uint32_t denseIndex = slot.DenseIndexOrNextFree;
+        uint32_t lastDenseIndex = (uint32_t)mValues.size() - 1;
+
+        // Keep storage dense by moving the last element into the hole
+        if (denseIndex != lastDenseIndex)
+        {
+            mValues[denseIndex] = std::move(mValues[lastDenseIndex]);
+            mDenseToSlot[denseIndex] = mDenseToSlot[lastDenseIndex];
+            mSlots[mDenseToSlot[denseIndex]].DenseIndexOrNextFree = denseIndex;
+        }
+
+        mValues.pop_back();
+        mDenseToSlot.pop_back();
+
+        // Bump generation so that outstanding handles become stale
+        ++slot.Generation;
+        slot.DenseIndexOrNextFree = mFreeSlotHead;
+        mFreeSlotHead = handle.Index;
+
+        return true;
+    }
+
+    template <class T>
+    void SlotMap<T>::Clear()
+    {
+        // Slots are kept to preserve generations and invalidate every outstanding handle
+        for (uint32_t slotIndex : mDenseToSlot)
+        {
+            Slot& slot = mSlots[slotIndex];
+            ++slot.Generation;
+            slot.DenseIndexOrNextFree = mFreeSlotHead;
+            mFreeSlotHead = slotIndex;
+        }
+
+        mValues.clear();
+        mDenseToSlot.clear();
+    }
+
+    template <class T>
+    void SlotMap<T>::Reserve(uint64_t capacity)
+    {
+        mValues.reserve(capacity);
+        mDenseToSlot.reserve(capacity);
+        mSlots.reserve(capacity);
+    }
+
+    template <class T>
+    bool SlotMap<T>::Contains(Handle handle) const
+    {
+        return handle.Index < mSlots.size() &&
+            mSlots[handle.Index].Generation == handle.Generation &&
+            mSlots[handle.Index].DenseIndexOrNextFree < mValues.size() &&
+            mDenseToSlot[mSlots[handle.Index].DenseIndexOrNextFree] == handle.Index;
+    }
+
+    template <class T>
+    T* SlotMap<T>::Get(Handle handle)
+    {
+        return Contains(handle) ? &mValues[mSlots[handle.Index].DenseIndexOrNextFree] : nullptr;
+    }
+
+    template <class T>
+    const T* SlotMap<T>::Get(Handle handle) const
+    {
+        return Contains(handle) ? &mValues[mSlots[handle.Index].DenseIndexOrNextFree] : nullptr;
+    }
+
+    template <class T>
+    T& SlotMap<T>::operator[](Handle handle)
+    {
+        assert_format(Contains(handle), "Slot map handle is stale or invalid");
+        return mValues[mSlots[handle.Index].DenseIndexOrNextFree];
+    }
+
+    template <class T>
+    const T& SlotMap<T>::operator[](Handle handle) const
+    {
+        assert_format(Contains(handle), "Slot map handle is stale or invalid");
+        return mValues[mSlots[handle.Index].DenseIndexOrNextFree];
+    }
+
+    template <class T>
+    typename SlotMap<T>::Handle SlotMap<T>::HandleAt(uint64_t denseIndex) const
+    {
+        uint32_t slotIndex = mDenseToSlot[denseIndex];
+        return { slotIndex, mSlots[slotIndex].Generation };
+    }
+
+    template <class T>
+    uint32_t SlotMap<T>::AcquireSlot()
+    {
+        if (mFreeSlotHead != Handle::InvalidIndex)
+        {
+            uint32_t slotIndex = mFreeSlotHead;
+            mFreeSlotHead = mSlots[slotIndex].DenseIndexOrNextFree;
+            return slotIndex;
+        }
+
+        assert_format(mSlots.size() < Handle::InvalidIndex, "Slot map is out of slots");
+
+        mSlots.emplace_back();
+        return (uint32_t)mSlots.size() - 1;
+    }
+
+}
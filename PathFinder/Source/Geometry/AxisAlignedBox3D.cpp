@@ -43,6 +43,12 @@ namespace Geometry
         return glm::length(Max - Min);
     }
 
+    float AxisAlignedBox3D::SurfaceArea() const
+    {
+        glm::vec3 extent = glm::max(Max - Min, glm::zero<glm::vec3>());
+        return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+    }
+
     glm::mat4 AxisAlignedBox3D::AsFrustum() const
     {
         // Z component shenanigans due to NDC and world handedness inconsistency
@@ -73,14 +79,14 @@ namespace Geometry
 
     float AxisAlignedBox3D::SmallestDimensionLength() const
     {
-        float minXY = std::min(fabs(Max.x - Min.x), fabs(Max.y - Min.y));
-        return std::min(fabs(Max.z - Min.z), minXY);
+        float minXY = std::min(std::fabs(Max.x - Min.x), std::fabs(Max.y - Min.y));
+        return std::min(std::fabs(Max.z - Min.z), minXY);
     }
 
     float AxisAlignedBox3D::LargestDimensionLength() const
     {
-        float maxXY = std::max(fabs(Max.x - Min.x), fabs(Max.y - Min.y));
-        return std::max(fabs(Max.z - Min.z), maxXY);
+        float maxXY = std::max(std::fabs(Max.x - Min.x), std::fabs(Max.y - Min.y));
+        return std::max(std::fabs(Max.z - Min.z), maxXY);
     }
 
     glm::vec3 AxisAlignedBox3D::Сenter() const
@@ -127,16 +133,22 @@ namespace Geometry
 
     AxisAlignedBox3D AxisAlignedBox3D::TransformedBy(const glm::mat4 &m) const
     {
-        glm::vec4 newMin = { Min.x, Min.y, Min.z, 1.0 };
-        glm::vec4 newMax = { Max.x, Max.y, Max.z, 1.0 };
-        newMin = m * newMin;
-        newMax = m * newMax;
-        newMin /= newMin.w;
-        newMax /= newMax.w;
-        return { glm::vec3(newMin), glm::vec3(newMax) };
+        // Transforming only min and max points is not enough under rotation,
+        // so resulting box has to enclose all transformed corners
+        AxisAlignedBox3D transformed = MaximumReversed();
+
+        for (const glm::vec4& corner : CornerPoints())
+        {
+            glm::vec4 transformedCorner = m * corner;
+            transformedCorner /= transformedCorner.w;
+            transformed.Min = glm::min(transformed.Min, glm::vec3(transformedCorner));
+            transformed.Max = glm::max(transformed.Max, glm::vec3(transformedCorner));
+        }
+
+        return transformed;
     }
 
-    AxisAlignedBox3D AxisAlignedBox3D::Union(const AxisAlignedBox3D& otherBox)
+    AxisAlignedBox3D AxisAlignedBox3D::Union(const AxisAlignedBox3D& otherBox) const
     {
         return { glm::min(Min, otherBox.Min), glm::max(Max, otherBox.Max) };
     }
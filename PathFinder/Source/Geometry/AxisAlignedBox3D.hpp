@@ -26,6 +26,7 @@ namespace Geometry
         AxisAlignedBox3D(const glm::vec3 &min, const glm::vec3 &max);
 
         float Diagonal() const;
+        float SurfaceArea() const;
 
         /**
          Represents box as an orthographic projection matrix
@@ -60,7 +61,7 @@ namespace Geometry
         std::array<AxisAlignedBox3D, 8> Octet() const;
         AxisAlignedBox3D TransformedBy(const Transformation &t) const;
         AxisAlignedBox3D TransformedBy(const glm::mat4 &m) const;
-        AxisAlignedBox3D Union(const AxisAlignedBox3D& otherBox);
+        AxisAlignedBox3D Union(const AxisAlignedBox3D& otherBox) const;
     };
 
 }
@@ -0,0 +1,303 @@
+#include "BoundingVolumeHierarchy.hpp"
+
+#include <Foundation/Assert.hpp>
+
+#include <algorithm>
+
+namespace Geometry
+{
+
+    void BoundingVolumeHierarchy::Build(const std::vector<AxisAlignedBox3D>& primitiveBounds)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        Clear();
+
+        if (primitiveBounds.empty()) return;
+
+        uint32_t primitiveCount = (uint32_t)primitiveBounds.size();
+
+        mPrimitiveBounds = primitiveBounds;
+        mPrimitiveIndices.resize(primitiveCount);
+        mPrimitiveLeafIndices.resize(primitiveCount);
+
+        std::vector<BuildPrimitive> primitives(primitiveCount);
+
+        for (uint32_t primitiveIdx = 0; primitiveIdx < primitiveCount; ++primitiveIdx)
+        {
+            const AxisAlignedBox3D& bounds = primitiveBounds[primitiveIdx];
+            primitives[primitiveIdx] = { bounds, (bounds.Min + bounds.Max) * 0.5f, primitiveIdx };
+        }
+
+        // A binary tree with at least one primitive per leaf can't have more nodes than that
+        mNodes.reserve(2 * primitiveCount - 1);
+        mParentIndices.reserve(2 * primitiveCount - 1);
+
+        Node root{};
+        root.LeftChildOrFirstPrimitive = 0;
+        root.PrimitiveCount = primitiveCount;
+
+        mNodes.push_back(root);
+        mParentIndices.push_back(0);
+
+        // Node index and its depth
+        std::vector<std::pair<uint32_t, uint32_t>> stack{ { 0, 1 } };
+
+        while (!stack.empty())
+        {
+            auto [nodeIdx, depth] = stack.back();
+            stack.pop_back();
+
+            mStatistics.Depth = std::max(mStatistics.Depth, depth);
+
+            uint32_t first = mNodes[nodeIdx].LeftChildOrFirstPrimitive;
+            uint32_t count = mNodes[nodeIdx].PrimitiveCount;
+
+            AxisAlignedBox3D bounds = AxisAlignedBox3D::MaximumReversed();
+            AxisAlignedBox3D centroidBounds = AxisAlignedBox3D::MaximumReversed();
+
+            for (uint32_t idx = first; idx < first + count; ++idx)
+            {
+                const BuildPrimitive& primitive = primitives[idx];
+                bounds = bounds.Union(primitive.Bounds);
+                centroidBounds = centroidBounds.Union({ primitive.Centroid, primitive.Centroid });
+            }
+
+            mNodes[nodeIdx].Bounds = bounds;
+
+            auto makeLeaf = [&]()
+            {
+                for (uint32_t idx = first; idx < first + count; ++idx)
+                {
+                    mPrimitiveIndices[idx] = primitives[idx].Index;
+                    mPrimitiveLeafIndices[primitives[idx].Index] = nodeIdx;
+                }
+            };
+
+            // Testing a handful of boxes is cheaper than evaluating splits for them
+            if (count <= mSettings.MaxPrimitivesInLeaf)
+            {
+                makeLeaf();
+                continue;
+            }
+
+            std::optional<Split> split = FindBestSplit(mNodes[nodeIdx], primitives, centroidBounds);
+
+            auto firstIt = primitives.begin() + first;
+            auto lastIt = firstIt + count;
+            auto middleIt = firstIt;
+
+            if (split)
+            {
+                middleIt = std::partition(firstIt, lastIt, [&](const BuildPrimitive& primitive)
+                {
+                    return BinIndex(primitive.Centroid, centroidBounds, split->Axis) <= split->Bin;
+                });
+            }
+
+            // Centroids are too close to be binned, fall back to splitting in the middle of the list
+            if (middleIt == firstIt || middleIt == lastIt)
+            {
+                middleIt = firstIt + count / 2;
+            }
+
+            uint32_t leftCount = uint32_t(middleIt - firstIt);
+            uint32_t leftChildIdx = (uint32_t)mNodes.size();
+
+            Node leftChild{};
+            leftChild.LeftChildOrFirstPrimitive = first;
+            leftChild.PrimitiveCount = leftCount;
+
+            Node rightChild{};
+            rightChild.LeftChildOrFirstPrimitive = first + leftCount;
+            rightChild.PrimitiveCount = count - leftCount;
+
+            mNodes[nodeIdx].LeftChildOrFirstPrimitive = leftChildIdx;
+            mNodes[nodeIdx].PrimitiveCount = 0;
+
+            mNodes.push_back(leftChild);
+            mNodes.push_back(rightChild);
+            mParentIndices.push_back(nodeIdx);
+            mParentIndices.push_back(nodeIdx);
+
+            stack.emplace_back(leftChildIdx, depth + 1);
+            stack.emplace_back(leftChildIdx + 1, depth + 1);
+        }
+
+        mIsNodeDirty.resize(mNodes.size(), false);
+
+        mStatistics.BuildTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+    }
+
+    void BoundingVolumeHierarchy::Clear()
+    {
+        mNodes.clear();
+        mParentIndices.clear();
+        mPrimitiveIndices.clear();
+        mPrimitiveBounds.clear();
+        mPrimitiveLeafIndices.clear();
+        mDirtyNodes.clear();
+        mIsNodeDirty.clear();
+        mStatistics = {};
+    }
+
+    void BoundingVolumeHierarchy::SetPrimitiveBounds(uint32_t primitiveIndex, const AxisAlignedBox3D& bounds)
+    {
+        assert_format(primitiveIndex < mPrimitiveBounds.size(), "Primitive index is out of bounds");
+
+        mPrimitiveBounds[primitiveIndex] = bounds;
+
+        // Mark the whole path to the root, stopping at already marked nodes
+        uint32_t nodeIdx = mPrimitiveLeafIndices[primitiveIndex];
+
+        while (!mIsNodeDirty[nodeIdx])
+        {
+            mIsNodeDirty[nodeIdx] = true;
+            mDirtyNodes.push_back(nodeIdx);
+
+            if (nodeIdx == 0) break;
+
+            nodeIdx = mParentIndices[nodeIdx];
+        }
+    }
+
+    void BoundingVolumeHierarchy::Refit()
+    {
+        if (mDirtyNodes.empty()) return;
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        // Children are always placed after their parents, so processing
+        // nodes in descending order updates children before parents
+        std::sort(mDirtyNodes.begin(), mDirtyNodes.end(), std::greater<uint32_t>());
+
+        for (uint32_t nodeIdx : mDirtyNodes)
+        {
+            Node& node = mNodes[nodeIdx];
+
+            if (node.IsLeaf())
+            {
+                AxisAlignedBox3D bounds = AxisAlignedBox3D::MaximumReversed();
+
+                for (uint32_t idx = node.LeftChildOrFirstPrimitive; idx < node.LeftChildOrFirstPrimitive + node.PrimitiveCount; ++idx)
+                {
+                    bounds = bounds.Union(mPrimitiveBounds[mPrimitiveIndices[idx]]);
+                }
+
+                node.Bounds = bounds;
+            }
+            else
+            {
+                node.Bounds = mNodes[node.LeftChildOrFirstPrimitive].Bounds.Union(mNodes[node.LeftChildOrFirstPrimitive + 1].Bounds);
+            }
+
+            mIsNodeDirty[nodeIdx] = false;
+        }
+
+        mStatistics.RefittedNodeCount = (uint32_t)mDirtyNodes.size();
+        mDirtyNodes.clear();
+
+        mStatistics.RefitTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+    }
+
+    float BoundingVolumeHierarchy::SAHCost() const
+    {
+        if (mNodes.empty()) return 0.0f;
+
+        float rootArea = mNodes[0].Bounds.SurfaceArea();
+
+        if (rootArea <= 0.0f) return 0.0f;
+
+        float cost = 0.0f;
+
+        for (const Node& node : mNodes)
+        {
+            float nodeCost = node.IsLeaf() ? float(node.PrimitiveCount) : mSettings.TraversalCost;
+            cost += nodeCost * node.Bounds.SurfaceArea();
+        }
+
+        return cost / rootArea;
+    }
+
+    std::optional<BoundingVolumeHierarchy::Split> BoundingVolumeHierarchy::FindBestSplit(
+        const Node& node, const std::vector<BuildPrimitive>& primitives, const AxisAlignedBox3D& centroidBounds) const
+    {
+        assert_format(mSettings.BinCount > 1, "Binned SAH build requires at least two bins");
+
+        std::optional<Split> bestSplit;
+        std::vector<Bin> bins(3 * mSettings.BinCount);
+        std::vector<float> rightCosts(mSettings.BinCount);
+
+        glm::vec3 centroidExtent = centroidBounds.Max - centroidBounds.Min;
+        glm::vec3 binScale{
+            centroidExtent.x > 0.0f ? mSettings.BinCount / centroidExtent.x : 0.0f,
+            centroidExtent.y > 0.0f ? mSettings.BinCount / centroidExtent.y : 0.0f,
+            centroidExtent.z > 0.0f ? mSettings.BinCount / centroidExtent.z : 0.0f
+        };
+
+        // Bin all axes in a single pass over primitives
+        for (uint32_t idx = node.LeftChildOrFirstPrimitive; idx < node.LeftChildOrFirstPrimitive + node.PrimitiveCount; ++idx)
+        {
+            const BuildPrimitive& primitive = primitives[idx];
+            glm::vec3 relativePosition = (primitive.Centroid - centroidBounds.Min) * binScale;
+
+            for (uint32_t axis = 0; axis < 3; ++axis)
+            {
+                uint32_t binIdx = std::min(uint32_t(relativePosition[axis]), mSettings.BinCount - 1);
+                Bin& bin = bins[axis * mSettings.BinCount + binIdx];
+                bin.Bounds.Min = glm::min(bin.Bounds.Min, primitive.Bounds.Min);
+                bin.Bounds.Max = glm::max(bin.Bounds.Max, primitive.Bounds.Max);
+                bin.PrimitiveCount++;
+            }
+        }
+
+        float traversalCost = mSettings.TraversalCost * node.Bounds.SurfaceArea();
+
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+            if (centroidExtent[axis] <= 0.0f) continue;
+
+            const Bin* axisBins = &bins[axis * mSettings.BinCount];
+
+            // Sweep from the right to get costs of right halves,
+            // then from the left to combine them with left halves
+            AxisAlignedBox3D rightBounds = AxisAlignedBox3D::MaximumReversed();
+            uint32_t rightCount = 0;
+
+            for (uint32_t binIdx = mSettings.BinCount - 1; binIdx > 0; --binIdx)
+            {
+                rightBounds = rightBounds.Union(axisBins[binIdx].Bounds);
+                rightCount += axisBins[binIdx].PrimitiveCount;
+                rightCosts[binIdx - 1] = rightCount > 0 ? rightBounds.SurfaceArea() * rightCount : 0.0f;
+            }
+
+            AxisAlignedBox3D leftBounds = AxisAlignedBox3D::MaximumReversed();
+            uint32_t leftCount = 0;
+
+            for (uint32_t binIdx = 0; binIdx < mSettings.BinCount - 1; ++binIdx)
+            {
+                leftBounds = leftBounds.Union(axisBins[binIdx].Bounds);
+                leftCount += axisBins[binIdx].PrimitiveCount;
+
+                if (leftCount == 0 || leftCount == node.PrimitiveCount) continue;
+
+                float cost = traversalCost + leftBounds.SurfaceArea() * leftCount + rightCosts[binIdx];
+
+                if (!bestSplit || cost < bestSplit->Cost)
+                {
+                    bestSplit = Split{ axis, binIdx, cost };
+                }
+            }
+        }
+
+        return bestSplit;
+    }
+
+    uint32_t BoundingVolumeHierarchy::BinIndex(const glm::vec3& centroid, const AxisAlignedBox3D& centroidBounds, uint32_t axis) const
+    {
+        float extent = centroidBounds.Max[axis] - centroidBounds.Min[axis];
+        float relativePosition = (centroid[axis] - centroidBounds.Min[axis]) / extent;
+        return std::min(uint32_t(relativePosition * mSettings.BinCount), mSettings.BinCount - 1);
+    }
+
+}
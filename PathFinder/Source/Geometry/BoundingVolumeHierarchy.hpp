@@ -0,0 +1,144 @@
+#pragma once
+
+#include "AxisAlignedBox3D.hpp"
+#include "Ray3D.hpp"
+#include "Frustum.hpp"
+#include "Collision.hpp"
+
+#include <vector>
+#include <optional>
+#include <chrono>
+#include <cstdint>
+
+namespace Geometry
+{
+
+    /// A binary tree of boxes over a set of primitives identified by their index.
+    /// Built top-down with binned surface area heuristic. When primitives move the tree
+    /// can be refitted: node bounds are recomputed, but topology stays intact,
+    /// so tree quality degrades over time and a rebuild is eventually required.
+    class BoundingVolumeHierarchy
+    {
+    public:
+        struct Node
+        {
+            AxisAlignedBox3D Bounds;
+
+            // Left child index for inner nodes (right child is next to it),
+            // first entry in primitive index list for leaves
+            uint32_t LeftChildOrFirstPrimitive = 0;
+            uint32_t PrimitiveCount = 0;
+
+            inline bool IsLeaf() const { return PrimitiveCount > 0; }
+        };
+
+        struct BuildSettings
+        {
+            uint32_t BinCount = 16;
+            uint32_t MaxPrimitivesInLeaf = 4;
+
+            // Cost of visiting a node relative to the cost of testing a primitive
+            float TraversalCost = 1.0f;
+        };
+
+        struct Statistics
+        {
+            uint32_t Depth = 0;
+            std::chrono::microseconds BuildTime{ 0 };
+            std::chrono::microseconds RefitTime{ 0 };
+            uint32_t RefittedNodeCount = 0;
+        };
+
+        struct RayHit
+        {
+            uint32_t PrimitiveIndex = 0;
+            float Distance = 0.0f;
+        };
+
+        void Build(const std::vector<AxisAlignedBox3D>& primitiveBounds);
+        void Clear();
+
+        /// Changes bounds of a primitive. Tree is updated on next Refit().
+        void SetPrimitiveBounds(uint32_t primitiveIndex, const AxisAlignedBox3D& bounds);
+        void Refit();
+
+        /// Expected cost of a random query estimated with surface area heuristic.
+        /// Comparing it to the cost right after a build tells how much refits degraded the tree.
+        float SAHCost() const;
+
+        /// Visits every primitive whose box is hit by the ray closer than max distance.
+        /// Visitor receives primitive index and distance to its box.
+        template <class Visitor>
+        void QueryRay(const Ray3D& ray, float maxDistance, Visitor&& visitor) const;
+
+        /// Finds the closest primitive hit by the ray. Boxes are traversed front to back and
+        /// hit test, bool(uint32_t primitiveIndex, float& distance), performs the exact test.
+        template <class HitTest>
+        std::optional<RayHit> RaycastClosest(const Ray3D& ray, HitTest&& hitTest) const;
+
+        /// Visits every primitive whose box intersects or is inside the frustum
+        template <class Visitor>
+        void QueryFrustum(const Frustum& frustum, Visitor&& visitor) const;
+
+        /// Visits every primitive whose box overlaps the given box
+        template <class Visitor>
+        void QueryOverlaps(const AxisAlignedBox3D& box, Visitor&& visitor) const;
+
+    private:
+        struct Bin
+        {
+            AxisAlignedBox3D Bounds = AxisAlignedBox3D::MaximumReversed();
+            uint32_t PrimitiveCount = 0;
+        };
+
+        struct Split
+        {
+            uint32_t Axis = 0;
+            uint32_t Bin = 0;
+            float Cost = 0.0f;
+        };
+
+        // Primitives are partitioned in a contiguous list during build
+        // to avoid scattered reads of bounds through primitive indices
+        struct BuildPrimitive
+        {
+            AxisAlignedBox3D Bounds;
+            glm::vec3 Centroid;
+            uint32_t Index = 0;
+        };
+
+        std::optional<Split> FindBestSplit(const Node& node, const std::vector<BuildPrimitive>& primitives, const AxisAlignedBox3D& centroidBounds) const;
+        uint32_t BinIndex(const glm::vec3& centroid, const AxisAlignedBox3D& centroidBounds, uint32_t axis) const;
+
+        template <class Visitor>
+        void VisitSubtree(uint32_t nodeIndex, std::vector<uint32_t>& stack, Visitor&& visitor) const;
+
+        BuildSettings mSettings;
+        Statistics mStatistics;
+
+        std::vector<Node> mNodes;
+        std::vector<uint32_t> mParentIndices;
+
+        // Leaves reference ranges of this list
+        std::vector<uint32_t> mPrimitiveIndices;
+        std::vector<AxisAlignedBox3D> mPrimitiveBounds;
+        std::vector<uint32_t> mPrimitiveLeafIndices;
+
+        std::vector<uint32_t> mDirtyNodes;
+        std::vector<bool> mIsNodeDirty;
+
+    public:
+        inline const auto& Nodes() const { return mNodes; }
+        inline const auto& PrimitiveBounds() const { return mPrimitiveBounds; }
+        inline const auto& GetStatistics() const { return mStatistics; }
+        inline const auto& Settings() const { return mSettings; }
+        inline auto PrimitiveCount() const { return mPrimitiveBounds.size(); }
+        inline bool IsEmpty() const { return mNodes.empty(); }
+        inline bool NeedsRefit() const { return !mDirtyNodes.empty(); }
+
+        inline void SetSettings(const BuildSettings& settings) { mSettings = settings; }
+    };
+
+}
+
+#include "BoundingVolumeHierarchy.inl"
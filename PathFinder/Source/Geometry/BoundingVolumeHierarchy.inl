@@ -0,0 +1,204 @@
+namespace Geometry
+{
+
+    template <class Visitor>
+    void BoundingVolumeHierarchy::QueryRay(const Ray3D& ray, float maxDistance, Visitor&& visitor) const
+    {
+        if (mNodes.empty()) return;
+
+        std::vector<uint32_t> stack{ 0 };
+
+        while (!stack.empty())
+        {
+            const Node& node = mNodes[stack.back()];
+            stack.pop_back();
+
+            float distance = 0.0f;
+
+            if (!Collision::RayAABB(ray, node.Bounds, distance) || distance > maxDistance) continue;
+
+            if (!node.IsLeaf())
+            {
+                stack.push_back(node.LeftChildOrFirstPrimitive);
+                stack.push_back(node.LeftChildOrFirstPrimitive + 1);
+                continue;
+            }
+
+            for (uint32_t idx = node.LeftChildOrFirstPrimitive; idx < node.LeftChildOrFirstPrimitive + node.PrimitiveCount; ++idx)
+            {
+                uint32_t primitiveIdx = mPrimitiveIndices[idx];
+
+                if (Collision::RayAABB(ray, mPrimitiveBounds[primitiveIdx], distance) && distance <= maxDistance)
+                {
+                    visitor(primitiveIdx, std::max(distance, 0.0f));
+                }
+            }
+        }
+    }
+
+    template <class HitTest>
+    std::optional<BoundingVolumeHierarchy::RayHit> BoundingVolumeHierarchy::RaycastClosest(const Ray3D& ray, HitTest&& hitTest) const
+    {
+        if (mNodes.empty()) return std::nullopt;
+
+        std::optional<RayHit> closestHit;
+
+        // Node index and distance to its box
+        std::vector<std::pair<uint32_t, float>> stack;
+
+        float rootDistance = 0.0f;
+
+        if (Collision::RayAABB(ray, mNodes[0].Bounds, rootDistance))
+        {
+            stack.emplace_back(0, std::max(rootDistance, 0.0f));
+        }
+
+        while (!stack.empty())
+        {
+            auto [nodeIdx, nodeDistance] = stack.back();
+            stack.pop_back();
+
+            // A closer hit was found after the node was pushed
+            if (closestHit && nodeDistance > closestHit->Distance) continue;
+
+            const Node& node = mNodes[nodeIdx];
+
+            if (node.IsLeaf())
+            {
+                for (uint32_t idx = node.LeftChildOrFirstPrimitive; idx < node.LeftChildOrFirstPrimitive + node.PrimitiveCount; ++idx)
+                {
+                    uint32_t primitiveIdx = mPrimitiveIndices[idx];
+                    float distance = 0.0f;
+
+                    if (hitTest(primitiveIdx, distance) && (!closestHit || distance < closestHit->Distance))
+                    {
+                        closestHit = RayHit{ primitiveIdx, distance };
+                    }
+                }
+
+                continue;
+            }
+
+            uint32_t nearIdx = node.LeftChildOrFirstPrimitive;
+            uint32_t farIdx = node.LeftChildOrFirstPrimitive + 1;
+            float nearDistance = 0.0f;
+            float farDistance = 0.0f;
+            bool isNearHit = Collision::RayAABB(ray, mNodes[nearIdx].Bounds, nearDistance);
+            bool isFarHit = Collision::RayAABB(ray, mNodes[farIdx].Bounds, farDistance);
+
+            nearDistance = std::max(nearDistance, 0.0f);
+            farDistance = std::max(farDistance, 0.0f);
+
+            if (isNearHit && isFarHit && farDistance < nearDistance)
+            {
+                std::swap(nearIdx, farIdx);
+                std::swap(nearDistance, farDistance);
+            }
+            else if (!isNearHit)
+            {
+                std::swap(nearIdx, farIdx);
+                std::swap(nearDistance, farDistance);
+                std::swap(isNearHit, isFarHit);
+            }
+
+            // Near child is pushed last to be visited first
+            if (isFarHit) stack.emplace_back(farIdx, farDistance);
+            if (isNearHit) stack.emplace_back(nearIdx, nearDistance);
+        }
+
+        return closestHit;
+    }
+
+    template <class Visitor>
+    void BoundingVolumeHierarchy::QueryFrustum(const Frustum& frustum, Visitor&& visitor) const
+    {
+        if (mNodes.empty()) return;
+
+        std::vector<uint32_t> stack{ 0 };
+        std::vector<uint32_t> subtreeStack;
+
+        while (!stack.empty())
+        {
+            uint32_t nodeIdx = stack.back();
+            const Node& node = mNodes[nodeIdx];
+            stack.pop_back();
+
+            if (!Collision::FrustumAABB(frustum, node.Bounds)) continue;
+
+            // Everything below a fully contained node is visible, no need for further tests
+            if (frustum.Contains(node.Bounds))
+            {
+                VisitSubtree(nodeIdx, subtreeStack, visitor);
+                continue;
+            }
+
+            if (!node.IsLeaf())
+            {
+                stack.push_back(node.LeftChildOrFirstPrimitive);
+                stack.push_back(node.LeftChildOrFirstPrimitive + 1);
+                continue;
+            }
+
+            for (uint32_t idx = node.LeftChildOrFirstPrimitive; idx < node.LeftChildOrFirstPrimitive + node.PrimitiveCount; ++idx)
+            {
+                uint32_t primitiveIdx = mPrimitiveIndices[idx];
+                if (Collision::FrustumAABB(frustum, mPrimitiveBounds[primitiveIdx])) visitor(primitiveIdx);
+            }
+        }
+    }
+
+    template <class Visitor>
+    void BoundingVolumeHierarchy::QueryOverlaps(const AxisAlignedBox3D& box, Visitor&& visitor) const
+    {
+        if (mNodes.empty()) return;
+
+        std::vector<uint32_t> stack{ 0 };
+
+        while (!stack.empty())
+        {
+            const Node& node = mNodes[stack.back()];
+            stack.pop_back();
+
+            if (!Collision::AABBAABB(box, node.Bounds)) continue;
+
+            if (!node.IsLeaf())
+            {
+                stack.push_back(node.LeftChildOrFirstPrimitive);
+                stack.push_back(node.LeftChildOrFirstPrimitive + 1);
+                continue;
+            }
+
+            for (uint32_t idx = node.LeftChildOrFirstPrimitive; idx < node.LeftChildOrFirstPrimitive + node.PrimitiveCount; ++idx)
+            {
+                uint32_t primitiveIdx = mPrimitiveIndices[idx];
+                if (Collision::AABBAABB(box, mPrimitiveBounds[primitiveIdx])) visitor(primitiveIdx);
+            }
+        }
+    }
+
+    template <class Visitor>
+    void BoundingVolumeHierarchy::VisitSubtree(uint32_t nodeIndex, std::vector<uint32_t>& stack, Visitor&& visitor) const
+    {
+        stack.clear();
+        stack.push_back(nodeIndex);
+
+        while (!stack.empty())
+        {
+            const Node& node = mNodes[stack.back()];
+            stack.pop_back();
+
+            if (!node.IsLeaf())
+            {
+                stack.push_back(node.LeftChildOrFirstPrimitive);
+                stack.push_back(node.LeftChildOrFirstPrimitive + 1);
+                continue;
+            }
+
+            for (uint32_t idx = node.LeftChildOrFirstPrimitive; idx < node.LeftChildOrFirstPrimitive + node.PrimitiveCount; ++idx)
+            {
+                visitor(mPrimitiveIndices[idx]);
+            }
+        }
+    }
+
+}
@@ -216,4 +216,27 @@ namespace Geometry {
         return false;
     }
 
+    bool Collision::AABBAABB(const AxisAlignedBox3D &a, const AxisAlignedBox3D &b) {
+        return a.Min.x <= b.Max.x && a.Max.x >= b.Min.x &&
+            a.Min.y <= b.Max.y && a.Max.y >= b.Min.y &&
+            a.Min.z <= b.Max.z && a.Max.z >= b.Min.z;
+    }
+
+    bool Collision::FrustumAABB(const Frustum &frustum, const AxisAlignedBox3D &aabb) {
+        for (const Plane &plane : frustum.Planes) {
+            // Box corner that is the farthest along plane normal
+            glm::vec3 positiveVertex{
+                plane.normal.x >= 0.0f ? aabb.Max.x : aabb.Min.x,
+                plane.normal.y >= 0.0f ? aabb.Max.y : aabb.Min.y,
+                plane.normal.z >= 0.0f ? aabb.Max.z : aabb.Min.z
+            };
+
+            if (glm::dot(plane.normal, positiveVertex) < plane.distance) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
 }
@@ -7,6 +7,7 @@
 #include "Triangle3D.hpp"
 #include "Sphere.hpp"
 #include "Plane.hpp"
+#include "Frustum.hpp"
 
 #include <glm/vec3.hpp>
 
@@ -35,6 +36,11 @@ namespace Geometry
         static bool RayPlane(const Ray3D &ray, const Plane &plane, float &distance);
 
         static bool RayTriangle(const Ray3D &ray, const Triangle3D &triangle, float &distance);
+
+        static bool AABBAABB(const AxisAlignedBox3D &a, const AxisAlignedBox3D &b);
+
+        // Conservative test: boxes near frustum corners might be reported as intersecting
+        static bool FrustumAABB(const Frustum &frustum, const AxisAlignedBox3D &aabb);
     };
 
 }
@@ -0,0 +1,67 @@
+#include "Frustum.hpp"
+
+#include <glm/geometric.hpp>
+
+namespace Geometry
+{
+
+    Frustum::Frustum(const glm::mat4& viewProjection)
+    {
+        // Gribb-Hartmann plane extraction. GLM matrices are column-major.
+        auto row = [&viewProjection](uint32_t index)
+        {
+            return glm::vec4{ viewProjection[0][index], viewProjection[1][index], viewProjection[2][index], viewProjection[3][index] };
+        };
+
+        std::array<glm::vec4, 6> equations{
+            row(3) + row(0),
+            row(3) - row(0),
+            row(3) + row(1),
+            row(3) - row(1),
+            row(2),
+            row(3) - row(2)
+        };
+
+        for (auto planeIdx = 0u; planeIdx < equations.size(); ++planeIdx)
+        {
+            const glm::vec4& equation = equations[planeIdx];
+            float length = glm::length(glm::vec3{ equation });
+
+            // Plane equation is n * p + d = 0, while Plane stores distance as n * p
+            Planes[planeIdx] = Plane{ -equation.w / length, glm::vec3{ equation } / length };
+        }
+    }
+
+    const Plane& Frustum::GetPlane(Side side) const
+    {
+        return Planes[std::underlying_type_t<Side>(side)];
+    }
+
+    bool Frustum::Contains(const glm::vec3& point) const
+    {
+        for (const Plane& plane : Planes)
+        {
+            if (glm::dot(plane.normal, point) < plane.distance) return false;
+        }
+
+        return true;
+    }
+
+    bool Frustum::Contains(const AxisAlignedBox3D& box) const
+    {
+        for (const Plane& plane : Planes)
+        {
+            // Box corner that is the farthest against plane normal
+            glm::vec3 negativeVertex{
+                plane.normal.x >= 0.0f ? box.Min.x : box.Max.x,
+                plane.normal.y >= 0.0f ? box.Min.y : box.Max.y,
+                plane.normal.z >= 0.0f ? box.Min.z : box.Max.z
+            };
+
+            if (glm::dot(plane.normal, negativeVertex) < plane.distance) return false;
+        }
+
+        return true;
+    }
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Plane.hpp"
+#include "AxisAlignedBox3D.hpp"
+
+#include <glm/mat4x4.hpp>
+#include <array>
+
+namespace Geometry
+{
+
+    /// A convex volume bounded by six planes with normals pointing inside.
+    /// Planes are extracted from a matrix producing clip space with [0; 1] depth range.
+    struct Frustum
+    {
+        enum class Side
+        {
+            Left, Right, Bottom, Top, Near, Far
+        };
+
+        std::array<Plane, 6> Planes;
+
+        Frustum() = default;
+        Frustum(const glm::mat4& viewProjection);
+
+        const Plane& GetPlane(Side side) const;
+
+        bool Contains(const glm::vec3& point) const;
+        bool Contains(const AxisAlignedBox3D& box) const;
+    };
+
+}
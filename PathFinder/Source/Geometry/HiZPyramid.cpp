@@ -0,0 +1,193 @@
+#include "HiZPyramid.hpp"
+
+#include <Foundation/Assert.hpp>
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace Geometry
+{
+
+    void HiZPyramid::Build(
+        const float* baseLevelDepth,
+        const Dimensions& viewportDimensions,
+        uint32_t baseTexelSize,
+        const glm::mat4& view,
+        const glm::mat4& viewProjection)
+    {
+        assert_format(baseTexelSize > 0, "Hi-Z base texel must cover at least one pixel");
+
+        mLevels.clear();
+        mViewportDimensions = viewportDimensions;
+        mBaseTexelSize = baseTexelSize;
+        mView = view;
+        mViewProjection = viewProjection;
+
+        std::vector<Dimensions> levelSizes = LevelSizes(
+            BaseLevelSize(viewportDimensions.Width, baseTexelSize),
+            BaseLevelSize(viewportDimensions.Height, baseTexelSize));
+
+        Level baseLevel{};
+        baseLevel.Width = (uint32_t)levelSizes[0].Width;
+        baseLevel.Height = (uint32_t)levelSizes[0].Height;
+        baseLevel.Depth.assign(baseLevelDepth, baseLevelDepth + baseLevel.Width * baseLevel.Height);
+
+        mLevels.push_back(std::move(baseLevel));
+
+        for (auto levelIdx = 1u; levelIdx < levelSizes.size(); ++levelIdx)
+        {
+            const Level& source = mLevels.back();
+
+            Level level{};
+            level.Width = (uint32_t)levelSizes[levelIdx].Width;
+            level.Height = (uint32_t)levelSizes[levelIdx].Height;
+            level.Depth.resize(level.Width * level.Height);
+
+            // Odd sized levels have their last row and column folded into the last texel
+            for (uint32_t y = 0; y < level.Height; ++y)
+            {
+                uint32_t sourceY0 = y * 2;
+                uint32_t sourceY1 = std::min(sourceY0 + 1, source.Height - 1);
+
+                for (uint32_t x = 0; x < level.Width; ++x)
+                {
+                    uint32_t sourceX0 = x * 2;
+                    uint32_t sourceX1 = std::min(sourceX0 + 1, source.Width - 1);
+
+                    level.Depth[y * level.Width + x] = std::max(
+                        std::max(source.Depth[sourceY0 * source.Width + sourceX0], source.Depth[sourceY0 * source.Width + sourceX1]),
+                        std::max(source.Depth[sourceY1 * source.Width + sourceX0], source.Depth[sourceY1 * source.Width + sourceX1]));
+                }
+            }
+
+            mLevels.push_back(std::move(level));
+        }
+    }
+
+    void HiZPyramid::Clear()
+    {
+        mLevels.clear();
+    }
+
+    bool HiZPyramid::IsOccluded(const AxisAlignedBox3D& box) const
+    {
+        if (mLevels.empty()) return false;
+
+        // Corners are the min corner offset by any combination of box edges,
+        // so transforming edges once is enough to get every transformed corner
+        glm::vec3 extent = box.Max - box.Min;
+        glm::vec4 clipMin = mViewProjection * glm::vec4{ box.Min, 1.0f };
+        std::array<glm::vec4, 3> clipEdges{ mViewProjection[0] * extent.x, mViewProjection[1] * extent.y, mViewProjection[2] * extent.z };
+        float viewDepthMin = (mView * glm::vec4{ box.Min, 1.0f }).z;
+        glm::vec3 viewDepthEdges{ mView[0].z * extent.x, mView[1].z * extent.y, mView[2].z * extent.z };
+
+        glm::vec2 ndcMin{ std::numeric_limits<float>::max() };
+        glm::vec2 ndcMax{ std::numeric_limits<float>::lowest() };
+        float nearestViewDepth = std::numeric_limits<float>::max();
+
+        for (uint32_t cornerIdx = 0; cornerIdx < 8; ++cornerIdx)
+        {
+            glm::vec4 clipPosition = clipMin;
+            float viewDepth = viewDepthMin;
+
+            for (uint32_t axis = 0; axis < 3; ++axis)
+            {
+                if (cornerIdx & (1 << axis))
+                {
+                    clipPosition += clipEdges[axis];
+                    viewDepth += viewDepthEdges[axis];
+                }
+            }
+
+            // Projection of a box crossing near plane is unbounded
+            if (clipPosition.w <= 0.0f || clipPosition.z < 0.0f) return false;
+
+            glm::vec2 ndc = glm::vec2{ clipPosition } / clipPosition.w;
+            ndcMin = glm::min(ndcMin, ndc);
+            ndcMax = glm::max(ndcMax, ndc);
+            nearestViewDepth = std::min(nearestViewDepth, viewDepth);
+        }
+
+        // Boxes outside of the viewport are frustum culling's concern
+        if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f) return false;
+
+        ndcMin = glm::clamp(ndcMin, glm::vec2{ -1.0f }, glm::vec2{ 1.0f });
+        ndcMax = glm::clamp(ndcMax, glm::vec2{ -1.0f }, glm::vec2{ 1.0f });
+
+        // NDC to pixels, Y axis of the viewport points down
+        uint32_t viewportWidth = (uint32_t)mViewportDimensions.Width;
+        uint32_t viewportHeight = (uint32_t)mViewportDimensions.Height;
+        uint32_t pixelX0 = std::min(uint32_t((ndcMin.x * 0.5f + 0.5f) * viewportWidth), viewportWidth - 1);
+        uint32_t pixelX1 = std::min(uint32_t((ndcMax.x * 0.5f + 0.5f) * viewportWidth), viewportWidth - 1);
+        uint32_t pixelY0 = std::min(uint32_t((0.5f - ndcMax.y * 0.5f) * viewportHeight), viewportHeight - 1);
+        uint32_t pixelY1 = std::min(uint32_t((0.5f - ndcMin.y * 0.5f) * viewportHeight), viewportHeight - 1);
+
+        // Pick the finest level where the rectangle touches a bounded number of texels.
+        // Coarser levels are cheaper to test but mix in depth from outside of the rectangle.
+        uint32_t levelIdx = 0;
+        uint32_t texelSize = mBaseTexelSize;
+
+        while (levelIdx + 1 < mLevels.size() &&
+            (pixelX1 / texelSize - pixelX0 / texelSize >= MaxFootprintTexelsPerSide ||
+                pixelY1 / texelSize - pixelY0 / texelSize >= MaxFootprintTexelsPerSide))
+        {
+            ++levelIdx;
+            texelSize *= 2;
+        }
+
+        const Level& level = mLevels[levelIdx];
+        float farthestViewDepth = 0.0f;
+
+        for (uint32_t y = pixelY0 / texelSize; y <= std::min(pixelY1 / texelSize, level.Height - 1); ++y)
+        {
+            for (uint32_t x = pixelX0 / texelSize; x <= std::min(pixelX1 / texelSize, level.Width - 1); ++x)
+            {
+                farthestViewDepth = std::max(farthestViewDepth, level.Depth[y * level.Width + x]);
+            }
+        }
+
+        return nearestViewDepth > farthestViewDepth;
+    }
+
+    std::vector<float> HiZPyramid::ReduceViewDepth(const float* viewDepth, const Dimensions& viewportDimensions, uint32_t baseTexelSize)
+    {
+        uint32_t viewportWidth = (uint32_t)viewportDimensions.Width;
+        uint32_t viewportHeight = (uint32_t)viewportDimensions.Height;
+        uint32_t width = BaseLevelSize(viewportWidth, baseTexelSize);
+        uint32_t height = BaseLevelSize(viewportHeight, baseTexelSize);
+
+        std::vector<float> baseLevel(width * height, 0.0f);
+
+        for (uint32_t y = 0; y < viewportHeight; ++y)
+        {
+            for (uint32_t x = 0; x < viewportWidth; ++x)
+            {
+                float& texel = baseLevel[(y / baseTexelSize) * width + x / baseTexelSize];
+                texel = std::max(texel, viewDepth[y * viewportWidth + x]);
+            }
+        }
+
+        return baseLevel;
+    }
+
+    uint32_t HiZPyramid::BaseLevelSize(uint64_t viewportSize, uint32_t baseTexelSize)
+    {
+        return std::max(uint32_t((viewportSize + baseTexelSize - 1) / baseTexelSize), 1u);
+    }
+
+    std::vector<Dimensions> HiZPyramid::LevelSizes(uint32_t baseWidth, uint32_t baseHeight)
+    {
+        std::vector<Dimensions> sizes{ Dimensions{ baseWidth, baseHeight } };
+
+        while (sizes.back().Width > 1 || sizes.back().Height > 1)
+        {
+            sizes.emplace_back((sizes.back().Width + 1) / 2, (sizes.back().Height + 1) / 2);
+        }
+
+        return sizes;
+    }
+
+}
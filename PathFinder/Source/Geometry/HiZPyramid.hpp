@@ -0,0 +1,69 @@
+#pragma once
+
+#include "AxisAlignedBox3D.hpp"
+#include "Dimensions.hpp"
+
+#include <glm/mat4x4.hpp>
+
+#include <vector>
+#include <cstdint>
+
+namespace Geometry
+{
+
+    /// Hierarchy of view depth images where every texel keeps the farthest depth of its footprint,
+    /// so a box that is closer to the viewer than nothing it covers is guaranteed to be hidden.
+    /// Serves as a CPU reference of the occlusion test and as an occluder source for CPU culling.
+    class HiZPyramid
+    {
+    public:
+        struct Level
+        {
+            uint32_t Width = 0;
+            uint32_t Height = 0;
+            std::vector<float> Depth;
+        };
+
+        /// Builds every level above the base one.
+        /// Base level texel is expected to hold the farthest depth of a square of 'baseTexelSize' viewport pixels.
+        void Build(
+            const float* baseLevelDepth,
+            const Dimensions& viewportDimensions,
+            uint32_t baseTexelSize,
+            const glm::mat4& view,
+            const glm::mat4& viewProjection);
+
+        void Clear();
+
+        /// Boxes crossing near plane or lying outside of the viewport are never reported as occluded
+        bool IsOccluded(const AxisAlignedBox3D& box) const;
+
+        /// Reference of the reduction performed on GPU: a row-major full resolution
+        /// view depth image is reduced to a base level of 'baseTexelSize' times smaller resolution
+        static std::vector<float> ReduceViewDepth(const float* viewDepth, const Dimensions& viewportDimensions, uint32_t baseTexelSize);
+
+        static uint32_t BaseLevelSize(uint64_t viewportSize, uint32_t baseTexelSize);
+
+        /// Sizes of every level from the base one down to a single texel.
+        /// GPU keeps levels in this order one after another in a single buffer.
+        static std::vector<Dimensions> LevelSizes(uint32_t baseWidth, uint32_t baseHeight);
+
+    private:
+        inline static const uint32_t MaxFootprintTexelsPerSide = 8;
+
+        std::vector<Level> mLevels;
+        Dimensions mViewportDimensions;
+        uint32_t mBaseTexelSize = 1;
+        glm::mat4 mView{ 1.0f };
+        glm::mat4 mViewProjection{ 1.0f };
+
+    public:
+        inline const auto& Levels() const { return mLevels; }
+        inline const auto& ViewportDimensions() const { return mViewportDimensions; }
+        inline auto BaseTexelSize() const { return mBaseTexelSize; }
+        inline const auto& View() const { return mView; }
+        inline const auto& ViewProjection() const { return mViewProjection; }
+        inline bool IsEmpty() const { return mLevels.empty(); }
+    };
+
+}
@@ -177,6 +177,17 @@ namespace HAL
         mList->DispatchRays(&dispatchInfo.D3DDispatchInfo());
     }
 
+    void ComputeCommandListBase::ExecuteIndirect(const CommandSignature& signature, const Buffer& argumentBuffer, uint32_t maxCommandCount, uint64_t argumentBufferOffset, const Buffer* countBuffer, uint64_t countBufferOffset)
+    {
+        mList->ExecuteIndirect(
+            signature.D3DSignature(),
+            maxCommandCount,
+            argumentBuffer.D3DResource(),
+            argumentBufferOffset,
+            countBuffer ? countBuffer->D3DResource() : nullptr,
+            countBufferOffset);
+    }
+
     void ComputeCommandListBase::SetPipelineState(const ComputePipelineState& state)
     {
         mList->SetPipelineState(state.D3DCompiledState());
@@ -274,7 +285,20 @@ namespace HAL
 
     void ComputeCommandList::BuildRaytracingAccelerationStructure(const RayTracingAccelerationStructure& as)
     {
-        mList->BuildRaytracingAccelerationStructure(&as.D3DAccelerationStructure(), 0, nullptr);
+        if (as.CompactedSizeBuffer())
+        {
+            mList->BuildRaytracingAccelerationStructure(&as.D3DAccelerationStructure(), 1, &as.D3DCompactedSizeInfo());
+        }
+        else
+        {
+            mList->BuildRaytracingAccelerationStructure(&as.D3DAccelerationStructure(), 0, nullptr);
+        }
+    }
+
+    void ComputeCommandList::CompactRaytracingAccelerationStructure(const Buffer& sourceBuffer, const Buffer& destinationBuffer)
+    {
+        mList->CopyRaytracingAccelerationStructure(
+            destinationBuffer.GPUVirtualAddress(), sourceBuffer.GPUVirtualAddress(), D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_COMPACT);
     }
 
 
@@ -294,7 +318,20 @@ namespace HAL
 
     void GraphicsCommandList::BuildRaytracingAccelerationStructure(const RayTracingAccelerationStructure& as)
     {
-        mList->BuildRaytracingAccelerationStructure(&as.D3DAccelerationStructure(), 0, nullptr);
+        if (as.CompactedSizeBuffer())
+        {
+            mList->BuildRaytracingAccelerationStructure(&as.D3DAccelerationStructure(), 1, &as.D3DCompactedSizeInfo());
+        }
+        else
+        {
+            mList->BuildRaytracingAccelerationStructure(&as.D3DAccelerationStructure(), 0, nullptr);
+        }
+    }
+
+    void GraphicsCommandList::CompactRaytracingAccelerationStructure(const Buffer& sourceBuffer, const Buffer& destinationBuffer)
+    {
+        mList->CopyRaytracingAccelerationStructure(
+            destinationBuffer.GPUVirtualAddress(), sourceBuffer.GPUVirtualAddress(), D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_COMPACT);
     }
 
     void GraphicsCommandList::Draw(uint32_t vertexCount, uint32_t vertexStart)
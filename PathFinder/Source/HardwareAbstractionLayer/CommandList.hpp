@@ -15,6 +15,7 @@
 #include "Fence.hpp"
 #include "Buffer.hpp"
 #include "RayTracingAccelerationStructure.hpp"
+#include "CommandSignature.hpp"
 #include "ResourceFootprint.hpp"
 #include "ShaderRegister.hpp"
 #include "Types.hpp"
@@ -102,6 +103,10 @@ namespace HAL
         void SetDescriptorHeaps(const CBSRUADescriptorHeap& cbsruaHeap, const SamplerDescriptorHeap& samplerHeap);
         void Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
         void DispatchRays(const RayDispatchInfo& dispatchInfo);
+
+        /// Executes up to max command count commands laid out according to the signature.
+        /// When count buffer is provided, actual command count is the minimum of max count and the value read from that buffer.
+        void ExecuteIndirect(const CommandSignature& signature, const Buffer& argumentBuffer, uint32_t maxCommandCount, uint64_t argumentBufferOffset = 0, const Buffer* countBuffer = nullptr, uint64_t countBufferOffset = 0);
     };
 
 
@@ -144,6 +149,7 @@ namespace HAL
         ~ComputeCommandList() = default;
 
         void BuildRaytracingAccelerationStructure(const RayTracingAccelerationStructure& as);
+        void CompactRaytracingAccelerationStructure(const Buffer& sourceBuffer, const Buffer& destinationBuffer);
     };
     
     class BundleCommandList : public GraphicsCommandListBase {
@@ -160,6 +166,7 @@ namespace HAL
         void ExecuteBundle(const BundleCommandList& bundle);
 
         void BuildRaytracingAccelerationStructure(const RayTracingAccelerationStructure& as);
+        void CompactRaytracingAccelerationStructure(const Buffer& sourceBuffer, const Buffer& destinationBuffer);
 
         void Draw(uint32_t vertexCount, uint32_t vertexStart);
         void DrawInstanced(uint32_t vertexCount, uint32_t vertexStart, uint32_t instanceCount);
@@ -0,0 +1,85 @@
+#include "CommandSignature.hpp"
+#include "Utils.h"
+
+#include <Foundation/StringUtils.hpp>
+#include <Foundation/Assert.hpp>
+
+namespace HAL
+{
+
+    CommandSignature::CommandSignature(const Device* device, const RootSignature* rootSignature)
+        : mDevice{ device }, mRootSignature{ rootSignature } {}
+
+    void CommandSignature::AddRootConstantsArgument(uint32_t rootParameterIndex, uint32_t firstConstant, uint32_t constantCount)
+    {
+        D3D12_INDIRECT_ARGUMENT_DESC argument{};
+        argument.Type = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
+        argument.Constant.RootParameterIndex = rootParameterIndex;
+        argument.Constant.DestOffsetIn32BitValues = firstConstant;
+        argument.Constant.Num32BitValuesToSet = constantCount;
+
+        AddArgument(argument, constantCount * sizeof(uint32_t));
+        mHasRootArguments = true;
+    }
+
+    void CommandSignature::AddDrawArgument()
+    {
+        D3D12_INDIRECT_ARGUMENT_DESC argument{};
+        argument.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW;
+        AddArgument(argument, sizeof(DrawArguments));
+        mHasFinalArgument = true;
+    }
+
+    void CommandSignature::AddDrawIndexedArgument()
+    {
+        D3D12_INDIRECT_ARGUMENT_DESC argument{};
+        argument.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+        AddArgument(argument, sizeof(DrawIndexedArguments));
+        mHasFinalArgument = true;
+    }
+
+    void CommandSignature::AddDispatchArgument()
+    {
+        D3D12_INDIRECT_ARGUMENT_DESC argument{};
+        argument.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH;
+        AddArgument(argument, sizeof(DispatchArguments));
+        mHasFinalArgument = true;
+    }
+
+    void CommandSignature::Compile()
+    {
+        assert_format(mHasFinalArgument, "Command signature must end with a draw or dispatch argument");
+        assert_format(!mHasRootArguments || mRootSignature, "Command signature changing root arguments requires a root signature");
+
+        D3D12_COMMAND_SIGNATURE_DESC desc{};
+        desc.ByteStride = mStride;
+        desc.NumArgumentDescs = (UINT)mArguments.size();
+        desc.pArgumentDescs = mArguments.data();
+
+        // Root signature must not be provided when no root arguments are changed
+        ID3D12RootSignature* rootSignature = mHasRootArguments ? mRootSignature->D3DSignature() : nullptr;
+
+        ThrowIfFailed(mDevice->D3DDevice()->CreateCommandSignature(&desc, rootSignature, IID_PPV_ARGS(&mSignature)));
+
+        mSignature->SetName(StringToWString(mDebugName).c_str());
+    }
+
+    void CommandSignature::SetDebugName(const std::string& name)
+    {
+        if (mSignature)
+        {
+            mSignature->SetName(StringToWString(name).c_str());
+        }
+
+        mDebugName = name;
+    }
+
+    void CommandSignature::AddArgument(const D3D12_INDIRECT_ARGUMENT_DESC& argument, uint32_t argumentSize)
+    {
+        assert_format(!mHasFinalArgument, "Draw or dispatch argument must be the last one in a command signature");
+
+        mArguments.push_back(argument);
+        mStride += argumentSize;
+    }
+
+}
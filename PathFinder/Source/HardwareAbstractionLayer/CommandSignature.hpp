@@ -0,0 +1,57 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include <cstdint>
+#include <vector>
+#include <string>
+
+#include "GraphicAPIObject.hpp"
+#include "IndirectArguments.hpp"
+#include "Device.hpp"
+#include "RootSignature.hpp"
+
+namespace HAL
+{
+
+    static_assert(sizeof(DrawArguments) == sizeof(D3D12_DRAW_ARGUMENTS));
+    static_assert(sizeof(DrawIndexedArguments) == sizeof(D3D12_DRAW_INDEXED_ARGUMENTS));
+    static_assert(sizeof(DispatchArguments) == sizeof(D3D12_DISPATCH_ARGUMENTS));
+
+    /// Describes layout of a single command in an indirect argument buffer.
+    /// Commands changing root arguments require a root signature,
+    /// and draw or dispatch argument has to be the last one.
+    class CommandSignature : public GraphicAPIObject
+    {
+    public:
+        CommandSignature(const Device* device, const RootSignature* rootSignature = nullptr);
+
+        void AddRootConstantsArgument(uint32_t rootParameterIndex, uint32_t firstConstant, uint32_t constantCount);
+        void AddDrawArgument();
+        void AddDrawIndexedArgument();
+        void AddDispatchArgument();
+
+        void Compile();
+
+        virtual void SetDebugName(const std::string& name) override;
+
+    private:
+        void AddArgument(const D3D12_INDIRECT_ARGUMENT_DESC& argument, uint32_t argumentSize);
+
+        std::vector<D3D12_INDIRECT_ARGUMENT_DESC> mArguments;
+        uint32_t mStride = 0;
+        bool mHasRootArguments = false;
+        bool mHasFinalArgument = false;
+
+        Microsoft::WRL::ComPtr<ID3D12CommandSignature> mSignature;
+        const Device* mDevice;
+        const RootSignature* mRootSignature;
+        std::string mDebugName;
+
+    public:
+        inline ID3D12CommandSignature* D3DSignature() const { return mSignature.Get(); }
+        inline uint32_t Stride() const { return mStride; }
+        inline const RootSignature* GetRootSignature() const { return mRootSignature; }
+    };
+
+}
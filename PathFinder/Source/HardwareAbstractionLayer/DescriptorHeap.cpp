@@ -311,6 +311,30 @@ namespace HAL
         D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle{ GetGPUAddress(indexInHeapRange, std::underlying_type_t<Range>(Range::ShaderResource)) };
 
         D3D12_SHADER_RESOURCE_VIEW_DESC desc = ResourceToSRVDescription(texture.D3DDescription(), 1, shaderVisibleFormat);
+
+        // Cube textures are indistinguishable from 2D arrays by their resource description
+        if (texture.Kind() == TextureKind::TextureCube)
+        {
+            UINT cubeCount = texture.D3DDescription().DepthOrArraySize / 6;
+
+            if (cubeCount > 1)
+            {
+                desc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBEARRAY;
+                desc.TextureCubeArray.MostDetailedMip = 0;
+                desc.TextureCubeArray.MipLevels = texture.D3DDescription().MipLevels;
+                desc.TextureCubeArray.First2DArrayFace = 0;
+                desc.TextureCubeArray.NumCubes = cubeCount;
+                desc.TextureCubeArray.ResourceMinLODClamp = 0.0f;
+            }
+            else
+            {
+                desc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBE;
+                desc.TextureCube.MostDetailedMip = 0;
+                desc.TextureCube.MipLevels = texture.D3DDescription().MipLevels;
+                desc.TextureCube.ResourceMinLODClamp = 0.0f;
+            }
+        }
+
         mDevice->D3DDevice()->CreateShaderResourceView(texture.D3DResource(), &desc, cpuHandle);
 
         return SRDescriptor{ cpuHandle, gpuHandle, indexInHeapRange };
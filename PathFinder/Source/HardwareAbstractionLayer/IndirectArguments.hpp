@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+namespace HAL
+{
+
+    // Layouts of arguments read by the GPU from indirect argument buffers
+
+    struct DrawArguments
+    {
+        uint32_t VertexCountPerInstance = 0;
+        uint32_t InstanceCount = 0;
+        uint32_t StartVertexLocation = 0;
+        uint32_t StartInstanceLocation = 0;
+    };
+
+    struct DrawIndexedArguments
+    {
+        uint32_t IndexCountPerInstance = 0;
+        uint32_t InstanceCount = 0;
+        uint32_t StartIndexLocation = 0;
+        int32_t BaseVertexLocation = 0;
+        uint32_t StartInstanceLocation = 0;
+    };
+
+    struct DispatchArguments
+    {
+        uint32_t ThreadGroupCountX = 0;
+        uint32_t ThreadGroupCountY = 0;
+        uint32_t ThreadGroupCountZ = 0;
+    };
+
+}
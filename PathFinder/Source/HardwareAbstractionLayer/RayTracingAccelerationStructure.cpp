@@ -29,16 +29,58 @@ namespace HAL
 
         if (mBuildScratchBuffer) mD3DAccelerationStructure.ScratchAccelerationStructureData = mBuildScratchBuffer->GPUVirtualAddress();
         if (mFinalBuffer) mD3DAccelerationStructure.DestAccelerationStructureData = mFinalBuffer->GPUVirtualAddress();
-        if (mUpdateBuffer) mD3DAccelerationStructure.SourceAccelerationStructureData = mUpdateBuffer->GPUVirtualAddress();
+
+        if (mUpdateBuffer)
+        {
+            mD3DAccelerationStructure.SourceAccelerationStructureData = mUpdateBuffer->GPUVirtualAddress();
+            mD3DInputs.Flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PERFORM_UPDATE;
+        }
+        else
+        {
+            mD3DAccelerationStructure.SourceAccelerationStructureData = 0;
+            mD3DInputs.Flags &= ~D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PERFORM_UPDATE;
+        }
 
         mD3DAccelerationStructure.Inputs = mD3DInputs;
     }
 
+    void RayTracingAccelerationStructure::SetUpdatesAllowed(bool allowed)
+    {
+        if (allowed)
+        {
+            mD3DInputs.Flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_UPDATE;
+        }
+        else
+        {
+            mD3DInputs.Flags &= ~D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_UPDATE;
+        }
+    }
+
+    void RayTracingAccelerationStructure::SetCompactionAllowed(bool allowed)
+    {
+        if (allowed)
+        {
+            mD3DInputs.Flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_COMPACTION;
+        }
+        else
+        {
+            mD3DInputs.Flags &= ~D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_COMPACTION;
+        }
+    }
+
+    void RayTracingAccelerationStructure::SetCompactedSizeBuffer(const Buffer* buffer)
+    {
+        mCompactedSizeBuffer = buffer;
+        mD3DCompactedSizeInfo.InfoType = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE;
+        mD3DCompactedSizeInfo.DestBuffer = buffer ? buffer->GPUVirtualAddress() : 0;
+    }
+
     void RayTracingAccelerationStructure::Clear()
     {
         mBuildScratchBuffer = nullptr;
         mFinalBuffer = nullptr;
         mUpdateBuffer = nullptr;
+        mCompactedSizeBuffer = nullptr;
     }
 
 
@@ -99,12 +141,7 @@ namespace HAL
 
         instance.AccelerationStructure = blas.FinalBuffer()->GPUVirtualAddress();
 
-        // A 3x4 transform matrix in row - major layout representing the instance - to - world transformation
-        for (auto row = 0u; row < 3; row++) {
-            for (auto column = 0u; column < 4; column++) {
-                instance.Transform[row][column] = transform[column][row];
-            }
-        }
+        WriteD3DTransform(transform, instance);
 
         mD3DInstances.push_back(instance);
 
@@ -112,6 +149,12 @@ namespace HAL
         mD3DInputs.NumDescs = (UINT)mD3DInstances.size();
     }
 
+    void RayTracingTopAccelerationStructure::SetInstanceTransform(uint64_t instanceIndex, const glm::mat4& transform)
+    {
+        assert_format(instanceIndex < mD3DInstances.size(), "Instance index is out of bounds");
+        WriteD3DTransform(transform, mD3DInstances[instanceIndex]);
+    }
+
     RayTracingTopAccelerationStructure::MemoryRequirements RayTracingTopAccelerationStructure::QueryMemoryRequirements() const
     {
         CommonMemoryRequirements commonRequirements = QueryCommonMemoryRequirements();
@@ -144,4 +187,14 @@ namespace HAL
         mD3DInstances.clear();
     }
 
+    void RayTracingTopAccelerationStructure::WriteD3DTransform(const glm::mat4& transform, D3D12_RAYTRACING_INSTANCE_DESC& d3dInstance)
+    {
+        // A 3x4 transform matrix in row - major layout representing the instance - to - world transformation
+        for (auto row = 0u; row < 3; row++) {
+            for (auto column = 0u; column < 4; column++) {
+                d3dInstance.Transform[row][column] = transform[column][row];
+            }
+        }
+    }
+
 }
@@ -48,8 +48,18 @@ namespace HAL
         RayTracingAccelerationStructure(const Device* device);
 
         virtual void Clear() = 0;
+
+        /// Providing an update buffer performs a refit of a structure previously built into that buffer.
+        /// Refits require the structure to be built with updates allowed.
         virtual void SetBuffers(const Buffer* destinationBuffer, const Buffer* scratchBuffer, const Buffer* updateBuffer = nullptr);
 
+        void SetUpdatesAllowed(bool allowed);
+        void SetCompactionAllowed(bool allowed);
+
+        /// A buffer that receives compacted size of the structure once it's built (optional).
+        /// Requires the buffer to be in unordered access state during the build.
+        void SetCompactedSizeBuffer(const Buffer* buffer);
+
     protected:
         struct CommonMemoryRequirements
         {
@@ -68,12 +78,16 @@ namespace HAL
         const Buffer* mBuildScratchBuffer = nullptr;
         const Buffer* mFinalBuffer = nullptr;
         const Buffer* mUpdateBuffer = nullptr;
+        const Buffer* mCompactedSizeBuffer = nullptr;
 
         D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC mD3DAccelerationStructure{};
+        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC mD3DCompactedSizeInfo{};
 
     public:
         inline const auto& D3DAccelerationStructure() const { return mD3DAccelerationStructure; }
+        inline const auto& D3DCompactedSizeInfo() const { return mD3DCompactedSizeInfo; }
         inline const auto* FinalBuffer() const { return mFinalBuffer; }
+        inline const auto* CompactedSizeBuffer() const { return mCompactedSizeBuffer; }
     };
 
 
@@ -124,6 +138,7 @@ namespace HAL
         using RayTracingAccelerationStructure::RayTracingAccelerationStructure;
 
         void AddInstance(const RayTracingBottomAccelerationStructure& blas, const InstanceInfo& instanceInfo, const glm::mat4& transform);
+        void SetInstanceTransform(uint64_t instanceIndex, const glm::mat4& transform);
         MemoryRequirements QueryMemoryRequirements() const;
 
         void SetBuffers(
@@ -137,8 +152,13 @@ namespace HAL
         virtual void Clear() override;
 
     private:
+        static void WriteD3DTransform(const glm::mat4& transform, D3D12_RAYTRACING_INSTANCE_DESC& d3dInstance);
+
         const Buffer* mInstanceBuffer = nullptr;
         std::vector<D3D12_RAYTRACING_INSTANCE_DESC> mD3DInstances;
+
+    public:
+        inline auto InstanceCount() const { return mD3DInstances.size(); }
     };
 
 }
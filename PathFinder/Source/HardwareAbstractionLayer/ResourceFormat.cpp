@@ -105,13 +105,14 @@ namespace HAL
         {
         case TextureKind::Texture3D: mDescription.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE3D; break;
         case TextureKind::Texture2D: mDescription.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D; break;
+        case TextureKind::TextureCube: mDescription.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D; break;
         case TextureKind::Texture1D: mDescription.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE1D; break;
         }
 
-        bool isArray = (kind == TextureKind::Texture1D || kind == TextureKind::Texture2D) && dimensions.Depth > 1;
-        mSubresourceCount = isArray ? dimensions.Depth * mipCount : mipCount;
+        assert_format(kind != TextureKind::TextureCube || (dimensions.Depth > 0 && dimensions.Depth % 6 == 0), "Cube textures must have 6 faces per cube");
 
-        assert_format(!isArray, "Texture arrays are not supported currently. Add proper handling of texture array scheduling first, then remove this assert.");
+        bool isArray = kind != TextureKind::Texture3D && dimensions.Depth > 1;
+        mSubresourceCount = isArray ? dimensions.Depth * mipCount : mipCount;
 
         mDescription.Height = (UINT)dimensions.Height;
         mDescription.Width = dimensions.Width;
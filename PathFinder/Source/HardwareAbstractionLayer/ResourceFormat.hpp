@@ -68,7 +68,9 @@ namespace HAL
         Depth24_Float_Stencil8_Unsigned, Depth32_Float
     };
 
-    enum class TextureKind { Texture1D, Texture2D, Texture3D };
+    // Depth of 1D and 2D textures is their array size.
+    // Cube textures are 2D arrays of 6 faces per cube, their depth is the total face count.
+    enum class TextureKind { Texture1D, Texture2D, Texture3D, TextureCube };
 
     using FormatVariant = std::variant<TypelessColorFormat, ColorFormat, DepthStencilFormat>;
 
@@ -77,11 +77,13 @@ namespace HAL
     {
         ThrowIfFailed(DxcCreateInstance(CLSID_DxcLibrary, IID_PPV_ARGS(mLibrary.GetAddressOf())));
         ThrowIfFailed(DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(mCompiler.GetAddressOf()))); 
+
+        mCompilerVersion = QueryCompilerVersion();
     }
 
     ShaderCompiler::ShaderCompilationResult ShaderCompiler::CompileShader(const std::filesystem::path& path, Shader::Stage stage, const std::string& entryPoint, bool debugBuild, bool separatePDB)
     {
-        BlobCompilationResult blobCompilationResult = CompileBlob(path, ProfileString(stage, Profile::P6_3), entryPoint, debugBuild, separatePDB);
+        BlobCompilationResult blobCompilationResult = CompileBlob(path, ProfileString(stage, TargetProfile), entryPoint, debugBuild, separatePDB);
         ShaderCompilationResult shaderCompilationResult{ Shader{ blobCompilationResult.Blob, blobCompilationResult.PDBBlob, entryPoint, stage }, blobCompilationResult.CompiledFileRelativePaths };
         shaderCompilationResult.CompiledShader.SetDebugName(blobCompilationResult.DebugName);
         return shaderCompilationResult;
@@ -89,12 +91,24 @@ namespace HAL
 
     ShaderCompiler::LibraryCompilationResult ShaderCompiler::CompileLibrary(const std::filesystem::path& path, bool debugBuild, bool separatePDB)
     {
-        BlobCompilationResult blobCompilationResult = CompileBlob(path, LibProfileString(Profile::P6_3), "", debugBuild, separatePDB);
+        BlobCompilationResult blobCompilationResult = CompileBlob(path, LibProfileString(TargetProfile), "", debugBuild, separatePDB);
         LibraryCompilationResult libraryCompilationResult{ Library{ blobCompilationResult.Blob, blobCompilationResult.PDBBlob }, blobCompilationResult.CompiledFileRelativePaths };
         libraryCompilationResult.CompiledLibrary.SetDebugName(blobCompilationResult.DebugName);
         return libraryCompilationResult;
     }
 
+    Microsoft::WRL::ComPtr<IDxcBlob> ShaderCompiler::CreateBlob(const std::vector<uint8_t>& contents)
+    {
+        if (contents.empty())
+        {
+            return nullptr;
+        }
+
+        Microsoft::WRL::ComPtr<IDxcBlobEncoding> blob;
+        ThrowIfFailed(mLibrary->CreateBlobWithEncodingOnHeapCopy(contents.data(), (UINT32)contents.size(), CP_ACP, blob.GetAddressOf()));
+        return blob;
+    }
+
     std::string ShaderCompiler::ProfileString(Shader::Stage stage, Profile profile)
     {
         std::string profileString;
@@ -130,6 +144,40 @@ namespace HAL
         }
     }
 
+    std::string ShaderCompiler::QueryCompilerVersion() const
+    {
+        Microsoft::WRL::ComPtr<IDxcVersionInfo> versionInfo;
+
+        if (FAILED(mCompiler.As(&versionInfo)))
+        {
+            return "Unknown";
+        }
+
+        UINT32 major = 0;
+        UINT32 minor = 0;
+        ThrowIfFailed(versionInfo->GetVersion(&major, &minor));
+
+        std::string version = std::to_string(major) + "." + std::to_string(minor);
+
+        // Compilers of the same version built from different commits can produce different binaries
+        Microsoft::WRL::ComPtr<IDxcVersionInfo2> commitInfo;
+        UINT32 commitCount = 0;
+        char* commitHash = nullptr;
+
+        if (SUCCEEDED(mCompiler.As(&commitInfo)) && SUCCEEDED(commitInfo->GetCommitInfo(&commitCount, &commitHash)))
+        {
+            version += "." + std::to_string(commitCount);
+
+            if (commitHash)
+            {
+                version += std::string{ " " } + commitHash;
+                CoTaskMemFree(commitHash);
+            }
+        }
+
+        return version;
+    }
+
     ShaderCompiler::BlobCompilationResult ShaderCompiler::CompileBlob(const std::filesystem::path& path, const std::string& profileString, const std::string& entryPoint, bool debugBuild, bool separatePDB)
     {
         assert_format(std::filesystem::exists(path), "Shader file ", path.filename(), " doesn't exist");
@@ -44,6 +44,9 @@ namespace HAL
             P6_3, P6_4
         };
 
+        // Profile every shader and library is compiled for
+        inline static const Profile TargetProfile = Profile::P6_3;
+
         struct ShaderCompilationResult
         {
             Shader CompiledShader;
@@ -61,6 +64,13 @@ namespace HAL
         ShaderCompilationResult CompileShader(const std::filesystem::path& path, Shader::Stage stage, const std::string& entryPoint, bool debugBuild, bool separatePDB);
         LibraryCompilationResult CompileLibrary(const std::filesystem::path& path, bool debugBuild, bool separatePDB);
 
+        /// Wraps a copy of previously compiled bytecode, so shaders and libraries can be created without compilation.
+        /// Returns null blob for empty contents.
+        Microsoft::WRL::ComPtr<IDxcBlob> CreateBlob(const std::vector<uint8_t>& contents);
+
+        static std::string ProfileString(Shader::Stage stage, Profile profile);
+        static std::string LibProfileString(Profile profile);
+
     private:
         struct BlobCompilationResult
         {
@@ -70,12 +80,16 @@ namespace HAL
             std::string DebugName;
         };
 
-        std::string ProfileString(Shader::Stage stage, Profile profile);
-        std::string LibProfileString(Profile profile);
+        std::string QueryCompilerVersion() const;
         BlobCompilationResult CompileBlob(const std::filesystem::path& path, const std::string& profileString, const std::string& entryPoint, bool debugBuild, bool separatePDB);
 
         Microsoft::WRL::ComPtr<IDxcLibrary> mLibrary;
         Microsoft::WRL::ComPtr<IDxcCompiler2> mCompiler;
+        std::string mCompilerVersion;
+
+    public:
+        // Major and minor versions followed by commit count and hash when the compiler reports them
+        inline const std::string& CompilerVersion() const { return mCompilerVersion; }
     };
 
 }
@@ -25,6 +25,7 @@ namespace HAL
         {
         case TextureKind::Texture1D:
         case TextureKind::Texture2D:
+        case TextureKind::TextureCube:
             return mProperties.Dimensions.Depth > 1;
 
         default:
@@ -11,6 +11,7 @@ namespace PathFinder
 
         std::filesystem::path executablePath{ argv[0] };
         mExecutableFolder = executablePath.parent_path();
+        mMemoryTelemetryCSVPath = mExecutableFolder / "MemoryTelemetry.csv";
 
         for (auto i = 1; i < argc; ++i)
         {
@@ -44,6 +45,32 @@ namespace PathFinder
         {
             mUseWARPDevice = true;
         }
+
+        if (strcmp(argv, "-rebuild_demo_scene") == 0)
+        {
+            mRebuildDemoScene = true;
+        }
+
+        if (strcmp(argv, "-verify_scene_round_trip") == 0)
+        {
+            mVerifySceneRoundTrip = true;
+        }
+
+        // Either "-memory_telemetry_csv" or "-memory_telemetry_csv=<path>"
+        const char* telemetryArgument = "-memory_telemetry_csv";
+        size_t telemetryArgumentLength = strlen(telemetryArgument);
+
+        if (strncmp(argv, telemetryArgument, telemetryArgumentLength) == 0)
+        {
+            const char* pathStart = argv + telemetryArgumentLength;
+
+            mExportMemoryTelemetryOnExit = true;
+
+            if (*pathStart == '=' && *(pathStart + 1) != '\0')
+            {
+                mMemoryTelemetryCSVPath = std::filesystem::path{ pathStart + 1 };
+            }
+        }
     }
 
 }
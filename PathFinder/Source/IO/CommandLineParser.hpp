@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <optional>
 
 namespace PathFinder 
 {
@@ -19,6 +20,12 @@ namespace PathFinder
         bool mDebugLayerEnabled = false;
         bool mAftermathEnabled = false;
         bool mUseWARPDevice = false;
+        bool mExportMemoryTelemetryOnExit = false;
+        bool mRebuildDemoScene = false;
+        bool mVerifySceneRoundTrip = false;
+
+        // Exports requested from UI go to the same file
+        std::filesystem::path mMemoryTelemetryCSVPath;
 
     public:
         inline auto ShouldEnableDebugLayer() const { return mDebugLayerEnabled; }
@@ -27,6 +34,10 @@ namespace PathFinder
         inline auto ShouldEnableAftermath() const { return mAftermathEnabled; }
         inline auto ShouldUseWARPDevice() const { return mUseWARPDevice; }
         inline const auto& ExecutableFolderPath() const { return mExecutableFolder; }
+        inline auto ShouldExportMemoryTelemetryOnExit() const { return mExportMemoryTelemetryOnExit; }
+        inline const auto& MemoryTelemetryCSVPath() const { return mMemoryTelemetryCSVPath; }
+        inline auto ShouldRebuildDemoScene() const { return mRebuildDemoScene; }
+        inline auto ShouldVerifySceneRoundTrip() const { return mVerifySceneRoundTrip; }
     };
 
 }
@@ -125,9 +125,25 @@ namespace Memory
     {
         return[&](HAL::CopyCommandListBase& cmdList)
         {
-            if (mUploadStrategy != GPUResource::UploadStrategy::DirectAccess)
+            if (mUploadStrategy == GPUResource::UploadStrategy::DirectAccess)
+            {
+                return;
+            }
+
+            std::vector<UploadRegion> regions = CoalescedUploadRegions();
+
+            if (regions.empty())
             {
                 cmdList.CopyBufferRegion(*CurrentFrameUploadBuffer(), *HALBuffer(), 0, HALBuffer()->ElementCapacity(), 0);
+                mCopyRequestManager->TrackUpload(HALBuffer()->ElementCapacity());
+                return;
+            }
+
+            // Copy only what was written this frame, the rest of the buffer retains its previous content
+            for (const UploadRegion& region : regions)
+            {
+                cmdList.CopyBufferRegion(*CurrentFrameUploadBuffer(), *HALBuffer(), region.Offset, region.Size, region.Offset);
+                mCopyRequestManager->TrackUpload(region.Size);
             }
         };
     }
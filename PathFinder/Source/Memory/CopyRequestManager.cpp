@@ -13,6 +13,17 @@ namespace Memory
     void CopyRequestManager::RequestReadback(const HAL::Resource* resource, const CopyCommand& copyCommand)
     {
         mReadbackRequests.emplace_back(CopyRequest{ resource, copyCommand });
+        mTotalReadbackBytes += resource->TotalMemory();
+    }
+
+    void CopyRequestManager::TrackUpload(uint64_t sizeInBytes)
+    {
+        mTotalUploadedBytes += sizeInBytes;
+    }
+
+    void CopyRequestManager::TrackDirectUpload(uint64_t sizeInBytes)
+    {
+        mTotalDirectlyUploadedBytes += sizeInBytes;
     }
 
     void CopyRequestManager::FlushUploadRequests()
@@ -22,6 +22,14 @@ namespace Memory
         void RequestUpload(const HAL::Resource* resource, const CopyCommand& copyCommand);
         void RequestReadback(const HAL::Resource* resource, const CopyCommand& copyCommand);
 
+        // Upload commands may copy only parts of a resource, so traffic
+        // is reported by resources when copy commands are recorded
+        void TrackUpload(uint64_t sizeInBytes);
+
+        // Direct access resources are written to upload memory without copy requests,
+        // but their traffic still needs to be accounted for
+        void TrackDirectUpload(uint64_t sizeInBytes);
+
         void FlushUploadRequests();
         void FlushReadbackRequests();
         void FlushAllRequests();
@@ -30,9 +38,17 @@ namespace Memory
         std::vector<CopyRequest> mUploadRequests;
         std::vector<CopyRequest> mReadbackRequests;
 
+        // Running totals. Consumers calculate per-frame traffic by diffing against previous values.
+        uint64_t mTotalUploadedBytes = 0;
+        uint64_t mTotalDirectlyUploadedBytes = 0;
+        uint64_t mTotalReadbackBytes = 0;
+
     public:
         inline const auto& UploadRequests() const { return mUploadRequests; }
         inline const auto& ReadbackRequests() const { return mReadbackRequests; }
+        inline auto TotalUploadedBytes() const { return mTotalUploadedBytes; }
+        inline auto TotalDirectlyUploadedBytes() const { return mTotalDirectlyUploadedBytes; }
+        inline auto TotalReadbackBytes() const { return mTotalReadbackBytes; }
     };
 
 }
@@ -1,5 +1,7 @@
 #include "GPUResource.hpp"
 
+#include <algorithm>
+
 namespace Memory
 {
 
@@ -62,6 +64,8 @@ namespace Memory
     void GPUResource::BeginFrame(uint64_t frameNumber)
     {
         mFrameNumber = frameNumber;
+        mUploadRegions.clear();
+        mIsWholeUploadBufferWritten = false;
 
         if (mUploadStrategy == UploadStrategy::DirectAccess)
         {
@@ -141,12 +145,54 @@ namespace Memory
             mReadbackBuffers.back().first.get() : nullptr;
     }
 
+    std::vector<GPUResource::UploadRegion> GPUResource::CoalescedUploadRegions() const
+    {
+        if (mIsWholeUploadBufferWritten)
+        {
+            return {};
+        }
+
+        std::vector<UploadRegion> regions = mUploadRegions;
+
+        std::sort(regions.begin(), regions.end(), [](const UploadRegion& a, const UploadRegion& b)
+        {
+            return a.Offset < b.Offset;
+        });
+
+        std::vector<UploadRegion> coalescedRegions;
+
+        for (const UploadRegion& region : regions)
+        {
+            // Merge overlapping and adjacent regions to minimize copy command count
+            if (!coalescedRegions.empty() && region.Offset <= coalescedRegions.back().Offset + coalescedRegions.back().Size)
+            {
+                UploadRegion& lastRegion = coalescedRegions.back();
+                lastRegion.Size = std::max(lastRegion.Offset + lastRegion.Size, region.Offset + region.Size) - lastRegion.Offset;
+            }
+            else
+            {
+                coalescedRegions.push_back(region);
+            }
+        }
+
+        return coalescedRegions;
+    }
+
     void GPUResource::ApplyDebugName()
     {
     }
 
+    uint8_t* GPUResource::MappedUploadMemory()
+    {
+        // No need to unmap as upload buffers can be mapped persistently
+        return CurrentFrameUploadBuffer() ? CurrentFrameUploadBuffer()->Map() : nullptr;
+    }
+
     void GPUResource::AllocateNewUploadBuffer()
     {
+        mUploadRegions.clear();
+        mIsWholeUploadBufferWritten = false;
+
         auto properties = HAL::BufferProperties::Create<uint8_t>(ResourceSizeInBytes());
         mUploadBuffers.emplace(mResourceAllocator->AllocateBuffer(properties, HAL::CPUAccessibleHeapType::Upload), mFrameNumber);
         mUploadBuffers.back().first->SetDebugName(StringFormat("%s Upload Buffer [Frame %d]", mDebugName.c_str(), mFrameNumber));
@@ -9,6 +9,7 @@
 #include <HardwareAbstractionLayer/CommandList.hpp>
 
 #include <queue>
+#include <vector>
 
 namespace Memory
 {
@@ -61,6 +62,16 @@ namespace Memory
     protected:
         using BufferFrameNumberPair = std::pair<SegregatedPoolsResourceAllocator::BufferPtr, uint64_t>;
 
+        struct UploadRegion
+        {
+            uint64_t Offset = 0;
+            uint64_t Size = 0;
+        };
+
+        // Sorted and merged regions written through Write() in current frame.
+        // Empty when raw upload memory was exposed through WriteOnlyPtr() and the whole resource has to be copied.
+        std::vector<UploadRegion> CoalescedUploadRegions() const;
+
         HAL::Buffer* CurrentFrameUploadBuffer();
         HAL::Buffer* CurrentFrameReadbackBuffer();
         const HAL::Buffer* CurrentFrameUploadBuffer() const;
@@ -84,11 +95,15 @@ namespace Memory
         uint64_t mFrameNumber = 0;
 
     private:
+        uint8_t* MappedUploadMemory();
         void AllocateNewUploadBuffer();
         void AllocateNewReadbackBuffer();
 
         SegregatedPoolsResourceAllocator::BufferPtr mCompletedReadbackBuffer;
         SegregatedPoolsResourceAllocator::BufferPtr mCompletedUploadBuffer;
+
+        std::vector<UploadRegion> mUploadRegions;
+        bool mIsWholeUploadBufferWritten = false;
     };
 
 }
@@ -7,13 +7,15 @@ namespace Memory
     template <class T>
     T* GPUResource::WriteOnlyPtr()
     {
-        if (!CurrentFrameUploadBuffer())
+        uint8_t* mappedMemory = MappedUploadMemory();
+
+        // We can't know which parts of memory will be touched through a raw pointer
+        if (mappedMemory)
         {
-            return nullptr;
+            mIsWholeUploadBufferWritten = true;
         }
 
-        // No need to unmap as upload buffers can be mapped persistently
-        return reinterpret_cast<T*>(CurrentFrameUploadBuffer()->Map());
+        return reinterpret_cast<T*>(mappedMemory);
     }
 
     template <class T>
@@ -23,11 +25,17 @@ namespace Memory
         uint64_t copyRegionSizeInBytes = alignedObjectSizeInBytes * objectCount;
         uint64_t byteOffset = alignedObjectSizeInBytes * startIndex;
 
-        uint8_t* writeOnlyPtr = WriteOnlyPtr<uint8_t>();
+        uint8_t* writeOnlyPtr = MappedUploadMemory();
 
         assert_format(writeOnlyPtr, "Need to request a write operation before trying to write data to resource");
 
         memcpy(writeOnlyPtr + byteOffset, data, copyRegionSizeInBytes);
+        mUploadRegions.push_back({ byteOffset, copyRegionSizeInBytes });
+
+        if (mUploadStrategy == UploadStrategy::DirectAccess)
+        {
+            mCopyRequestManager->TrackDirectUpload(copyRegionSizeInBytes);
+        }
     }
 
     template <class T>
@@ -40,6 +40,8 @@ namespace Memory
 
     public:
         inline auto SlotSize() const { return mSlotSize; }
+        inline auto AllocatedSize() const { return mAllocatedSize; }
+        inline auto UsedSize() const { return mAllocatedSize - mFreeSlots.size() * mSlotSize; }
     };
 
 }
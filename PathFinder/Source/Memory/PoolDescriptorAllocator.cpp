@@ -143,6 +143,19 @@ namespace Memory
         mRingFrameTracker.ReleaseCompletedFrames(frameNumber);
     }
 
+    PoolDescriptorAllocator::Statistics PoolDescriptorAllocator::GatherStatistics() const
+    {
+        // Pools operate on 1-sized slots, so used size is the number of live descriptors
+        Statistics statistics;
+        statistics.RT = { mDescriptorRangeCapacity, mRTPool.UsedSize() };
+        statistics.DS = { mDescriptorRangeCapacity, mDSPool.UsedSize() };
+        statistics.SR = { mDescriptorRangeCapacity, mSRPool.UsedSize() };
+        statistics.UA = { mDescriptorRangeCapacity, mUAPool.UsedSize() };
+        statistics.CB = { mDescriptorRangeCapacity, mCBPool.UsedSize() };
+        statistics.Sampler = { mDescriptorRangeCapacity, mSamplerPool.UsedSize() };
+        return statistics;
+    }
+
     void PoolDescriptorAllocator::ExecutePendingDeallocations(uint64_t frameIndex)
     {
         for (Deallocation& deallocation : mPendingDeallocations[frameIndex])
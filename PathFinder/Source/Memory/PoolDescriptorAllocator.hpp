@@ -29,6 +29,22 @@ namespace Memory
         using CBDescriptorPtr = DescriptorPtr<HAL::CBDescriptor>;
         using SamplerDescriptorPtr = DescriptorPtr<HAL::SamplerDescriptor>;
 
+        struct RangeStatistics
+        {
+            uint64_t Capacity = 0;
+            uint64_t Used = 0;
+        };
+
+        struct Statistics
+        {
+            RangeStatistics RT;
+            RangeStatistics DS;
+            RangeStatistics SR;
+            RangeStatistics UA;
+            RangeStatistics CB;
+            RangeStatistics Sampler;
+        };
+
         RTDescriptorPtr AllocateRTDescriptor(const HAL::Texture& texture, uint8_t mipLevel = 0, std::optional<HAL::ColorFormat> shaderVisibleFormat = std::nullopt);
         DSDescriptorPtr AllocateDSDescriptor(const HAL::Texture& texture);
         SRDescriptorPtr AllocateSRDescriptor(const HAL::Texture& texture, std::optional<HAL::ColorFormat> shaderVisibleFormat = std::nullopt);
@@ -42,6 +58,8 @@ namespace Memory
 
         void BeginFrame(uint64_t frameNumber);
         void EndFrame(uint64_t frameNumber);
+
+        Statistics GatherStatistics() const;
         
     private:
         template <class DescriptorT>
@@ -56,6 +56,9 @@ namespace Memory
         uint64_t SlotSizeInBucket(uint64_t bucketIndex) const;
         Bucket& GetBucket(uint64_t index);
 
+        // Memory occupied by slots that are currently handed out
+        uint64_t UsedMemory() const;
+
         Allocation Allocate(uint64_t allocationSize);
         void Deallocate(const Allocation& allocation);
 
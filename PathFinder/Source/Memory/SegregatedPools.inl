@@ -43,6 +43,19 @@ namespace Memory
         return mBuckets[index];
     }
 
+    template <class BucketUserData, class SlotUserData>
+    uint64_t SegregatedPools<BucketUserData, SlotUserData>::UsedMemory() const
+    {
+        uint64_t usedMemory = 0;
+
+        for (const Bucket& bucket : mBuckets)
+        {
+            usedMemory += bucket.mSlots.UsedSize();
+        }
+
+        return usedMemory;
+    }
+
     template <class BucketUserData, class SlotUserData>
     typename SegregatedPools<BucketUserData, SlotUserData>::Allocation
         SegregatedPools<BucketUserData, SlotUserData>::Allocate(uint64_t allocationSize)
@@ -96,6 +96,17 @@ namespace Memory
         mRingFrameTracker.ReleaseCompletedFrames(frameNumber);
     }
 
+    SegregatedPoolsResourceAllocator::Statistics SegregatedPoolsResourceAllocator::GatherStatistics() const
+    {
+        Statistics statistics;
+        statistics.Upload = GatherPoolStatistics(mUploadPools, mUploadHeapLists);
+        statistics.Readback = GatherPoolStatistics(mReadbackPools, mReadbackHeapLists);
+        statistics.DefaultUniversalOrBuffer = GatherPoolStatistics(mDefaultUniversalOrBufferPools, mDefaultUniversalOrBufferHeapLists);
+        statistics.DefaultRTDS = GatherPoolStatistics(mDefaultRTDSPools, mDefaultRTDSHeapLists);
+        statistics.DefaultNonRTDS = GatherPoolStatistics(mDefaultNonRTDSPools, mDefaultNonRTDSHeapLists);
+        return statistics;
+    }
+
     SegregatedPoolsResourceAllocator::Allocation SegregatedPoolsResourceAllocator::FindOrAllocateMostFittingFreeSlot(
         uint64_t allocationSizeInBytes, const HAL::ResourceFormat& resourceFormat, std::optional<HAL::CPUAccessibleHeapType> cpuHeapType)
     {
@@ -212,4 +223,23 @@ namespace Memory
         mPendingDeallocations[frameIndex].clear();
     }
 
+    SegregatedPoolsResourceAllocator::PoolStatistics SegregatedPoolsResourceAllocator::GatherPoolStatistics(
+        const Pools& pools, const std::vector<HeapList>& heapLists) const
+    {
+        PoolStatistics statistics;
+        statistics.UsedBytes = pools.UsedMemory();
+
+        for (const HeapList& heapList : heapLists)
+        {
+            statistics.HeapCount += heapList.size();
+
+            for (const HAL::Heap& heap : heapList)
+            {
+                statistics.CommittedBytes += heap.AlighnedSize();
+            }
+        }
+
+        return statistics;
+    }
+
 }
@@ -20,6 +20,22 @@ namespace Memory
         using BufferPtr = std::unique_ptr<HAL::Buffer, std::function<void(HAL::Buffer*)>>;
         using TexturePtr = std::unique_ptr<HAL::Texture, std::function<void(HAL::Texture*)>>;
 
+        struct PoolStatistics
+        {
+            uint64_t HeapCount = 0;
+            uint64_t CommittedBytes = 0;
+            uint64_t UsedBytes = 0;
+        };
+
+        struct Statistics
+        {
+            PoolStatistics Upload;
+            PoolStatistics Readback;
+            PoolStatistics DefaultUniversalOrBuffer;
+            PoolStatistics DefaultRTDS;
+            PoolStatistics DefaultNonRTDS;
+        };
+
         SegregatedPoolsResourceAllocator(const HAL::Device* device, uint8_t simultaneousFramesInFlight);
 
         BufferPtr AllocateBuffer(const HAL::BufferProperties& properties, std::optional<HAL::CPUAccessibleHeapType> heapType = std::nullopt);
@@ -28,6 +44,8 @@ namespace Memory
         void BeginFrame(uint64_t frameNumber);
         void EndFrame(uint64_t frameNumber);
 
+        Statistics GatherStatistics() const;
+
     private:
         using HeapList = std::vector<HAL::Heap>;
         using HeapIterator = HeapList::iterator;
@@ -75,6 +93,7 @@ namespace Memory
 
         uint64_t AdjustMemoryOffsetToPointInsideHeap(const SegregatedPoolsResourceAllocator::Allocation& allocation);
         void ExecutePendingDeallocations(uint64_t frameIndex);
+        PoolStatistics GatherPoolStatistics(const Pools& pools, const std::vector<HeapList>& heapLists) const;
 
         const HAL::Device* mDevice = nullptr;
 
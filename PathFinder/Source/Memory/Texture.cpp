@@ -140,6 +140,8 @@ namespace Memory
             {
                 cmdList.CopyBufferToTexture(*CurrentFrameUploadBuffer(), *HALTexture(), subresourceFootprint);
             }
+
+            mCopyRequestManager->TrackUpload(HALTexture()->TotalMemory());
         };
     }
 
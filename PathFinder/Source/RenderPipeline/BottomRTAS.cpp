@@ -4,7 +4,10 @@ namespace PathFinder
 {
 
     BottomRTAS::BottomRTAS(const HAL::Device* device, Memory::GPUResourceProducer* resourceProducer)
-        : RTAS(resourceProducer), mAccelerationStructure{ device } {}
+        : RTAS(resourceProducer), mAccelerationStructure{ device } 
+    {
+        mAccelerationStructure.SetCompactionAllowed(true);
+    }
 
     void BottomRTAS::AddGeometry(const HAL::RayTracingGeometry& geometry)
     {
@@ -15,7 +18,22 @@ namespace PathFinder
     {
         auto memoryRequirements = mAccelerationStructure.QueryMemoryRequirements();
         AllocateBuffersForBuildIfNeeded(memoryRequirements.DestinationBufferMaxSizeInBytes, memoryRequirements.BuildScratchBufferSizeInBytes);
+
+        if (!mCompactedSizeBuffer)
+        {
+            auto properties = HAL::BufferProperties::Create<uint64_t>(
+                1, 1, HAL::ResourceState::UnorderedAccess, HAL::ResourceState::UnorderedAccess | HAL::ResourceState::CopySource);
+
+            mCompactedSizeBuffer = mResourceProducer->NewBuffer(properties);
+        }
+
+        mCompactedSize = std::nullopt;
+        mIsCompacted = false;
+
         mAccelerationStructure.SetBuffers(mDestinationBuffer->HALBuffer(), mScratchBuffer->HALBuffer(), nullptr);
+        mAccelerationStructure.SetCompactedSizeBuffer(mCompactedSizeBuffer->HALBuffer());
+
+        ApplyDebugName();
     }
 
     void BottomRTAS::Update()
@@ -23,6 +41,7 @@ namespace PathFinder
         auto memoryRequirements = mAccelerationStructure.QueryMemoryRequirements();
         AllocateBuffersForUpdateIfNeeded(memoryRequirements.DestinationBufferMaxSizeInBytes, memoryRequirements.UpdateScratchBufferSizeInBytes);
         mAccelerationStructure.SetBuffers(mDestinationBuffer->HALBuffer(), mScratchBuffer->HALBuffer(), mUpdateSourceBuffer->HALBuffer());
+        mAccelerationStructure.SetCompactedSizeBuffer(nullptr);
     }
 
     void BottomRTAS::Clear()
@@ -31,4 +50,72 @@ namespace PathFinder
         mAccelerationStructure.Clear();
     }
 
+    void BottomRTAS::Release()
+    {
+        Clear();
+        mDestinationBuffer = nullptr;
+        mScratchBuffer = nullptr;
+        mUpdateSourceBuffer = nullptr;
+        mCompactedSizeBuffer = nullptr;
+        mCompactionSourceBuffer = nullptr;
+        mCompactedSize = std::nullopt;
+        mIsCompacted = false;
+        mUABarrier = HAL::UnorderedAccessResourceBarrier{ nullptr };
+    }
+
+    bool BottomRTAS::ReadCompactedSize()
+    {
+        if (mCompactedSize) return true;
+        if (!mCompactedSizeBuffer) return false;
+
+        mCompactedSizeBuffer->Read<uint64_t>([this](const uint64_t* compactedSize)
+        {
+            if (compactedSize) mCompactedSize = *compactedSize;
+        });
+
+        return mCompactedSize.has_value();
+    }
+
+    bool BottomRTAS::Compact()
+    {
+        assert_format(mCompactedSize, "Compacted size must be read back before compacting a structure");
+
+        // Structure is never rebuilt or updated after compaction, so intermediate buffers can go
+        mScratchBuffer = nullptr;
+        mCompactedSizeBuffer = nullptr;
+        mAccelerationStructure.SetCompactedSizeBuffer(nullptr);
+        mIsCompacted = true;
+
+        if (*mCompactedSize >= mDestinationBuffer->Capacity())
+        {
+            return false;
+        }
+
+        HAL::BufferProperties properties{ *mCompactedSize, 1, HAL::ResourceState::RaytracingAccelerationStructure, HAL::ResourceState::UnorderedAccess };
+
+        mCompactionSourceBuffer = std::move(mDestinationBuffer);
+        mDestinationBuffer = mResourceProducer->NewBuffer(properties);
+        mUABarrier = HAL::UnorderedAccessResourceBarrier{ mDestinationBuffer->HALBuffer() };
+
+        // Top structures pick up the final buffer from HAL structure
+        mAccelerationStructure.SetBuffers(mDestinationBuffer->HALBuffer(), nullptr, nullptr);
+
+        ApplyDebugName();
+
+        return true;
+    }
+
+    void BottomRTAS::FinalizeCompaction()
+    {
+        // Deallocation is deferred until GPU is done with the frame that performed the copy
+        mCompactionSourceBuffer = nullptr;
+    }
+
+    void BottomRTAS::ApplyDebugName()
+    {
+        RTAS::ApplyDebugName();
+        if (mCompactedSizeBuffer) mCompactedSizeBuffer->SetDebugName(mDebugName + " Compacted Size Buffer");
+        if (mCompactionSourceBuffer) mCompactionSourceBuffer->SetDebugName(mDebugName + " Compaction Source Buffer");
+    }
+
 }
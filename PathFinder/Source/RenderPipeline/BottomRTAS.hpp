@@ -2,6 +2,8 @@
 
 #include "RTAS.hpp"
 
+#include <optional>
+
 namespace PathFinder
 {
 
@@ -20,11 +22,41 @@ namespace PathFinder
         void Update();
         void Clear() override;
 
+        /// Drops geometry and every buffer owned by the structure
+        void Release();
+
+        /// Picks up compacted size the GPU reported for the last build. 
+        /// Returns true once the size is known.
+        bool ReadCompactedSize();
+
+        /// Allocates a buffer of compacted size and makes it the new destination.
+        /// Built structure is kept as a source of compaction copy until FinalizeCompaction() is called.
+        /// Returns false if compaction would not save any memory.
+        bool Compact();
+
+        void FinalizeCompaction();
+
+    protected:
+        void ApplyDebugName() override;
+
     private:
         HAL::RayTracingBottomAccelerationStructure mAccelerationStructure;
 
+        // Receives compacted size of the structure during build
+        Memory::GPUResourceProducer::BufferPtr mCompactedSizeBuffer;
+
+        // Uncompacted structure that is copied into destination buffer during compaction
+        Memory::GPUResourceProducer::BufferPtr mCompactionSourceBuffer;
+
+        std::optional<uint64_t> mCompactedSize;
+        bool mIsCompacted = false;
+
     public:
         inline const auto& HALAccelerationStructure() const { return mAccelerationStructure; }
+        inline auto CompactedSizeBuffer() const { return mCompactedSizeBuffer.get(); }
+        inline auto CompactionSourceBuffer() const { return mCompactionSourceBuffer.get(); }
+        inline bool IsCompactionPending() const { return mCompactionSourceBuffer != nullptr; }
+        inline bool IsCompacted() const { return mIsCompacted; }
     };
 
 }
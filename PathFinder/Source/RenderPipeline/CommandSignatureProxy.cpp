@@ -0,0 +1,21 @@
+#include "CommandSignatureProxy.hpp"
+
+namespace PathFinder
+{
+
+    void CommandSignatureProxy::AddDrawArgument()
+    {
+        mArguments.push_back({ ArgumentType::Draw });
+    }
+
+    void CommandSignatureProxy::AddDrawIndexedArgument()
+    {
+        mArguments.push_back({ ArgumentType::DrawIndexed });
+    }
+
+    void CommandSignatureProxy::AddDispatchArgument()
+    {
+        mArguments.push_back({ ArgumentType::Dispatch });
+    }
+
+}
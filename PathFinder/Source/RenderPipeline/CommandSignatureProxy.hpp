@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Foundation/Name.hpp>
+
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    // Describes a single command of an indirect argument buffer.
+    // Root constants are addressed by their register in the root signature
+    // the command signature is created for, so that indices of root parameters
+    // don't need to be known by render passes.
+    //
+    class CommandSignatureProxy
+    {
+    public:
+        enum class ArgumentType
+        {
+            RootConstants, Draw, DrawIndexed, Dispatch
+        };
+
+        struct Argument
+        {
+            ArgumentType Type;
+            uint16_t BaseRegister = 0;
+            uint16_t RegisterSpace = 0;
+            uint32_t ConstantCount = 0;
+        };
+
+        template <class ConstantsType>
+        void AddRootConstantsArgument(uint16_t bRegisterIndex, uint16_t registerSpace);
+        void AddDrawArgument();
+        void AddDrawIndexedArgument();
+        void AddDispatchArgument();
+
+        // Required when root constants are part of a command
+        std::optional<Foundation::Name> RootSignatureName;
+
+    private:
+        std::vector<Argument> mArguments;
+
+    public:
+        inline const auto& Arguments() const { return mArguments; }
+    };
+
+}
+
+#include "CommandSignatureProxy.inl"
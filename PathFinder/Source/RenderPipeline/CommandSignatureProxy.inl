@@ -0,0 +1,11 @@
+namespace PathFinder
+{
+
+    template <class ConstantsType>
+    void CommandSignatureProxy::AddRootConstantsArgument(uint16_t bRegisterIndex, uint16_t registerSpace)
+    {
+        uint32_t num32BitValues = std::ceil(sizeof(ConstantsType) / 4.0f);
+        mArguments.push_back({ ArgumentType::RootConstants, bRegisterIndex, registerSpace, num32BitValues });
+    }
+
+}
@@ -0,0 +1,174 @@
+#include "MemoryTelemetry.hpp"
+
+#include <fstream>
+#include <functional>
+
+namespace PathFinder
+{
+
+    uint64_t MemoryTelemetry::FrameSample::TotalPoolCommittedBytes() const
+    {
+        return Pools.Upload.CommittedBytes + Pools.Readback.CommittedBytes + Pools.DefaultUniversalOrBuffer.CommittedBytes +
+            Pools.DefaultRTDS.CommittedBytes + Pools.DefaultNonRTDS.CommittedBytes;
+    }
+
+    uint64_t MemoryTelemetry::FrameSample::TotalTransientCommittedBytes() const
+    {
+        return Transient.RTDSHeap.CommittedBytes + Transient.NonRTDSHeap.CommittedBytes +
+            Transient.BufferHeap.CommittedBytes + Transient.UniversalHeap.CommittedBytes;
+    }
+
+    uint64_t MemoryTelemetry::FrameSample::TotalTransientRequestedBytes() const
+    {
+        return Transient.RTDSHeap.RequestedBytes + Transient.NonRTDSHeap.RequestedBytes +
+            Transient.BufferHeap.RequestedBytes + Transient.UniversalHeap.RequestedBytes;
+    }
+
+    uint64_t MemoryTelemetry::FrameSample::AliasingSavingsBytes() const
+    {
+        uint64_t requested = TotalTransientRequestedBytes();
+        uint64_t committed = TotalTransientCommittedBytes();
+        return requested > committed ? requested - committed : 0;
+    }
+
+    MemoryTelemetry::MemoryTelemetry(
+        const Memory::SegregatedPoolsResourceAllocator* resourceAllocator,
+        const Memory::PoolDescriptorAllocator* descriptorAllocator,
+        const Memory::CopyRequestManager* copyRequestManager,
+        const PipelineResourceStorage* resourceStorage,
+        uint64_t historyLength)
+        :
+        mResourceAllocator{ resourceAllocator },
+        mDescriptorAllocator{ descriptorAllocator },
+        mCopyRequestManager{ copyRequestManager },
+        mResourceStorage{ resourceStorage },
+        mHistoryLength{ historyLength }
+    {
+        assert_format(historyLength > 0, "Telemetry history cannot be empty");
+    }
+
+    void MemoryTelemetry::CaptureFrame(uint64_t frameNumber)
+    {
+        if (mHistory.size() >= mHistoryLength)
+        {
+            mHistory.pop_front();
+        }
+
+        FrameSample& sample = mHistory.emplace_back();
+        sample.FrameNumber = frameNumber;
+        sample.Pools = mResourceAllocator->GatherStatistics();
+        sample.Descriptors = mDescriptorAllocator->GatherStatistics();
+        sample.Transient = mResourceStorage->GatherMemoryStatistics();
+
+        CopyTraffic totals{
+            mCopyRequestManager->TotalUploadedBytes(),
+            mCopyRequestManager->TotalDirectlyUploadedBytes(),
+            mCopyRequestManager->TotalReadbackBytes()
+        };
+
+        sample.Traffic.UploadedBytes = totals.UploadedBytes - mPreviousTrafficTotals.UploadedBytes;
+        sample.Traffic.DirectlyUploadedBytes = totals.DirectlyUploadedBytes - mPreviousTrafficTotals.DirectlyUploadedBytes;
+        sample.Traffic.ReadbackBytes = totals.ReadbackBytes - mPreviousTrafficTotals.ReadbackBytes;
+
+        mPreviousTrafficTotals = totals;
+    }
+
+    bool MemoryTelemetry::ExportCSV(const std::filesystem::path& filePath) const
+    {
+        std::ofstream csvFile{ filePath, std::ios::out | std::ios::trunc };
+
+        if (!csvFile.is_open())
+        {
+            return false;
+        }
+
+        using Column = std::pair<std::string, std::function<uint64_t(const FrameSample&)>>;
+
+        std::vector<Column> columns{
+            { "Frame", [](const FrameSample& s) { return s.FrameNumber; } },
+
+            { "UploadPoolHeaps", [](const FrameSample& s) { return s.Pools.Upload.HeapCount; } },
+            { "UploadPoolCommitted", [](const FrameSample& s) { return s.Pools.Upload.CommittedBytes; } },
+            { "UploadPoolUsed", [](const FrameSample& s) { return s.Pools.Upload.UsedBytes; } },
+            { "ReadbackPoolHeaps", [](const FrameSample& s) { return s.Pools.Readback.HeapCount; } },
+            { "ReadbackPoolCommitted", [](const FrameSample& s) { return s.Pools.Readback.CommittedBytes; } },
+            { "ReadbackPoolUsed", [](const FrameSample& s) { return s.Pools.Readback.UsedBytes; } },
+            { "UniversalOrBufferPoolHeaps", [](const FrameSample& s) { return s.Pools.DefaultUniversalOrBuffer.HeapCount; } },
+            { "UniversalOrBufferPoolCommitted", [](const FrameSample& s) { return s.Pools.DefaultUniversalOrBuffer.CommittedBytes; } },
+            { "UniversalOrBufferPoolUsed", [](const FrameSample& s) { return s.Pools.DefaultUniversalOrBuffer.UsedBytes; } },
+            { "RTDSPoolHeaps", [](const FrameSample& s) { return s.Pools.DefaultRTDS.HeapCount; } },
+            { "RTDSPoolCommitted", [](const FrameSample& s) { return s.Pools.DefaultRTDS.CommittedBytes; } },
+            { "RTDSPoolUsed", [](const FrameSample& s) { return s.Pools.DefaultRTDS.UsedBytes; } },
+            { "NonRTDSPoolHeaps", [](const FrameSample& s) { return s.Pools.DefaultNonRTDS.HeapCount; } },
+            { "NonRTDSPoolCommitted", [](const FrameSample& s) { return s.Pools.DefaultNonRTDS.CommittedBytes; } },
+            { "NonRTDSPoolUsed", [](const FrameSample& s) { return s.Pools.DefaultNonRTDS.UsedBytes; } },
+
+            { "RTDSHeapCommitted", [](const FrameSample& s) { return s.Transient.RTDSHeap.CommittedBytes; } },
+            { "RTDSHeapRequested", [](const FrameSample& s) { return s.Transient.RTDSHeap.RequestedBytes; } },
+            { "NonRTDSHeapCommitted", [](const FrameSample& s) { return s.Transient.NonRTDSHeap.CommittedBytes; } },
+            { "NonRTDSHeapRequested", [](const FrameSample& s) { return s.Transient.NonRTDSHeap.RequestedBytes; } },
+            { "BufferHeapCommitted", [](const FrameSample& s) { return s.Transient.BufferHeap.CommittedBytes; } },
+            { "BufferHeapRequested", [](const FrameSample& s) { return s.Transient.BufferHeap.RequestedBytes; } },
+            { "UniversalHeapCommitted", [](const FrameSample& s) { return s.Transient.UniversalHeap.CommittedBytes; } },
+            { "UniversalHeapRequested", [](const FrameSample& s) { return s.Transient.UniversalHeap.RequestedBytes; } },
+            { "NonAliasedTransient", [](const FrameSample& s) { return s.Transient.NonAliasedBytes; } },
+            { "AliasingSavings", [](const FrameSample& s) { return s.AliasingSavingsBytes(); } },
+
+            { "RTDescriptors", [](const FrameSample& s) { return s.Descriptors.RT.Used; } },
+            { "DSDescriptors", [](const FrameSample& s) { return s.Descriptors.DS.Used; } },
+            { "SRDescriptors", [](const FrameSample& s) { return s.Descriptors.SR.Used; } },
+            { "UADescriptors", [](const FrameSample& s) { return s.Descriptors.UA.Used; } },
+            { "CBDescriptors", [](const FrameSample& s) { return s.Descriptors.CB.Used; } },
+            { "SamplerDescriptors", [](const FrameSample& s) { return s.Descriptors.Sampler.Used; } },
+
+            { "UploadCopyTraffic", [](const FrameSample& s) { return s.Traffic.UploadedBytes; } },
+            { "DirectUploadTraffic", [](const FrameSample& s) { return s.Traffic.DirectlyUploadedBytes; } },
+            { "ReadbackTraffic", [](const FrameSample& s) { return s.Traffic.ReadbackBytes; } },
+        };
+
+        // Render graph can change between frames, so gather every pass that appeared in the history
+        std::vector<Foundation::Name> passNames;
+        robin_hood::unordered_flat_set<Foundation::Name> knownPassNames;
+
+        for (const FrameSample& sample : mHistory)
+        {
+            for (const PipelineResourceStorage::PassMemoryStatistics& passStatistics : sample.Transient.Passes)
+            {
+                if (knownPassNames.insert(passStatistics.Name).second)
+                {
+                    passNames.push_back(passStatistics.Name);
+                }
+            }
+        }
+
+        for (Foundation::Name passName : passNames)
+        {
+            columns.emplace_back("Pass." + passName.ToString(), [passName](const FrameSample& s) -> uint64_t
+            {
+                for (const PipelineResourceStorage::PassMemoryStatistics& passStatistics : s.Transient.Passes)
+                {
+                    if (passStatistics.Name == passName) return passStatistics.TransientBytes;
+                }
+                return 0;
+            });
+        }
+
+        for (auto columnIdx = 0u; columnIdx < columns.size(); ++columnIdx)
+        {
+            csvFile << (columnIdx > 0 ? "," : "") << columns[columnIdx].first;
+        }
+        csvFile << '\n';
+
+        for (const FrameSample& sample : mHistory)
+        {
+            for (auto columnIdx = 0u; columnIdx < columns.size(); ++columnIdx)
+            {
+                csvFile << (columnIdx > 0 ? "," : "") << columns[columnIdx].second(sample);
+            }
+            csvFile << '\n';
+        }
+
+        return csvFile.good();
+    }
+
+}
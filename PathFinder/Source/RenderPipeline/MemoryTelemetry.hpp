@@ -0,0 +1,69 @@
+#pragma once
+
+#include "PipelineResourceStorage.hpp"
+
+#include <Memory/SegregatedPoolsResourceAllocator.hpp>
+#include <Memory/PoolDescriptorAllocator.hpp>
+#include <Memory/CopyRequestManager.hpp>
+
+#include <deque>
+#include <vector>
+#include <filesystem>
+
+namespace PathFinder
+{
+
+    /// Samples memory consumption of engine allocators once per frame
+    /// and keeps a rolling history for live inspection and CSV export
+    class MemoryTelemetry
+    {
+    public:
+        struct CopyTraffic
+        {
+            uint64_t UploadedBytes = 0;
+            uint64_t DirectlyUploadedBytes = 0;
+            uint64_t ReadbackBytes = 0;
+        };
+
+        struct FrameSample
+        {
+            uint64_t FrameNumber = 0;
+            Memory::SegregatedPoolsResourceAllocator::Statistics Pools;
+            Memory::PoolDescriptorAllocator::Statistics Descriptors;
+            PipelineResourceStorage::MemoryStatistics Transient;
+            CopyTraffic Traffic;
+
+            uint64_t TotalPoolCommittedBytes() const;
+            uint64_t TotalTransientCommittedBytes() const;
+            uint64_t TotalTransientRequestedBytes() const;
+            uint64_t AliasingSavingsBytes() const;
+        };
+
+        MemoryTelemetry(
+            const Memory::SegregatedPoolsResourceAllocator* resourceAllocator,
+            const Memory::PoolDescriptorAllocator* descriptorAllocator,
+            const Memory::CopyRequestManager* copyRequestManager,
+            const PipelineResourceStorage* resourceStorage,
+            uint64_t historyLength = 1024);
+
+        void CaptureFrame(uint64_t frameNumber);
+        bool ExportCSV(const std::filesystem::path& filePath) const;
+
+    private:
+        const Memory::SegregatedPoolsResourceAllocator* mResourceAllocator;
+        const Memory::PoolDescriptorAllocator* mDescriptorAllocator;
+        const Memory::CopyRequestManager* mCopyRequestManager;
+        const PipelineResourceStorage* mResourceStorage;
+
+        uint64_t mHistoryLength = 0;
+        std::deque<FrameSample> mHistory;
+
+        // Copy manager reports running totals, we need deltas
+        CopyTraffic mPreviousTrafficTotals;
+
+    public:
+        inline const auto& History() const { return mHistory; }
+        inline auto HistoryLength() const { return mHistoryLength; }
+    };
+
+}
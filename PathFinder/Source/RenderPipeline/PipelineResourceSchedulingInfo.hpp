@@ -22,7 +22,7 @@ namespace PathFinder
         public:
             enum class AccessFlag
             {
-                TextureRT, TextureDS, TextureSR, TextureUA, BufferSR, BufferUA, BufferCB
+                TextureRT, TextureDS, TextureSR, TextureUA, BufferSR, BufferUA, BufferCB, BufferIA
             };
 
             HAL::ResourceState RequestedState = HAL::ResourceState::Common;
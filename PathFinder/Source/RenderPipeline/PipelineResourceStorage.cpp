@@ -456,4 +456,57 @@ namespace PathFinder
         }*/
     }
 
+    PipelineResourceStorage::MemoryStatistics PipelineResourceStorage::GatherMemoryStatistics() const
+    {
+        MemoryStatistics statistics;
+
+        if (mRTDSHeap) statistics.RTDSHeap.CommittedBytes = mRTDSHeap->AlighnedSize();
+        if (mNonRTDSHeap) statistics.NonRTDSHeap.CommittedBytes = mNonRTDSHeap->AlighnedSize();
+        if (mBufferHeap) statistics.BufferHeap.CommittedBytes = mBufferHeap->AlighnedSize();
+        if (mUniversalHeap) statistics.UniversalHeap.CommittedBytes = mUniversalHeap->AlighnedSize();
+
+        for (const PipelineResourceStorageResource& resourceData : *mCurrentFrameResources)
+        {
+            uint64_t resourceSize = resourceData.SchedulingInfo.TotalRequiredMemory();
+
+            if (!resourceData.SchedulingInfo.CanBeAliased)
+            {
+                statistics.NonAliasedBytes += resourceSize;
+                continue;
+            }
+
+            TransientHeapStatistics* heapStatistics = nullptr;
+
+            switch (resourceData.SchedulingInfo.ResourceFormat().ResourceAliasingGroup())
+            {
+            case HAL::HeapAliasingGroup::RTDSTextures: heapStatistics = &statistics.RTDSHeap; break;
+            case HAL::HeapAliasingGroup::NonRTDSTextures: heapStatistics = &statistics.NonRTDSHeap; break;
+            case HAL::HeapAliasingGroup::Buffers: heapStatistics = &statistics.BufferHeap; break;
+            case HAL::HeapAliasingGroup::Universal: heapStatistics = &statistics.UniversalHeap; break;
+            }
+
+            if (heapStatistics)
+            {
+                heapStatistics->RequestedBytes += resourceSize;
+                heapStatistics->ResourceCount += 1;
+            }
+        }
+
+        for (const RenderPassGraph::Node* node : mPassExecutionGraph->NodesInGlobalExecutionOrder())
+        {
+            PassMemoryStatistics& passStatistics = statistics.Passes.emplace_back();
+            passStatistics.Name = node->PassMetadata().Name;
+
+            for (const PipelineResourceStorageResource& resourceData : *mCurrentFrameResources)
+            {
+                if (resourceData.SchedulingInfo.GetInfoForPass(passStatistics.Name))
+                {
+                    passStatistics.TransientBytes += resourceData.SchedulingInfo.TotalRequiredMemory();
+                }
+            }
+        }
+
+        return statistics;
+    }
+
 }
@@ -47,6 +47,31 @@ namespace PathFinder
         using DebugBufferIteratorFunc = std::function<void(PassName passName, const float* debugData)>;
         using SchedulingInfoConfigurator = std::function<void(PipelineResourceSchedulingInfo&)>;
 
+        struct TransientHeapStatistics
+        {
+            uint64_t CommittedBytes = 0;
+            // Memory that resources placed in the heap would take without aliasing
+            uint64_t RequestedBytes = 0;
+            uint64_t ResourceCount = 0;
+        };
+
+        struct PassMemoryStatistics
+        {
+            PassName Name;
+            uint64_t TransientBytes = 0;
+        };
+
+        struct MemoryStatistics
+        {
+            TransientHeapStatistics RTDSHeap;
+            TransientHeapStatistics NonRTDSHeap;
+            TransientHeapStatistics BufferHeap;
+            TransientHeapStatistics UniversalHeap;
+            // Scheduled resources that opted out of aliasing and live in allocator pools
+            uint64_t NonAliasedBytes = 0;
+            std::vector<PassMemoryStatistics> Passes;
+        };
+
         const HAL::RTDescriptor* GetRenderTargetDescriptor(Foundation::Name resourceName, Foundation::Name passName, uint64_t mipIndex = 0) const;
         const HAL::DSDescriptor* GetDepthStencilDescriptor(Foundation::Name resourceName, Foundation::Name passName) const;
         const HAL::SamplerDescriptor* GetSamplerDescriptor(Foundation::Name resourceName) const;
@@ -81,6 +106,8 @@ namespace PathFinder
 
         void IterateDebugBuffers(const DebugBufferIteratorFunc& func) const;
 
+        MemoryStatistics GatherMemoryStatistics() const;
+
         void QueueResourceAllocationIfNeeded(
             ResourceName resourceName, 
             const HAL::ResourcePropertiesVariant& properties, 
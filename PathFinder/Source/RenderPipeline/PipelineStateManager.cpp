@@ -56,6 +56,40 @@ namespace PathFinder
         mSignaturesToCompile.insert(&iterator->second);
     }
 
+    void PipelineStateManager::CreateCommandSignature(CommandSignatureName name, const CommandSignatureConfigurator& configurator)
+    {
+        assert_format(GetCommandSignature(name) == nullptr, "Redefinition of Command Signature. ", name.ToString(), " already exists.");
+
+        CommandSignatureProxy signatureProxy{};
+        configurator(signatureProxy);
+
+        const HAL::RootSignature* rootSignature = GetNamedRootSignatureOrNull(signatureProxy.RootSignatureName);
+        HAL::CommandSignature newSignature{ mDevice, rootSignature };
+
+        for (const CommandSignatureProxy::Argument& argument : signatureProxy.Arguments())
+        {
+            switch (argument.Type)
+            {
+            case CommandSignatureProxy::ArgumentType::RootConstants:
+            {
+                assert_format(rootSignature, "Command Signature ", name.ToString(), " sets root constants, but has no root signature");
+                auto index = rootSignature->GetParameterIndex({ argument.BaseRegister, argument.RegisterSpace, HAL::ShaderRegister::ConstantBuffer });
+                assert_format(index, "Root signature parameter doesn't exist");
+                newSignature.AddRootConstantsArgument(index->IndexInSignature, 0, argument.ConstantCount);
+                break;
+            }
+            case CommandSignatureProxy::ArgumentType::Draw: newSignature.AddDrawArgument(); break;
+            case CommandSignatureProxy::ArgumentType::DrawIndexed: newSignature.AddDrawIndexedArgument(); break;
+            case CommandSignatureProxy::ArgumentType::Dispatch: newSignature.AddDispatchArgument(); break;
+            }
+        }
+
+        newSignature.SetDebugName(name.ToString());
+
+        auto [iterator, success] = mCommandSignatures.emplace(name, std::move(newSignature));
+        mCommandSignaturesToCompile.insert(&iterator->second);
+    }
+
     void PipelineStateManager::CreateGraphicsState(PSOName name, const GraphicsStateConfigurator& configurator)
     {
         assert_format(GetPipelineState(name) == std::nullopt, "Redefinition of pipeline state. ", name.ToString(), " already exists.");
@@ -241,6 +275,13 @@ namespace PathFinder
         return &it->second;
     }
 
+    const HAL::CommandSignature* PipelineStateManager::GetCommandSignature(CommandSignatureName name) const
+    {
+        auto it = mCommandSignatures.find(name);
+        if (it == mCommandSignatures.end()) return nullptr;
+        return &it->second;
+    }
+
     const HAL::RootSignature* PipelineStateManager::GetNamedRootSignatureOrDefault(std::optional<RootSignatureName> name) const
     {
         if (!name) return &mBaseRootSignature;
@@ -271,6 +312,12 @@ namespace PathFinder
             signature->Compile();
         }
 
+        // Root signatures referenced by command signatures are compiled by now
+        for (HAL::CommandSignature* signature : mCommandSignaturesToCompile)
+        {
+            signature->Compile();
+        }
+
         for (PipelineStateVariantInternal* state : mStatesToCompile)
         {
             if (auto pso = std::get_if<HAL::GraphicsPipelineState>(state))
@@ -288,6 +335,7 @@ namespace PathFinder
         }
 
         mSignaturesToCompile.clear();
+        mCommandSignaturesToCompile.clear();
         mStatesToCompile.clear();
     }
 
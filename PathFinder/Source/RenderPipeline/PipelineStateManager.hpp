@@ -2,6 +2,7 @@
 
 #include <Foundation/Name.hpp>
 #include <HardwareAbstractionLayer/PipelineState.hpp>
+#include <HardwareAbstractionLayer/CommandSignature.hpp>
 #include <Memory/GPUResourceProducer.hpp>
 
 #include <robinhood/robin_hood.h>
@@ -10,6 +11,7 @@
 #include "RenderSurfaceDescription.hpp"
 #include "PipelineStateProxy.hpp"
 #include "RootSignatureProxy.hpp"
+#include "CommandSignatureProxy.hpp"
 
 #include <unordered_map>
 
@@ -17,11 +19,13 @@ namespace PathFinder
 {
     using PSOName = Foundation::Name;
     using RootSignatureName = Foundation::Name;
+    using CommandSignatureName = Foundation::Name;
 
     class PipelineStateManager
     {
     public:
         using RootSignatureConfigurator = std::function<void(RootSignatureProxy&)>;
+        using CommandSignatureConfigurator = std::function<void(CommandSignatureProxy&)>;
         using GraphicsStateConfigurator = std::function<void(GraphicsStateProxy&)>;
         using ComputeStateConfigurator = std::function<void(ComputeStateProxy&)>;
         using RayTracingStateConfigurator = std::function<void(RayTracingStateProxy&)>;
@@ -47,12 +51,14 @@ namespace PathFinder
         );
 
         void CreateRootSignature(RootSignatureName name, const RootSignatureConfigurator& configurator);
+        void CreateCommandSignature(CommandSignatureName name, const CommandSignatureConfigurator& configurator);
         void CreateGraphicsState(PSOName name, const GraphicsStateConfigurator& configurator);
         void CreateComputeState(PSOName name, const ComputeStateConfigurator& configurator);
         void CreateRayTracingState(PSOName name, const RayTracingStateConfigurator& configurator);
 
         std::optional<PipelineStateVariant> GetPipelineState(PSOName name) const;
         const HAL::RootSignature* GetRootSignature(RootSignatureName name) const;
+        const HAL::CommandSignature* GetCommandSignature(CommandSignatureName name) const;
         const HAL::RootSignature& BaseRootSignature() const;
 
         void CompileUncompiledSignaturesAndStates();
@@ -96,10 +102,12 @@ namespace PathFinder
 
         robin_hood::unordered_node_map<PSOName, PipelineStateVariantInternal> mPipelineStates;
         robin_hood::unordered_node_map<RootSignatureName, HAL::RootSignature> mRootSignatures;
+        robin_hood::unordered_node_map<CommandSignatureName, HAL::CommandSignature> mCommandSignatures;
         robin_hood::unordered_map<const HAL::Shader*, robin_hood::unordered_flat_set<PipelineStateVariantInternal*>> mShaderToPSOAssociations;
         robin_hood::unordered_map<const HAL::Library*, robin_hood::unordered_flat_set<PipelineStateVariantInternal*>> mLibraryToPSOAssociations;
         robin_hood::unordered_set<PipelineStateVariantInternal*> mStatesToCompile;
         robin_hood::unordered_set<HAL::RootSignature*> mSignaturesToCompile;
+        robin_hood::unordered_set<HAL::CommandSignature*> mCommandSignaturesToCompile;
 
         std::string mDefaultVertexEntryPointName = "VSMain";
         std::string mDefaultPixelEntryPointName = "PSMain";
@@ -1,28 +1,44 @@
 #include "PreprocessableAssetStorage.hpp"
 
+#include <sstream>
+#include <iomanip>
+
 namespace PathFinder
 {
 
-    void PreprocessableAssetStorage::PreprocessAsset(Memory::GPUResource* asset, const PostprocessCallback& callback)
-    {
-        mAssets.emplace_back(asset, callback);
-    }
+    PreprocessableAssetStorage::PreprocessableAssetStorage(const std::filesystem::path& rootPath, const std::string& cacheFolder)
+        : mRootPath{ rootPath }, mCacheFolder{ cacheFolder } {}
 
-    void PreprocessableAssetStorage::ReadbackAllAssets()
+    bool PreprocessableAssetStorage::LoadCachedAsset(Memory::GPUResource* asset, const CacheKey& key, const CacheLoader& loader)
     {
-        for (auto& [asset, callback] : mAssets)
+        std::string cachedAssetPath = CachedAssetPath(key);
+
+        std::filesystem::path fullPath = mRootPath;
+        fullPath += cachedAssetPath;
+
+        std::error_code error;
+
+        // Files that don't match the asset are treated as missing and are overwritten by owners
+        if (std::filesystem::exists(fullPath, error) && loader(asset, cachedAssetPath))
         {
-            asset->RequestRead();
+            ++mStatistics.CacheHitCount;
+            return true;
         }
+
+        ++mStatistics.CacheMissCount;
+        return false;
     }
 
-    void PreprocessableAssetStorage::ReportAllAssetsPostprocessed()
+    std::string PreprocessableAssetStorage::CachedAssetPath(const CacheKey& key) const
     {
-        for (auto& [asset, callback] : mAssets)
-        {
-            callback(asset);
-        }
-        mAssets.clear();
+        std::filesystem::path assetName{ key.AssetName };
+
+        // A file per source and preprocessing version combination
+        std::stringstream fileName;
+        fileName << assetName.stem().string() << "." << std::hex << std::setfill('0') << std::setw(16) << key.SourceHash
+            << "." << std::dec << key.PreprocessingVersion << assetName.extension().string();
+
+        return mCacheFolder + "/" + fileName.str();
     }
 
 }
@@ -3,21 +3,54 @@
 #include <Memory/GPUResource.hpp>
 
 #include <functional>
+#include <filesystem>
+#include <string>
 
 namespace PathFinder
 {
 
+    /// Locates results of asset preprocessing in a disk cache keyed by source hash and preprocessing version,
+    /// so an asset is only preprocessed again when either of them changes.
+    /// Owners preprocess assets themselves on a miss and store results under CachedAssetPath().
     class PreprocessableAssetStorage
     {
     public:
-        using PostprocessCallback = std::function<void(Memory::GPUResource* asset)>;
+        struct CacheKey
+        {
+            // Tells apart assets made from the same source, extension included
+            std::string AssetName;
 
-        void PreprocessAsset(Memory::GPUResource* asset, const PostprocessCallback& callback);
-        void ReadbackAllAssets();
-        void ReportAllAssetsPostprocessed();
+            // Of everything the asset is computed from
+            uint64_t SourceHash = 0;
+
+            // Has to be incremented whenever preprocessing starts producing different results
+            uint32_t PreprocessingVersion = 0;
+        };
+
+        struct Statistics
+        {
+            uint32_t CacheHitCount = 0;
+            uint32_t CacheMissCount = 0;
+        };
+
+        // Receives root relative path of the cached file
+        using CacheLoader = std::function<bool(Memory::GPUResource* asset, const std::string& cachedAssetPath)>;
+
+        PreprocessableAssetStorage(const std::filesystem::path& rootPath, const std::string& cacheFolder);
+
+        /// Fills the asset through 'loader' and returns true if a cached result for the key exists
+        bool LoadCachedAsset(Memory::GPUResource* asset, const CacheKey& key, const CacheLoader& loader);
+
+        /// Root relative path preprocessed assets are stored under
+        std::string CachedAssetPath(const CacheKey& key) const;
 
     private:
-        std::vector<std::pair<Memory::GPUResource*, PostprocessCallback>> mAssets;
+        std::filesystem::path mRootPath;
+        std::string mCacheFolder;
+        Statistics mStatistics;
+
+    public:
+        inline const auto& GetStatistics() const { return mStatistics; }
     };
 
 }
@@ -45,6 +45,7 @@ namespace PathFinder
     public:
         inline const auto& UABarrier() const { return mUABarrier; }
         inline const auto AccelerationStructureBuffer() const { return mDestinationBuffer.get(); }
+        inline bool IsBuilt() const { return mDestinationBuffer != nullptr; }
     };
 
 }
@@ -39,6 +39,7 @@
 #include "RenderPassGraph.hpp"
 #include "BottomRTAS.hpp"
 #include "TopRTAS.hpp"
+#include "MemoryTelemetry.hpp"
 
 namespace PathFinder
 {
@@ -112,6 +113,7 @@ namespace PathFinder
         std::unique_ptr<RootSignatureCreator> mRootSignatureCreator;
         std::unique_ptr<RenderDevice> mRenderDevice;
         std::unique_ptr<RenderPassContainer<ContentMediator>> mRenderPassContainer;
+        std::unique_ptr<MemoryTelemetry> mMemoryTelemetry;
 
         std::unique_ptr<HAL::SwapChain> mSwapChain;
         std::unique_ptr<HAL::Fence> mFrameFence;
@@ -129,6 +131,8 @@ namespace PathFinder
     public:
         inline PreprocessableAssetStorage* AssetStorage() { return mAssetStorage.get(); }
         inline PipelineResourceStorage* ResourceStorage() { return mPipelineResourceStorage.get(); }
+        inline const MemoryTelemetry* Telemetry() const { return mMemoryTelemetry.get(); }
+        inline const ShaderManager::Statistics& ShaderLoadingStatistics() const { return mShaderManager->GetStatistics(); }
         inline const RenderSurfaceDescription& RenderSurface() const { return mRenderSurfaceDescription; }
         inline Memory::GPUResourceProducer* ResourceProducer() { return mResourceProducer.get(); }
         inline HAL::Device* Device() { return mDevice.get(); }
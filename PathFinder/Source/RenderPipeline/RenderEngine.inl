@@ -55,6 +55,8 @@ namespace PathFinder
             mRenderSurfaceDescription, 
             &mRenderPassGraph);
 
+        mAssetStorage = std::make_unique<PreprocessableAssetStorage>(commandLineParser.ExecutableFolderPath(), "/PreprocessedAssets");
+
         mResourceScheduler = std::make_unique<ResourceScheduler>(
             mPipelineResourceStorage.get(),
             mPassUtilityProvider.get(),
@@ -109,6 +111,12 @@ namespace PathFinder
             mPipelineResourceStorage.get(),
             mPassUtilityProvider.get());
 
+        mMemoryTelemetry = std::make_unique<MemoryTelemetry>(
+            mResourceAllocator.get(),
+            mDescriptorAllocator.get(),
+            mCopyRequestManager.get(),
+            mPipelineResourceStorage.get());
+
         mFrameFence = std::make_unique<HAL::Fence>(*mDevice);
 
         // Start first frame here to prepare engine for external data transfer requests
@@ -222,6 +230,8 @@ namespace PathFinder
         mDescriptorAllocator->EndFrame(completedFrameNumber);
         mCommandListAllocator->EndFrame(completedFrameNumber);
 
+        mMemoryTelemetry->CaptureFrame(mFrameNumber);
+
         using namespace std::chrono;
         mFrameDuration = duration_cast<microseconds>(steady_clock::now() - mFrameStartTimestamp);
     }
@@ -264,12 +274,32 @@ namespace PathFinder
         for (const BottomRTAS* blas : mBottomRTASes)
         {
             bottomRTASUABarriers.AddBarrier(blas->UABarrier());
-            mRenderDevice->RTASBuildsCommandList()->BuildRaytracingAccelerationStructure(blas->HALAccelerationStructure());
+
+            if (blas->IsCompactionPending())
+            {
+                mRenderDevice->RTASBuildsCommandList()->CompactRaytracingAccelerationStructure(
+                    *blas->CompactionSourceBuffer()->HALBuffer(), *blas->AccelerationStructureBuffer()->HALBuffer());
+            }
+            else
+            {
+                mRenderDevice->RTASBuildsCommandList()->BuildRaytracingAccelerationStructure(blas->HALAccelerationStructure());
+            }
         }
 
         // Top RTAS needs to wait for Bottom RTAS
         mRenderDevice->RTASBuildsCommandList()->InsertBarriers(bottomRTASUABarriers);
 
+        // Builds above emit compacted sizes, which are read back to compact structures in later frames
+        for (const BottomRTAS* blas : mBottomRTASes)
+        {
+            if (!blas->IsCompactionPending() && blas->CompactedSizeBuffer())
+            {
+                blas->CompactedSizeBuffer()->RequestRead();
+            }
+        }
+
+        RecordReadbackRequests(*mRenderDevice->RTASBuildsCommandList(), *mResourceStateTracker, *mCopyRequestManager, true);
+
         HAL::ResourceBarrierCollection topRTASUABarriers{};
         for (const TopRTAS* tlas : mTopRTASes)
         {
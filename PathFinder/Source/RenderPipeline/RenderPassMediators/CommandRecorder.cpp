@@ -105,29 +105,7 @@ namespace PathFinder
         HAL::GraphicsCommandList* cmdList = GetGraphicsCommandList();
         RenderDevice::PassHelpers& passHelpers = GetPassHelpers();
 
-        // Apply default viewport if none were provided by the render pass yet
-        if (!passHelpers.LastAppliedViewport)
-        {
-            passHelpers.LastAppliedViewport = HAL::Viewport(
-                mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Width,
-                mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Height 
-            );
-
-            cmdList->SetViewport(*passHelpers.LastAppliedViewport);
-        }
-
-        // Apply default scissor if none were provided by the render pass yet
-        if (!passHelpers.LastAppliedScissor)
-        {
-            passHelpers.LastAppliedScissor = Geometry::Rect2D{
-                {0, 0},
-                Geometry::Size2D(
-                    mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Width,
-                    mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Height)
-            };
-
-            cmdList->SetScissor(*passHelpers.LastAppliedScissor);
-        }
+        ApplyDefaultViewportAndScissorIfNeeded(cmdList);
 
         // Inset UAV barriers between draws
         if (passHelpers.ExecutedRenderCommandsCount > 0)
@@ -147,6 +125,56 @@ namespace PathFinder
         Draw(primitive.VertexCount());
     }
 
+    void CommandRecorder::ExecuteIndirect(Foundation::Name commandSignatureName, const Memory::Buffer& argumentBuffer, uint32_t commandCount, uint64_t argumentBufferOffset)
+    {
+        RenderDevice::PassHelpers& passHelpers = GetPassHelpers();
+        const HAL::CommandSignature* signature = mPipelineStateManager->GetCommandSignature(commandSignatureName);
+
+        assert_format(signature, "Command signature ", commandSignatureName.ToString(), " doesn't exist");
+        assert_format(passHelpers.LastSetPipelineState, "No pipeline state applied before executing indirect commands in ", GetPassNode().PassMetadata().Name.ToString(), " render pass");
+
+        if (passHelpers.LastSetPipelineState->GraphicPSO)
+        {
+            assert_format(RenderPassExecutionQueue{ GetPassNode().ExecutionQueueIndex } != RenderPassExecutionQueue::AsyncCompute,
+                "Indirect draw commands are unsupported on asynchronous compute queue");
+
+            HAL::GraphicsCommandList* cmdList = GetGraphicsCommandList();
+
+            ApplyDefaultViewportAndScissorIfNeeded(cmdList);
+
+            if (passHelpers.ExecutedRenderCommandsCount > 0)
+            {
+                cmdList->InsertBarriers(passHelpers.UAVBarriers);
+            }
+
+            BindGraphicsPassRootConstantBuffer(cmdList);
+            cmdList->ExecuteIndirect(*signature, *argumentBuffer.HALBuffer(), commandCount, argumentBufferOffset);
+        }
+        else
+        {
+            HAL::ComputeCommandListBase* cmdList = GetComputeCommandListBase();
+
+            if (passHelpers.ExecutedRenderCommandsCount > 0)
+            {
+                cmdList->InsertBarriers(passHelpers.UAVBarriers);
+            }
+
+            BindComputePassRootConstantBuffer(cmdList);
+            cmdList->ExecuteIndirect(*signature, *argumentBuffer.HALBuffer(), commandCount, argumentBufferOffset);
+        }
+
+        passHelpers.ResourceStoragePassData->IsAllowedToAdvanceConstantBufferOffset = true;
+        passHelpers.ExecutedRenderCommandsCount++;
+    }
+
+    void CommandRecorder::ExecuteIndirect(Foundation::Name commandSignatureName, Foundation::Name argumentBufferName, uint32_t commandCount, uint64_t argumentBufferOffset)
+    {
+        const PipelineResourceStorageResource* resourceData = mResourceStorage->GetPerResourceData(argumentBufferName);
+        assert_format(resourceData && resourceData->Buffer, "Buffer '", argumentBufferName.ToString(), "' doesn't exist");
+
+        ExecuteIndirect(commandSignatureName, *resourceData->Buffer, commandCount, argumentBufferOffset);
+    }
+
     void CommandRecorder::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
     {
         HAL::ComputeCommandListBase* cmdList = GetComputeCommandListBase();
@@ -202,6 +230,35 @@ namespace PathFinder
         BindExternalBuffer(*resourceData->Buffer, shaderRegister, registerSpace, registerType);
     }
 
+    void CommandRecorder::ApplyDefaultViewportAndScissorIfNeeded(HAL::GraphicsCommandList* cmdList)
+    {
+        RenderDevice::PassHelpers& passHelpers = GetPassHelpers();
+
+        // Apply default viewport if none were provided by the render pass yet
+        if (!passHelpers.LastAppliedViewport)
+        {
+            passHelpers.LastAppliedViewport = HAL::Viewport(
+                mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Width,
+                mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Height 
+            );
+
+            cmdList->SetViewport(*passHelpers.LastAppliedViewport);
+        }
+
+        // Apply default scissor if none were provided by the render pass yet
+        if (!passHelpers.LastAppliedScissor)
+        {
+            passHelpers.LastAppliedScissor = Geometry::Rect2D{
+                {0, 0},
+                Geometry::Size2D(
+                    mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Width,
+                    mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Height)
+            };
+
+            cmdList->SetScissor(*passHelpers.LastAppliedScissor);
+        }
+    }
+
     void CommandRecorder::BindGraphicsCommonResources(const HAL::RootSignature* rootSignature, HAL::GraphicsCommandListBase* cmdList)
     {
         auto commonParametersIndexOffset = rootSignature->ParameterCount() - mPipelineStateManager->CommonRootSignatureParameterCount();
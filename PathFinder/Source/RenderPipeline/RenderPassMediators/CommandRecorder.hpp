@@ -42,6 +42,13 @@ namespace PathFinder
         void DispatchRays(const Geometry::Dimensions& dispatchDimensions);
         void Dispatch(const Geometry::Dimensions& viewportDimensions, const Geometry::Dimensions& groupSize);
 
+        /// Executes commands laid out in the argument buffer according to a command signature
+        /// created through RootSignatureCreator. Indirect draws use currently applied render targets, viewport and scissor.
+        void ExecuteIndirect(Foundation::Name commandSignatureName, const Memory::Buffer& argumentBuffer, uint32_t commandCount, uint64_t argumentBufferOffset = 0);
+
+        /// Reads arguments from a buffer scheduled by render passes, it has to be read as indirect argument buffer in this pass
+        void ExecuteIndirect(Foundation::Name commandSignatureName, Foundation::Name argumentBufferName, uint32_t commandCount, uint64_t argumentBufferOffset = 0);
+
         void BindBuffer(Foundation::Name bufferName, uint16_t shaderRegister, uint16_t registerSpace, HAL::ShaderRegister registerType);
         void BindExternalBuffer(const Memory::Buffer& buffer, uint16_t shaderRegister, uint16_t registerSpace, HAL::ShaderRegister registerType);
         
@@ -53,6 +60,7 @@ namespace PathFinder
         void ApplyState(const HAL::ComputePipelineState* state);
         void ApplyState(const HAL::RayTracingPipelineState* state, const HAL::RayDispatchInfo* dispatchInfo);
 
+        void ApplyDefaultViewportAndScissorIfNeeded(HAL::GraphicsCommandList* cmdList);
         void BindGraphicsCommonResources(const HAL::RootSignature* rootSignature, HAL::GraphicsCommandListBase* cmdList);
         void BindComputeCommonResources(const HAL::RootSignature* rootSignature, HAL::ComputeCommandListBase* cmdList);
         void BindGraphicsPassRootConstantBuffer(HAL::GraphicsCommandListBase* cmdList);
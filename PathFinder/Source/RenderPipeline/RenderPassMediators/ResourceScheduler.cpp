@@ -246,17 +246,59 @@ namespace PathFinder
 
     void ResourceScheduler::ReadBuffer(Foundation::Name resourceName, BufferReadContext readContext)
     {
-        assert_format(false, "Not implemented");
+        mResourceStorage->QueueResourceUsage(resourceName, {},
+            [passNode = mCurrentlySchedulingPassNode,
+            readContext,
+            resourceName,
+            this]
+            (PipelineResourceSchedulingInfo& schedulingInfo)
+        {
+            HAL::ResourceState state = HAL::ResourceState::AnyShaderAccess;
+            PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag accessFlag = PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::BufferSR;
+
+            switch (readContext)
+            {
+            case BufferReadContext::Constant:
+                state = HAL::ResourceState::ConstantBuffer;
+                accessFlag = PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::BufferCB;
+                break;
+
+            case BufferReadContext::IndirectArgument:
+                state = HAL::ResourceState::IndirectArgument;
+                accessFlag = PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::BufferIA;
+                break;
+
+            case BufferReadContext::ShaderResource:
+                break;
+            }
+
+            RegisterGraphDependency(*passNode, MipSet::FirstMip(), resourceName, {}, 1, false);
+            schedulingInfo.SetSubresourceInfo(passNode->PassMetadata().Name, 0, state, accessFlag, std::nullopt);
+        });
     }
 
     void ResourceScheduler::WriteBuffer(Foundation::Name resourceName)
     {
-        assert_format(false, "Not implemented");
+        WriteBuffer(resourceName, {});
     }
 
     void ResourceScheduler::WriteBuffer(Foundation::Name resourceName, Foundation::Name outputAliasName)
     {
-        assert_format(false, "Not implemented");
+        mResourceStorage->QueueResourceUsage(resourceName, outputAliasName.IsValid() ? std::optional(outputAliasName) : std::nullopt,
+            [passNode = mCurrentlySchedulingPassNode,
+            resourceName,
+            outputAliasName,
+            this]
+            (PipelineResourceSchedulingInfo& schedulingInfo)
+        {
+            RegisterGraphDependency(*passNode, MipSet::FirstMip(), resourceName, outputAliasName, 1, true);
+            schedulingInfo.SetSubresourceInfo(
+                passNode->PassMetadata().Name,
+                0,
+                HAL::ResourceState::UnorderedAccess,
+                PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::BufferUA,
+                std::nullopt);
+        });
     }
 
     void ResourceScheduler::WriteToBackBuffer()
@@ -318,6 +360,10 @@ namespace PathFinder
             if (properties->TextureToCopyPropertiesFrom) filledProperties.TextureToCopyPropertiesFrom = properties->TextureToCopyPropertiesFrom;
         }
 
+        // Render graph tracks subresources by mip only
+        assert_format(*filledProperties.Kind == HAL::TextureKind::Texture3D || filledProperties.Dimensions->Depth == 1,
+            "Texture arrays are not supported by render graph currently. Add proper handling of texture array scheduling first, then remove this assert.");
+
         return filledProperties;
     }
 
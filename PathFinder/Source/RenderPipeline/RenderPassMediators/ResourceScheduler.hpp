@@ -21,7 +21,7 @@ namespace PathFinder
 
         enum class BufferReadContext
         {
-            Constant, ShaderResource
+            Constant, ShaderResource, IndirectArgument
         };
 
         enum class Flags : uint32_t
@@ -185,7 +185,7 @@ namespace PathFinder
             Foundation::Name resourceName, 
             const NewBufferProperties<T>& bufferProperties = NewByteBufferProperties{ 1, 1 });
 
-        // Read any previously created buffer either as Constant or Structured buffer (Read Only)
+        // Read any previously created buffer either as Constant, Structured or indirect argument buffer (Read Only)
         void ReadBuffer(Foundation::Name resourceName, BufferReadContext readContext);
 
         // Access a previously created buffer as an Unordered Access Structured buffer (Write)
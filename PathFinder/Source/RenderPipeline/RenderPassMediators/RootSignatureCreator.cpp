@@ -11,4 +11,9 @@ namespace PathFinder
         mPipelineStateManager->CreateRootSignature(name, configurator);
     }
 
+    void RootSignatureCreator::CreateCommandSignature(CommandSignatureName name, const PipelineStateManager::CommandSignatureConfigurator& configurator)
+    {
+        mPipelineStateManager->CreateCommandSignature(name, configurator);
+    }
+
 }
\ No newline at end of file
@@ -12,6 +12,9 @@ namespace PathFinder
 
         void CreateRootSignature(RootSignatureName name, const PipelineStateManager::RootSignatureConfigurator& configurator);
 
+        // Command signatures that set root constants have to be created after the root signature they reference
+        void CreateCommandSignature(CommandSignatureName name, const PipelineStateManager::CommandSignatureConfigurator& configurator);
+
     private:
         PipelineStateManager* mPipelineStateManager;
     };
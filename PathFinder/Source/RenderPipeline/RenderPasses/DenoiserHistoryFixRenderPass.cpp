@@ -20,8 +20,8 @@ namespace PathFinder
     {
         auto frameIndex = scheduler->FrameNumber() % 2;
 
-        scheduler->ReadTexture(ResourceNames::GBufferNormalRoughness);
-        scheduler->ReadTexture(ResourceNames::GBufferViewDepth[frameIndex]);
+        scheduler->ReadTexture(ResourceNames::GBufferNormalRoughnessSecondPhase);
+        scheduler->ReadTexture(ResourceNames::GBufferViewDepthSecondPhase);
         scheduler->ReadTexture(ResourceNames::DenoiserReprojectedFramesCount[frameIndex]);
         
         // Write to mip 0
@@ -43,8 +43,8 @@ namespace PathFinder
         auto frameIndex = context->FrameNumber() % 2;
 
         DenoiserHistoryFixCBContent cbContent{};
-        cbContent.GBufferNormalRoughnessTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferNormalRoughness);
-        cbContent.ViewDepthTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferViewDepth[frameIndex]);
+        cbContent.GBufferNormalRoughnessTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferNormalRoughnessSecondPhase);
+        cbContent.ViewDepthTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferViewDepthSecondPhase);
         cbContent.AccumulationCounterTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::DenoiserReprojectedFramesCount[frameIndex]);
         cbContent.ShadowedShadingPreBlurredTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::StochasticShadowedShadingPreBlurred, 1);
         cbContent.UnshadowedShadingPreBlurredTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::StochasticUnshadowedShadingPreBlurred, 1);
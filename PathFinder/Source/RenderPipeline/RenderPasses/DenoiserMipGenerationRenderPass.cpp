@@ -13,12 +13,10 @@ namespace PathFinder
 
     void DenoiserMipGenerationRenderPass::ScheduleSubPasses(SubPassScheduler<RenderPassContentMediator>* scheduler)
     {
-        auto frameIndex = scheduler->FrameNumber() % 2;
-
         std::array<std::vector<DownsamplingInvocationInputs>, 4> perResourceDownsamplingInvocationInputs{
             GenerateDownsamplingShaderInvocationInputs(
-            ResourceNames::GBufferViewDepth[frameIndex],
-            scheduler->GetTextureProperties(ResourceNames::GBufferViewDepth[frameIndex]),
+            ResourceNames::GBufferViewDepthSecondPhase,
+            scheduler->GetTextureProperties(ResourceNames::GBufferViewDepthSecondPhase),
             DownsamplingCBContent::Filter::Min,
             DownsamplingStrategy::WriteAllLevels),
 
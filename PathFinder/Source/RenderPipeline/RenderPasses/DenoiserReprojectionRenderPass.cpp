@@ -30,11 +30,11 @@ namespace PathFinder
         scheduler->NewTexture(ResourceNames::StochasticShadowedShadingReprojected);
         scheduler->NewTexture(ResourceNames::StochasticUnshadowedShadingReprojected);
 
-        scheduler->ReadTexture(ResourceNames::GBufferNormalRoughness);
-        scheduler->ReadTexture(ResourceNames::GBufferDepthStencil);
-        scheduler->ReadTexture(ResourceNames::GBufferMotionVector);
+        scheduler->ReadTexture(ResourceNames::GBufferNormalRoughnessSecondPhase);
+        scheduler->ReadTexture(ResourceNames::GBufferDepthStencilSecondPhase);
+        scheduler->ReadTexture(ResourceNames::GBufferMotionVectorSecondPhase);
         scheduler->ReadTexture(ResourceNames::GBufferViewDepth[previousFrameIndex]);
-        scheduler->ReadTexture(ResourceNames::GBufferViewDepth[frameIndex]);
+        scheduler->ReadTexture(ResourceNames::GBufferViewDepthSecondPhase);
         scheduler->ReadTexture(ResourceNames::DenoiserReprojectedFramesCount[previousFrameIndex]);
         scheduler->ReadTexture(ResourceNames::StochasticShadowedShadingDenoised[previousFrameIndex]);
         scheduler->ReadTexture(ResourceNames::StochasticUnshadowedShadingDenoised[previousFrameIndex]);
@@ -55,11 +55,11 @@ namespace PathFinder
 
         DenoiserReprojectionCBContent cbContent{};
         cbContent.DispatchGroupCount = { groupCount.Width, groupCount.Height };
-        cbContent.GBufferNormalRoughnessTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferNormalRoughness);
-        cbContent.DepthTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferDepthStencil);
-        cbContent.MotionTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferMotionVector);
+        cbContent.GBufferNormalRoughnessTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferNormalRoughnessSecondPhase);
+        cbContent.DepthTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferDepthStencilSecondPhase);
+        cbContent.MotionTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferMotionVectorSecondPhase);
         cbContent.PreviousViewDepthTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferViewDepth[previousFrameIndex]);
-        cbContent.CurrentViewDepthTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferViewDepth[frameIndex]);
+        cbContent.CurrentViewDepthTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferViewDepthSecondPhase);
         cbContent.PreviousAccumulationCounterTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::DenoiserReprojectedFramesCount[previousFrameIndex]);
         cbContent.CurrentAccumulationCounterTexIdx = resourceProvider->GetUATextureIndex(ResourceNames::DenoiserReprojectedFramesCount[frameIndex]);
         cbContent.ShadowedShadingHistoryTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::StochasticShadowedShadingDenoised[previousFrameIndex]);
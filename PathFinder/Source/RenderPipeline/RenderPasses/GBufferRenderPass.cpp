@@ -10,11 +10,38 @@ namespace PathFinder
     {
         rootSignatureCreator->CreateRootSignature(RootSignatureNames::GBufferMeshes, [](RootSignatureProxy& signatureProxy)
         {
-            signatureProxy.AddRootConstantsParameter<uint32_t>(0, 0); // Mesh instance table index
+            signatureProxy.AddRootConstantsParameter<uint32_t>(0, 0); // Batch instance list offset
             signatureProxy.AddShaderResourceBufferParameter(0, 0); // Unified vertex buffer
             signatureProxy.AddShaderResourceBufferParameter(1, 0); // Unified index buffer
             signatureProxy.AddShaderResourceBufferParameter(2, 0); // Instance data buffer
             signatureProxy.AddShaderResourceBufferParameter(3, 0); // Material data buffer
+            signatureProxy.AddShaderResourceBufferParameter(4, 0); // Batch instance list
+            signatureProxy.AddShaderResourceBufferParameter(5, 0); // Unified packed vertex buffer
+        });
+
+        rootSignatureCreator->CreateCommandSignature(CommandSignatureNames::GBufferMeshes, [](CommandSignatureProxy& signatureProxy)
+        {
+            signatureProxy.RootSignatureName = RootSignatureNames::GBufferMeshes;
+            signatureProxy.AddRootConstantsArgument<uint32_t>(0, 0); // Batch instance list offset
+            signatureProxy.AddDrawArgument();
+        });
+
+        rootSignatureCreator->CreateRootSignature(RootSignatureNames::GBufferMeshlets, [](RootSignatureProxy& signatureProxy)
+        {
+            signatureProxy.AddShaderResourceBufferParameter(0, 0); // Unified vertex buffer
+            signatureProxy.AddShaderResourceBufferParameter(1, 0); // Unified meshlet vertex index buffer
+            signatureProxy.AddShaderResourceBufferParameter(2, 0); // Instance data buffer
+            signatureProxy.AddShaderResourceBufferParameter(3, 0); // Material data buffer
+            signatureProxy.AddShaderResourceBufferParameter(4, 0); // Visible meshlets
+            signatureProxy.AddShaderResourceBufferParameter(5, 0); // Unified packed vertex buffer
+            signatureProxy.AddShaderResourceBufferParameter(6, 0); // Meshlet table
+            signatureProxy.AddShaderResourceBufferParameter(7, 0); // Unified meshlet triangle buffer
+        });
+
+        rootSignatureCreator->CreateCommandSignature(CommandSignatureNames::GBufferMeshlets, [](CommandSignatureProxy& signatureProxy)
+        {
+            signatureProxy.RootSignatureName = RootSignatureNames::GBufferMeshlets;
+            signatureProxy.AddDrawArgument();
         });
 
         rootSignatureCreator->CreateRootSignature(RootSignatureNames::GBufferLights, [](RootSignatureProxy& signatureProxy)
@@ -41,6 +68,22 @@ namespace PathFinder
             };
         });
 
+        stateCreator->CreateGraphicsState(PSONames::GBufferMeshlets, [](GraphicsStateProxy& state)
+        {
+            state.VertexShaderFileName = "GBufferMeshlets.hlsl";
+            state.PixelShaderFileName = "GBufferMeshlets.hlsl";
+            state.PrimitiveTopology = HAL::PrimitiveTopology::TriangleList;
+            state.RootSignatureName = RootSignatureNames::GBufferMeshlets;
+            state.DepthStencilState.SetDepthTestEnabled(true);
+            state.RenderTargetFormats = {
+                HAL::ColorFormat::RGBA8_Usigned_Norm,
+                HAL::ColorFormat::RGBA8_Usigned_Norm,
+                HAL::ColorFormat::RG32_Unsigned,
+                HAL::ColorFormat::R8_Unsigned,
+                HAL::ColorFormat::R32_Float
+            };
+        });
+
         stateCreator->CreateGraphicsState(PSONames::GBufferLights, [](GraphicsStateProxy& state)
         {
             state.VertexShaderFileName = "GBufferLights.hlsl";
@@ -78,6 +121,8 @@ namespace PathFinder
         scheduler->NewRenderTarget(ResourceNames::GBufferViewDepth[0], viewDepthProperties);
         scheduler->NewRenderTarget(ResourceNames::GBufferViewDepth[1], viewDepthProperties);
         scheduler->NewDepthStencil(ResourceNames::GBufferDepthStencil);
+        scheduler->ReadBuffer(ResourceNames::MeshletCulledDrawArguments, ResourceScheduler::BufferReadContext::IndirectArgument);
+        scheduler->ReadBuffer(ResourceNames::VisibleMeshlets, ResourceScheduler::BufferReadContext::ShaderResource);
     }  
 
     void GBufferRenderPass::Render(RenderContext<RenderPassContentMediator>* context) 
@@ -102,6 +147,7 @@ namespace PathFinder
         context->GetCommandRecorder()->ClearDepth(ResourceNames::GBufferDepthStencil);
 
         RenderMeshes(context);
+        RenderMeshlets(context);
         RenderLights(context);
     }
 
@@ -109,34 +155,59 @@ namespace PathFinder
     {
         context->GetCommandRecorder()->ApplyPipelineState(PSONames::GBufferMeshes);
 
-        auto& instances = context->GetContent()->GetScene()->MeshInstances();
+        auto meshStorage = context->GetContent()->GetSceneGPUStorage();
 
-        if (instances.empty()) 
+        // Instanced draw commands for batches of visible instances are prepared on CPU ahead of time
+        if (meshStorage->MeshInstanceDrawCommandCount() == 0)
             return;
 
         // Use vertex and index buffers as normal structured buffers
-        auto meshStorage = context->GetContent()->GetSceneGPUStorage();
         context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->UnifiedVertexBuffer(), 0, 0, HAL::ShaderRegister::ShaderResource);
         context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->UnifiedIndexBuffer(), 1, 0, HAL::ShaderRegister::ShaderResource);
         context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->MeshInstanceTable(), 2, 0, HAL::ShaderRegister::ShaderResource);
         context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->MaterialTable(), 3, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->MeshInstanceBatchListBuffer(), 4, 0, HAL::ShaderRegister::ShaderResource);
 
-        for (const MeshInstance& instance : instances)
-        {
-            context->GetCommandRecorder()->SetRootConstants(instance.IndexInGPUTable(), 0, 0);
-            context->GetCommandRecorder()->Draw(instance.AssociatedMesh()->LocationInVertexStorage().IndexCount);
-        }
+        // Packed buffer doesn't exist while no mesh is packed, nothing reads the slot then
+        auto packedVertexBuffer = meshStorage->UnifiedPackedVertexBuffer() ? meshStorage->UnifiedPackedVertexBuffer() : meshStorage->UnifiedVertexBuffer();
+        context->GetCommandRecorder()->BindExternalBuffer(*packedVertexBuffer, 5, 0, HAL::ShaderRegister::ShaderResource);
+
+        context->GetCommandRecorder()->ExecuteIndirect(
+            CommandSignatureNames::GBufferMeshes, *meshStorage->MeshInstanceDrawCommandBuffer(), meshStorage->MeshInstanceDrawCommandCount());
+    }
+
+    void GBufferRenderPass::RenderMeshlets(RenderContext<RenderPassContentMediator>* context)
+    {
+        auto meshStorage = context->GetContent()->GetSceneGPUStorage();
+
+        // Instance count of the draw is the number of meshlets that survived culling on GPU
+        if (meshStorage->ClusteredInstanceCount() == 0)
+            return;
+
+        context->GetCommandRecorder()->ApplyPipelineState(PSONames::GBufferMeshlets);
+
+        context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->UnifiedVertexBuffer(), 0, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->MeshletVertexIndexBuffer(), 1, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->MeshInstanceTable(), 2, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->MaterialTable(), 3, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindBuffer(ResourceNames::VisibleMeshlets, 4, 0, HAL::ShaderRegister::ShaderResource);
+
+        auto packedVertexBuffer = meshStorage->UnifiedPackedVertexBuffer() ? meshStorage->UnifiedPackedVertexBuffer() : meshStorage->UnifiedVertexBuffer();
+        context->GetCommandRecorder()->BindExternalBuffer(*packedVertexBuffer, 5, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->MeshletTable(), 6, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->MeshletTriangleBuffer(), 7, 0, HAL::ShaderRegister::ShaderResource);
+
+        context->GetCommandRecorder()->ExecuteIndirect(CommandSignatureNames::GBufferMeshlets, ResourceNames::MeshletCulledDrawArguments, 1);
     }
 
     void GBufferRenderPass::RenderLights(RenderContext<RenderPassContentMediator>* context)
     {
         context->GetCommandRecorder()->ApplyPipelineState(PSONames::GBufferLights);
 
-        auto& rectLights = context->GetContent()->GetScene()->RectangularLights();
-        auto& diskLights = context->GetContent()->GetScene()->DiskLights();
+        auto& flatLights = context->GetContent()->GetScene()->FlatLights();
         auto& sphereLights = context->GetContent()->GetScene()->SphericalLights();
 
-        if (rectLights.empty() && diskLights.empty() && sphereLights.empty())
+        if (flatLights.empty() && sphereLights.empty())
             return;
 
         // Use vertex and index buffers as normal structured buffers
@@ -146,13 +217,7 @@ namespace PathFinder
         context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->UnifiedVertexBuffer(), 1, 0, HAL::ShaderRegister::ShaderResource);
         context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->UnifiedIndexBuffer(), 2, 0, HAL::ShaderRegister::ShaderResource);
 
-        for (const FlatLight& light : rectLights)
-        {
-            context->GetCommandRecorder()->SetRootConstants(light.IndexInGPUTable(), 0, 0);
-            context->GetCommandRecorder()->Draw(light.LocationInVertexStorage().IndexCount);
-        }
-
-        for (const FlatLight& light : diskLights)
+        for (const FlatLight& light : flatLights)
         {
             context->GetCommandRecorder()->SetRootConstants(light.IndexInGPUTable(), 0, 0);
             context->GetCommandRecorder()->Draw(light.LocationInVertexStorage().IndexCount); 
@@ -28,6 +28,7 @@ namespace PathFinder
 
     private:
         void RenderMeshes(RenderContext<RenderPassContentMediator>* context);
+        void RenderMeshlets(RenderContext<RenderPassContentMediator>* context);
         void RenderLights(RenderContext<RenderPassContentMediator>* context);
     };
 
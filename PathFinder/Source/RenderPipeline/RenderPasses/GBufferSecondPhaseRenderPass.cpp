@@ -0,0 +1,58 @@
+#include "GBufferSecondPhaseRenderPass.hpp"
+
+namespace PathFinder
+{
+
+    GBufferSecondPhaseRenderPass::GBufferSecondPhaseRenderPass()
+        : RenderPass("GBufferSecondPhase") {}
+
+    void GBufferSecondPhaseRenderPass::ScheduleResources(ResourceScheduler* scheduler)
+    {
+        auto currentFrameIndex = scheduler->FrameNumber() % 2;
+
+        scheduler->AliasAndUseRenderTarget(ResourceNames::GBufferAlbedoMetalness, ResourceNames::GBufferAlbedoMetalnessSecondPhase);
+        scheduler->AliasAndUseRenderTarget(ResourceNames::GBufferNormalRoughness, ResourceNames::GBufferNormalRoughnessSecondPhase);
+        scheduler->AliasAndUseRenderTarget(ResourceNames::GBufferMotionVector, ResourceNames::GBufferMotionVectorSecondPhase);
+        scheduler->AliasAndUseRenderTarget(ResourceNames::GBufferTypeAndMaterialIndex, ResourceNames::GBufferTypeAndMaterialIndexSecondPhase);
+        scheduler->AliasAndUseRenderTarget(ResourceNames::GBufferViewDepth[currentFrameIndex], ResourceNames::GBufferViewDepthSecondPhase);
+        scheduler->AliasAndUseDepthStencil(ResourceNames::GBufferDepthStencil, ResourceNames::GBufferDepthStencilSecondPhase);
+        scheduler->ReadBuffer(ResourceNames::OcclusionCulledDrawCommands, ResourceScheduler::BufferReadContext::IndirectArgument);
+        scheduler->ReadBuffer(ResourceNames::OcclusionCulledBatchInstanceList, ResourceScheduler::BufferReadContext::ShaderResource);
+    }
+
+    void GBufferSecondPhaseRenderPass::Render(RenderContext<RenderPassContentMediator>* context)
+    {
+        auto meshStorage = context->GetContent()->GetSceneGPUStorage();
+
+        // Commands of batches without visible candidates draw zero instances
+        if (meshStorage->OcclusionCandidateCount() == 0)
+            return;
+
+        // Targets keep first phase content, so no clears here
+        context->GetCommandRecorder()->SetRenderTargets(
+            std::array{
+                ResourceNames::GBufferAlbedoMetalnessSecondPhase,
+                ResourceNames::GBufferNormalRoughnessSecondPhase,
+                ResourceNames::GBufferMotionVectorSecondPhase,
+                ResourceNames::GBufferTypeAndMaterialIndexSecondPhase,
+                ResourceNames::GBufferViewDepthSecondPhase
+            },
+            ResourceNames::GBufferDepthStencilSecondPhase);
+
+        // Same state and command signature as meshes of the first phase, only batch instance list differs
+        context->GetCommandRecorder()->ApplyPipelineState(PSONames::GBufferMeshes);
+
+        context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->UnifiedVertexBuffer(), 0, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->UnifiedIndexBuffer(), 1, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->MeshInstanceTable(), 2, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->MaterialTable(), 3, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindBuffer(ResourceNames::OcclusionCulledBatchInstanceList, 4, 0, HAL::ShaderRegister::ShaderResource);
+
+        auto packedVertexBuffer = meshStorage->UnifiedPackedVertexBuffer() ? meshStorage->UnifiedPackedVertexBuffer() : meshStorage->UnifiedVertexBuffer();
+        context->GetCommandRecorder()->BindExternalBuffer(*packedVertexBuffer, 5, 0, HAL::ShaderRegister::ShaderResource);
+
+        context->GetCommandRecorder()->ExecuteIndirect(
+            CommandSignatureNames::GBufferMeshes, ResourceNames::OcclusionCulledDrawCommands, meshStorage->OcclusionCandidateDrawCommandCount());
+    }
+
+}
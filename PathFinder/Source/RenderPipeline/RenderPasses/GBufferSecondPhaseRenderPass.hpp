@@ -0,0 +1,24 @@
+#pragma once
+
+#include "../RenderPass.hpp"
+#include "../RenderPassContentMediator.hpp"
+
+#include "PipelineNames.hpp"
+
+namespace PathFinder
+{
+
+    /// Draws instances that were occluded in an older Hi-Z on CPU, but turned out visible
+    /// against Hi-Z of this frame, on top of GBuffer of the first phase.
+    /// Draw commands are produced by occlusion culling pass on GPU.
+    class GBufferSecondPhaseRenderPass : public RenderPass<RenderPassContentMediator>
+    {
+    public:
+        GBufferSecondPhaseRenderPass();
+        ~GBufferSecondPhaseRenderPass() = default;
+
+        virtual void ScheduleResources(ResourceScheduler* scheduler) override;
+        virtual void Render(RenderContext<RenderPassContentMediator>* context) override;
+    };
+
+}
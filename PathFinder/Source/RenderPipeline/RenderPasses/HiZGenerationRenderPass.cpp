@@ -0,0 +1,78 @@
+#include "HiZGenerationRenderPass.hpp"
+
+#include <Geometry/HiZPyramid.hpp>
+
+namespace PathFinder
+{
+
+    HiZGenerationRenderPass::HiZGenerationRenderPass()
+        : RenderPass("HiZGeneration") {}
+
+    void HiZGenerationRenderPass::SetupPipelineStates(PipelineStateCreator* stateCreator, RootSignatureCreator* rootSignatureCreator)
+    {
+        rootSignatureCreator->CreateRootSignature(RootSignatureNames::HiZGeneration, [](RootSignatureProxy& signatureProxy)
+        {
+            signatureProxy.AddUnorderedAccessBufferParameter(0, 0); // Hi-Z base level | u0 - s0
+            signatureProxy.AddUnorderedAccessBufferParameter(1, 0); // Hi-Z info | u1 - s0
+        });
+
+        stateCreator->CreateComputeState(PSONames::HiZGeneration, [](ComputeStateProxy& state)
+        {
+            state.ComputeShaderFileName = "HiZGeneration.hlsl";
+            state.RootSignatureName = RootSignatureNames::HiZGeneration;
+        });
+    }
+
+    void HiZGenerationRenderPass::ScheduleResources(ResourceScheduler* scheduler)
+    {
+        auto currentFrameIndex = scheduler->FrameNumber() % 2;
+        uint64_t texelCount = 0;
+
+        for (const Geometry::Dimensions& levelSize : HiZLevelSizes(scheduler->DefaultRenderSurfaceDesc().Dimensions()))
+        {
+            texelCount += levelSize.Width * levelSize.Height;
+        }
+
+        // Depth of instances that passed first phase of occlusion culling only
+        scheduler->ReadTexture(ResourceNames::GBufferViewDepth[currentFrameIndex]);
+        scheduler->NewBuffer(ResourceNames::HiZ, ResourceScheduler::NewBufferProperties<float>{ texelCount });
+        scheduler->NewBuffer(ResourceNames::HiZInfo, ResourceScheduler::NewBufferProperties<HiZInfo>{ 1 });
+        scheduler->Export(ResourceNames::HiZ);
+        scheduler->Export(ResourceNames::HiZInfo);
+    }
+
+    void HiZGenerationRenderPass::Render(RenderContext<RenderPassContentMediator>* context)
+    {
+        context->GetCommandRecorder()->ApplyPipelineState(PSONames::HiZGeneration);
+
+        auto currentFrameIndex = context->FrameNumber() % 2;
+        const Geometry::Dimensions& viewportDimensions = context->GetDefaultRenderSurfaceDesc().Dimensions();
+        std::vector<Geometry::Dimensions> levelSizes = HiZLevelSizes(viewportDimensions);
+
+        HiZGenerationCBContent cbContent{};
+        cbContent.ViewDepthTexIdx = context->GetResourceProvider()->GetSRTextureIndex(ResourceNames::GBufferViewDepth[currentFrameIndex]);
+        cbContent.BaseTexelSize = BaseTexelSize;
+        cbContent.ViewportSize = { viewportDimensions.Width, viewportDimensions.Height };
+        cbContent.HiZSize = { levelSizes[0].Width, levelSizes[0].Height };
+        cbContent.FrameNumber = (uint32_t)context->FrameNumber();
+
+        context->GetCommandRecorder()->BindBuffer(ResourceNames::HiZ, 0, 0, HAL::ShaderRegister::UnorderedAccess);
+        context->GetCommandRecorder()->BindBuffer(ResourceNames::HiZInfo, 1, 0, HAL::ShaderRegister::UnorderedAccess);
+
+        // Every level is reduced from the previous one, dispatches are separated by UAV barriers
+        for (auto level = 0u; level < levelSizes.size(); ++level)
+        {
+            cbContent.Level = level;
+            context->GetConstantsUpdater()->UpdateRootConstantBuffer(cbContent);
+            context->GetCommandRecorder()->Dispatch(levelSizes[level], { 8, 8 });
+        }
+    }
+
+    std::vector<Geometry::Dimensions> HiZGenerationRenderPass::HiZLevelSizes(const Geometry::Dimensions& viewportDimensions) const
+    {
+        return Geometry::HiZPyramid::LevelSizes(
+            Geometry::HiZPyramid::BaseLevelSize(viewportDimensions.Width, BaseTexelSize),
+            Geometry::HiZPyramid::BaseLevelSize(viewportDimensions.Height, BaseTexelSize));
+    }
+
+}
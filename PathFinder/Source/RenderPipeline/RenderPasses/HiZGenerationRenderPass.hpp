@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../RenderPass.hpp"
+#include "../RenderPassContentMediator.hpp"
+
+#include "PipelineNames.hpp"
+
+#include <glm/mat4x4.hpp>
+
+namespace PathFinder
+{
+
+    struct HiZGenerationCBContent
+    {
+        uint32_t ViewDepthTexIdx;
+        uint32_t BaseTexelSize;
+        glm::uvec2 ViewportSize;
+        glm::uvec2 HiZSize;
+        uint32_t FrameNumber;
+        uint32_t Level;
+    };
+
+    // Describes camera and resolution exported Hi-Z was built with,
+    // so that it can be used on CPU frames after it was rendered
+    struct HiZInfo
+    {
+        glm::mat4 View;
+        glm::mat4 ViewProjection;
+        glm::uvec2 ViewportSize;
+        glm::uvec2 Size;
+        uint32_t BaseTexelSize;
+        uint32_t FrameNumber;
+    };
+
+    class HiZGenerationRenderPass : public RenderPass<RenderPassContentMediator>
+    {
+    public:
+        // Viewport pixels reduced into a single base level texel on GPU.
+        // Only the base level is read back, CPU builds the rest of its pyramid itself.
+        inline static const uint32_t BaseTexelSize = 8;
+
+        HiZGenerationRenderPass();
+        ~HiZGenerationRenderPass() = default;
+
+        virtual void SetupPipelineStates(PipelineStateCreator* stateCreator, RootSignatureCreator* rootSignatureCreator) override;
+        virtual void ScheduleResources(ResourceScheduler* scheduler) override;
+        virtual void Render(RenderContext<RenderPassContentMediator>* context) override;
+
+    private:
+        std::vector<Geometry::Dimensions> HiZLevelSizes(const Geometry::Dimensions& viewportDimensions) const;
+    };
+
+}
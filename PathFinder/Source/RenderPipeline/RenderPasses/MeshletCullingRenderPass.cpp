@@ -0,0 +1,76 @@
+#include "MeshletCullingRenderPass.hpp"
+
+#include <HardwareAbstractionLayer/IndirectArguments.hpp>
+
+#include <algorithm>
+
+namespace PathFinder
+{
+
+    MeshletCullingRenderPass::MeshletCullingRenderPass()
+        : RenderPass("MeshletCulling") {}
+
+    void MeshletCullingRenderPass::SetupPipelineStates(PipelineStateCreator* stateCreator, RootSignatureCreator* rootSignatureCreator)
+    {
+        rootSignatureCreator->CreateRootSignature(RootSignatureNames::MeshletCulling, [](RootSignatureProxy& signatureProxy)
+        {
+            signatureProxy.AddShaderResourceBufferParameter(0, 0); // Instance table | t0 - s0
+            signatureProxy.AddShaderResourceBufferParameter(1, 0); // Meshlet table | t1 - s0
+            signatureProxy.AddShaderResourceBufferParameter(2, 0); // Clustered instances | t2 - s0
+            signatureProxy.AddUnorderedAccessBufferParameter(0, 0); // Draw arguments | u0 - s0
+            signatureProxy.AddUnorderedAccessBufferParameter(1, 0); // Visible meshlets | u1 - s0
+        });
+
+        stateCreator->CreateComputeState(PSONames::MeshletCulling, [](ComputeStateProxy& state)
+        {
+            state.ComputeShaderFileName = "MeshletCulling.hlsl";
+            state.RootSignatureName = RootSignatureNames::MeshletCulling;
+        });
+    }
+
+    void MeshletCullingRenderPass::ScheduleResources(ResourceScheduler* scheduler)
+    {
+        scheduler->NewBuffer(ResourceNames::MeshletCulledDrawArguments, ResourceScheduler::NewBufferProperties<HAL::DrawArguments>{ 1 });
+        scheduler->NewBuffer(ResourceNames::VisibleMeshlets, ResourceScheduler::NewBufferProperties<GPUVisibleMeshlet>{ mMaxVisibleMeshletCount });
+    }
+
+    void MeshletCullingRenderPass::Render(RenderContext<RenderPassContentMediator>* context)
+    {
+        auto meshStorage = context->GetContent()->GetSceneGPUStorage();
+
+        if (meshStorage->ClusteredInstanceCount() == 0)
+            return;
+
+        assert_format(meshStorage->ClusteredMeshletCount() <= mMaxVisibleMeshletCount, "Meshlets of clustered instances don't fit into visible meshlet list");
+
+        // Every instance is culled by its own thread group
+        assert_format(meshStorage->ClusteredInstanceCount() <= 65535, "Clustered instances exceed dispatch group count limit");
+
+        context->GetCommandRecorder()->ApplyPipelineState(PSONames::MeshletCulling);
+
+        MeshletCullingCBContent cbContent{};
+        cbContent.ClusteredInstanceCount = meshStorage->ClusteredInstanceCount();
+        cbContent.MaxMeshletTriangleCount = meshStorage->MaxMeshletTriangleCount();
+
+        context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->MeshInstanceTable(), 0, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->MeshletTable(), 1, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->ClusteredInstanceBuffer(), 2, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindBuffer(ResourceNames::MeshletCulledDrawArguments, 0, 0, HAL::ShaderRegister::UnorderedAccess);
+        context->GetCommandRecorder()->BindBuffer(ResourceNames::VisibleMeshlets, 1, 0, HAL::ShaderRegister::UnorderedAccess);
+
+        // Draw starts with no instances, meshlets that pass are appended to it
+        cbContent.IsResettingDrawArguments = true;
+        context->GetConstantsUpdater()->UpdateRootConstantBuffer(cbContent);
+        context->GetCommandRecorder()->Dispatch(1);
+
+        cbContent.IsResettingDrawArguments = false;
+        context->GetConstantsUpdater()->UpdateRootConstantBuffer(cbContent);
+        context->GetCommandRecorder()->Dispatch(cbContent.ClusteredInstanceCount);
+    }
+
+    void MeshletCullingRenderPass::SetMaxVisibleMeshletCount(uint32_t count)
+    {
+        mMaxVisibleMeshletCount = std::max(count, 1u);
+    }
+
+}
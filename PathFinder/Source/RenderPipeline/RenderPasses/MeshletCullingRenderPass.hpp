@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../RenderPass.hpp"
+#include "../RenderPassContentMediator.hpp"
+
+#include "PipelineNames.hpp"
+
+namespace PathFinder
+{
+
+    struct MeshletCullingCBContent
+    {
+        uint32_t ClusteredInstanceCount;
+        uint32_t MaxMeshletTriangleCount;
+        uint32_t IsResettingDrawArguments;
+    };
+
+    // Meshlet that survived culling, one instance of the GBuffer meshlet draw
+    struct GPUVisibleMeshlet
+    {
+        uint32_t InstanceTableIndex;
+        uint32_t MeshletTableIndex;
+    };
+
+    /// Culls meshlets of visible LOD 0 instances against view frustum and their normal cones.
+    /// Survivors are compacted into a single instanced draw, where every instance is a meshlet
+    /// and every vertex beyond the meshlet's triangles is discarded as degenerate.
+    class MeshletCullingRenderPass : public RenderPass<RenderPassContentMediator>
+    {
+    public:
+        MeshletCullingRenderPass();
+        ~MeshletCullingRenderPass() = default;
+
+        virtual void SetupPipelineStates(PipelineStateCreator* stateCreator, RootSignatureCreator* rootSignatureCreator) override;
+        virtual void ScheduleResources(ResourceScheduler* scheduler) override;
+        virtual void Render(RenderContext<RenderPassContentMediator>* context) override;
+
+        /// Sizes the visible meshlet list, which is scheduled before instances of a frame are culled.
+        /// Meshlets of every mesh instance of the scene fit into it at worst.
+        void SetMaxVisibleMeshletCount(uint32_t count);
+
+    private:
+        uint32_t mMaxVisibleMeshletCount = 1;
+    };
+
+}
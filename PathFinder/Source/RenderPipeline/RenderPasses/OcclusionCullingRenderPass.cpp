@@ -0,0 +1,83 @@
+#include "OcclusionCullingRenderPass.hpp"
+#include "HiZGenerationRenderPass.hpp"
+
+#include <Geometry/HiZPyramid.hpp>
+
+#include <algorithm>
+
+namespace PathFinder
+{
+
+    OcclusionCullingRenderPass::OcclusionCullingRenderPass()
+        : RenderPass("OcclusionCulling") {}
+
+    void OcclusionCullingRenderPass::SetupPipelineStates(PipelineStateCreator* stateCreator, RootSignatureCreator* rootSignatureCreator)
+    {
+        rootSignatureCreator->CreateRootSignature(RootSignatureNames::OcclusionCulling, [](RootSignatureProxy& signatureProxy)
+        {
+            signatureProxy.AddShaderResourceBufferParameter(0, 0); // Hi-Z | t0 - s0
+            signatureProxy.AddShaderResourceBufferParameter(1, 0); // Candidates | t1 - s0
+            signatureProxy.AddShaderResourceBufferParameter(2, 0); // Candidate draw commands | t2 - s0
+            signatureProxy.AddUnorderedAccessBufferParameter(0, 0); // Culled draw commands | u0 - s0
+            signatureProxy.AddUnorderedAccessBufferParameter(1, 0); // Culled batch instance list | u1 - s0
+        });
+
+        stateCreator->CreateComputeState(PSONames::OcclusionCulling, [](ComputeStateProxy& state)
+        {
+            state.ComputeShaderFileName = "OcclusionCulling.hlsl";
+            state.RootSignatureName = RootSignatureNames::OcclusionCulling;
+        });
+    }
+
+    void OcclusionCullingRenderPass::ScheduleResources(ResourceScheduler* scheduler)
+    {
+        scheduler->ReadBuffer(ResourceNames::HiZ, ResourceScheduler::BufferReadContext::ShaderResource);
+        scheduler->NewBuffer(ResourceNames::OcclusionCulledDrawCommands, ResourceScheduler::NewBufferProperties<GPUMeshInstanceDrawCommand>{ mMaxCandidateCount });
+        scheduler->NewBuffer(ResourceNames::OcclusionCulledBatchInstanceList, ResourceScheduler::NewBufferProperties<uint32_t>{ mMaxCandidateCount });
+    }
+
+    void OcclusionCullingRenderPass::Render(RenderContext<RenderPassContentMediator>* context)
+    {
+        auto meshStorage = context->GetContent()->GetSceneGPUStorage();
+
+        if (meshStorage->OcclusionCandidateCount() == 0)
+            return;
+
+        assert_format(meshStorage->OcclusionCandidateCount() <= mMaxCandidateCount, "Occlusion candidates don't fit into culled batch instance list");
+
+        context->GetCommandRecorder()->ApplyPipelineState(PSONames::OcclusionCulling);
+
+        const Geometry::Dimensions& viewportDimensions = context->GetDefaultRenderSurfaceDesc().Dimensions();
+
+        OcclusionCullingCBContent cbContent{};
+        cbContent.ViewportSize = { viewportDimensions.Width, viewportDimensions.Height };
+        cbContent.HiZSize = {
+            Geometry::HiZPyramid::BaseLevelSize(viewportDimensions.Width, HiZGenerationRenderPass::BaseTexelSize),
+            Geometry::HiZPyramid::BaseLevelSize(viewportDimensions.Height, HiZGenerationRenderPass::BaseTexelSize)
+        };
+        cbContent.HiZBaseTexelSize = HiZGenerationRenderPass::BaseTexelSize;
+        cbContent.CandidateCount = meshStorage->OcclusionCandidateCount();
+        cbContent.DrawCommandCount = meshStorage->OcclusionCandidateDrawCommandCount();
+
+        context->GetCommandRecorder()->BindBuffer(ResourceNames::HiZ, 0, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->OcclusionCandidateBuffer(), 1, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->OcclusionCandidateDrawCommandBuffer(), 2, 0, HAL::ShaderRegister::ShaderResource);
+        context->GetCommandRecorder()->BindBuffer(ResourceNames::OcclusionCulledDrawCommands, 0, 0, HAL::ShaderRegister::UnorderedAccess);
+        context->GetCommandRecorder()->BindBuffer(ResourceNames::OcclusionCulledBatchInstanceList, 1, 0, HAL::ShaderRegister::UnorderedAccess);
+
+        // Commands start empty, candidates visible in this frame's Hi-Z are appended to them
+        cbContent.IsResettingDrawCommands = true;
+        context->GetConstantsUpdater()->UpdateRootConstantBuffer(cbContent);
+        context->GetCommandRecorder()->Dispatch(Geometry::Dimensions{ cbContent.DrawCommandCount }, { 64 });
+
+        cbContent.IsResettingDrawCommands = false;
+        context->GetConstantsUpdater()->UpdateRootConstantBuffer(cbContent);
+        context->GetCommandRecorder()->Dispatch(Geometry::Dimensions{ cbContent.CandidateCount }, { 64 });
+    }
+
+    void OcclusionCullingRenderPass::SetMaxCandidateCount(uint32_t count)
+    {
+        mMaxCandidateCount = std::max(count, 1u);
+    }
+
+}
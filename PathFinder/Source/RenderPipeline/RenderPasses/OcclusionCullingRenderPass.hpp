@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../RenderPass.hpp"
+#include "../RenderPassContentMediator.hpp"
+
+#include "PipelineNames.hpp"
+
+#include <glm/vec2.hpp>
+
+namespace PathFinder
+{
+
+    struct OcclusionCullingCBContent
+    {
+        glm::uvec2 ViewportSize;
+        glm::uvec2 HiZSize;
+        uint32_t HiZBaseTexelSize;
+        uint32_t CandidateCount;
+        uint32_t DrawCommandCount;
+        uint32_t IsResettingDrawCommands;
+    };
+
+    /// Second phase of occlusion culling.
+    /// Instances occluded on CPU in an older Hi-Z are tested again with the current camera
+    /// against Hi-Z built from depth of instances that passed the first phase in this frame.
+    /// Visible ones are compacted into draw commands for GBuffer second phase, so nothing is rejected
+    /// only because of a pyramid built from another camera.
+    class OcclusionCullingRenderPass : public RenderPass<RenderPassContentMediator>
+    {
+    public:
+        OcclusionCullingRenderPass();
+        ~OcclusionCullingRenderPass() = default;
+
+        virtual void SetupPipelineStates(PipelineStateCreator* stateCreator, RootSignatureCreator* rootSignatureCreator) override;
+        virtual void ScheduleResources(ResourceScheduler* scheduler) override;
+        virtual void Render(RenderContext<RenderPassContentMediator>* context) override;
+
+        /// Sizes output buffers, which are scheduled before instances of a frame are culled.
+        /// Candidates can't outnumber mesh instances of the scene.
+        void SetMaxCandidateCount(uint32_t count);
+
+    private:
+        uint32_t mMaxCandidateCount = 1;
+    };
+
+}
@@ -25,6 +25,14 @@ namespace PathFinder
         inline Foundation::Name GBufferDepthStencil{ "Resource_GBuffer_Depth_Stencil" };
         inline NameArray<2> GBufferViewDepth{ "Resource_GBuffer_View_Depth[0]", "Resource_GBuffer_View_Depth[1]" };
 
+        // Aliases of GBuffer of the current frame after instances that were occluded only in older Hi-Z are drawn
+        inline Foundation::Name GBufferAlbedoMetalnessSecondPhase{ "Resource_GBuffer_Albedo_Metalness_Second_Phase" };
+        inline Foundation::Name GBufferNormalRoughnessSecondPhase{ "Resource_GBuffer_Normal_Roughness_Second_Phase" };
+        inline Foundation::Name GBufferMotionVectorSecondPhase{ "Resource_GBuffer_Motion_Vector_Second_Phase" };
+        inline Foundation::Name GBufferTypeAndMaterialIndexSecondPhase{ "Resource_GBuffer_Type_And_Material_Index_Second_Phase" };
+        inline Foundation::Name GBufferDepthStencilSecondPhase{ "Resource_GBuffer_Depth_Stencil_Second_Phase" };
+        inline Foundation::Name GBufferViewDepthSecondPhase{ "Resource_GBuffer_View_Depth_Second_Phase" };
+
         inline Foundation::Name ShadingAnalyticOutput{ "Resource_Shading_Analytic_Output" };
 
         inline Foundation::Name StochasticUnshadowedShadingOutput{ "Resource_Shading_Stochastic_Unshadowed_Output" };
@@ -67,6 +75,13 @@ namespace PathFinder
         inline Foundation::Name SMAAAntialiased{ "Resource_SMAA_Antialiased_Image" };
 
         inline Foundation::Name PickedGeometryInfo{ "Resource_Picked_Geometry_Info" };
+
+        inline Foundation::Name HiZ{ "Resource_HiZ" };
+        inline Foundation::Name HiZInfo{ "Resource_HiZ_Info" };
+        inline Foundation::Name OcclusionCulledDrawCommands{ "Resource_Occlusion_Culled_Draw_Commands" };
+        inline Foundation::Name OcclusionCulledBatchInstanceList{ "Resource_Occlusion_Culled_Batch_Instance_List" };
+        inline Foundation::Name MeshletCulledDrawArguments{ "Resource_Meshlet_Culled_Draw_Arguments" };
+        inline Foundation::Name VisibleMeshlets{ "Resource_Visible_Meshlets" };
     }
 
     namespace PSONames
@@ -77,6 +92,7 @@ namespace PathFinder
         inline Foundation::Name Downsampling{ "PSO_AveragingDownsampling" };
         inline Foundation::Name DepthOnly{ "PSO_DepthOnly" };
         inline Foundation::Name GBufferMeshes{ "PSO_GBufferMeshes" };
+        inline Foundation::Name GBufferMeshlets{ "PSO_GBufferMeshlets" };
         inline Foundation::Name GBufferLights{ "PSO_GBufferLights" };
         inline Foundation::Name Shading{ "PSO_Shading" };
         inline Foundation::Name GeometryPicking{ "PSO_GeometryPicking" };
@@ -102,17 +118,30 @@ namespace PathFinder
         inline Foundation::Name HDRBackBufferOutput{ "PSO_HDRBackBufferOutput" };
         inline Foundation::Name UAVClear{ "PSO_UAVClear" };
         inline Foundation::Name BoxBlur{ "PSO_BoxBlur" };
+        inline Foundation::Name HiZGeneration{ "PSO_HiZGeneration" };
+        inline Foundation::Name OcclusionCulling{ "PSO_OcclusionCulling" };
+        inline Foundation::Name MeshletCulling{ "PSO_MeshletCulling" };
     }  
    
     namespace RootSignatureNames
     {
         inline Foundation::Name GBufferMeshes{ "GBuffer_Meshes_Root_Sig" };
+        inline Foundation::Name GBufferMeshlets{ "GBuffer_Meshlets_Root_Sig" };
         inline Foundation::Name GBufferLights{ "GBuffer_Lights_Root_Sig" };
         inline Foundation::Name DeferredLighting{ "Deferred_Lighting_Root_Sig" };
         inline Foundation::Name Shading{ "Shading_Root_Sig" };
         inline Foundation::Name GeometryPicking{ "Geometry_Picking_Root_Sig" };
         inline Foundation::Name UI{ "UI_Root_Sig" };
         inline Foundation::Name DisplacementDistanceMapGeneration{ "Distance_Map_Generation_Root_Sig" };
+        inline Foundation::Name HiZGeneration{ "HiZ_Generation_Root_Sig" };
+        inline Foundation::Name OcclusionCulling{ "Occlusion_Culling_Root_Sig" };
+        inline Foundation::Name MeshletCulling{ "Meshlet_Culling_Root_Sig" };
+    }
+
+    namespace CommandSignatureNames
+    {
+        inline Foundation::Name GBufferMeshes{ "GBuffer_Meshes_Command_Sig" };
+        inline Foundation::Name GBufferMeshlets{ "GBuffer_Meshlets_Command_Sig" };
     }
 
     namespace SamplerNames
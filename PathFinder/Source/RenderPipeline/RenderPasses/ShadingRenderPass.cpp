@@ -34,11 +34,11 @@ namespace PathFinder
         scheduler->NewTexture(ResourceNames::StochasticShadowedShadingOutput);
         scheduler->NewTexture(ResourceNames::StochasticUnshadowedShadingOutput);
         
-        scheduler->ReadTexture(ResourceNames::GBufferAlbedoMetalness);
-        scheduler->ReadTexture(ResourceNames::GBufferNormalRoughness);
-        scheduler->ReadTexture(ResourceNames::GBufferMotionVector);
-        scheduler->ReadTexture(ResourceNames::GBufferTypeAndMaterialIndex);
-        scheduler->ReadTexture(ResourceNames::GBufferDepthStencil);
+        scheduler->ReadTexture(ResourceNames::GBufferAlbedoMetalnessSecondPhase);
+        scheduler->ReadTexture(ResourceNames::GBufferNormalRoughnessSecondPhase);
+        scheduler->ReadTexture(ResourceNames::GBufferMotionVectorSecondPhase);
+        scheduler->ReadTexture(ResourceNames::GBufferTypeAndMaterialIndexSecondPhase);
+        scheduler->ReadTexture(ResourceNames::GBufferDepthStencilSecondPhase);
         scheduler->ReadTexture(ResourceNames::RngSeedsCorrelated);
 
         scheduler->UseRayTracing();
@@ -56,11 +56,11 @@ namespace PathFinder
 
         ShadingCBContent cbContent{};
 
-        cbContent.GBufferIndices.AlbedoMetalnessTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferAlbedoMetalness);
-        cbContent.GBufferIndices.NormalRoughnessTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferNormalRoughness);
-        cbContent.GBufferIndices.MotionTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferMotionVector);
-        cbContent.GBufferIndices.TypeAndMaterialTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferTypeAndMaterialIndex);
-        cbContent.GBufferIndices.DepthStencilTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferDepthStencil);
+        cbContent.GBufferIndices.AlbedoMetalnessTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferAlbedoMetalnessSecondPhase);
+        cbContent.GBufferIndices.NormalRoughnessTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferNormalRoughnessSecondPhase);
+        cbContent.GBufferIndices.MotionTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferMotionVectorSecondPhase);
+        cbContent.GBufferIndices.TypeAndMaterialTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferTypeAndMaterialIndexSecondPhase);
+        cbContent.GBufferIndices.DepthStencilTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferDepthStencilSecondPhase);
         cbContent.BlueNoiseTexIdx = blueNoiseTexture->GetSRDescriptor()->IndexInHeapRange();
         cbContent.AnalyticOutputTexIdx = resourceProvider->GetUATextureIndex(ResourceNames::ShadingAnalyticOutput);
         cbContent.StochasticShadowedOutputTexIdx = resourceProvider->GetUATextureIndex(ResourceNames::StochasticShadowedShadingOutput);
@@ -21,10 +21,10 @@ namespace PathFinder
         auto previousFrameIndex = (scheduler->FrameNumber() - 1) % 2;
         auto currentFrameIndex = scheduler->FrameNumber() % 2;
 
-        scheduler->ReadTexture(ResourceNames::GBufferNormalRoughness);
-        scheduler->ReadTexture(ResourceNames::GBufferMotionVector);
-        scheduler->ReadTexture(ResourceNames::GBufferDepthStencil);
-        scheduler->ReadTexture(ResourceNames::GBufferViewDepth[currentFrameIndex]);
+        scheduler->ReadTexture(ResourceNames::GBufferNormalRoughnessSecondPhase);
+        scheduler->ReadTexture(ResourceNames::GBufferMotionVectorSecondPhase);
+        scheduler->ReadTexture(ResourceNames::GBufferDepthStencilSecondPhase);
+        scheduler->ReadTexture(ResourceNames::GBufferViewDepthSecondPhase);
         scheduler->ReadTexture(ResourceNames::DenoiserReprojectedFramesCount[currentFrameIndex]);
         scheduler->ReadTexture(ResourceNames::StochasticShadowedShadingReprojected);
         scheduler->ReadTexture(ResourceNames::StochasticUnshadowedShadingReprojected);
@@ -55,10 +55,10 @@ namespace PathFinder
 
         SpecularDenoiserCBContent cbContent{};
 
-        cbContent.GBufferIndices.NormalRoughnessTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferNormalRoughness);
-        cbContent.GBufferIndices.MotionTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferMotionVector);
-        cbContent.GBufferIndices.DepthStencilTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferDepthStencil);
-        cbContent.GBufferIndices.ViewDepthTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferViewDepth[currentFrameIndex]);
+        cbContent.GBufferIndices.NormalRoughnessTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferNormalRoughnessSecondPhase);
+        cbContent.GBufferIndices.MotionTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferMotionVectorSecondPhase);
+        cbContent.GBufferIndices.DepthStencilTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferDepthStencilSecondPhase);
+        cbContent.GBufferIndices.ViewDepthTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::GBufferViewDepthSecondPhase);
         cbContent.DispatchGroupCount = { groupCount.Width, groupCount.Height };
         cbContent.AccumulatedFramesCountTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::DenoiserReprojectedFramesCount[currentFrameIndex]);
         cbContent.CurrentShadowedShadingTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::StochasticShadowedShadingFixed);
@@ -0,0 +1,242 @@
+#include "ShaderBinaryCache.hpp"
+
+#include <Foundation/FileWriting.hpp>
+
+#include <robinhood/robin_hood.h>
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iterator>
+#include <cstring>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+        void Append(std::vector<uint8_t>& content, const void* data, uint64_t size)
+        {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+            content.insert(content.end(), bytes, bytes + size);
+        }
+
+        template <class T>
+        void AppendValue(std::vector<uint8_t>& content, const T& value)
+        {
+            Append(content, &value, sizeof(T));
+        }
+
+        void AppendBytes(std::vector<uint8_t>& content, const void* data, uint64_t size)
+        {
+            AppendValue(content, size);
+            Append(content, data, size);
+        }
+
+        // Reads entry contents back, fails instead of reading past the end
+        class ContentReader
+        {
+        public:
+            ContentReader(const std::vector<uint8_t>& content) : mContent{ content } {}
+
+            template <class T>
+            bool ReadValue(T& value)
+            {
+                return Read(&value, sizeof(T));
+            }
+
+            bool ReadBytes(std::vector<uint8_t>& bytes)
+            {
+                uint64_t size = 0;
+                if (!ReadValue(size) || size > mContent.size() - mOffset) return false;
+
+                bytes.assign(mContent.begin() + mOffset, mContent.begin() + mOffset + size);
+                mOffset += size;
+                return true;
+            }
+
+            bool ReadString(std::string& string)
+            {
+                std::vector<uint8_t> bytes;
+                if (!ReadBytes(bytes)) return false;
+
+                string.assign(bytes.begin(), bytes.end());
+                return true;
+            }
+
+            bool IsAtEnd() const { return mOffset == mContent.size(); }
+
+        private:
+            bool Read(void* destination, uint64_t size)
+            {
+                if (size > mContent.size() - mOffset) return false;
+
+                std::memcpy(destination, mContent.data() + mOffset, size);
+                mOffset += size;
+                return true;
+            }
+
+            const std::vector<uint8_t>& mContent;
+            uint64_t mOffset = 0;
+        };
+    }
+
+    ShaderBinaryCache::ShaderBinaryCache(const std::filesystem::path& cacheFolder)
+        : mCacheFolder{ cacheFolder } {}
+
+    std::optional<ShaderBinaryCache::Entry> ShaderBinaryCache::Load(const Key& key, const std::filesystem::path& sourceFolder) const
+    {
+        std::ifstream stream{ EntryPath(key), std::ios::binary };
+
+        if (!stream)
+        {
+            return std::nullopt;
+        }
+
+        EntryHeader header;
+        stream.read(reinterpret_cast<char*>(&header), sizeof(EntryHeader));
+
+        bool isHeaderValid = stream &&
+            header.Magic == EntryMagic &&
+            header.Version == CacheVersion &&
+            header.KeyHash == KeyHash(key);
+
+        if (!isHeaderValid)
+        {
+            return std::nullopt;
+        }
+
+        std::vector<uint8_t> content{ std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+
+        if (content.size() != header.ContentSize || robin_hood::hash_bytes(content.data(), content.size()) != header.ContentHash)
+        {
+            return std::nullopt;
+        }
+
+        ContentReader reader{ content };
+        Entry entry;
+        uint64_t fileCount = 0;
+
+        if (!reader.ReadValue(fileCount))
+        {
+            return std::nullopt;
+        }
+
+        for (uint64_t file = 0; file < fileCount; ++file)
+        {
+            std::string relativePath;
+            uint64_t storedHash = 0;
+
+            if (!reader.ReadString(relativePath) || !reader.ReadValue(storedHash))
+            {
+                return std::nullopt;
+            }
+
+            // Any changed or missing file makes the entry outdated
+            std::optional<uint64_t> currentHash = FileHash(sourceFolder / relativePath);
+
+            if (!currentHash || *currentHash != storedHash)
+            {
+                return std::nullopt;
+            }
+
+            entry.CompiledFileRelativePaths.push_back(std::move(relativePath));
+        }
+
+        bool isRead = reader.ReadString(entry.DebugName) &&
+            reader.ReadBytes(entry.Binary) &&
+            reader.ReadBytes(entry.PDBBinary) &&
+            reader.IsAtEnd();
+
+        if (!isRead || entry.Binary.empty())
+        {
+            return std::nullopt;
+        }
+
+        return entry;
+    }
+
+    void ShaderBinaryCache::Store(const Key& key, const std::filesystem::path& sourceFolder, const Entry& entry) const
+    {
+        std::vector<uint8_t> content;
+        content.reserve(entry.Binary.size() + entry.PDBBinary.size() + 1024);
+
+        AppendValue(content, uint64_t(entry.CompiledFileRelativePaths.size()));
+
+        for (const std::string& relativePath : entry.CompiledFileRelativePaths)
+        {
+            std::optional<uint64_t> fileHash = FileHash(sourceFolder / relativePath);
+
+            if (!fileHash)
+            {
+                return;
+            }
+
+            AppendBytes(content, relativePath.data(), relativePath.size());
+            AppendValue(content, *fileHash);
+        }
+
+        AppendBytes(content, entry.DebugName.data(), entry.DebugName.size());
+        AppendBytes(content, entry.Binary.data(), entry.Binary.size());
+        AppendBytes(content, entry.PDBBinary.data(), entry.PDBBinary.size());
+
+        EntryHeader header;
+        header.KeyHash = KeyHash(key);
+        header.ContentSize = content.size();
+        header.ContentHash = robin_hood::hash_bytes(content.data(), content.size());
+
+        // Entries are replaced only once they're written in full
+        Foundation::WriteFileAtomically(EntryPath(key), [&header, &content](std::ostream& stream)
+        {
+            stream.write(reinterpret_cast<const char*>(&header), sizeof(EntryHeader));
+            stream.write(reinterpret_cast<const char*>(content.data()), content.size());
+        });
+    }
+
+    uint64_t ShaderBinaryCache::KeyHash(const Key& key)
+    {
+        std::vector<uint8_t> keyBytes;
+        std::string sourcePath = key.SourceRelativePath.generic_string();
+
+        AppendBytes(keyBytes, sourcePath.data(), sourcePath.size());
+        AppendBytes(keyBytes, key.EntryPoint.data(), key.EntryPoint.size());
+        AppendValue(keyBytes, key.Stage);
+        AppendValue(keyBytes, uint8_t(key.IsLibrary));
+        AppendValue(keyBytes, uint8_t(key.DebugBuild));
+        AppendValue(keyBytes, uint8_t(key.SeparatePDB));
+        AppendBytes(keyBytes, key.TargetProfile.data(), key.TargetProfile.size());
+        AppendBytes(keyBytes, key.CompilerVersion.data(), key.CompilerVersion.size());
+
+        return robin_hood::hash_bytes(keyBytes.data(), keyBytes.size());
+    }
+
+    std::optional<uint64_t> ShaderBinaryCache::FileHash(const std::filesystem::path& path)
+    {
+        std::ifstream stream{ path, std::ios::binary };
+
+        if (!stream)
+        {
+            return std::nullopt;
+        }
+
+        std::string contents{ std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+        return robin_hood::hash_bytes(contents.data(), contents.size());
+    }
+
+    std::filesystem::path ShaderBinaryCache::EntryPath(const Key& key) const
+    {
+        // Readable part of the name is for convenience only, the hash tells entries apart
+        std::stringstream fileName;
+        fileName << key.SourceRelativePath.stem().string();
+
+        if (!key.IsLibrary)
+        {
+            fileName << "_" << key.EntryPoint;
+        }
+
+        fileName << "." << std::hex << std::setfill('0') << std::setw(16) << KeyHash(key) << ".shadercache";
+
+        return mCacheFolder / fileName.str();
+    }
+
+}
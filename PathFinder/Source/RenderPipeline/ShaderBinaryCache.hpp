@@ -0,0 +1,79 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Keeps compiled shader and library binaries on disk between runs, so that unchanged sources skip compilation.
+    /// An entry remembers every file that took part in compilation with a hash of its contents
+    /// and is only loaded while all of them are unchanged. Entries are checked against a hash of their whole contents,
+    /// so partially written or damaged ones are treated as missing.
+    class ShaderBinaryCache
+    {
+    public:
+        struct Key
+        {
+            std::filesystem::path SourceRelativePath;
+
+            // Libraries have neither entry points nor stages
+            std::string EntryPoint;
+            uint32_t Stage = 0;
+            bool IsLibrary = false;
+
+            bool DebugBuild = false;
+            bool SeparatePDB = false;
+
+            // Binaries of other profiles or compiler builds are never loaded
+            std::string TargetProfile;
+            std::string CompilerVersion;
+        };
+
+        struct Entry
+        {
+            std::vector<uint8_t> Binary;
+            std::vector<uint8_t> PDBBinary;
+            std::string DebugName;
+
+            // Relative to the folder of the entry point file, the entry point file included
+            std::vector<std::string> CompiledFileRelativePaths;
+        };
+
+        ShaderBinaryCache(const std::filesystem::path& cacheFolder);
+
+        /// Returns nothing if the cache has no entry for the key, any file it was compiled from changed or the entry is damaged
+        std::optional<Entry> Load(const Key& key, const std::filesystem::path& sourceFolder) const;
+
+        /// Hashes compiled files as they are now, so it should be called right after compilation.
+        /// Failing to write an entry is not an error, the shader is compiled again next time.
+        void Store(const Key& key, const std::filesystem::path& sourceFolder, const Entry& entry) const;
+
+    private:
+        // Incremented on every change of the entry layout or of compiler settings that keys don't capture
+        inline static const uint32_t CacheVersion = 2;
+        inline static const uint32_t EntryMagic = 0x43535046; // 'PFSC'
+
+        struct EntryHeader
+        {
+            uint32_t Magic = EntryMagic;
+            uint32_t Version = CacheVersion;
+            uint64_t KeyHash = 0;
+            uint64_t ContentSize = 0;
+            uint64_t ContentHash = 0;
+        };
+
+        static uint64_t KeyHash(const Key& key);
+
+        // Returns nothing for files that can't be read
+        static std::optional<uint64_t> FileHash(const std::filesystem::path& path);
+
+        std::filesystem::path EntryPath(const Key& key) const;
+
+        std::filesystem::path mCacheFolder;
+    };
+
+}
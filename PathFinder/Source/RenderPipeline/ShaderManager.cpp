@@ -13,7 +13,8 @@ namespace PathFinder
         mBuildDebugShaders{ buildDebugShaders },
         mOutputPDBInSeparateFiles{ separatePDBFiles },
         mExecutableFolderPath{ executableFolder }, 
-        mAftermathShaderDatabase{ aftermathShaderDatabase }
+        mAftermathShaderDatabase{ aftermathShaderDatabase },
+        mBinaryCache{ executableFolder / "CompiledShaders" / "Cache" }
     {
         mShaderSourceRootPath = mUseProjectDirShaders ? 
             std::filesystem::path{ std::string(PROJECT_DIR) + "Source\\RenderPipeline\\Shaders" } :
@@ -108,26 +109,52 @@ namespace PathFinder
     HAL::Shader* ShaderManager::LoadAndCacheShader(HAL::Shader::Stage pipelineStage, const std::string& entryPoint, const std::filesystem::path& relativePath)
     {
         auto fullPath = mShaderSourceRootPath / relativePath;
+        auto startTime = std::chrono::steady_clock::now();
 
-        HAL::ShaderCompiler::ShaderCompilationResult compilationResult = mCompiler.CompileShader(fullPath, pipelineStage, entryPoint, mBuildDebugShaders, mOutputPDBInSeparateFiles);
-        
-        if (!compilationResult.CompiledShader.Blob())
+        ShaderBinaryCache::Key cacheKey = BinaryCacheKey(relativePath, entryPoint, pipelineStage);
+        std::optional<ShaderBinaryCache::Entry> cacheEntry = mBinaryCache.Load(cacheKey, fullPath.parent_path());
+        std::optional<HAL::ShaderCompiler::ShaderCompilationResult> compilationResult;
+
+        if (cacheEntry)
         {
-            return nullptr;
+            compilationResult = HAL::ShaderCompiler::ShaderCompilationResult{
+                HAL::Shader{ mCompiler.CreateBlob(cacheEntry->Binary), mCompiler.CreateBlob(cacheEntry->PDBBinary), entryPoint, pipelineStage },
+                std::move(cacheEntry->CompiledFileRelativePaths) };
+
+            compilationResult->CompiledShader.SetDebugName(cacheEntry->DebugName);
+        }
+        else
+        {
+            compilationResult = mCompiler.CompileShader(fullPath, pipelineStage, entryPoint, mBuildDebugShaders, mOutputPDBInSeparateFiles);
+
+            if (!compilationResult->CompiledShader.Blob())
+            {
+                return nullptr;
+            }
+
+            const HAL::Shader& shader = compilationResult->CompiledShader;
+            mBinaryCache.Store(cacheKey, fullPath.parent_path(), BinaryCacheEntry(shader.Binary(), shader.PDBBinary(), shader.DebugName(), compilationResult->CompiledFileRelativePaths));
         }
 
-        mAftermathShaderDatabase->AddShader(compilationResult.CompiledShader);
-        mShaders.emplace_back(std::move(compilationResult.CompiledShader));
+        UpdateStatistics(cacheEntry.has_value(), startTime);
+
+        mAftermathShaderDatabase->AddShader(compilationResult->CompiledShader);
+        mShaders.emplace_back(std::move(compilationResult->CompiledShader));
         
         std::string relativePathString = relativePath.filename().string();
         ShaderListIterator shaderIt = std::prev(mShaders.end());
-        SaveToFile(shaderIt->Binary(), shaderIt->PDBBinary(), shaderIt->EntryPoint(), shaderIt->DebugName(), relativePath);
+
+        // Binaries loaded from the cache were saved when they were compiled
+        if (!cacheEntry)
+        {
+            SaveToFile(shaderIt->Binary(), shaderIt->PDBBinary(), shaderIt->EntryPoint(), shaderIt->DebugName(), relativePath);
+        }
         
         // Associate shader with a file it was loaded from and its entry point name
         CompiledObjectsInFile& compiledObjectsInFile = mEntryPointFilePathToCompiledObjectAssociations[relativePathString];
         compiledObjectsInFile.Shaders[shaderIt->EntryPointName()] = shaderIt;
 
-        for (auto& shaderFilePath : compilationResult.CompiledFileRelativePaths)
+        for (auto& shaderFilePath : compilationResult->CompiledFileRelativePaths)
         {
             // Associate every file that took place in compilation with the root file that has shader's entry point
             mIncludedFilePathToEntryPointFilePathAssociations[shaderFilePath].insert(relativePathString);
@@ -174,25 +201,50 @@ namespace PathFinder
     HAL::Library* ShaderManager::LoadAndCacheLibrary(const std::filesystem::path& relativePath)
     {
         auto fullPath = mShaderSourceRootPath / relativePath;
+        auto startTime = std::chrono::steady_clock::now();
 
-        HAL::ShaderCompiler::LibraryCompilationResult compilationResult = mCompiler.CompileLibrary(fullPath, mBuildDebugShaders, mOutputPDBInSeparateFiles);
+        ShaderBinaryCache::Key cacheKey = BinaryCacheKey(relativePath, "", std::nullopt);
+        std::optional<ShaderBinaryCache::Entry> cacheEntry = mBinaryCache.Load(cacheKey, fullPath.parent_path());
+        std::optional<HAL::ShaderCompiler::LibraryCompilationResult> compilationResult;
 
-        if (!compilationResult.CompiledLibrary.Blob())
+        if (cacheEntry)
         {
-            return nullptr;
+            compilationResult = HAL::ShaderCompiler::LibraryCompilationResult{
+                HAL::Library{ mCompiler.CreateBlob(cacheEntry->Binary), mCompiler.CreateBlob(cacheEntry->PDBBinary) },
+                std::move(cacheEntry->CompiledFileRelativePaths) };
+
+            compilationResult->CompiledLibrary.SetDebugName(cacheEntry->DebugName);
+        }
+        else
+        {
+            compilationResult = mCompiler.CompileLibrary(fullPath, mBuildDebugShaders, mOutputPDBInSeparateFiles);
+
+            if (!compilationResult->CompiledLibrary.Blob())
+            {
+                return nullptr;
+            }
+
+            const HAL::Library& library = compilationResult->CompiledLibrary;
+            mBinaryCache.Store(cacheKey, fullPath.parent_path(), BinaryCacheEntry(library.Binary(), library.PDBBinary(), library.DebugName(), compilationResult->CompiledFileRelativePaths));
         }
 
-        mAftermathShaderDatabase->AddLibrary(compilationResult.CompiledLibrary);
-        mLibraries.emplace_back(std::move(compilationResult.CompiledLibrary));
+        UpdateStatistics(cacheEntry.has_value(), startTime);
+
+        mAftermathShaderDatabase->AddLibrary(compilationResult->CompiledLibrary);
+        mLibraries.emplace_back(std::move(compilationResult->CompiledLibrary));
 
         std::string relativePathString = relativePath.filename().string();
         LibraryListIterator libraryIt = std::prev(mLibraries.end());
-        SaveToFile(libraryIt->Binary(), libraryIt->PDBBinary(), "", libraryIt->DebugName(), relativePath);
+
+        if (!cacheEntry)
+        {
+            SaveToFile(libraryIt->Binary(), libraryIt->PDBBinary(), "", libraryIt->DebugName(), relativePath);
+        }
 
         CompiledObjectsInFile& compiledObjectsInFile = mEntryPointFilePathToCompiledObjectAssociations[relativePathString];
         compiledObjectsInFile.Library = libraryIt;
 
-        for (auto& shaderFilePath : compilationResult.CompiledFileRelativePaths)
+        for (auto& shaderFilePath : compilationResult->CompiledFileRelativePaths)
         {
             mIncludedFilePathToEntryPointFilePathAssociations[shaderFilePath].insert(relativePathString);
         }
@@ -200,6 +252,57 @@ namespace PathFinder
         return &(*libraryIt);
     }
 
+    ShaderBinaryCache::Key ShaderManager::BinaryCacheKey(const std::filesystem::path& relativePath, const std::string& entryPoint, std::optional<HAL::Shader::Stage> pipelineStage) const
+    {
+        ShaderBinaryCache::Key key;
+        key.SourceRelativePath = relativePath;
+        key.EntryPoint = entryPoint;
+        key.Stage = pipelineStage ? uint32_t(*pipelineStage) : 0;
+        key.IsLibrary = !pipelineStage;
+        key.DebugBuild = mBuildDebugShaders;
+        key.SeparatePDB = mOutputPDBInSeparateFiles;
+        key.CompilerVersion = mCompiler.CompilerVersion();
+        key.TargetProfile = pipelineStage ?
+            HAL::ShaderCompiler::ProfileString(*pipelineStage, HAL::ShaderCompiler::TargetProfile) :
+            HAL::ShaderCompiler::LibProfileString(HAL::ShaderCompiler::TargetProfile);
+        return key;
+    }
+
+    ShaderBinaryCache::Entry ShaderManager::BinaryCacheEntry(
+        const HAL::CompiledBinary& binary,
+        const HAL::CompiledBinary& debugBinary,
+        const std::string& debugName,
+        const std::vector<std::string>& compiledFileRelativePaths)
+    {
+        ShaderBinaryCache::Entry entry;
+        entry.Binary.assign(binary.Data, binary.Data + binary.Size);
+        entry.DebugName = debugName;
+        entry.CompiledFileRelativePaths = compiledFileRelativePaths;
+
+        if (debugBinary.Data)
+        {
+            entry.PDBBinary.assign(debugBinary.Data, debugBinary.Data + debugBinary.Size);
+        }
+
+        return entry;
+    }
+
+    void ShaderManager::UpdateStatistics(bool isLoadedFromCache, std::chrono::steady_clock::time_point startTime)
+    {
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+        if (isLoadedFromCache)
+        {
+            mStatistics.CachedObjectCount += 1;
+            mStatistics.CacheLoadTime += duration;
+        }
+        else
+        {
+            mStatistics.CompiledObjectCount += 1;
+            mStatistics.CompilationTime += duration;
+        }
+    }
+
     void ShaderManager::SaveToFile(
         const HAL::CompiledBinary& binary,
         const HAL::CompiledBinary& debugBinary,
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ShaderBinaryCache.hpp"
+
 #include <HardwareAbstractionLayer/Shader.hpp>
 #include <HardwareAbstractionLayer/ShaderCompiler.hpp>
 #include <IO/CommandLineParser.hpp>
@@ -12,6 +14,8 @@
 #include <unordered_set>
 #include <filesystem>
 #include <functional>
+#include <optional>
+#include <chrono>
 #include <filewatch/FileWatcher.h>
 
 namespace PathFinder
@@ -23,6 +27,17 @@ namespace PathFinder
         using ShaderEvent = Foundation::Event<ShaderManager, std::string, void(const HAL::Shader*, const HAL::Shader*)>;
         using LibraryEvent = Foundation::Event<ShaderManager, std::string, void(const HAL::Library*, const HAL::Library*)>;
 
+        struct Statistics
+        {
+            // Shaders and libraries, recompiled ones included
+            uint32_t CompiledObjectCount = 0;
+            uint32_t CachedObjectCount = 0;
+
+            // Compilation time with a cold cache, load time with a warm one
+            std::chrono::microseconds CompilationTime{ 0 };
+            std::chrono::microseconds CacheLoadTime{ 0 };
+        };
+
         ShaderManager(const std::filesystem::path& executableFolder, bool useProjectDirShaders, bool buildDebugShaders, bool separatePDBFiles, AftermathShaderDatabase* aftermathShaderDatabase);
 
         HAL::Shader* LoadShader(HAL::Shader::Stage pipelineStage, const std::string& entryPoint, const std::filesystem::path& relativePath);
@@ -50,6 +65,17 @@ namespace PathFinder
         HAL::Library* FindCachedLibrary(const std::filesystem::path& relativePath);
         HAL::Library* LoadAndCacheLibrary(const std::filesystem::path& relativePath);
 
+        // Libraries have no entry points and stages
+        ShaderBinaryCache::Key BinaryCacheKey(const std::filesystem::path& relativePath, const std::string& entryPoint, std::optional<HAL::Shader::Stage> pipelineStage) const;
+
+        static ShaderBinaryCache::Entry BinaryCacheEntry(
+            const HAL::CompiledBinary& binary,
+            const HAL::CompiledBinary& debugBinary,
+            const std::string& debugName,
+            const std::vector<std::string>& compiledFileRelativePaths);
+
+        void UpdateStatistics(bool isLoadedFromCache, std::chrono::steady_clock::time_point startTime);
+
         void SaveToFile(
             const HAL::CompiledBinary& binary, 
             const HAL::CompiledBinary& debugBinary, 
@@ -66,6 +92,7 @@ namespace PathFinder
         AftermathShaderDatabase* mAftermathShaderDatabase = nullptr;
         FW::FileWatcher mFileWatcher;
         HAL::ShaderCompiler mCompiler;
+        ShaderBinaryCache mBinaryCache;
 
         bool mUseProjectDirShaders = false;
         bool mBuildDebugShaders = false;
@@ -84,8 +111,11 @@ namespace PathFinder
 
         ShaderEvent mShaderRecompilationEvent;
         LibraryEvent mLibraryRecompilationEvent;
+        Statistics mStatistics;
 
     public:
+        inline const auto& GetStatistics() const { return mStatistics; }
+
         inline ShaderEvent& ShaderRecompilationEvent() { return mShaderRecompilationEvent; }
         inline LibraryEvent& LibraryRecompilationEvent() { return mLibraryRecompilationEvent; }
     };
@@ -0,0 +1,146 @@
+#ifndef _GBufferMeshCommon__
+#define _GBufferMeshCommon__
+
+// Vertex transformation and pixel shading shared by batched and meshlet GBuffer draws.
+// Expects MandatoryEntryPointInclude.hlsl to be included by the entry point file.
+
+#include "GBuffer.hlsl"
+#include "ColorConversion.hlsl"
+#include "Vertices.hlsl"
+#include "Geometry.hlsl"
+#include "Matrix.hlsl"
+#include "Mesh.hlsl"
+
+StructuredBuffer<Vertex1P1N1UV1T1BT> UnifiedVertexBuffer : register(t0);
+StructuredBuffer<MeshInstance> InstanceTable : register(t2);
+StructuredBuffer<Material> MaterialTable : register(t3);
+StructuredBuffer<Vertex1P1N1UV1T1BTPacked> UnifiedPackedVertexBuffer : register(t5);
+
+//------------------------  Vertex  ------------------------------//
+
+struct VertexOut
+{
+    float4 Position : SV_POSITION;
+    float3 CurrWorldPos : CURR_WORLD_POS;
+    float3 PrevWorldPos : PREV_WORLD_POS;
+    float ViewDepth : VIEW_DEPTH;
+    float2 UV : TEXCOORD0;
+    float3x3 TBN : TBN_MATRIX;
+    nointerpolation uint InstanceTableIndex : INSTANCE_TABLE_INDEX;
+};
+
+float3x3 BuildTBNMatrix(Vertex1P1N1UV1T1BT vertex, MeshInstance instanceData)
+{
+    float3 N = mul(instanceData.NormalMatrix, float4(normalize(vertex.Normal), 0.0)).xyz;
+    float3 T = mul(instanceData.NormalMatrix, float4(normalize(vertex.Tangent), 0.0)).xyz;
+    float3 B = normalize(cross(N, T));
+
+    return Matrix3x3ColumnMajor(T, B, N);
+}
+
+Vertex1P1N1UV1T1BT LoadVertex(MeshInstance instanceData, uint vertexIndex)
+{
+    if (instanceData.PackedVertexBufferOffset == MeshNoPackedVertices)
+    {
+        return UnifiedVertexBuffer[instanceData.UnifiedVertexBufferOffset + vertexIndex];
+    }
+
+    Vertex1P1N1UV1T1BTPacked packed = UnifiedPackedVertexBuffer[instanceData.PackedVertexBufferOffset + vertexIndex];
+    return UnpackVertex(packed, instanceData.PackedVertexBoundsMin, instanceData.PackedVertexBoundsMax);
+}
+
+VertexOut TransformMeshVertex(Vertex1P1N1UV1T1BT vertex, MeshInstance instanceData, uint instanceTableIndex)
+{
+    VertexOut vout;
+
+    float4 prevWSPosition = mul(instanceData.PrevModelMatrix, vertex.Position);
+    float4 WSPosition = mul(instanceData.ModelMatrix, vertex.Position);
+    float4 CSPosition = mul(FrameDataCB.CurrentFrameCamera.View, WSPosition);
+    float4 ClipSPosition = mul(FrameDataCB.CurrentFrameCamera.Projection, CSPosition);
+
+    vout.Position = ClipSPosition;
+    vout.CurrWorldPos = WSPosition.xyz;
+    vout.PrevWorldPos = prevWSPosition.xyz;
+    vout.ViewDepth = CSPosition.z;
+    vout.UV = vertex.UV;
+    vout.TBN = BuildTBNMatrix(vertex, instanceData);
+    vout.InstanceTableIndex = instanceTableIndex;
+
+    return vout;
+}
+
+//------------------------  Pixel  ------------------------------//
+
+// Maps may be slices of texture arrays shared by several materials
+float4 SampleMaterialMap(uint textureIndex, uint arraySlice, float2 uv)
+{
+    if (arraySlice == MaterialNoArraySlice)
+    {
+        return Textures2D[textureIndex].Sample(AnisotropicClampSampler(), uv);
+    }
+
+    return Texture2DArrays[textureIndex].Sample(AnisotropicClampSampler(), float3(uv, arraySlice));
+}
+
+float3 FetchAlbedoMap(VertexOut vertex, Material material)
+{
+    return SRGBToLinear(SampleMaterialMap(material.AlbedoMapIndex, material.AlbedoMapSlice, vertex.UV).rgb);
+}
+
+float3 FetchNormalMap(VertexOut vertex, Material material)
+{
+    // Cooked normal maps are two channel, Z is reconstructed for all maps alike
+    float2 normalXY = SampleMaterialMap(material.NormalMapIndex, material.NormalMapSlice, vertex.UV).xy * 2.0 - 1.0;
+    float3 normal = float3(normalXY, sqrt(saturate(1.0 - dot(normalXY, normalXY))));
+
+    return normalize(mul(vertex.TBN, normal));
+}
+
+float FetchMetallnessMap(VertexOut vertex, Material material)
+{
+    return SampleMaterialMap(material.MetalnessMapIndex, material.MetalnessMapSlice, vertex.UV).r;
+}
+
+float FetchRoughnessMap(VertexOut vertex, Material material)
+{
+    return SampleMaterialMap(material.RoughnessMapIndex, material.RoughnessMapSlice, vertex.UV).r;
+}
+
+float FetchAOMap(VertexOut vertex, Material material)
+{
+    return SampleMaterialMap(material.AOMapIndex, material.AOMapSlice, vertex.UV).r;
+}
+
+float FetchDisplacementMap(VertexOut vertex, Material material)
+{
+    Texture2D displacementMap = Textures2D[material.DisplacementMapIndex];
+    return displacementMap.Sample(AnisotropicClampSampler(), vertex.UV).r;
+}
+
+GBufferPixelOut PSMain(VertexOut pin)
+{
+    MeshInstance instanceData = InstanceTable[pin.InstanceTableIndex];
+    Material material = MaterialTable[instanceData.MaterialIndex];
+
+    float3 normal = instanceData.HasTangentSpace ?
+        FetchNormalMap(pin, material) :
+        normalize(float3(pin.TBN[0][2], pin.TBN[1][2], pin.TBN[2][2]));
+
+    GBufferPixelOut pixelOut = GetStandardGBufferPixelOutput(
+        FetchAlbedoMap(pin, material),
+        FetchMetallnessMap(pin, material),
+        FetchRoughnessMap(pin, material),
+        normal,
+        pin.CurrWorldPos - pin.PrevWorldPos,
+        instanceData.MaterialIndex,
+        pin.ViewDepth
+    );
+
+    //DebugOut(123.0, pin.Position.xy, uint2(1000, 500));
+    //DebugOut(566.0, pin.Position.xy, uint2(1000, 500));
+    //DebugOut(2548.1234, pin.Position.xy, uint2(1000, 500));
+
+    return pixelOut;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef _GBufferMeshlets__
+#define _GBufferMeshlets__
+
+#include "MandatoryEntryPointInclude.hlsl"
+#include "GBufferMeshCommon.hlsl"
+#include "Meshlet.hlsl"
+
+struct VisibleMeshlet
+{
+    uint InstanceTableIndex;
+    uint MeshletTableIndex;
+};
+
+StructuredBuffer<uint> UnifiedMeshletVertexIndexBuffer : register(t1);
+StructuredBuffer<VisibleMeshlet> VisibleMeshlets : register(t4);
+StructuredBuffer<Meshlet> MeshletTable : register(t6);
+StructuredBuffer<uint> UnifiedMeshletTriangleBuffer : register(t7);
+
+// Every instance is a meshlet that survived culling, drawn with vertices enough for the largest meshlet
+VertexOut VSMain(uint vertexId : SV_VertexID, uint instanceId : SV_InstanceID)
+{
+    VisibleMeshlet visibleMeshlet = VisibleMeshlets[instanceId];
+    Meshlet meshlet = MeshletTable[visibleMeshlet.MeshletTableIndex];
+    MeshInstance instanceData = InstanceTable[visibleMeshlet.InstanceTableIndex];
+
+    uint triangleIdx = vertexId / 3;
+
+    // Vertices of triangles the meshlet doesn't have collapse into a point and are never rasterized
+    if (triangleIdx >= meshlet.TriangleCount)
+    {
+        VertexOut vout = (VertexOut)0;
+        vout.Position = float4(0.0, 0.0, 0.0, 1.0);
+        return vout;
+    }
+
+    uint3 triangleVertices = UnpackMeshletTriangle(UnifiedMeshletTriangleBuffer[meshlet.TriangleOffset + triangleIdx]);
+    uint localVertexIdx = triangleVertices[vertexId % 3];
+    uint vertexIdx = UnifiedMeshletVertexIndexBuffer[meshlet.VertexOffset + localVertexIdx];
+    Vertex1P1N1UV1T1BT vertex = LoadVertex(instanceData, vertexIdx);
+
+    return TransformMeshVertex(vertex, instanceData, visibleMeshlet.InstanceTableIndex);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef _HiZ__
+#define _HiZ__
+
+// Hi-Z levels are kept one after another in a single buffer, from the base level down to a single texel,
+// every level is half the size of the previous one rounded up, same as Geometry::HiZPyramid levels on CPU
+
+uint2 HiZLevelSize(uint2 baseLevelSize, uint level)
+{
+    uint2 size = baseLevelSize;
+
+    for (uint i = 0; i < level; ++i)
+    {
+        size = (size + 1) / 2;
+    }
+
+    return size;
+}
+
+uint HiZLevelOffset(uint2 baseLevelSize, uint level)
+{
+    uint offset = 0;
+    uint2 size = baseLevelSize;
+
+    for (uint i = 0; i < level; ++i)
+    {
+        offset += size.x * size.y;
+        size = (size + 1) / 2;
+    }
+
+    return offset;
+}
+
+uint HiZLevelCount(uint2 baseLevelSize)
+{
+    uint count = 1;
+    uint2 size = baseLevelSize;
+
+    while (any(size > 1))
+    {
+        size = (size + 1) / 2;
+        ++count;
+    }
+
+    return count;
+}
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef _HiZGeneration__
+#define _HiZGeneration__
+
+struct PassData
+{
+    uint ViewDepthTexIdx;
+    uint BaseTexelSize;
+    uint2 ViewportSize;
+    uint2 HiZSize;
+    uint FrameNumber;
+    uint Level;
+};
+
+#define PassDataType PassData
+
+#include "MandatoryEntryPointInclude.hlsl"
+#include "HiZ.hlsl"
+
+struct HiZInfo
+{
+    float4x4 View;
+    float4x4 ViewProjection;
+    uint2 ViewportSize;
+    uint2 Size;
+    uint BaseTexelSize;
+    uint FrameNumber;
+};
+
+RWStructuredBuffer<float> HiZ : register(u0, space0);
+RWStructuredBuffer<HiZInfo> HiZInfoBuffer : register(u1, space0);
+
+static const int GroupDimensionSize = 8;
+
+// Levels above the base one keep the farthest depth of 2x2 texels of the previous level.
+// Odd sized levels have their last row and column folded into the last texel.
+void ReduceLevel(uint2 texelIndex, uint2 levelSize)
+{
+    uint2 sourceSize = HiZLevelSize(PassDataCB.HiZSize, PassDataCB.Level - 1);
+    uint sourceOffset = HiZLevelOffset(PassDataCB.HiZSize, PassDataCB.Level - 1);
+    uint offset = sourceOffset + sourceSize.x * sourceSize.y;
+
+    uint2 source0 = texelIndex * 2;
+    uint2 source1 = min(source0 + 1, sourceSize - 1);
+
+    float farthestDepth = max(
+        max(HiZ[sourceOffset + source0.y * sourceSize.x + source0.x], HiZ[sourceOffset + source0.y * sourceSize.x + source1.x]),
+        max(HiZ[sourceOffset + source1.y * sourceSize.x + source0.x], HiZ[sourceOffset + source1.y * sourceSize.x + source1.x]));
+
+    HiZ[offset + texelIndex.y * levelSize.x + texelIndex.x] = farthestDepth;
+}
+
+[numthreads(GroupDimensionSize, GroupDimensionSize, 1)]
+void CSMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    uint2 texelIndex = dispatchThreadID.xy;
+    uint2 levelSize = HiZLevelSize(PassDataCB.HiZSize, PassDataCB.Level);
+
+    if (any(texelIndex >= levelSize))
+    {
+        return;
+    }
+
+    if (PassDataCB.Level > 0)
+    {
+        ReduceLevel(texelIndex, levelSize);
+        return;
+    }
+
+    Texture2D viewDepthTexture = Textures2D[PassDataCB.ViewDepthTexIdx];
+
+    uint2 firstPixel = texelIndex * PassDataCB.BaseTexelSize;
+    uint2 lastPixel = min(firstPixel + PassDataCB.BaseTexelSize, PassDataCB.ViewportSize);
+
+    // Keep the farthest depth, so that texel is a conservative occluder for its whole footprint.
+    // Pixels without geometry are cleared to max float and never occlude anything.
+    float farthestDepth = 0.0;
+
+    for (uint y = firstPixel.y; y < lastPixel.y; ++y)
+    {
+        for (uint x = firstPixel.x; x < lastPixel.x; ++x)
+        {
+            farthestDepth = max(farthestDepth, viewDepthTexture.Load(uint3(x, y, 0)).r);
+        }
+    }
+
+    HiZ[texelIndex.y * PassDataCB.HiZSize.x + texelIndex.x] = farthestDepth;
+
+    if (all(texelIndex == 0))
+    {
+        HiZInfo info;
+        info.View = FrameDataCB.CurrentFrameCamera.View;
+        info.ViewProjection = FrameDataCB.CurrentFrameCamera.ViewProjection;
+        info.ViewportSize = PassDataCB.ViewportSize;
+        info.Size = PassDataCB.HiZSize;
+        info.BaseTexelSize = PassDataCB.BaseTexelSize;
+        info.FrameNumber = PassDataCB.FrameNumber;
+        HiZInfoBuffer[0] = info;
+    }
+}
+
+#endif
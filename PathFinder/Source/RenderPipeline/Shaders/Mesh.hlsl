@@ -11,11 +11,22 @@ struct MeshInstance
     uint UnifiedIndexBufferOffset;
     uint IndexCount;
     bool HasTangentSpace;
+    uint MeshletTableOffset;
+    uint MeshletCount;
+    uint PackedVertexBufferOffset;
+    float3 PackedVertexBoundsMin;
+    float3 PackedVertexBoundsMax;
 };
 
+// Meshes without packed vertices are read from unified vertex buffer
+static const uint MeshNoPackedVertices = 0xFFFFFFFF;
+
 static const uint MaterialTypeCookTorrance = 0;
 static const uint MaterialTypeEmissive = 1;
 
+// Maps packed into texture arrays have a valid slice index
+static const uint MaterialNoArraySlice = 0xFFFFFFFF;
+
 struct Material
 {
     uint AlbedoMapIndex;
@@ -35,6 +46,12 @@ struct Material
     // 16 byte boundary
     uint LTC_LUT_Terms_Diffuse_Index;
     uint LTC_LUT_TextureSize;
+    uint AlbedoMapSlice;
+    uint NormalMapSlice;
+    // 16 byte boundary
+    uint RoughnessMapSlice;
+    uint MetalnessMapSlice;
+    uint AOMapSlice;
 };
 
 #endif
\ No newline at end of file
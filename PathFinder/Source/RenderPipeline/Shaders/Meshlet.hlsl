@@ -0,0 +1,78 @@
+#ifndef _Meshlet__
+#define _Meshlet__
+
+#include "Mesh.hlsl"
+
+// Vertex indices are relative to MeshInstance.UnifiedVertexBufferOffset.
+// Every triangle is three 8-bit meshlet local vertex indices packed into a uint.
+struct Meshlet
+{
+    float3 BoundingSphereCenter;
+    float BoundingSphereRadius;
+    float3 ConeApex;
+    float ConeCutoff;
+    float3 ConeAxis;
+    uint VertexOffset;
+    uint VertexCount;
+    uint TriangleOffset;
+    uint TriangleCount;
+};
+
+uint3 UnpackMeshletTriangle(uint packed)
+{
+    return uint3(packed & 0xFF, (packed >> 8) & 0xFF, (packed >> 16) & 0xFF);
+}
+
+float MaxScale(float4x4 modelMatrix)
+{
+    float3 scaleSquared = float3(
+        dot(modelMatrix._m00_m10_m20, modelMatrix._m00_m10_m20),
+        dot(modelMatrix._m01_m11_m21, modelMatrix._m01_m11_m21),
+        dot(modelMatrix._m02_m12_m22, modelMatrix._m02_m12_m22));
+
+    return sqrt(max(scaleSquared.x, max(scaleSquared.y, scaleSquared.z)));
+}
+
+// Cone is built in mesh space, so the test holds for rotated, translated and uniformly scaled instances
+bool IsMeshletBackFacing(Meshlet meshlet, MeshInstance instance, float3 viewerWSPosition)
+{
+    // Cutoff of 1 marks meshlets with too widely spread normals
+    if (meshlet.ConeCutoff >= 1.0)
+    {
+        return false;
+    }
+
+    float3 apex = mul(instance.ModelMatrix, float4(meshlet.ConeApex, 1.0)).xyz;
+    float3 axis = normalize(mul(instance.ModelMatrix, float4(meshlet.ConeAxis, 0.0)).xyz);
+
+    return dot(normalize(apex - viewerWSPosition), axis) >= meshlet.ConeCutoff;
+}
+
+// Planes are extracted from a view-projection matrix with [0; 1] depth range
+bool IsMeshletOutsideFrustum(Meshlet meshlet, MeshInstance instance, float4x4 viewProjection)
+{
+    float3 center = mul(instance.ModelMatrix, float4(meshlet.BoundingSphereCenter, 1.0)).xyz;
+    float radius = meshlet.BoundingSphereRadius * MaxScale(instance.ModelMatrix);
+
+    float4 planes[6] = {
+        viewProjection[3] + viewProjection[0],
+        viewProjection[3] - viewProjection[0],
+        viewProjection[3] + viewProjection[1],
+        viewProjection[3] - viewProjection[1],
+        viewProjection[2],
+        viewProjection[3] - viewProjection[2]
+    };
+
+    [unroll]
+    for (uint i = 0; i < 6; ++i)
+    {
+        if (dot(planes[i].xyz, center) + planes[i].w < -radius * length(planes[i].xyz))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef _MeshletCulling__
+#define _MeshletCulling__
+
+struct PassData
+{
+    uint ClusteredInstanceCount;
+    uint MaxMeshletTriangleCount;
+    // Draw arguments are reset in a separate dispatch before meshlets are tested
+    bool IsResettingDrawArguments;
+};
+
+#define PassDataType PassData
+
+#include "MandatoryEntryPointInclude.hlsl"
+#include "Mesh.hlsl"
+#include "Meshlet.hlsl"
+
+struct DrawArguments
+{
+    uint VertexCountPerInstance;
+    uint InstanceCount;
+    uint StartVertexLocation;
+    uint StartInstanceLocation;
+};
+
+struct VisibleMeshlet
+{
+    uint InstanceTableIndex;
+    uint MeshletTableIndex;
+};
+
+StructuredBuffer<MeshInstance> InstanceTable : register(t0, space0);
+StructuredBuffer<Meshlet> MeshletTable : register(t1, space0);
+// Instance table indices of visible LOD 0 instances
+StructuredBuffer<uint> ClusteredInstances : register(t2, space0);
+RWStructuredBuffer<DrawArguments> MeshletDrawArguments : register(u0, space0);
+RWStructuredBuffer<VisibleMeshlet> VisibleMeshlets : register(u1, space0);
+
+static const uint GroupSize = 64;
+
+// A group per instance, its threads stride over meshlets of the instance
+[numthreads(GroupSize, 1, 1)]
+void CSMain(uint3 groupID : SV_GroupID, uint3 groupThreadID : SV_GroupThreadID)
+{
+    if (PassDataCB.IsResettingDrawArguments)
+    {
+        if (groupThreadID.x == 0)
+        {
+            // Every meshlet is drawn with vertices enough for the largest one
+            DrawArguments arguments;
+            arguments.VertexCountPerInstance = PassDataCB.MaxMeshletTriangleCount * 3;
+            arguments.InstanceCount = 0;
+            arguments.StartVertexLocation = 0;
+            arguments.StartInstanceLocation = 0;
+            MeshletDrawArguments[0] = arguments;
+        }
+
+        return;
+    }
+
+    uint instanceTableIndex = ClusteredInstances[groupID.x];
+    MeshInstance instance = InstanceTable[instanceTableIndex];
+    float3 viewerWSPosition = FrameDataCB.CurrentFrameCamera.Position.xyz;
+
+    for (uint meshletIdx = groupThreadID.x; meshletIdx < instance.MeshletCount; meshletIdx += GroupSize)
+    {
+        uint meshletTableIndex = instance.MeshletTableOffset + meshletIdx;
+        Meshlet meshlet = MeshletTable[meshletTableIndex];
+
+        if (IsMeshletOutsideFrustum(meshlet, instance, FrameDataCB.CurrentFrameCamera.ViewProjection) ||
+            IsMeshletBackFacing(meshlet, instance, viewerWSPosition))
+        {
+            continue;
+        }
+
+        uint slot = 0;
+        InterlockedAdd(MeshletDrawArguments[0].InstanceCount, 1, slot);
+
+        VisibleMeshlet visibleMeshlet;
+        visibleMeshlet.InstanceTableIndex = instanceTableIndex;
+        visibleMeshlet.MeshletTableIndex = meshletTableIndex;
+        VisibleMeshlets[slot] = visibleMeshlet;
+    }
+}
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef _OcclusionCulling__
+#define _OcclusionCulling__
+
+struct PassData
+{
+    uint2 ViewportSize;
+    uint2 HiZSize;
+    uint HiZBaseTexelSize;
+    uint CandidateCount;
+    uint DrawCommandCount;
+    // Draw commands are reset in a separate dispatch before candidates are tested
+    bool IsResettingDrawCommands;
+};
+
+#define PassDataType PassData
+
+#include "MandatoryEntryPointInclude.hlsl"
+#include "HiZ.hlsl"
+#include "Constants.hlsl"
+
+// Instance rejected by occlusion culling on CPU against an older Hi-Z
+struct OcclusionCandidate
+{
+    float3 BoundsMin;
+    uint InstanceTableIndex;
+    float3 BoundsMax;
+    uint DrawCommandIndex;
+};
+
+struct MeshInstanceDrawCommand
+{
+    uint BatchInstanceListOffset;
+    uint VertexCountPerInstance;
+    uint InstanceCount;
+    uint StartVertexLocation;
+    uint StartInstanceLocation;
+};
+
+StructuredBuffer<float> HiZ : register(t0, space0);
+StructuredBuffer<OcclusionCandidate> Candidates : register(t1, space0);
+// Commands of batches of candidates with instance count of a whole batch
+StructuredBuffer<MeshInstanceDrawCommand> CandidateDrawCommands : register(t2, space0);
+RWStructuredBuffer<MeshInstanceDrawCommand> DrawCommands : register(u0, space0);
+RWStructuredBuffer<uint> BatchInstanceList : register(u1, space0);
+
+static const uint GroupSize = 64;
+
+// Texels of a level the box rectangle may span on either side before a coarser level is taken
+static const uint MaxFootprintTexelsPerSide = 8;
+
+// Same test as Geometry::HiZPyramid::IsOccluded, made against this frame's camera and depth
+bool IsOccluded(float3 boundsMin, float3 boundsMax)
+{
+    float2 ndcMin = FloatMax;
+    float2 ndcMax = -FloatMax;
+    float nearestViewDepth = FloatMax;
+
+    for (uint cornerIdx = 0; cornerIdx < 8; ++cornerIdx)
+    {
+        float4 corner = float4(
+            cornerIdx & 1 ? boundsMax.x : boundsMin.x,
+            cornerIdx & 2 ? boundsMax.y : boundsMin.y,
+            cornerIdx & 4 ? boundsMax.z : boundsMin.z,
+            1.0);
+
+        float4 clipPosition = mul(FrameDataCB.CurrentFrameCamera.ViewProjection, corner);
+
+        // Projection of a box crossing near plane is unbounded
+        if (clipPosition.w <= 0.0 || clipPosition.z < 0.0)
+        {
+            return false;
+        }
+
+        float2 ndc = clipPosition.xy / clipPosition.w;
+        ndcMin = min(ndcMin, ndc);
+        ndcMax = max(ndcMax, ndc);
+        nearestViewDepth = min(nearestViewDepth, mul(FrameDataCB.CurrentFrameCamera.View, corner).z);
+    }
+
+    if (any(ndcMax < -1.0) || any(ndcMin > 1.0))
+    {
+        return false;
+    }
+
+    ndcMin = clamp(ndcMin, -1.0, 1.0);
+    ndcMax = clamp(ndcMax, -1.0, 1.0);
+
+    // NDC to pixels, Y axis of the viewport points down
+    uint2 lastPixel = PassDataCB.ViewportSize - 1;
+    uint2 pixel0 = min(uint2(float2(ndcMin.x * 0.5 + 0.5, 0.5 - ndcMax.y * 0.5) * PassDataCB.ViewportSize), lastPixel);
+    uint2 pixel1 = min(uint2(float2(ndcMax.x * 0.5 + 0.5, 0.5 - ndcMin.y * 0.5) * PassDataCB.ViewportSize), lastPixel);
+
+    // Pick the finest level where the rectangle touches a bounded number of texels
+    uint levelCount = HiZLevelCount(PassDataCB.HiZSize);
+    uint level = 0;
+    uint texelSize = PassDataCB.HiZBaseTexelSize;
+
+    while (level + 1 < levelCount && any(pixel1 / texelSize - pixel0 / texelSize >= MaxFootprintTexelsPerSide))
+    {
+        ++level;
+        texelSize *= 2;
+    }
+
+    uint2 levelSize = HiZLevelSize(PassDataCB.HiZSize, level);
+    uint levelOffset = HiZLevelOffset(PassDataCB.HiZSize, level);
+    uint2 texel0 = pixel0 / texelSize;
+    uint2 texel1 = min(pixel1 / texelSize, levelSize - 1);
+    float farthestViewDepth = 0.0;
+
+    for (uint y = texel0.y; y <= texel1.y; ++y)
+    {
+        for (uint x = texel0.x; x <= texel1.x; ++x)
+        {
+            farthestViewDepth = max(farthestViewDepth, HiZ[levelOffset + y * levelSize.x + x]);
+        }
+    }
+
+    return nearestViewDepth > farthestViewDepth;
+}
+
+[numthreads(GroupSize, 1, 1)]
+void CSMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    uint index = dispatchThreadID.x;
+
+    if (PassDataCB.IsResettingDrawCommands)
+    {
+        if (index < PassDataCB.DrawCommandCount)
+        {
+            MeshInstanceDrawCommand command = CandidateDrawCommands[index];
+            command.InstanceCount = 0;
+            DrawCommands[index] = command;
+        }
+
+        return;
+    }
+
+    if (index >= PassDataCB.CandidateCount)
+    {
+        return;
+    }
+
+    OcclusionCandidate candidate = Candidates[index];
+
+    if (IsOccluded(candidate.BoundsMin, candidate.BoundsMax))
+    {
+        return;
+    }
+
+    // Batch list range of a command has room for every candidate of its batch
+    uint slot = 0;
+    InterlockedAdd(DrawCommands[candidate.DrawCommandIndex].InstanceCount, 1, slot);
+    BatchInstanceList[CandidateDrawCommands[candidate.DrawCommandIndex].BatchInstanceListOffset + slot] = candidate.InstanceTableIndex;
+}
+
+#endif
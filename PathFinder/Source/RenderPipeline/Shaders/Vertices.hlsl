@@ -17,9 +17,62 @@ struct Vertex1P1N1UV1T1BT
     float3 Bitangent;
 };
 
+// Compact counterpart of Vertex1P1N1UV1T1BT, produced by MeshLoader.
+// Position is quantized to 21 bits per axis relative to mesh bounding box,
+// highest bit of the second position word is bitangent sign.
+// Normal and tangent are octahedral encoded snorm16 pairs, UV is a half pair.
+struct Vertex1P1N1UV1T1BTPacked
+{
+    uint2 PositionAndBitangentSign;
+    uint Normal;
+    uint Tangent;
+    uint UV;
+};
+
 struct IndexU32
 {
     uint Index;
 };
 
+static const uint PackedVertexPositionQuantizationMax = (1u << 21) - 1;
+
+float3 OctDecode(uint encoded)
+{
+    // Sign extend both snorm16 halves, X is stored in low bits
+    int2 quantized = int2(int(encoded << 16) >> 16, int(encoded) >> 16);
+    float2 octahedral = max(float2(quantized) / 32767.0, -1.0);
+    float3 n = float3(octahedral, 1.0 - abs(octahedral.x) - abs(octahedral.y));
+
+    float fold = saturate(-n.z);
+    n.xy += n.xy >= 0.0 ? -fold : fold;
+
+    return normalize(n);
+}
+
+float3 UnpackVertexPosition(uint2 packed, float3 boundsMin, float3 boundsMax)
+{
+    uint3 quantized = uint3(
+        packed.x & PackedVertexPositionQuantizationMax,
+        (packed.x >> 21) | ((packed.y & 0x3FFu) << 11),
+        (packed.y >> 10) & PackedVertexPositionQuantizationMax);
+
+    return boundsMin + float3(quantized) * (boundsMax - boundsMin) / float(PackedVertexPositionQuantizationMax);
+}
+
+// Bounds are the bounding box of the mesh the vertex belongs to
+Vertex1P1N1UV1T1BT UnpackVertex(Vertex1P1N1UV1T1BTPacked packed, float3 boundsMin, float3 boundsMax)
+{
+    Vertex1P1N1UV1T1BT vertex;
+
+    float bitangentSign = (packed.PositionAndBitangentSign.y >> 31) != 0 ? -1.0 : 1.0;
+
+    vertex.Position = float4(UnpackVertexPosition(packed.PositionAndBitangentSign, boundsMin, boundsMax), 1.0);
+    vertex.Normal = OctDecode(packed.Normal);
+    vertex.Tangent = OctDecode(packed.Tangent);
+    vertex.Bitangent = cross(vertex.Normal, vertex.Tangent) * bitangentSign;
+    vertex.UV = f16tof32(uint2(packed.UV, packed.UV >> 16));
+
+    return vertex;
+}
+
 #endif
\ No newline at end of file
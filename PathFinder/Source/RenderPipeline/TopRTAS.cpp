@@ -5,13 +5,21 @@ namespace PathFinder
 
 
     TopRTAS::TopRTAS(const HAL::Device* device, Memory::GPUResourceProducer* resourceProducer)
-        : RTAS(resourceProducer), mAccelerationStructure{ device } {}
+        : RTAS(resourceProducer), mAccelerationStructure{ device } 
+    {
+        mAccelerationStructure.SetUpdatesAllowed(true);
+    }
 
     void TopRTAS::AddInstance(const BottomRTAS& blas, const HAL::RayTracingTopAccelerationStructure::InstanceInfo& instanceInfo, const glm::mat4& transform)
     {
         mAccelerationStructure.AddInstance(blas.HALAccelerationStructure(), instanceInfo, transform);
     }
 
+    void TopRTAS::SetInstanceTransform(uint64_t instanceIndex, const glm::mat4& transform)
+    {
+        mAccelerationStructure.SetInstanceTransform(instanceIndex, transform);
+    }
+
     void TopRTAS::Build()
     {
         auto memoryRequirements = mAccelerationStructure.QueryMemoryRequirements();
@@ -18,6 +18,10 @@ namespace PathFinder
 
         void AddInstance(const BottomRTAS& blas, const HAL::RayTracingTopAccelerationStructure::InstanceInfo& instanceInfo, const glm::mat4& transform);
 
+        /// Changes transform of an already added instance. 
+        /// Instance list stays the same, so structure can be refitted with Update().
+        void SetInstanceTransform(uint64_t instanceIndex, const glm::mat4& transform);
+
         void Build();
         void Update();
         void Clear() override;
@@ -33,6 +37,7 @@ namespace PathFinder
 
     public:
         inline const auto& HALAccelerationStructure() const { return mAccelerationStructure; }
+        inline auto InstanceCount() const { return mAccelerationStructure.InstanceCount(); }
     };
 
 }
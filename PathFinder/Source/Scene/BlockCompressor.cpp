@@ -0,0 +1,509 @@
+#include "BlockCompressor.hpp"
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <cstring>
+#include <limits>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+        // Interpolation weights of 4 bit BC7 indices, out of 64
+        const uint32_t BC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        float HorizontalSum(__m128 value)
+        {
+            __m128 shuffled = _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1));
+            __m128 sums = _mm_add_ps(value, shuffled);
+            shuffled = _mm_movehl_ps(shuffled, sums);
+            return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+        }
+
+        float Dot16(const float* first, const float* second)
+        {
+            __m128 sum = _mm_setzero_ps();
+
+            for (uint32_t i = 0; i < 16; i += 4)
+            {
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps(first + i), _mm_load_ps(second + i)));
+            }
+
+            return HorizontalSum(sum);
+        }
+
+        uint16_t QuantizeRGB565(const float color[4])
+        {
+            uint32_t r = (uint32_t)std::lround(std::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f);
+            uint32_t g = (uint32_t)std::lround(std::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f);
+            uint32_t b = (uint32_t)std::lround(std::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f);
+            return uint16_t((r << 11) | (g << 5) | b);
+        }
+
+        void DequantizeRGB565(uint16_t packed, float color[4])
+        {
+            uint32_t r = (packed >> 11) & 31;
+            uint32_t g = (packed >> 5) & 63;
+            uint32_t b = packed & 31;
+
+            color[0] = float((r << 3) | (r >> 2));
+            color[1] = float((g << 2) | (g >> 4));
+            color[2] = float((b << 3) | (b >> 2));
+            color[3] = 0.0f;
+        }
+
+        void WriteBits(uint8_t* output, uint32_t& bitOffset, uint32_t value, uint32_t bitCount)
+        {
+            for (uint32_t bit = 0; bit < bitCount; ++bit, ++bitOffset)
+            {
+                if ((value >> bit) & 1) output[bitOffset / 8] |= uint8_t(1 << (bitOffset % 8));
+            }
+        }
+    }
+
+    uint32_t BlockCompressor::BlockSize(Format format)
+    {
+        return format == Format::BC1 || format == Format::BC4 ? 8 : 16;
+    }
+
+    std::vector<uint8_t> BlockCompressor::Compress(const uint8_t* texels, uint32_t width, uint32_t height, Format format)
+    {
+        uint32_t blockCountX = (width + 3) / 4;
+        uint32_t blockCountY = (height + 3) / 4;
+        uint32_t blockSize = BlockSize(format);
+
+        std::vector<uint8_t> blocks(uint64_t(blockCountX) * blockCountY * blockSize);
+        std::vector<uint32_t> blockRows(blockCountY);
+        std::iota(blockRows.begin(), blockRows.end(), 0);
+
+        std::for_each(std::execution::par, blockRows.begin(), blockRows.end(), [&](uint32_t blockY)
+        {
+            Block block;
+
+            for (uint32_t blockX = 0; blockX < blockCountX; ++blockX)
+            {
+                LoadBlock(texels, width, height, blockX, blockY, block);
+
+                uint8_t* output = blocks.data() + (uint64_t(blockY) * blockCountX + blockX) * blockSize;
+
+                switch (format)
+                {
+                case Format::BC1: EncodeBC1(block, output); break;
+                case Format::BC4: EncodeBC4(block, 0, output); break;
+                case Format::BC5: EncodeBC4(block, 0, output); EncodeBC4(block, 1, output + 8); break;
+                case Format::BC7: EncodeBC7(block, output); break;
+                }
+            }
+        });
+
+        return blocks;
+    }
+
+    void BlockCompressor::LoadBlock(const uint8_t* texels, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, Block& block)
+    {
+        for (uint32_t y = 0; y < 4; ++y)
+        {
+            uint32_t texelY = std::min(blockY * 4 + y, height - 1);
+
+            for (uint32_t x = 0; x < 4; ++x)
+            {
+                uint32_t texelX = std::min(blockX * 4 + x, width - 1);
+                const uint8_t* texel = texels + (uint64_t(texelY) * width + texelX) * 4;
+
+                for (uint32_t channel = 0; channel < 4; ++channel)
+                {
+                    block.Channels[channel][y * 4 + x] = texel[channel];
+                }
+            }
+        }
+    }
+
+    void BlockCompressor::EncodeBC1(const Block& block, uint8_t* output)
+    {
+        float mean[4];
+        float axis[4];
+        float projections[16];
+
+        PrincipalAxis(block, 3, mean, axis);
+        ProjectOntoAxis(block, 3, mean, axis, projections);
+
+        auto [minProjection, maxProjection] = std::minmax_element(projections, projections + 16);
+
+        float endpoints[2][4]{};
+
+        for (uint32_t channel = 0; channel < 3; ++channel)
+        {
+            endpoints[0][channel] = std::clamp(mean[channel] + axis[channel] * *maxProjection, 0.0f, 255.0f);
+            endpoints[1][channel] = std::clamp(mean[channel] + axis[channel] * *minProjection, 0.0f, 255.0f);
+        }
+
+        // Endpoints are refined once by least squares fit of texels to their interpolation levels
+        uint32_t indices[16];
+        FitIndices(block, 0, 3, endpoints[0], endpoints[1], 4, indices);
+
+        float alphaAlpha = 0.0f, alphaBeta = 0.0f, betaBeta = 0.0f;
+        float alphaTexel[3]{}, betaTexel[3]{};
+
+        for (uint32_t texel = 0; texel < 16; ++texel)
+        {
+            float beta = indices[texel] / 3.0f;
+            float alpha = 1.0f - beta;
+
+            alphaAlpha += alpha * alpha;
+            alphaBeta += alpha * beta;
+            betaBeta += beta * beta;
+
+            for (uint32_t channel = 0; channel < 3; ++channel)
+            {
+                alphaTexel[channel] += alpha * block.Channels[channel][texel];
+                betaTexel[channel] += beta * block.Channels[channel][texel];
+            }
+        }
+
+        float determinant = alphaAlpha * betaBeta - alphaBeta * alphaBeta;
+
+        if (std::abs(determinant) > 1e-4f)
+        {
+            for (uint32_t channel = 0; channel < 3; ++channel)
+            {
+                endpoints[0][channel] = std::clamp((betaBeta * alphaTexel[channel] - alphaBeta * betaTexel[channel]) / determinant, 0.0f, 255.0f);
+                endpoints[1][channel] = std::clamp((alphaAlpha * betaTexel[channel] - alphaBeta * alphaTexel[channel]) / determinant, 0.0f, 255.0f);
+            }
+        }
+
+        uint16_t colors[2] = { QuantizeRGB565(endpoints[0]), QuantizeRGB565(endpoints[1]) };
+
+        // First color has to be the larger one for blocks to be decoded in 4 color mode
+        if (colors[0] < colors[1]) std::swap(colors[0], colors[1]);
+
+        uint32_t packedIndices = 0;
+
+        if (colors[0] != colors[1])
+        {
+            DequantizeRGB565(colors[0], endpoints[0]);
+            DequantizeRGB565(colors[1], endpoints[1]);
+            FitIndices(block, 0, 3, endpoints[0], endpoints[1], 4, indices);
+
+            // Levels ordered from the first color to the second one map to indices 0, 2, 3, 1
+            const uint32_t LevelIndices[4] = { 0, 2, 3, 1 };
+
+            for (uint32_t texel = 0; texel < 16; ++texel)
+            {
+                packedIndices |= LevelIndices[indices[texel]] << (texel * 2);
+            }
+        }
+
+        std::memcpy(output, colors, sizeof(colors));
+        std::memcpy(output + 4, &packedIndices, sizeof(packedIndices));
+    }
+
+    void BlockCompressor::EncodeBC4(const Block& block, uint32_t channel, uint8_t* output)
+    {
+        const float* values = block.Channels[channel];
+
+        __m128 minValues = _mm_load_ps(values);
+        __m128 maxValues = minValues;
+
+        for (uint32_t i = 4; i < 16; i += 4)
+        {
+            minValues = _mm_min_ps(minValues, _mm_load_ps(values + i));
+            maxValues = _mm_max_ps(maxValues, _mm_load_ps(values + i));
+        }
+
+        alignas(16) float minLanes[4];
+        alignas(16) float maxLanes[4];
+        _mm_store_ps(minLanes, minValues);
+        _mm_store_ps(maxLanes, maxValues);
+
+        uint8_t endpoints[2] = {
+            uint8_t(std::lround(*std::max_element(maxLanes, maxLanes + 4))),
+            uint8_t(std::lround(*std::min_element(minLanes, minLanes + 4)))
+        };
+
+        uint64_t packedIndices = 0;
+
+        // Equal endpoints decode to the first one everywhere, otherwise the first being larger selects 8 level mode
+        if (endpoints[0] != endpoints[1])
+        {
+            float start[4]{};
+            float end[4]{};
+            start[channel] = endpoints[0];
+            end[channel] = endpoints[1];
+
+            uint32_t levels[16];
+            FitIndices(block, channel, 1, start, end, 8, levels);
+
+            // Levels ordered from the first endpoint to the second one map to indices 0, 2, 3, 4, 5, 6, 7, 1
+            for (uint32_t texel = 0; texel < 16; ++texel)
+            {
+                uint32_t level = levels[texel];
+                uint64_t index = level == 0 ? 0 : (level == 7 ? 1 : level + 1);
+                packedIndices |= index << (texel * 3);
+            }
+        }
+
+        output[0] = endpoints[0];
+        output[1] = endpoints[1];
+
+        for (uint32_t byte = 0; byte < 6; ++byte)
+        {
+            output[2 + byte] = uint8_t(packedIndices >> (byte * 8));
+        }
+    }
+
+    void BlockCompressor::EncodeBC7(const Block& block, uint8_t* output)
+    {
+        float mean[4];
+        float axis[4];
+        float projections[16];
+
+        PrincipalAxis(block, 4, mean, axis);
+        ProjectOntoAxis(block, 4, mean, axis, projections);
+
+        auto [minProjection, maxProjection] = std::minmax_element(projections, projections + 16);
+
+        float endpoints[2][4];
+
+        for (uint32_t channel = 0; channel < 4; ++channel)
+        {
+            endpoints[0][channel] = std::clamp(mean[channel] + axis[channel] * *minProjection, 0.0f, 255.0f);
+            endpoints[1][channel] = std::clamp(mean[channel] + axis[channel] * *maxProjection, 0.0f, 255.0f);
+        }
+
+        // Endpoints are stored as 7 bits per channel and a shared least significant bit per endpoint,
+        // every combination of those bits is tried
+        uint32_t bestQuantized[2][4]{};
+        uint32_t bestPBits[2]{};
+        uint32_t bestIndices[16]{};
+        float bestError = std::numeric_limits<float>::max();
+
+        for (uint32_t pBitCombination = 0; pBitCombination < 4; ++pBitCombination)
+        {
+            uint32_t pBits[2] = { pBitCombination & 1, pBitCombination >> 1 };
+            uint32_t quantized[2][4];
+            float dequantized[2][4];
+
+            for (uint32_t endpoint = 0; endpoint < 2; ++endpoint)
+            {
+                for (uint32_t channel = 0; channel < 4; ++channel)
+                {
+                    float value = (endpoints[endpoint][channel] - pBits[endpoint]) * 0.5f;
+                    quantized[endpoint][channel] = (uint32_t)std::clamp(std::lround(value), 0l, 127l);
+                    dequantized[endpoint][channel] = float((quantized[endpoint][channel] << 1) | pBits[endpoint]);
+                }
+            }
+
+            uint32_t indices[16];
+            FitIndices(block, 0, 4, dequantized[0], dequantized[1], 16, indices);
+
+            // Weights aren't evenly spaced, so neighbours of fitted indices are checked as well
+            float error = 0.0f;
+
+            for (uint32_t texel = 0; texel < 16; ++texel)
+            {
+                float bestTexelError = std::numeric_limits<float>::max();
+                uint32_t firstCandidate = indices[texel] > 0 ? indices[texel] - 1 : 0;
+                uint32_t lastCandidate = std::min(indices[texel] + 1, 15u);
+
+                for (uint32_t candidate = firstCandidate; candidate <= lastCandidate; ++candidate)
+                {
+                    float texelError = 0.0f;
+
+                    for (uint32_t channel = 0; channel < 4; ++channel)
+                    {
+                        uint32_t weight = BC7Weights[candidate];
+                        uint32_t decoded = ((64 - weight) * uint32_t(dequantized[0][channel]) + weight * uint32_t(dequantized[1][channel]) + 32) >> 6;
+                        float difference = float(decoded) - block.Channels[channel][texel];
+                        texelError += difference * difference;
+                    }
+
+                    if (texelError < bestTexelError)
+                    {
+                        bestTexelError = texelError;
+                        indices[texel] = candidate;
+                    }
+                }
+
+                error += bestTexelError;
+            }
+
+            if (error < bestError)
+            {
+                bestError = error;
+                std::memcpy(bestQuantized, quantized, sizeof(quantized));
+                std::memcpy(bestPBits, pBits, sizeof(pBits));
+                std::memcpy(bestIndices, indices, sizeof(indices));
+            }
+        }
+
+        // Most significant bit of the first index is implied to be zero, endpoints are swapped to make it so
+        if (bestIndices[0] & 8)
+        {
+            std::swap(bestQuantized[0], bestQuantized[1]);
+            std::swap(bestPBits[0], bestPBits[1]);
+
+            for (uint32_t& index : bestIndices) index = 15 - index;
+        }
+
+        std::memset(output, 0, 16);
+        uint32_t bitOffset = 0;
+
+        WriteBits(output, bitOffset, 1 << 6, 7);
+
+        for (uint32_t channel = 0; channel < 4; ++channel)
+        {
+            WriteBits(output, bitOffset, bestQuantized[0][channel], 7);
+            WriteBits(output, bitOffset, bestQuantized[1][channel], 7);
+        }
+
+        WriteBits(output, bitOffset, bestPBits[0], 1);
+        WriteBits(output, bitOffset, bestPBits[1], 1);
+
+        for (uint32_t texel = 0; texel < 16; ++texel)
+        {
+            WriteBits(output, bitOffset, bestIndices[texel], texel == 0 ? 3 : 4);
+        }
+    }
+
+    void BlockCompressor::PrincipalAxis(const Block& block, uint32_t channelCount, float mean[4], float axis[4])
+    {
+        Block centered;
+
+        for (uint32_t channel = 0; channel < 4; ++channel)
+        {
+            mean[channel] = 0.0f;
+            axis[channel] = 0.0f;
+        }
+
+        for (uint32_t channel = 0; channel < channelCount; ++channel)
+        {
+            __m128 sum = _mm_setzero_ps();
+
+            for (uint32_t i = 0; i < 16; i += 4)
+            {
+                sum = _mm_add_ps(sum, _mm_load_ps(block.Channels[channel] + i));
+            }
+
+            mean[channel] = HorizontalSum(sum) / 16.0f;
+
+            __m128 channelMean = _mm_set1_ps(mean[channel]);
+
+            for (uint32_t i = 0; i < 16; i += 4)
+            {
+                _mm_store_ps(centered.Channels[channel] + i, _mm_sub_ps(_mm_load_ps(block.Channels[channel] + i), channelMean));
+            }
+        }
+
+        float covariance[4][4]{};
+        uint32_t widestChannel = 0;
+
+        for (uint32_t first = 0; first < channelCount; ++first)
+        {
+            for (uint32_t second = first; second < channelCount; ++second)
+            {
+                covariance[first][second] = covariance[second][first] = Dot16(centered.Channels[first], centered.Channels[second]);
+            }
+
+            if (covariance[first][first] > covariance[widestChannel][widestChannel]) widestChannel = first;
+        }
+
+        if (covariance[widestChannel][widestChannel] < 1e-3f) return;
+
+        // Power iteration starting from the direction of the widest channel
+        float vector[4]{};
+        vector[widestChannel] = 1.0f;
+
+        for (uint32_t iteration = 0; iteration < 8; ++iteration)
+        {
+            float next[4]{};
+            float length = 0.0f;
+
+            for (uint32_t row = 0; row < channelCount; ++row)
+            {
+                for (uint32_t column = 0; column < channelCount; ++column)
+                {
+                    next[row] += covariance[row][column] * vector[column];
+                }
+
+                length += next[row] * next[row];
+            }
+
+            if (length < 1e-12f) return;
+
+            length = std::sqrt(length);
+
+            for (uint32_t channel = 0; channel < channelCount; ++channel)
+            {
+                vector[channel] = next[channel] / length;
+            }
+        }
+
+        std::copy(vector, vector + 4, axis);
+    }
+
+    void BlockCompressor::ProjectOntoAxis(const Block& block, uint32_t channelCount, const float mean[4], const float axis[4], float projections[16])
+    {
+        for (uint32_t i = 0; i < 16; i += 4)
+        {
+            __m128 projection = _mm_setzero_ps();
+
+            for (uint32_t channel = 0; channel < channelCount; ++channel)
+            {
+                __m128 centered = _mm_sub_ps(_mm_load_ps(block.Channels[channel] + i), _mm_set1_ps(mean[channel]));
+                projection = _mm_add_ps(projection, _mm_mul_ps(centered, _mm_set1_ps(axis[channel])));
+            }
+
+            _mm_storeu_ps(projections + i, projection);
+        }
+    }
+
+    void BlockCompressor::FitIndices(
+        const Block& block,
+        uint32_t firstChannel,
+        uint32_t channelCount,
+        const float start[4],
+        const float end[4],
+        uint32_t levelCount,
+        uint32_t indices[16])
+    {
+        float direction[4]{};
+        float lengthSquared = 0.0f;
+
+        for (uint32_t channel = firstChannel; channel < firstChannel + channelCount; ++channel)
+        {
+            direction[channel] = end[channel] - start[channel];
+            lengthSquared += direction[channel] * direction[channel];
+        }
+
+        if (lengthSquared < 1e-6f)
+        {
+            std::fill(indices, indices + 16, 0);
+            return;
+        }
+
+        __m128 scale = _mm_set1_ps(float(levelCount - 1) / lengthSquared);
+        __m128 maxLevel = _mm_set1_ps(float(levelCount - 1));
+
+        for (uint32_t i = 0; i < 16; i += 4)
+        {
+            __m128 projection = _mm_setzero_ps();
+
+            for (uint32_t channel = firstChannel; channel < firstChannel + channelCount; ++channel)
+            {
+                __m128 offset = _mm_sub_ps(_mm_load_ps(block.Channels[channel] + i), _mm_set1_ps(start[channel]));
+                projection = _mm_add_ps(projection, _mm_mul_ps(offset, _mm_set1_ps(direction[channel])));
+            }
+
+            __m128 level = _mm_min_ps(_mm_max_ps(_mm_mul_ps(projection, scale), _mm_setzero_ps()), maxLevel);
+
+            // Rounds to nearest
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(indices + i), _mm_cvtps_epi32(level));
+        }
+    }
+
+}
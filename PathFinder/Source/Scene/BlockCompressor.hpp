@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Encodes RGBA8 images into BCn blocks on CPU.
+    /// Texels of a block are converted to planar floats, so that endpoint fitting and index selection
+    /// process four texels at once with SSE. Rows of blocks are encoded in parallel.
+    class BlockCompressor
+    {
+    public:
+        // BC7 is encoded in mode 6 only: a single RGBA subset with 4 bit indices,
+        // which suits smooth material textures and is by far the cheapest mode to search
+        enum class Format { BC1, BC4, BC5, BC7 };
+
+        /// Bytes per 4x4 block
+        static uint32_t BlockSize(Format format);
+
+        /// Texels are tightly packed RGBA8 rows. Blocks crossing image edges repeat edge texels.
+        /// BC4 encodes the red channel, BC5 red and green ones.
+        static std::vector<uint8_t> Compress(const uint8_t* texels, uint32_t width, uint32_t height, Format format);
+
+    private:
+        // Texels of a block channel by channel
+        struct alignas(16) Block
+        {
+            float Channels[4][16];
+        };
+
+        static void LoadBlock(const uint8_t* texels, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, Block& block);
+
+        static void EncodeBC1(const Block& block, uint8_t* output);
+        static void EncodeBC4(const Block& block, uint32_t channel, uint8_t* output);
+        static void EncodeBC7(const Block& block, uint8_t* output);
+
+        // Texels are spread the most along the principal axis, endpoints are searched on it.
+        // Returns zero axis for blocks of a single color.
+        static void PrincipalAxis(const Block& block, uint32_t channelCount, float mean[4], float axis[4]);
+
+        // Texels projected onto the axis, relative to the mean
+        static void ProjectOntoAxis(const Block& block, uint32_t channelCount, const float mean[4], const float axis[4], float projections[16]);
+
+        // Indices of levels evenly spaced between endpoints that are the closest to texels,
+        // only channels starting from 'firstChannel' are considered
+        static void FitIndices(
+            const Block& block, 
+            uint32_t firstChannel, 
+            uint32_t channelCount, 
+            const float start[4], 
+            const float end[4], 
+            uint32_t levelCount, 
+            uint32_t indices[16]);
+    };
+
+}
@@ -0,0 +1,185 @@
+#include "CookedMeshCache.hpp"
+
+#include <Foundation/FileWriting.hpp>
+
+#include <robinhood/robin_hood.h>
+
+#include <sstream>
+#include <iomanip>
+#include <string>
+
+namespace PathFinder
+{
+
+    CookedMeshCache::CookedMeshCache(const std::filesystem::path& cacheRoot)
+        : mCacheRoot{ cacheRoot } {}
+
+    std::optional<CookedMeshCache::Key> CookedMeshCache::MakeKey(const std::filesystem::path& sourceRoot, const std::filesystem::path& relativeSourcePath, uint64_t settingsHash) const
+    {
+        Foundation::MemoryMappedFile sourceFile{ sourceRoot / relativeSourcePath };
+
+        if (!sourceFile.IsOpen()) return std::nullopt;
+
+        Key key{};
+        key.SourceHash = robin_hood::hash_bytes(sourceFile.Data(), sourceFile.Size());
+        key.SettingsHash = settingsHash;
+
+        std::string relativePathString = relativeSourcePath.lexically_normal().generic_string();
+        uint64_t pathHash = robin_hood::hash_bytes(relativePathString.data(), relativePathString.size());
+
+        // A file per source and settings combination, outdated sources are detected by the hash in the header
+        std::stringstream fileName;
+        fileName << relativeSourcePath.filename().string() << "." << std::hex << std::setfill('0') 
+            << std::setw(16) << pathHash << "." << std::setw(16) << settingsHash << ".cmesh";
+
+        key.CookedFilePath = mCacheRoot / fileName.str();
+
+        return key;
+    }
+
+    std::optional<std::vector<Mesh>> CookedMeshCache::Load(const Key& key) const
+    {
+        Foundation::MemoryMappedFile file{ key.CookedFilePath };
+
+        if (!file.IsOpen() || file.Size() < sizeof(FileHeader)) return std::nullopt;
+
+        FileHeader header{};
+        std::memcpy(&header, file.Data(), sizeof(FileHeader));
+
+        bool isHeaderValid =
+            header.Magic == Magic &&
+            header.FormatVersion == FormatVersion &&
+            header.SourceHash == key.SourceHash &&
+            header.SettingsHash == key.SettingsHash &&
+            header.FileSize == file.Size() &&
+            header.VertexSize == sizeof(Vertex1P1N1UV1T1BT);
+
+        if (!isHeaderValid) return std::nullopt;
+
+        std::vector<MeshRecord> records;
+
+        if (!ReadSection(file, Section{ sizeof(FileHeader), uint64_t(header.MeshCount) * sizeof(MeshRecord) }, records))
+        {
+            return std::nullopt;
+        }
+
+        std::vector<Mesh> meshes(records.size());
+        std::vector<char> name;
+        std::vector<LODRecord> lodRecords;
+        std::vector<uint32_t> lodIndices;
+
+        for (uint64_t meshIdx = 0; meshIdx < records.size(); ++meshIdx)
+        {
+            const MeshRecord& record = records[meshIdx];
+            Mesh& mesh = meshes[meshIdx];
+
+            bool areSectionsValid =
+                ReadSection(file, record.Name, name) &&
+                ReadSection(file, record.Vertices, mesh.mVertices) &&
+                ReadSection(file, record.PackedVertices, mesh.mPackedVertices) &&
+                ReadSection(file, record.Indices, mesh.mIndices) &&
+                ReadSection(file, record.Meshlets, mesh.mMeshlets) &&
+                ReadSection(file, record.MeshletVertexIndices, mesh.mMeshletVertexIndices) &&
+                ReadSection(file, record.MeshletTriangles, mesh.mMeshletTriangles) &&
+                ReadSection(file, record.LODs, lodRecords) &&
+                ReadSection(file, record.LODIndices, lodIndices);
+
+            if (!areSectionsValid) return std::nullopt;
+
+            mesh.mName.assign(name.begin(), name.end());
+            mesh.mBoundingBox = Geometry::AxisAlignedBox3D{ record.BoundsMin, record.BoundsMax };
+            mesh.mArea = record.SurfaceArea;
+            mesh.mHasTangentSpace = record.HasTangentSpace;
+            mesh.mPackingError = record.PackingError;
+            mesh.mOptimizationReport = record.OptimizationReport;
+
+            for (const LODRecord& lodRecord : lodRecords)
+            {
+                if (lodRecord.FirstIndex > lodIndices.size() || lodRecord.IndexCount > lodIndices.size() - lodRecord.FirstIndex)
+                {
+                    return std::nullopt;
+                }
+
+                MeshLOD lod{};
+                lod.Indices.assign(lodIndices.begin() + lodRecord.FirstIndex, lodIndices.begin() + lodRecord.FirstIndex + lodRecord.IndexCount);
+                lod.Error = lodRecord.Error;
+
+                mesh.mLODs.emplace_back(std::move(lod));
+            }
+        }
+
+        return meshes;
+    }
+
+    bool CookedMeshCache::Store(const Key& key, const std::vector<Mesh>& meshes) const
+    {
+        std::vector<uint8_t> buffer(sizeof(FileHeader) + meshes.size() * sizeof(MeshRecord), 0);
+        std::vector<MeshRecord> records(meshes.size());
+        std::vector<LODRecord> lodRecords;
+        std::vector<uint32_t> lodIndices;
+
+        for (uint64_t meshIdx = 0; meshIdx < meshes.size(); ++meshIdx)
+        {
+            const Mesh& mesh = meshes[meshIdx];
+            MeshRecord& record = records[meshIdx];
+
+            // Padding is zeroed to keep cooked files identical for identical input
+            std::memset(static_cast<void*>(&record), 0, sizeof(MeshRecord));
+
+            lodRecords.clear();
+            lodIndices.clear();
+
+            for (const MeshLOD& lod : mesh.LODs())
+            {
+                LODRecord lodRecord{};
+                std::memset(static_cast<void*>(&lodRecord), 0, sizeof(LODRecord));
+
+                lodRecord.FirstIndex = lodIndices.size();
+                lodRecord.IndexCount = lod.Indices.size();
+                lodRecord.Error = lod.Error;
+
+                lodRecords.push_back(lodRecord);
+                lodIndices.insert(lodIndices.end(), lod.Indices.begin(), lod.Indices.end());
+            }
+
+            record.Name = WriteSection(buffer, mesh.Name().data(), mesh.Name().size());
+            record.Vertices = WriteSection(buffer, mesh.Vertices().data(), mesh.Vertices().size());
+            record.PackedVertices = WriteSection(buffer, mesh.PackedVertices().data(), mesh.PackedVertices().size());
+            record.Indices = WriteSection(buffer, mesh.Indices().data(), mesh.Indices().size());
+            record.Meshlets = WriteSection(buffer, mesh.Meshlets().data(), mesh.Meshlets().size());
+            record.MeshletVertexIndices = WriteSection(buffer, mesh.MeshletVertexIndices().data(), mesh.MeshletVertexIndices().size());
+            record.MeshletTriangles = WriteSection(buffer, mesh.MeshletTriangles().data(), mesh.MeshletTriangles().size());
+            record.LODs = WriteSection(buffer, lodRecords.data(), lodRecords.size());
+            record.LODIndices = WriteSection(buffer, lodIndices.data(), lodIndices.size());
+
+            record.BoundsMin = mesh.BoundingBox().Min;
+            record.BoundsMax = mesh.BoundingBox().Max;
+            record.SurfaceArea = mesh.SurfaceArea();
+            record.HasTangentSpace = mesh.HasTangentSpace();
+            record.PackingError = mesh.PackingError();
+            record.OptimizationReport = mesh.OptimizationReport();
+        }
+
+        FileHeader header{};
+        std::memset(static_cast<void*>(&header), 0, sizeof(FileHeader));
+
+        header.Magic = Magic;
+        header.FormatVersion = FormatVersion;
+        header.SourceHash = key.SourceHash;
+        header.SettingsHash = key.SettingsHash;
+        header.FileSize = buffer.size();
+        header.MeshCount = (uint32_t)meshes.size();
+        header.VertexSize = sizeof(Vertex1P1N1UV1T1BT);
+
+        std::memcpy(buffer.data(), &header, sizeof(FileHeader));
+
+        if (!records.empty())
+        {
+            std::memcpy(buffer.data() + sizeof(FileHeader), records.data(), records.size() * sizeof(MeshRecord));
+        }
+
+        // The same source can be cooked by concurrent loads, so an interrupted or racing write must never leave a partial file behind
+        return Foundation::WriteFileAtomically(key.CookedFilePath, buffer.data(), buffer.size());
+    }
+
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Mesh.hpp"
+
+#include <Foundation/MemoryMappedFile.hpp>
+#include <Foundation/MemoryUtils.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+#include <type_traits>
+#include <cstring>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Stores imported meshes on disk in a flat binary layout, so that later imports of the same
+    /// source file with the same settings skip Assimp and processing entirely.
+    /// Every array of a mesh occupies its own aligned section of the file, cooked files are memory-mapped
+    /// on load and sections are copied to mesh storage in one go, without any per-element decoding.
+    class CookedMeshCache
+    {
+    public:
+        struct Key
+        {
+            std::filesystem::path CookedFilePath;
+            uint64_t SourceHash = 0;
+            uint64_t SettingsHash = 0;
+        };
+
+        CookedMeshCache(const std::filesystem::path& cacheRoot);
+
+        /// Hashes contents of the source file. Returns nothing if the source can't be read.
+        /// Cooked files are told apart by relative source paths, so sources of the same name in different folders don't evict each other.
+        std::optional<Key> MakeKey(const std::filesystem::path& sourceRoot, const std::filesystem::path& relativeSourcePath, uint64_t settingsHash) const;
+
+        /// Returns nothing if there is no cooked file for the key or it's outdated
+        std::optional<std::vector<Mesh>> Load(const Key& key) const;
+
+        /// Failing to write a cooked file is not an error, the source will be imported again next time
+        bool Store(const Key& key, const std::vector<Mesh>& meshes) const;
+
+    private:
+        // Incremented on every change of the layout or of the import pipeline that affects its output
+        inline static const uint32_t FormatVersion = 1;
+        inline static const uint32_t Magic = 0x48534D50; // 'PMSH'
+        inline static const uint64_t SectionAlignment = 64;
+
+        // Byte range relative to the beginning of the file
+        struct Section
+        {
+            uint64_t Offset = 0;
+            uint64_t Size = 0;
+        };
+
+        struct FileHeader
+        {
+            uint32_t Magic = 0;
+            uint32_t FormatVersion = 0;
+            uint64_t SourceHash = 0;
+            uint64_t SettingsHash = 0;
+            uint64_t FileSize = 0;
+            uint32_t MeshCount = 0;
+            uint32_t VertexSize = 0;
+        };
+
+        struct LODRecord
+        {
+            // Range in the LOD index section of the mesh
+            uint64_t FirstIndex = 0;
+            uint64_t IndexCount = 0;
+            float Error = 0.0f;
+        };
+
+        // Mesh records follow the file header
+        struct MeshRecord
+        {
+            Section Name;
+            Section Vertices;
+            Section PackedVertices;
+            Section Indices;
+            Section Meshlets;
+            Section MeshletVertexIndices;
+            Section MeshletTriangles;
+            Section LODs;
+            Section LODIndices;
+
+            glm::vec3 BoundsMin{ 0.0f };
+            glm::vec3 BoundsMax{ 0.0f };
+            float SurfaceArea = 0.0f;
+            uint32_t HasTangentSpace = 0;
+            VertexPackingError PackingError;
+            MeshOptimizationReport OptimizationReport;
+        };
+
+        // Returns false for sections out of file bounds or of size not divisible by element size
+        template <class Element>
+        static bool ReadSection(const Foundation::MemoryMappedFile& file, const Section& section, std::vector<Element>& elements);
+
+        template <class Element>
+        static Section WriteSection(std::vector<uint8_t>& buffer, const Element* elements, uint64_t elementCount);
+
+        std::filesystem::path mCacheRoot;
+    };
+
+}
+
+#include "CookedMeshCache.inl"
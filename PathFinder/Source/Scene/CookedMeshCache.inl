@@ -0,0 +1,41 @@
+namespace PathFinder
+{
+
+    template <class Element>
+    bool CookedMeshCache::ReadSection(const Foundation::MemoryMappedFile& file, const Section& section, std::vector<Element>& elements)
+    {
+        static_assert(std::is_trivially_copyable_v<Element>, "Cooked elements are copied as raw memory");
+
+        if (section.Offset > file.Size() || section.Size > file.Size() - section.Offset || section.Size % sizeof(Element) != 0)
+        {
+            return false;
+        }
+
+        elements.resize(section.Size / sizeof(Element));
+
+        if (section.Size > 0)
+        {
+            std::memcpy(elements.data(), file.Data() + section.Offset, section.Size);
+        }
+
+        return true;
+    }
+
+    template <class Element>
+    CookedMeshCache::Section CookedMeshCache::WriteSection(std::vector<uint8_t>& buffer, const Element* elements, uint64_t elementCount)
+    {
+        static_assert(std::is_trivially_copyable_v<Element>, "Cooked elements are copied as raw memory");
+
+        Section section{ Foundation::MemoryUtils::Align(buffer.size(), SectionAlignment), elementCount * sizeof(Element) };
+
+        buffer.resize(section.Offset + section.Size);
+
+        if (section.Size > 0)
+        {
+            std::memcpy(buffer.data() + section.Offset, elements, section.Size);
+        }
+
+        return section;
+    }
+
+}
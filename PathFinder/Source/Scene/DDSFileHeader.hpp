@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    // DDS header followed by the DX10 extension, which is the only way to store formats like BC7 or 32 bit integer ones
+#pragma pack(push, 1)
+    struct DDSFileHeader
+    {
+        uint32_t Magic;
+        uint32_t Size;
+        uint32_t Flags;
+        uint32_t Height;
+        uint32_t Width;
+        uint32_t LinearSize;
+        uint32_t Depth;
+        uint32_t MipCount;
+        uint32_t Reserved1[11];
+        uint32_t PixelFormatSize;
+        uint32_t PixelFormatFlags;
+        uint32_t FourCC;
+        uint32_t RGBBitCount;
+        uint32_t BitMasks[4];
+        uint32_t Caps[4];
+        uint32_t Reserved2;
+        uint32_t DXGIFormat;
+        uint32_t ResourceDimension;
+        uint32_t MiscFlags;
+        uint32_t ArraySize;
+        uint32_t MiscFlags2;
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(DDSFileHeader) == 148, "DDS header layout is fixed by the format");
+
+    const uint32_t DDSMagic = 0x20534444; // 'DDS '
+    const uint32_t DDSHeaderSize = 124; // Without magic and DX10 extension
+    const uint32_t DX10FourCC = 0x30315844; // 'DX10'
+
+    const uint32_t DDSDCaps = 0x1, DDSDHeight = 0x2, DDSDWidth = 0x4, DDSDPixelFormat = 0x1000, DDSDMipCount = 0x20000, DDSDLinearSize = 0x80000, DDSDDepth = 0x800000;
+    const uint32_t DDPFFourCC = 0x4;
+    const uint32_t DDSCapsComplex = 0x8, DDSCapsTexture = 0x1000, DDSCapsMipMap = 0x400000;
+    const uint32_t DDSCaps2CubeMapAllFaces = 0xFE00, DDSCaps2Volume = 0x200000;
+    const uint32_t D3D10ResourceDimensionTexture1D = 2, D3D10ResourceDimensionTexture2D = 3, D3D10ResourceDimensionTexture3D = 4;
+    const uint32_t D3D10ResourceMiscTextureCube = 0x4;
+
+}
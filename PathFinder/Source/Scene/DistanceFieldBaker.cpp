@@ -0,0 +1,453 @@
+#include "DistanceFieldBaker.hpp"
+
+#include <Foundation/Assert.hpp>
+
+#include <glm/gtc/packing.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vector_relational.hpp>
+
+#include <emmintrin.h>
+
+#include <array>
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <cstring>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+        // Seed coordinates are packed into non-negative integers, 10 bits per axis
+        const uint32_t CoordinateBits = 10;
+        const uint32_t CoordinateMask = (1u << CoordinateBits) - 1;
+
+        // Jump flooding is followed by a few passes of the smallest step, which fix most of its errors
+        const uint32_t RefinementPassCount = 4;
+
+        struct FloodOffset
+        {
+            glm::ivec3 Direction;
+            uint32_t Cone;
+        };
+
+        int32_t PackVoxel(uint32_t x, uint32_t y, uint32_t z)
+        {
+            return int32_t(x | (y << CoordinateBits) | (z << (CoordinateBits * 2)));
+        }
+
+        // Octant of a direction the same way VectorOctant() of shaders picks it
+        uint32_t DirectionCone(const glm::ivec3& direction)
+        {
+            uint32_t cone = std::abs(direction.x) > std::abs(direction.z) ? (direction.x < 0 ? 0 : 2) : (direction.z < 0 ? 3 : 1);
+            return direction.y < 0 ? cone + 4 : cone;
+        }
+
+        // In the order of the flooding shader, since it decides which of equally distant seeds wins
+        const std::array<FloodOffset, 26>& FloodOffsets()
+        {
+            static const std::array<FloodOffset, 26> offsets = []
+            {
+                const glm::ivec3 directions[26] = {
+                    { 0, 0, 1 }, { 1, 0, 1 }, { -1, 0, 1 },
+                    { 0, 1, 1 }, { 0, -1, 1 }, { 1, 1, 1 },
+                    { 1, -1, 1 }, { -1, 1, 1 }, { -1, -1, 1 },
+                    { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 },
+                    { 0, -1, 0 }, { 1, 1, 0 }, { 1, -1, 0 },
+                    { -1, 1, 0 }, { -1, -1, 0 }, { 0, 0, -1 },
+                    { 1, 0, -1 }, { -1, 0, -1 }, { 0, 1, -1 },
+                    { 0, -1, -1 }, { 1, 1, -1 },
+                    { 1, -1, -1 }, { -1, 1, -1 }, { -1, -1, -1 }
+                };
+
+                std::array<FloodOffset, 26> values{};
+
+                for (uint32_t i = 0; i < 26; ++i)
+                {
+                    values[i] = { directions[i], DirectionCone(directions[i]) };
+                }
+
+                return values;
+            }();
+
+            return offsets;
+        }
+
+        uint32_t HalfTexelSize(ddsktx_format format)
+        {
+            switch (format)
+            {
+            case DDSKTX_FORMAT_RG16F: return 4;
+            case DDSKTX_FORMAT_RGBA16F: return 8;
+            default: return 2;
+            }
+        }
+
+        // PackUnorm2x16() of shaders, the first value goes to the high half
+        uint32_t PackUnorm2x16(float first, float second, float range)
+        {
+            const float base = 65535.0f;
+            float rangeInverse = 1.0f / range;
+
+            uint32_t packed = uint32_t(std::abs(first) * rangeInverse * base);
+            packed <<= 16;
+            packed |= uint32_t(std::abs(second) * rangeInverse * base) & 0x0000FFFFu;
+
+            return packed;
+        }
+    }
+
+    std::optional<std::vector<glm::uvec4>> DistanceFieldBaker::Bake(
+        const ddsktx_texture_info& displacementMapInfo,
+        const Foundation::MemoryMappedFile& displacementMapFile,
+        const Geometry::Dimensions& fieldSize)
+    {
+        assert_format(fieldSize.LargestDimension() <= CoordinateMask + 1, "Distance field is too large to pack seed coordinates");
+
+        auto startTime = std::chrono::steady_clock::now();
+        uint64_t voxelCount = fieldSize.Width * fieldSize.Height * fieldSize.Depth;
+
+        std::optional<DisplacementImage> displacement = DecodeDisplacement(displacementMapInfo, displacementMapFile);
+
+        if (!displacement)
+        {
+            std::lock_guard lock{ mStatisticsMutex };
+            ++mStatistics.SkippedFieldCount;
+            return std::nullopt;
+        }
+
+        Grid grid = MakeGrid(fieldSize);
+
+        std::vector<int32_t> cones(voxelCount * 8);
+        std::vector<int32_t> flooded(voxelCount * 8);
+
+        SeedCones(*displacement, grid, cones);
+
+        uint32_t largestDimension = std::max({ grid.Width, grid.Height, grid.Depth });
+        uint32_t jumpStepCount = uint32_t(std::log2(largestDimension));
+
+        // Steps are halved from half of the largest dimension down to a single voxel
+        for (uint32_t pass = 0; pass < jumpStepCount + RefinementPassCount; ++pass)
+        {
+            uint32_t step = pass < jumpStepCount ? std::max(largestDimension >> (pass + 1), 1u) : 1;
+
+            Flood(grid, step, cones, flooded);
+            cones.swap(flooded);
+        }
+
+        std::vector<glm::uvec4> field = Compress(grid, cones);
+
+        std::lock_guard lock{ mStatisticsMutex };
+
+        mStatistics.BakedFieldCount += 1;
+        mStatistics.BakeTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+        return field;
+    }
+
+    std::optional<DistanceFieldBaker::DisplacementImage> DistanceFieldBaker::DecodeDisplacement(const ddsktx_texture_info& textureInfo, const Foundation::MemoryMappedFile& file)
+    {
+        bool isPlain2D = textureInfo.depth == 1 &&
+            textureInfo.num_layers == 1 &&
+            !(textureInfo.flags & DDSKTX_TEXTURE_FLAG_CUBEMAP);
+
+        if (!isPlain2D)
+        {
+            return std::nullopt;
+        }
+
+        ddsktx_sub_data subData;
+        ddsktx_get_sub(&textureInfo, &subData, file.Data(), (int)file.Size(), 0, 0, 0);
+
+        DisplacementImage image{ (uint32_t)textureInfo.width, (uint32_t)textureInfo.height };
+        image.Values.resize(uint64_t(image.Width) * image.Height);
+
+        // Formats whose red channel shaders read as unorm or float values
+        for (uint32_t y = 0; y < image.Height; ++y)
+        {
+            const uint8_t* row = reinterpret_cast<const uint8_t*>(subData.buff) + uint64_t(y) * subData.row_pitch_bytes;
+            float* values = image.Values.data() + uint64_t(y) * image.Width;
+
+            for (uint32_t x = 0; x < image.Width; ++x)
+            {
+                uint16_t value16 = 0;
+                float value32 = 0.0f;
+
+                switch (textureInfo.format)
+                {
+                case DDSKTX_FORMAT_R8: values[x] = row[x] / 255.0f; break;
+                case DDSKTX_FORMAT_RG8: values[x] = row[x * 2] / 255.0f; break;
+                case DDSKTX_FORMAT_RGBA8: values[x] = row[x * 4] / 255.0f; break;
+                case DDSKTX_FORMAT_BGRA8: values[x] = row[x * 4 + 2] / 255.0f; break;
+
+                case DDSKTX_FORMAT_RGBA16:
+                    std::memcpy(&value16, row + x * 8, sizeof(uint16_t));
+                    values[x] = value16 / 65535.0f;
+                    break;
+
+                case DDSKTX_FORMAT_R16F:
+                case DDSKTX_FORMAT_RG16F:
+                case DDSKTX_FORMAT_RGBA16F:
+                    std::memcpy(&value16, row + x * HalfTexelSize(textureInfo.format), sizeof(uint16_t));
+                    values[x] = glm::unpackHalf1x16(value16);
+                    break;
+
+                case DDSKTX_FORMAT_R32F:
+                    std::memcpy(&value32, row + x * 4, sizeof(float));
+                    values[x] = value32;
+                    break;
+
+                default:
+                    return std::nullopt;
+                }
+            }
+        }
+
+        return image;
+    }
+
+    DistanceFieldBaker::Grid DistanceFieldBaker::MakeGrid(const Geometry::Dimensions& fieldSize)
+    {
+        Grid grid{ uint32_t(fieldSize.Width), uint32_t(fieldSize.Height), uint32_t(fieldSize.Depth) };
+
+        // Computed exactly as VoxelCentersDistance() of shaders computes them
+        auto centers = [](uint32_t voxelCount)
+        {
+            float voxelSize = 1.0f / float(voxelCount);
+            float voxelHalfSize = voxelSize * 0.5f;
+
+            std::vector<float> values(voxelCount);
+
+            for (uint32_t voxel = 0; voxel < voxelCount; ++voxel)
+            {
+                values[voxel] = float(voxel) * voxelSize + voxelHalfSize;
+            }
+
+            return values;
+        };
+
+        grid.CentersX = centers(grid.Width);
+        grid.CentersY = centers(grid.Height);
+        grid.CentersZ = centers(grid.Depth);
+
+        return grid;
+    }
+
+    void DistanceFieldBaker::SeedCones(const DisplacementImage& displacement, const Grid& grid, std::vector<int32_t>& cones)
+    {
+        glm::vec3 voxelSize = 1.0f / glm::vec3{ grid.Width, grid.Height, grid.Depth };
+
+        // Every voxel of a column covers the same rect of displacement texels
+        uint32_t texelCountX = uint32_t(voxelSize.x * displacement.Width);
+        uint32_t texelCountY = uint32_t(voxelSize.y * displacement.Height);
+
+        std::vector<uint32_t> rows(grid.Height);
+        std::iota(rows.begin(), rows.end(), 0);
+
+        std::for_each(std::execution::par, rows.begin(), rows.end(), [&](uint32_t y)
+        {
+            std::vector<float> samples;
+            samples.reserve(uint64_t(texelCountX) * texelCountY);
+
+            for (uint32_t x = 0; x < grid.Width; ++x)
+            {
+                uint32_t originX = uint32_t((x + 0.5f) / grid.Width * displacement.Width);
+                uint32_t originY = uint32_t((y + 0.5f) / grid.Height * displacement.Height);
+
+                samples.clear();
+
+                for (uint32_t texelY = originY; texelY < originY + texelCountY; ++texelY)
+                {
+                    for (uint32_t texelX = originX; texelX < originX + texelCountX; ++texelX)
+                    {
+                        // Loads outside of a texture return zero
+                        bool isInside = texelX < displacement.Width && texelY < displacement.Height;
+                        samples.push_back(isInside ? displacement.Values[uint64_t(texelY) * displacement.Width + texelX] : 0.0f);
+                    }
+                }
+
+                // Sorted samples answer whether any of them falls into a voxel with a single search
+                std::sort(samples.begin(), samples.end());
+
+                for (uint32_t z = 0; z < grid.Depth; ++z)
+                {
+                    float voxelBottom = (z + 0.5f) / grid.Depth;
+                    float voxelTop = voxelBottom + voxelSize.z;
+
+                    auto firstAboveBottom = std::lower_bound(samples.begin(), samples.end(), voxelBottom);
+
+                    bool isIntersected = firstAboveBottom != samples.end() && *firstAboveBottom < voxelTop;
+                    bool isUnder = samples.empty() || samples.front() > voxelTop;
+
+                    int32_t seed = isIntersected ? PackVoxel(x, y, z) : (isUnder ? VoxelUnderDisplacementMap : VoxelFree);
+                    int32_t* voxelCones = cones.data() + ((uint64_t(z) * grid.Height + y) * grid.Width + x) * 8;
+
+                    std::fill(voxelCones, voxelCones + 8, seed);
+                }
+            }
+        });
+    }
+
+    void DistanceFieldBaker::Flood(const Grid& grid, uint32_t step, const std::vector<int32_t>& sourceCones, std::vector<int32_t>& destinationCones)
+    {
+        const std::array<FloodOffset, 26>& offsets = FloodOffsets();
+        glm::ivec3 gridSize{ grid.Width, grid.Height, grid.Depth };
+
+        std::vector<uint32_t> rows(grid.Height * grid.Depth);
+        std::iota(rows.begin(), rows.end(), 0);
+
+        std::for_each(std::execution::par, rows.begin(), rows.end(), [&](uint32_t row)
+        {
+            uint32_t y = row % grid.Height;
+            uint32_t z = row / grid.Height;
+
+            // Rounded up to SSE width
+            int32_t candidates[28];
+            uint32_t candidateCones[28];
+            float candidateDistances[28];
+            float currentDistances[8];
+
+            for (uint32_t x = 0; x < grid.Width; ++x)
+            {
+                uint64_t voxelIndex = uint64_t(row) * grid.Width + x;
+                const int32_t* cones = sourceCones.data() + voxelIndex * 8;
+                int32_t* floodedCones = destinationCones.data() + voxelIndex * 8;
+
+                std::copy(cones, cones + 8, floodedCones);
+
+                int32_t self = PackVoxel(x, y, z);
+                bool isOriginalSeed = std::all_of(cones, cones + 8, [self](int32_t seed) { return seed == self; });
+                bool isUnder = std::all_of(cones, cones + 8, [](int32_t seed) { return seed == VoxelUnderDisplacementMap; });
+
+                if (isOriginalSeed || isUnder)
+                {
+                    continue;
+                }
+
+                uint32_t candidateCount = 0;
+
+                for (const FloodOffset& offset : offsets)
+                {
+                    glm::ivec3 neighbour = glm::ivec3{ x, y, z } + offset.Direction * int32_t(step);
+
+                    bool isOutOfBounds = glm::any(glm::lessThan(neighbour, glm::ivec3{ 0 })) || glm::any(glm::greaterThanEqual(neighbour, gridSize));
+
+                    if (isOutOfBounds)
+                    {
+                        continue;
+                    }
+
+                    uint64_t neighbourIndex = (uint64_t(neighbour.z) * grid.Height + neighbour.y) * grid.Width + neighbour.x;
+                    int32_t neighbourSeed = sourceCones[neighbourIndex * 8 + offset.Cone];
+
+                    if (neighbourSeed < 0)
+                    {
+                        continue;
+                    }
+
+                    candidates[candidateCount] = neighbourSeed;
+                    candidateCones[candidateCount] = offset.Cone;
+                    ++candidateCount;
+                }
+
+                if (candidateCount == 0)
+                {
+                    continue;
+                }
+
+                SeedDistances(grid, x, y, z, cones, 8, currentDistances);
+                SeedDistances(grid, x, y, z, candidates, candidateCount, candidateDistances);
+
+                // Candidates are taken in order, so a seed replaces the current one only when it's strictly closer
+                for (uint32_t candidate = 0; candidate < candidateCount; ++candidate)
+                {
+                    uint32_t cone = candidateCones[candidate];
+
+                    if (floodedCones[cone] == VoxelFree || candidateDistances[candidate] < currentDistances[cone])
+                    {
+                        currentDistances[cone] = candidateDistances[candidate];
+                        floodedCones[cone] = candidates[candidate];
+                    }
+                }
+            }
+        });
+    }
+
+    std::vector<glm::uvec4> DistanceFieldBaker::Compress(const Grid& grid, const std::vector<int32_t>& cones)
+    {
+        const float maxVoxelDistance = std::sqrt(3.0f);
+
+        std::vector<glm::uvec4> field(uint64_t(grid.Width) * grid.Height * grid.Depth);
+        std::vector<uint32_t> rows(grid.Height * grid.Depth);
+        std::iota(rows.begin(), rows.end(), 0);
+
+        std::for_each(std::execution::par, rows.begin(), rows.end(), [&](uint32_t row)
+        {
+            uint32_t y = row % grid.Height;
+            uint32_t z = row / grid.Height;
+
+            float distances[8];
+
+            for (uint32_t x = 0; x < grid.Width; ++x)
+            {
+                uint64_t voxelIndex = uint64_t(row) * grid.Width + x;
+                const int32_t* voxelCones = cones.data() + voxelIndex * 8;
+
+                SeedDistances(grid, x, y, z, voxelCones, 8, distances);
+
+                for (uint32_t cone = 0; cone < 8; ++cone)
+                {
+                    // Cones that never learned of a seed are stored as zero distance
+                    if (voxelCones[cone] < 0) distances[cone] = 0.0f;
+                }
+
+                field[voxelIndex] = glm::uvec4{
+                    PackUnorm2x16(distances[0], distances[1], maxVoxelDistance),
+                    PackUnorm2x16(distances[2], distances[3], maxVoxelDistance),
+                    PackUnorm2x16(distances[4], distances[5], maxVoxelDistance),
+                    PackUnorm2x16(distances[6], distances[7], maxVoxelDistance)
+                };
+            }
+        });
+
+        return field;
+    }
+
+    void DistanceFieldBaker::SeedDistances(const Grid& grid, uint32_t x, uint32_t y, uint32_t z, const int32_t* seeds, uint32_t seedCount, float* distances)
+    {
+        __m128 voxelX = _mm_set1_ps(grid.CentersX[x]);
+        __m128 voxelY = _mm_set1_ps(grid.CentersY[y]);
+        __m128 voxelZ = _mm_set1_ps(grid.CentersZ[z]);
+
+        for (uint32_t first = 0; first < seedCount; first += 4)
+        {
+            alignas(16) float seedX[4];
+            alignas(16) float seedY[4];
+            alignas(16) float seedZ[4];
+
+            for (uint32_t lane = 0; lane < 4; ++lane)
+            {
+                uint32_t seed = first + lane;
+
+                // Markers and padding measure distance to the voxel itself and are overwritten by callers
+                bool isSeed = seed < seedCount && seeds[seed] >= 0;
+                uint32_t packed = isSeed ? uint32_t(seeds[seed]) : uint32_t(PackVoxel(x, y, z));
+
+                seedX[lane] = grid.CentersX[packed & CoordinateMask];
+                seedY[lane] = grid.CentersY[(packed >> CoordinateBits) & CoordinateMask];
+                seedZ[lane] = grid.CentersZ[(packed >> (CoordinateBits * 2)) & CoordinateMask];
+            }
+
+            __m128 deltaX = _mm_sub_ps(_mm_load_ps(seedX), voxelX);
+            __m128 deltaY = _mm_sub_ps(_mm_load_ps(seedY), voxelY);
+            __m128 deltaZ = _mm_sub_ps(_mm_load_ps(seedZ), voxelZ);
+
+            __m128 squaredLength = _mm_add_ps(_mm_add_ps(_mm_mul_ps(deltaX, deltaX), _mm_mul_ps(deltaY, deltaY)), _mm_mul_ps(deltaZ, deltaZ));
+
+            _mm_storeu_ps(distances + first, _mm_sqrt_ps(squaredLength));
+        }
+    }
+
+}
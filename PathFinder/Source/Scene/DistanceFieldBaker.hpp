@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Geometry/Dimensions.hpp>
+#include <Foundation/MemoryMappedFile.hpp>
+#include <ThirdParty/dds/dds-ktx.h>
+
+#include <glm/vec4.hpp>
+
+#include <optional>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Bakes distance fields of displacement maps on CPU, following the jump flooding passes that used to run on GPU.
+    /// Voxels crossed by the displacement surface are seeds, every voxel above the surface learns the closest seed
+    /// in each of 8 direction cones. Voxel rows are flooded in parallel, distances to candidate seeds are computed four at a time with SSE.
+    /// Baked fields aren't kept, owners store them along with other preprocessed assets.
+    class DistanceFieldBaker
+    {
+    public:
+        struct Statistics
+        {
+            uint32_t BakedFieldCount = 0;
+
+            // Displacement maps of formats that can't be decoded on CPU
+            uint32_t SkippedFieldCount = 0;
+
+            std::chrono::microseconds BakeTime{ 0 };
+        };
+
+        /// Voxels are ordered the way texels of a volume texture are: X first, then Y, then Z.
+        /// Every voxel packs distances of its 8 cones into 16 bit unorms, two per component, the same way the GPU compression pass did.
+        /// Returns nothing for displacement maps of formats that can't be decoded. Safe to call from several threads at once.
+        std::optional<std::vector<glm::uvec4>> Bake(
+            const ddsktx_texture_info& displacementMapInfo,
+            const Foundation::MemoryMappedFile& displacementMapFile,
+            const Geometry::Dimensions& fieldSize);
+
+    private:
+        // Markers cones hold instead of packed seed coordinates
+        inline static const int32_t VoxelFree = -1;
+        inline static const int32_t VoxelUnderDisplacementMap = -2;
+
+        struct DisplacementImage
+        {
+            uint32_t Width = 0;
+            uint32_t Height = 0;
+            std::vector<float> Values;
+        };
+
+        struct Grid
+        {
+            uint32_t Width = 0;
+            uint32_t Height = 0;
+            uint32_t Depth = 0;
+
+            // Voxel centers in texture space along each axis
+            std::vector<float> CentersX;
+            std::vector<float> CentersY;
+            std::vector<float> CentersZ;
+        };
+
+        // Red channel of the most detailed mip as shaders would read it. Returns nothing for unsupported formats.
+        static std::optional<DisplacementImage> DecodeDisplacement(const ddsktx_texture_info& textureInfo, const Foundation::MemoryMappedFile& file);
+
+        static Grid MakeGrid(const Geometry::Dimensions& fieldSize);
+
+        // Cones of a voxel hold packed coordinates of the closest seeds or markers,
+        // distances are recomputed from coordinates, which is cheaper than storing them
+        static void SeedCones(const DisplacementImage& displacement, const Grid& grid, std::vector<int32_t>& cones);
+        static void Flood(const Grid& grid, uint32_t step, const std::vector<int32_t>& sourceCones, std::vector<int32_t>& destinationCones);
+        static std::vector<glm::uvec4> Compress(const Grid& grid, const std::vector<int32_t>& cones);
+
+        // Distances between centers of the voxel and seeds, 'distances' must fit 'seedCount' rounded up to 4
+        static void SeedDistances(const Grid& grid, uint32_t x, uint32_t y, uint32_t z, const int32_t* seeds, uint32_t seedCount, float* distances);
+
+        Statistics mStatistics;
+        std::mutex mStatisticsMutex;
+
+    public:
+        inline const auto& GetStatistics() const { return mStatistics; }
+    };
+
+}
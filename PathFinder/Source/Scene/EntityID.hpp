@@ -1,7 +1,7 @@
 #pragma once
 
 #include <cstdint>
-#include <HardwareAbstractionLayer/RayTracingAccelerationStructure.hpp>
+#include <limits>
 #include <Foundation/BitwiseEnum.hpp>
 
 namespace PathFinder 
@@ -16,11 +16,6 @@ namespace PathFinder
         Unknown = 0, MeshInstance = 1 << 0, Light = 1 << 1
     };
 
-    inline HAL::RayTracingTopAccelerationStructure::InstanceInfo RTASInstanceInfoForEntity(EntityID id, EntityMask mask)
-    {
-        return { id, std::underlying_type_t<EntityMask>(mask) };
-    }
-
 }
 
 ENABLE_BITMASK_OPERATORS(PathFinder::EntityMask);
\ No newline at end of file
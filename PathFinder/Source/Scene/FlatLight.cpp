@@ -49,6 +49,7 @@ namespace PathFinder
 
         glm::vec3 up = glm::abs(glm::dot(mNormal, UpY)) < 0.999 ? UpY : UpZ;
         mModelMatrix = glm::translate(mPosition) * glm::lookAt(mPosition, mPosition + mNormal, up) * glm::scale(glm::vec3{ mWidth, mHeight, 1.0f });
+        ++mVersion;
     }
 
 }
@@ -3,6 +3,7 @@
 #include "Light.hpp"
 
 #include <glm/vec3.hpp>
+#include <Foundation/SlotMap.hpp>
 
 namespace PathFinder 
 {
@@ -41,4 +42,6 @@ namespace PathFinder
         inline const auto& Height() const { return mHeight; }
     };
 
+    using FlatLightHandle = Foundation::SlotMapHandle<FlatLight>;
+
 }
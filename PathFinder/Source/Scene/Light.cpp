@@ -10,6 +10,7 @@ namespace PathFinder
     void Light::SetColor(const Foundation::Color& color)
     {
         mColor = color;
+        ++mVersion;
     }
 
     void Light::SetColorTemperature(Kelvin temperature)
@@ -21,6 +22,7 @@ namespace PathFinder
     {
         mLuminousPower = luminousPower;
         mLuminance = mLuminousPower / mArea / M_PI;
+        ++mVersion;
 
         // Luminance due to a point on a Lambertian emitter, emitted in any direction, 
         // is equal to its total luminous power Phi divided by the emitter area A and the projected solid angle (Pi)
@@ -36,6 +36,9 @@ namespace PathFinder
         EntityID mEntityID = 0;
         uint32_t mIndexInGPUTable = 0;
 
+        // Incremented on every change affecting GPU representation of the light
+        uint64_t mVersion = 0;
+
     private:
         Lumen mLuminousPower = 0.0;
         Nit mLuminance = 0.0;
@@ -50,6 +53,8 @@ namespace PathFinder
         inline const glm::mat4& ModelMatrix() const { return mModelMatrix; }
         inline const EntityID& ID() const { return mEntityID; }
         inline auto IndexInGPUTable() const { return mIndexInGPUTable; }
+        inline auto Version() const { return mVersion; }
+        inline bool IsEnabled() const { return mLuminousPower > 0.0; }
         inline const VertexStorageLocation& LocationInVertexStorage() const { return mVertexStorageLocation; }
     };
 
@@ -1,14 +1,27 @@
 #pragma once
 
-#include <Memory/GPUResourceProducer.hpp>
+#include <Foundation/SlotMap.hpp>
 
 #include <bitsery/bitsery.h>
 
+#include <string>
+#include <limits>
+
+namespace Memory
+{
+    class Texture;
+}
+
 namespace PathFinder 
 {
 
     struct Material
     {
+        inline static const uint64_t MaxPathLength = 1024;
+
+        // Slice of maps that are not packed into texture arrays
+        inline static const uint32_t NoArraySlice = std::numeric_limits<uint32_t>::max();
+
         Memory::Texture* AlbedoMap = nullptr;
         Memory::Texture* NormalMap = nullptr;
         Memory::Texture* RoughnessMap = nullptr;
@@ -23,6 +36,13 @@ namespace PathFinder
         Memory::Texture* LTC_LUT_Matrix_Diffuse = nullptr;
         Memory::Texture* LTC_LUT_Terms_Diffuse = nullptr;
 
+        // Maps packed into texture arrays reference the array and their slice in it
+        uint32_t AlbedoMapSlice = NoArraySlice;
+        uint32_t NormalMapSlice = NoArraySlice;
+        uint32_t RoughnessMapSlice = NoArraySlice;
+        uint32_t MetalnessMapSlice = NoArraySlice;
+        uint32_t AOMapSlice = NoArraySlice;
+
         std::string AlbedoMapPath;
         std::string NormalMapPath;
         std::string RoughnessMapPath;
@@ -36,14 +56,16 @@ namespace PathFinder
         template <typename S>
         void serialize(S& s)
         {
-            s.text(AlbedoMapPath);
-            s.text(NormalMapPath);
-            s.text(RoughnessMapPath);
-            s.text(MetalnessMapPath);
-            s.text(AOMapPath);
-            s.text(DisplacementMapPath);
-            s.text(DistanceFieldPath);
+            s.text1b(AlbedoMapPath, MaxPathLength);
+            s.text1b(NormalMapPath, MaxPathLength);
+            s.text1b(RoughnessMapPath, MaxPathLength);
+            s.text1b(MetalnessMapPath, MaxPathLength);
+            s.text1b(AOMapPath, MaxPathLength);
+            s.text1b(DisplacementMapPath, MaxPathLength);
+            s.text1b(DistanceFieldPath, MaxPathLength);
         }
     };
 
+    using MaterialHandle = Foundation::SlotMapHandle<Material>;
+
 }
@@ -1,12 +1,21 @@
 #include "MaterialLoader.hpp"
 
 #include <glm/gtc/type_precision.hpp>
+#include <robinhood/robin_hood.h>
+
+#include <unordered_set>
+#include <execution>
+#include <numeric>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <tuple>
 
 namespace PathFinder
 {
 
     MaterialLoader::MaterialLoader(const std::filesystem::path& executableFolder, PreprocessableAssetStorage* assetStorage, Memory::GPUResourceProducer* resourceProducer)
-        : mAssetStorage{ assetStorage }, mResourceLoader{ executableFolder, resourceProducer }, mResourceProducer{ resourceProducer }
+        : mAssetStorage{ assetStorage }, mResourceLoader{ executableFolder, resourceProducer }, mTextureStreamer{ &mResourceLoader }, mTextureCooker{ executableFolder, "/CookedTextures" }, mResourceProducer{ resourceProducer }
     {
         CreateDefaultTextures();
         LoadLTCLookupTables();
@@ -20,20 +29,267 @@ namespace PathFinder
         std::optional<std::string> displacementMapRelativePath,
         std::optional<std::string> distanceFieldRelativePath,
         std::optional<std::string> AOMapRelativePath)
+    {
+        MaterialFiles files{
+            albedoMapRelativePath,
+            normalMapRelativePath,
+            roughnessMapRelativePath.value_or(""),
+            metalnessMapRelativePath.value_or(""),
+            displacementMapRelativePath.value_or(""),
+            distanceFieldRelativePath.value_or(""),
+            AOMapRelativePath.value_or("") };
+
+        return std::move(LoadMaterials({ files }).front());
+    }
+
+    std::vector<Material> MaterialLoader::LoadMaterials(const std::vector<MaterialFiles>& materials)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        using Usage = TextureCooker::Usage;
+
+        std::vector<TextureRequest> requests;
+
+        for (const MaterialFiles& files : materials)
+        {
+            requests.push_back({ files.AlbedoMap, Usage::Albedo });
+            requests.push_back({ files.NormalMap, Usage::Normal });
+            requests.push_back({ files.RoughnessMap, Usage::Scalar });
+            requests.push_back({ files.MetalnessMap, Usage::Scalar });
+            requests.push_back({ files.AOMap, Usage::Scalar });
+
+            // Distance fields are baked from displacement maps, which therefore have to be complete
+            requests.push_back({ files.DisplacementMap, std::nullopt });
+        }
+
+        LoadTextures(requests);
+
+        std::vector<Material> loadedMaterials;
+        loadedMaterials.reserve(materials.size());
+
+        for (const MaterialFiles& files : materials)
+        {
+            loadedMaterials.push_back(AssembleMaterial(files));
+        }
+
+        mStatistics.MaterialCount += (uint32_t)materials.size();
+        mStatistics.LoadTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+        return loadedMaterials;
+    }
+
+    void MaterialLoader::PackTextures(Foundation::SlotMap<Material>& materials)
+    {
+        if (!mSettings.PackTexturesIntoArrays) return;
+
+        struct MaterialMap
+        {
+            Memory::Texture** Texture;
+            uint32_t* Slice;
+            const std::string* Path;
+        };
+
+        auto materialMaps = [](Material& material)
+        {
+            return std::array<MaterialMap, 5>{ {
+                { &material.AlbedoMap, &material.AlbedoMapSlice, &material.AlbedoMapPath },
+                { &material.NormalMap, &material.NormalMapSlice, &material.NormalMapPath },
+                { &material.RoughnessMap, &material.RoughnessMapSlice, &material.RoughnessMapPath },
+                { &material.MetalnessMap, &material.MetalnessMapSlice, &material.MetalnessMapPath },
+                { &material.AOMap, &material.AOMapSlice, &material.AOMapPath } } };
+        };
+
+        // Maps are read once more from their files since streamed textures have only a part of their mips.
+        // Materials refer to source paths, while cooked or deduplicated files are the ones that are read.
+        std::vector<std::string> paths;
+        std::vector<ResourceLoader::MappedTexture> files;
+        std::unordered_set<std::string> visitedPaths;
+
+        for (Material& material : materials)
+        {
+            for (const MaterialMap& map : materialMaps(material))
+            {
+                bool isPacked = *map.Slice != Material::NoArraySlice;
+                const std::string& loadPath = TextureLoadPath(*map.Path);
+
+                if (isPacked || map.Path->empty() || !visitedPaths.insert(loadPath).second) continue;
+
+                std::optional<ResourceLoader::MappedTexture> file = mResourceLoader.MapTexture(loadPath);
+
+                // Shaders sample packed maps as single slices, so textures that are arrays themselves are left alone
+                if (!file || ResourceLoader::ArraySliceCount(file->Info) != 1) continue;
+
+                paths.push_back(loadPath);
+                files.push_back(std::move(*file));
+            }
+        }
+
+        std::vector<std::vector<uint32_t>> arrays;
+
+        for (uint32_t fileIdx = 0; fileIdx < files.size(); ++fileIdx)
+        {
+            auto arrayIt = std::find_if(arrays.begin(), arrays.end(), [&](const std::vector<uint32_t>& array)
+            {
+                return ResourceLoader::AreArrayCompatible(files[array.front()], files[fileIdx]);
+            });
+
+            if (arrayIt != arrays.end()) arrayIt->push_back(fileIdx);
+            else arrays.push_back({ fileIdx });
+        }
+
+        std::unordered_map<std::string, std::pair<Memory::Texture*, uint32_t>> packedMaps;
+
+        for (const std::vector<uint32_t>& array : arrays)
+        {
+            // Nothing to save on a single texture
+            if (array.size() < 2) continue;
+
+            std::vector<const ResourceLoader::MappedTexture*> arrayFiles;
+
+            for (uint32_t fileIdx : array)
+            {
+                arrayFiles.push_back(&files[fileIdx]);
+            }
+
+            auto textureArray = mResourceLoader.CreateTextureArray(arrayFiles, "Material Texture Array " + std::to_string(mTextureArrays.size()));
+
+            for (uint32_t slice = 0; slice < array.size(); ++slice)
+            {
+                const std::string& path = paths[array[slice]];
+                packedMaps.emplace(path, std::make_pair(textureArray.get(), slice));
+                mTextureStreamer.Release(path);
+            }
+
+            mStatistics.PackedTextureCount += (uint32_t)array.size();
+            mStatistics.TextureArrayCount += 1;
+            mTextureArrays.push_back(std::move(textureArray));
+        }
+
+        for (Material& material : materials)
+        {
+            for (const MaterialMap& map : materialMaps(material))
+            {
+                auto packedIt = packedMaps.find(TextureLoadPath(*map.Path));
+
+                if (packedIt == packedMaps.end()) continue;
+
+                std::tie(*map.Texture, *map.Slice) = packedIt->second;
+            }
+        }
+    }
+
+    MaterialLoader::PreparedTexture MaterialLoader::PrepareTexture(const TextureRequest& request)
+    {
+        PreparedTexture texture{};
+
+        std::optional<std::string> cookedPath = request.Usage && mSettings.CookTextures ?
+            mTextureCooker.Cook(request.RelativePath, *request.Usage) : std::nullopt;
+
+        texture.LoadPath = cookedPath.value_or(request.RelativePath);
+        texture.File = mResourceLoader.MapTexture(texture.LoadPath);
+
+        if (!texture.File) return texture;
+
+        // Streamed and fully loaded textures are kept apart even if their contents match
+        texture.ContentHash = ContentHash(*texture.File) ^ uint64_t(request.Usage.has_value());
+
+        // Pages are brought into memory here, so that the calling thread only copies them to upload memory
+        if (request.Usage) mTextureStreamer.PrefetchMipTail(*texture.File);
+        else ResourceLoader::Prefetch(*texture.File, 0);
+
+        return texture;
+    }
+
+    void MaterialLoader::LoadTextures(const std::vector<TextureRequest>& requests)
+    {
+        std::vector<TextureRequest> newRequests;
+        std::unordered_set<std::string> requestedPaths;
+
+        for (const TextureRequest& request : requests)
+        {
+            if (request.RelativePath.empty() || mTextureLoadPaths.count(request.RelativePath)) continue;
+            if (requestedPaths.insert(request.RelativePath).second) newRequests.push_back(request);
+        }
+
+        std::vector<PreparedTexture> preparedTextures(newRequests.size());
+        std::vector<uint32_t> requestIndices(newRequests.size());
+        std::iota(requestIndices.begin(), requestIndices.end(), 0);
+
+        // Files are cooked, mapped and prefetched on the shared worker pool, however many textures there are
+        std::for_each(std::execution::par, requestIndices.begin(), requestIndices.end(), [&](uint32_t requestIdx)
+        {
+            preparedTextures[requestIdx] = PrepareTexture(newRequests[requestIdx]);
+        });
+
+        // Textures are created in request order, since GPU resources can only be created from this thread
+        for (uint32_t requestIdx = 0; requestIdx < newRequests.size(); ++requestIdx)
+        {
+            const TextureRequest& request = newRequests[requestIdx];
+            PreparedTexture& texture = preparedTextures[requestIdx];
+
+            // Unreadable files are left for the usual path, which will fail to load them as well
+            if (!texture.File)
+            {
+                mTextureLoadPaths.emplace(request.RelativePath, request.RelativePath);
+                continue;
+            }
+
+            auto [firstCandidate, lastCandidate] = mTextureContentPaths.equal_range(texture.ContentHash);
+
+            auto duplicateIt = std::find_if(firstCandidate, lastCandidate, [&](const auto& candidate)
+            {
+                return IsSameContent(*texture.File, candidate.second);
+            });
+
+            if (duplicateIt != lastCandidate)
+            {
+                mTextureLoadPaths.emplace(request.RelativePath, duplicateIt->second);
+                mStatistics.DuplicateTextureCount += 1;
+                mStatistics.DuplicateBytes += texture.File->File.Size();
+                continue;
+            }
+
+            mTextureLoadPaths.emplace(request.RelativePath, texture.LoadPath);
+            mTextureContentPaths.emplace(texture.ContentHash, texture.LoadPath);
+            mStatistics.UniqueTextureCount += 1;
+
+            if (request.Usage)
+            {
+                mTextureStreamer.LoadTexture(texture.LoadPath, std::move(*texture.File));
+            }
+            else if (!mMaterialTextures.count(texture.LoadPath))
+            {
+                mMaterialTextures.emplace(texture.LoadPath, mResourceLoader.CreateTexture(*texture.File));
+            }
+        }
+    }
+
+    Material MaterialLoader::AssembleMaterial(const MaterialFiles& files)
     {
         Material material{};
 
-        material.AlbedoMap = GetOrAllocateTexture(albedoMapRelativePath);
-        material.NormalMap = GetOrAllocateTexture(normalMapRelativePath);
+        // Paths are kept for serialization, absent optional maps are stored as empty paths
+        material.AlbedoMapPath = files.AlbedoMap;
+        material.NormalMapPath = files.NormalMap;
+        material.RoughnessMapPath = files.RoughnessMap;
+        material.MetalnessMapPath = files.MetalnessMap;
+        material.DisplacementMapPath = files.DisplacementMap;
+        material.AOMapPath = files.AOMap;
 
-        if (roughnessMapRelativePath) material.RoughnessMap = GetOrAllocateTexture(*roughnessMapRelativePath);
-        if (metalnessMapRelativePath) material.MetalnessMap = GetOrAllocateTexture(*metalnessMapRelativePath);
-        if (displacementMapRelativePath) material.DisplacementMap = GetOrAllocateTexture(*displacementMapRelativePath);
-        if (AOMapRelativePath) material.AOMap = GetOrAllocateTexture(*AOMapRelativePath);
+        material.AlbedoMap = GetOrLoadStreamedTexture(TextureLoadPath(files.AlbedoMap));
+        material.NormalMap = GetOrLoadStreamedTexture(TextureLoadPath(files.NormalMap));
 
-        if (material.DisplacementMap && distanceFieldRelativePath)
+        if (!files.RoughnessMap.empty()) material.RoughnessMap = GetOrLoadStreamedTexture(TextureLoadPath(files.RoughnessMap));
+        if (!files.MetalnessMap.empty()) material.MetalnessMap = GetOrLoadStreamedTexture(TextureLoadPath(files.MetalnessMap));
+        if (!files.AOMap.empty()) material.AOMap = GetOrLoadStreamedTexture(TextureLoadPath(files.AOMap));
+        if (!files.DisplacementMap.empty()) material.DisplacementMap = GetOrAllocateTexture(TextureLoadPath(files.DisplacementMap));
+
+        if (material.DisplacementMap && !files.DistanceField.empty())
         {
-            material.DistanceField = GetOrAllocateTexture(*distanceFieldRelativePath);
+            const std::string& distanceFieldRelativePath = files.DistanceField;
+
+            material.DistanceField = GetOrAllocateTexture(distanceFieldRelativePath);
+            material.DistanceFieldPath = distanceFieldRelativePath;
 
             if (!material.DistanceField)
             {
@@ -41,12 +297,49 @@ namespace PathFinder
                     HAL::ColorFormat::RGBA32_Unsigned, HAL::TextureKind::Texture3D,
                     DistanceFieldTextureSize, HAL::ResourceState::UnorderedAccess, HAL::ResourceState::AnyShaderAccess };
 
-                material.DistanceField = AllocateAndStoreTexture(distFieldProperties, *distanceFieldRelativePath);
+                Memory::GPUResourceProducer::TexturePtr distanceField = mResourceProducer->NewTexture(distFieldProperties);
+
+                // Distance fields are baked anew only when their displacement maps change
+                std::optional<ResourceLoader::MappedTexture> displacementFile = mResourceLoader.MapTexture(TextureLoadPath(files.DisplacementMap));
+                bool isFilled = false;
+
+                if (displacementFile)
+                {
+                    PreprocessableAssetStorage::CacheKey cacheKey{
+                        std::filesystem::path{ distanceFieldRelativePath }.filename().string(),
+                        robin_hood::hash_bytes(displacementFile->File.Data(), displacementFile->File.Size()),
+                        DistanceFieldVersion };
+
+                    // Stored fields are copied from mapped files straight into upload memory
+                    isFilled = mAssetStorage->LoadCachedAsset(distanceField.get(), cacheKey,
+                        [this](Memory::GPUResource* asset, const std::string& cachedPath)
+                        {
+                            return mResourceLoader.LoadStoredResource(*asset, cachedPath);
+                        });
+
+                    if (!isFilled && mSettings.BakeDistanceFieldsOnCPU)
+                    {
+                        std::optional<std::vector<glm::uvec4>> bakedField = 
+                            mDistanceFieldBaker.Bake(displacementFile->Info, displacementFile->File, DistanceFieldTextureSize);
 
-                mAssetStorage->PreprocessAsset(material.DistanceField, [this, distanceFieldRelativePath](Memory::GPUResource* distanceField)
+                        if (bakedField)
+                        {
+                            const uint8_t* contents = reinterpret_cast<const uint8_t*>(bakedField->data());
+                            ResourceLoader::WriteTextureContents(*distanceField, contents);
+
+                            // Failing to store a field is not an error, it's baked again next time
+                            mResourceLoader.StoreTextureContents(*distanceField, contents, mAssetStorage->CachedAssetPath(cacheKey));
+                            isFilled = true;
+                        }
+                    }
+                }
+
+                // GPU generation pass is disabled, so fields that can't be baked on CPU are left out
+                if (isFilled)
                 {
-                    mResourceLoader.StoreResource(*distanceField, *distanceFieldRelativePath);
-                });
+                    material.DistanceField = distanceField.get();
+                    mMaterialTextures[distanceFieldRelativePath] = std::move(distanceField);
+                }
             }
         }
 
@@ -69,6 +362,38 @@ namespace PathFinder
         return material;
     }
 
+    uint64_t MaterialLoader::ContentHash(const ResourceLoader::MappedTexture& texture)
+    {
+        const uint64_t HeaderSize = 4096;
+        const uint64_t TailSize = 65536;
+
+        uint64_t fileSize = texture.File.Size();
+        uint64_t headerSize = std::min(fileSize, HeaderSize);
+        uint64_t tailSize = std::min(fileSize, TailSize);
+
+        uint64_t values[3] = {
+            fileSize,
+            robin_hood::hash_bytes(texture.File.Data(), headerSize),
+            robin_hood::hash_bytes(texture.File.Data() + fileSize - tailSize, tailSize) };
+
+        return robin_hood::hash_bytes(values, sizeof(values));
+    }
+
+    bool MaterialLoader::IsSameContent(const ResourceLoader::MappedTexture& texture, const std::string& relativePath) const
+    {
+        std::optional<ResourceLoader::MappedTexture> other = mResourceLoader.MapTexture(relativePath);
+
+        return other &&
+            other->File.Size() == texture.File.Size() &&
+            std::memcmp(other->File.Data(), texture.File.Data(), texture.File.Size()) == 0;
+    }
+
+    const std::string& MaterialLoader::TextureLoadPath(const std::string& relativePath) const
+    {
+        auto pathIt = mTextureLoadPaths.find(relativePath);
+        return pathIt != mTextureLoadPaths.end() ? pathIt->second : relativePath;
+    }
+
     Memory::Texture* MaterialLoader::GetOrAllocateTexture(const std::string& relativePath)
     {
         auto textureIt = mMaterialTextures.find(relativePath);
@@ -84,10 +409,9 @@ namespace PathFinder
         }
     }
 
-    Memory::Texture* MaterialLoader::AllocateAndStoreTexture(const HAL::TextureProperties& properties, const std::string& relativePath)
+    Memory::Texture* MaterialLoader::GetOrLoadStreamedTexture(const std::string& relativePath)
     {
-        auto [iter, success] = mMaterialTextures.emplace(relativePath, mResourceProducer->NewTexture(properties));
-        return iter->second.get();
+        return mTextureStreamer.LoadTexture(relativePath);
     }
 
     void MaterialLoader::CreateDefaultTextures()
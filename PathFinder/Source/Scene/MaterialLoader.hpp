@@ -2,14 +2,20 @@
 
 #include "Material.hpp"
 #include "ResourceLoader.hpp"
+#include "TextureStreamer.hpp"
+#include "TextureCooker.hpp"
+#include "DistanceFieldBaker.hpp"
 
 #include <RenderPipeline/PreprocessableAssetStorage.hpp>
 #include <HardwareAbstractionLayer/Buffer.hpp>
 #include <Memory/GPUResourceProducer.hpp>
 
 #include <filesystem>
+#include <unordered_map>
+#include <chrono>
 #include <string>
 #include <optional>
+#include <vector>
 
 namespace PathFinder 
 {
@@ -17,8 +23,53 @@ namespace PathFinder
     class MaterialLoader
     {
     public:
+        struct Settings
+        {
+            // Lets PackTextures() put material maps of the same format, size and mip count into texture arrays,
+            // which saves descriptors and allocations. Packed maps are loaded in full and are no longer streamed.
+            bool PackTexturesIntoArrays = false;
+
+            // Uncompressed maps are converted into block compressed ones on first load and read from the cache afterwards.
+            // Displacement maps are used for distance field baking and stay as they are.
+            bool CookTextures = true;
+
+            // Distance fields are baked on CPU while materials load. Fields of displacement maps
+            // the CPU baker can't decode, and all fields when disabled, are left to GPU preprocessing.
+            bool BakeDistanceFieldsOnCPU = true;
+        };
+
+        struct Statistics
+        {
+            uint32_t PackedTextureCount = 0;
+            uint32_t TextureArrayCount = 0;
+
+            // Of all materials loaded so far
+            uint32_t MaterialCount = 0;
+            uint32_t UniqueTextureCount = 0;
+            std::chrono::microseconds LoadTime{ 0 };
+
+            // Files whose contents match an already loaded texture under another path
+            uint32_t DuplicateTextureCount = 0;
+            uint64_t DuplicateBytes = 0;
+        };
+
+        /// Relative paths of material maps, absent optional maps are left empty
+        struct MaterialFiles
+        {
+            std::string AlbedoMap;
+            std::string NormalMap;
+            std::string RoughnessMap;
+            std::string MetalnessMap;
+            std::string DisplacementMap;
+            std::string DistanceField;
+            std::string AOMap;
+        };
+
         inline static const Geometry::Dimensions DistanceFieldTextureSize{ 128, 128, 64 };
 
+        // Incremented whenever distance field baking starts producing different results
+        inline static const uint32_t DistanceFieldVersion = 1;
+
         MaterialLoader(const std::filesystem::path& executableFolder, PreprocessableAssetStorage* assetStorage, Memory::GPUResourceProducer* resourceProducer);
 
         Material LoadMaterial(
@@ -30,6 +81,15 @@ namespace PathFinder
             std::optional<std::string> distanceMapRelativePath = std::nullopt,
             std::optional<std::string> AOMapRelativePath = std::nullopt);
 
+        /// Textures of all materials are cooked, mapped and read in on worker threads,
+        /// while textures that are ready are created and uploaded on the calling one.
+        /// Textures with identical contents are loaded once and shared no matter their paths.
+        std::vector<Material> LoadMaterials(const std::vector<MaterialFiles>& materials);
+
+        /// Packs streamed maps of materials into texture arrays and patches materials to reference array slices.
+        /// Maps that have no compatible counterparts are left as they are. Does nothing unless enabled in settings.
+        void PackTextures(Foundation::SlotMap<Material>& materials);
+
     private:
         struct SerializationData
         {
@@ -39,13 +99,48 @@ namespace PathFinder
             const HAL::Buffer* DistanceAtlasCounterBuffer;
         };
 
+        struct TextureRequest
+        {
+            std::string RelativePath;
+
+            // Textures without usage are neither cooked nor streamed
+            std::optional<TextureCooker::Usage> Usage;
+        };
+
+        struct PreparedTexture
+        {
+            std::string LoadPath;
+            std::optional<ResourceLoader::MappedTexture> File;
+            uint64_t ContentHash = 0;
+        };
+
+        // Cooks, maps and reads in textures seen for the first time, done on worker threads
+        PreparedTexture PrepareTexture(const TextureRequest& request);
+        void LoadTextures(const std::vector<TextureRequest>& requests);
+        Material AssembleMaterial(const MaterialFiles& files);
+
+        // Hashing whole files would read in mips that are meant to be streamed, so only the header and the end
+        // of the file, which holds the smallest mips, are hashed. Matching hashes are confirmed by comparing files.
+        static uint64_t ContentHash(const ResourceLoader::MappedTexture& texture);
+        bool IsSameContent(const ResourceLoader::MappedTexture& texture, const std::string& relativePath) const;
+
+        // Path of the file that is actually loaded for a material map:
+        // the cooked one or the first file of the same contents
+        const std::string& TextureLoadPath(const std::string& relativePath) const;
+
         Memory::Texture* GetOrAllocateTexture(const std::string& relativePath);
-        Memory::Texture* AllocateAndStoreTexture(const HAL::TextureProperties& properties, const std::string& relativePath);
+
+        // Streamed textures are created with their mip tails only, callers have to apply
+        // replacements reported by the streamer to keep their references valid
+        Memory::Texture* GetOrLoadStreamedTexture(const std::string& relativePath);
 
         void CreateDefaultTextures();
         void LoadLTCLookupTables();
 
         std::unordered_map<std::string, Memory::GPUResourceProducer::TexturePtr> mMaterialTextures;
+        std::unordered_map<std::string, std::string> mTextureLoadPaths;
+        std::unordered_multimap<uint64_t, std::string> mTextureContentPaths;
+        std::vector<Memory::GPUResourceProducer::TexturePtr> mTextureArrays;
         Memory::GPUResourceProducer::TexturePtr m1x1Black2DTexture;
         Memory::GPUResourceProducer::TexturePtr m1x1White2DTexture;
         Memory::GPUResourceProducer::TexturePtr m1x1Black3DTexture;
@@ -61,6 +156,23 @@ namespace PathFinder
         Memory::GPUResourceProducer* mResourceProducer;
         PreprocessableAssetStorage* mAssetStorage;
         ResourceLoader mResourceLoader;
+        TextureStreamer mTextureStreamer;
+        TextureCooker mTextureCooker;
+        DistanceFieldBaker mDistanceFieldBaker;
+        Settings mSettings;
+        Statistics mStatistics;
+
+    public:
+        inline const auto& GetSettings() const { return mSettings; }
+        inline const auto& GetStatistics() const { return mStatistics; }
+
+        inline const auto& TextureLoadStatistics() const { return mResourceLoader.GetStatistics(); }
+        inline const TextureStreamer& TextureStreaming() const { return mTextureStreamer; }
+        inline TextureStreamer& TextureStreaming() { return mTextureStreamer; }
+        inline const auto& TextureCookingStatistics() const { return mTextureCooker.GetStatistics(); }
+        inline const auto& DistanceFieldBakingStatistics() const { return mDistanceFieldBaker.GetStatistics(); }
+
+        inline void SetSettings(const Settings& settings) { mSettings = settings; }
     };
 
 }
@@ -1,6 +1,7 @@
 #include "Mesh.hpp"
 
 #include <Geometry/Triangle3D.hpp>
+#include <Foundation/Assert.hpp>
 
 namespace PathFinder
 {
@@ -10,6 +11,16 @@ namespace PathFinder
         return mName;
     }
 
+    const std::string& Mesh::SourceFile() const
+    {
+        return mSourceFile;
+    }
+
+    uint32_t Mesh::IndexInSourceFile() const
+    {
+        return mIndexInSourceFile;
+    }
+
     std::vector<Vertex1P1N1UV1T1BT>& Mesh::Vertices()
     {
         return mVertices;
@@ -20,11 +31,70 @@ namespace PathFinder
         return mVertices;
     }
 
+    const std::vector<Vertex1P1N1UV1T1BTPacked>& Mesh::PackedVertices() const
+    {
+        return mPackedVertices;
+    }
+
+    const VertexPackingError& Mesh::PackingError() const
+    {
+        return mPackingError;
+    }
+
+    bool Mesh::HasPackedVertices() const
+    {
+        return !mPackedVertices.empty();
+    }
+
     const std::vector<uint32_t>& Mesh::Indices() const
     {
         return mIndices;
     }
 
+    const std::vector<Meshlet>& Mesh::Meshlets() const
+    {
+        return mMeshlets;
+    }
+
+    const std::vector<uint32_t>& Mesh::MeshletVertexIndices() const
+    {
+        return mMeshletVertexIndices;
+    }
+
+    const std::vector<uint32_t>& Mesh::MeshletTriangles() const
+    {
+        return mMeshletTriangles;
+    }
+
+    const MeshOptimizationReport& Mesh::OptimizationReport() const
+    {
+        return mOptimizationReport;
+    }
+
+    const std::vector<MeshLOD>& Mesh::LODs() const
+    {
+        return mLODs;
+    }
+
+    const std::vector<uint32_t>& Mesh::LODIndices(uint32_t lod) const
+    {
+        assert_format(lod < LODCount(), "LOD ", lod, " does not exist");
+
+        return lod == 0 ? mIndices : mLODs[lod - 1].Indices;
+    }
+
+    float Mesh::LODError(uint32_t lod) const
+    {
+        assert_format(lod < LODCount(), "LOD ", lod, " does not exist");
+
+        return lod == 0 ? 0.0f : mLODs[lod - 1].Error;
+    }
+
+    uint32_t Mesh::LODCount() const
+    {
+        return uint32_t(mLODs.size()) + 1;
+    }
+
     const Geometry::AxisAlignedBox3D& Mesh::BoundingBox() const
     {
         return mBoundingBox;
@@ -35,6 +105,25 @@ namespace PathFinder
         return mVertexStorageLocation;
     }
 
+    bool Mesh::HasLocationInVertexStorage() const
+    {
+        return mHasVertexStorageLocation;
+    }
+
+    IndexStorageLocation Mesh::LODLocationInIndexStorage(uint32_t lod) const
+    {
+        assert_format(lod < LODCount(), "LOD ", lod, " does not exist");
+
+        if (lod == 0)
+        {
+            return { mVertexStorageLocation.IndexBufferOffset, mVertexStorageLocation.IndexCount };
+        }
+
+        assert_format(lod <= mLODIndexStorageLocations.size(), "LOD ", lod, " has no location in index storage");
+
+        return mLODIndexStorageLocations[lod - 1];
+    }
+
     float Mesh::SurfaceArea() const
     {
         return mArea;
@@ -50,6 +139,12 @@ namespace PathFinder
         mName = name;
     }
 
+    void Mesh::SetSource(const std::string& file, uint32_t indexInFile)
+    {
+        mSourceFile = file;
+        mIndexInSourceFile = indexInFile;
+    }
+
     void Mesh::SetHasTangentSpace(bool hts)
     {
         mHasTangentSpace = hts;
@@ -58,6 +153,7 @@ namespace PathFinder
     void Mesh::SetVertexStorageLocation(const VertexStorageLocation& location)
     {
         mVertexStorageLocation = location;
+        mHasVertexStorageLocation = true;
     }
 
     void Mesh::AddVertex(const Vertex1P1N1UV1T1BT& vertex)
@@ -87,6 +183,43 @@ namespace PathFinder
         mIndices.push_back(index);
     }
 
+    void Mesh::SetIndices(std::vector<uint32_t>&& indices)
+    {
+        mIndices = std::move(indices);
+    }
+
+    void Mesh::SetOptimizationReport(const MeshOptimizationReport& report)
+    {
+        mOptimizationReport = report;
+    }
+
+    void Mesh::AddLOD(MeshLOD&& lod)
+    {
+        mLODs.emplace_back(std::move(lod));
+    }
+
+    void Mesh::SetLODIndexStorageLocations(std::vector<IndexStorageLocation>&& locations)
+    {
+        assert_format(locations.size() == mLODs.size(), "Every LOD must have a location in index storage");
+
+        mLODIndexStorageLocations = std::move(locations);
+    }
+
+    void Mesh::SetPackedVertices(std::vector<Vertex1P1N1UV1T1BTPacked>&& vertices, const VertexPackingError& error)
+    {
+        assert_format(vertices.empty() || vertices.size() == mVertices.size(), "Packed vertex count must match source vertex count");
+
+        mPackedVertices = std::move(vertices);
+        mPackingError = error;
+    }
+
+    void Mesh::SetMeshlets(std::vector<Meshlet>&& meshlets, std::vector<uint32_t>&& vertexIndices, std::vector<uint32_t>&& triangles)
+    {
+        mMeshlets = std::move(meshlets);
+        mMeshletVertexIndices = std::move(vertexIndices);
+        mMeshletTriangles = std::move(triangles);
+    }
+
 }
 
 
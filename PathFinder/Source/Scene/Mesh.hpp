@@ -4,35 +4,91 @@
 #include <string>
 
 #include "VertexStorageLocation.hpp"
+#include "Meshlet.hpp"
+#include "MeshOptimizer.hpp"
 #include "Vertices/Vertex1P1N1UV1T1BT.hpp"
+#include "Vertices/Vertex1P1N1UV1T1BTPacked.hpp"
 
 #include <bitsery/bitsery.h>
 #include <Geometry/AxisAlignedBox3D.hpp>
+#include <Foundation/SlotMap.hpp>
 
 
 namespace PathFinder
 {
 
+    /// Simplified version of a mesh. Refers to vertices of the mesh it belongs to.
+    struct MeshLOD
+    {
+        std::vector<uint32_t> Indices;
+
+        // Largest geometric deviation from the full detail mesh, in mesh space units
+        float Error = 0.0f;
+
+        template <typename S>
+        void serialize(S& s)
+        {
+            s.container(Indices);
+            s.value4b(Error);
+        }
+    };
+
     class Mesh
     {
     public:
         const std::string& Name() const;
+        const std::string& SourceFile() const;
+        uint32_t IndexInSourceFile() const;
         std::vector<Vertex1P1N1UV1T1BT>& Vertices();
         const std::vector<Vertex1P1N1UV1T1BT>& Vertices() const;
+        const std::vector<Vertex1P1N1UV1T1BTPacked>& PackedVertices() const;
+        const VertexPackingError& PackingError() const;
+        bool HasPackedVertices() const;
         const std::vector<uint32_t>& Indices() const;
+        const std::vector<Meshlet>& Meshlets() const;
+        const std::vector<uint32_t>& MeshletVertexIndices() const;
+        const std::vector<uint32_t>& MeshletTriangles() const;
+        const MeshOptimizationReport& OptimizationReport() const;
+        const std::vector<MeshLOD>& LODs() const;
+        const std::vector<uint32_t>& LODIndices(uint32_t lod) const;
+        float LODError(uint32_t lod) const;
+        uint32_t LODCount() const;
         const Geometry::AxisAlignedBox3D& BoundingBox() const;
         const VertexStorageLocation& LocationInVertexStorage() const;
+        bool HasLocationInVertexStorage() const;
+        IndexStorageLocation LODLocationInIndexStorage(uint32_t lod) const;
         float SurfaceArea() const;
         bool HasTangentSpace() const;
 
         void SetName(const std::string& name);
+
+        /// File the mesh was loaded from, relative to the root of the loader, and position among meshes of that file.
+        /// Lets serialized scenes refer to meshes instead of storing their geometry.
+        void SetSource(const std::string& file, uint32_t indexInFile);
+
         void SetHasTangentSpace(bool hts);
         void SetVertexStorageLocation(const VertexStorageLocation& location);
         void AddVertex(const Vertex1P1N1UV1T1BT& vertex);
         void AddIndex(uint32_t index);
+        void SetIndices(std::vector<uint32_t>&& indices);
+        void SetOptimizationReport(const MeshOptimizationReport& report);
+
+        /// LODs are expected to be added from finest to coarsest, LOD 0 is the mesh itself
+        void AddLOD(MeshLOD&& lod);
+
+        /// Locations of LOD 1 and coarser index ranges, LOD 0 uses the vertex storage location
+        void SetLODIndexStorageLocations(std::vector<IndexStorageLocation>&& locations);
+
+        /// Packed vertices are quantized relative to the bounding box,
+        /// so they have to be set after all vertices are added.
+        /// Empty vertices with an error record a mesh that was rejected for packing.
+        void SetPackedVertices(std::vector<Vertex1P1N1UV1T1BTPacked>&& vertices, const VertexPackingError& error);
+
+        void SetMeshlets(std::vector<Meshlet>&& meshlets, std::vector<uint32_t>&& vertexIndices, std::vector<uint32_t>&& triangles);
 
     private:
         friend bitsery::Access;
+        friend class CookedMeshCache;
 
         template <typename S>
         void serialize(S& s)
@@ -44,15 +100,35 @@ namespace PathFinder
             s.object(mBoundingBox.Max);
             s.value(mArea);
             s.value(mHasTangentSpace);
+            s.container(mPackedVertices);
+            s.object(mPackingError);
+            s.container(mMeshlets);
+            s.container(mMeshletVertexIndices);
+            s.container(mMeshletTriangles);
+            s.object(mOptimizationReport);
+            s.container(mLODs);
         }
 
         std::string mName;
+        std::string mSourceFile;
+        uint32_t mIndexInSourceFile = 0;
         std::vector<Vertex1P1N1UV1T1BT> mVertices;
+        std::vector<Vertex1P1N1UV1T1BTPacked> mPackedVertices;
+        VertexPackingError mPackingError;
         std::vector<uint32_t> mIndices;
+        std::vector<Meshlet> mMeshlets;
+        std::vector<uint32_t> mMeshletVertexIndices;
+        std::vector<uint32_t> mMeshletTriangles;
+        MeshOptimizationReport mOptimizationReport;
+        std::vector<MeshLOD> mLODs;
         VertexStorageLocation mVertexStorageLocation;
+        std::vector<IndexStorageLocation> mLODIndexStorageLocations;
+        bool mHasVertexStorageLocation = false;
         Geometry::AxisAlignedBox3D mBoundingBox = Geometry::AxisAlignedBox3D::MaximumReversed();
         float mArea = 0.0;
         bool mHasTangentSpace = true;
     };
 
+    using MeshHandle = Foundation::SlotMapHandle<Mesh>;
+
 }
@@ -21,7 +21,7 @@ namespace PathFinder
     class MeshInstance
     {
     public:
-        MeshInstance(const Mesh* mesh, const Material* material);
+        MeshInstance(MeshHandle mesh, MaterialHandle material);
 
         void UpdatePreviousTransform();
 
@@ -31,16 +31,16 @@ namespace PathFinder
         template <typename S>
         void serialize(S& s)
         {
-            s.ext(mMesh, bitsery::ext::PointerObserver{});
-            s.ext(mMaterial, bitsery::ext::PointerObserver{});
+            s.object(mMesh);
+            s.object(mMaterial);
             s.value(mIsSelected);
             s.value(mIsHighlighted);
             s.object(mPrevTransformation);
             s.object(mTransformation);
         }
 
-        const Mesh* mMesh;
-        const Material* mMaterial;
+        MeshHandle mMesh;
+        MaterialHandle mMaterial;
         bool mIsSelected = false;
         bool mIsHighlighted = false;
         Geometry::Transformation mTransformation;
@@ -48,22 +48,33 @@ namespace PathFinder
         EntityID mEntityID = 0;
         uint32_t mIndexInGPUTable = 0;
 
+        // Level of detail of the associated mesh instance is drawn with, chosen every frame
+        uint32_t mLOD = 0;
+
+        // Incremented on every change affecting GPU representation of the instance
+        uint64_t mVersion = 0;
+
     public:
         inline bool IsSelected() const { return mIsSelected; }
         inline bool IsHighlighted() const { return mIsHighlighted; }
         inline const Geometry::Transformation& Transformation() const { return mTransformation; }
         inline const Geometry::Transformation& PrevTransformation() { return mPrevTransformation; }
         inline Geometry::AxisAlignedBox3D BoundingBox(const Mesh& mesh) const { return mesh.BoundingBox().TransformedBy(mTransformation); }
-        inline const Mesh* AssociatedMesh() const { return mMesh; }
-        inline const Material* AssociatedMaterial() const { return mMaterial; }
+        inline MeshHandle AssociatedMesh() const { return mMesh; }
+        inline MaterialHandle AssociatedMaterial() const { return mMaterial; }
         inline const EntityID& ID() const { return mEntityID; }
         inline auto IndexInGPUTable () const { return mIndexInGPUTable; }
+        inline auto Version() const { return mVersion; }
+        inline auto LOD() const { return mLOD; }
 
         inline void SetIsSelected(bool selected) { mIsSelected = selected; }
         inline void SetIsHighlighted(bool highlighted) { mIsHighlighted = highlighted; }
-        inline void SetTransformation(const Geometry::Transformation& transform) { mTransformation = transform; }
+        inline void SetTransformation(const Geometry::Transformation& transform) { mTransformation = transform; ++mVersion; }
         inline void SetIndexInGPUTable(uint32_t index) { mIndexInGPUTable = index; }
         inline void SetEntityID(EntityID id) { mEntityID = id; }
+        inline void SetLOD(uint32_t lod) { mLOD = lod; }
     };
 
+    using MeshInstanceHandle = Foundation::SlotMapHandle<MeshInstance>;
+
 }
@@ -0,0 +1,107 @@
+#include "MeshInstanceBatcher.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+namespace PathFinder
+{
+
+    bool MeshInstanceBatcher::Update(const Foundation::SlotMap<MeshInstance>& instances, const std::vector<uint32_t>& visibleInstances, uint64_t sceneLayoutVersion)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        // Mesh and material of an instance never change, so batches stay valid until the visible set
+        // or levels of detail change, or dense indices are shuffled by additions and removals
+        bool isMembershipChanged = mSceneLayoutVersion != sceneLayoutVersion || mBatchedVisibleInstances != visibleInstances;
+
+        if (!isMembershipChanged)
+        {
+            for (uint32_t idx = 0; idx < visibleInstances.size() && !isMembershipChanged; ++idx)
+            {
+                isMembershipChanged = mBatchedVisibleInstanceLODs[idx] != instances.data()[visibleInstances[idx]].LOD();
+            }
+        }
+
+        mStatistics.WereBatchesRebuilt = isMembershipChanged;
+
+        if (!isMembershipChanged)
+        {
+            mStatistics.BatchingTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+            return false;
+        }
+
+        mBatchedVisibleInstances = visibleInstances;
+        mSceneLayoutVersion = sceneLayoutVersion;
+        mBatchedVisibleInstanceLODs.clear();
+
+        for (uint32_t instanceIdx : visibleInstances)
+        {
+            mBatchedVisibleInstanceLODs.push_back(instances.data()[instanceIdx].LOD());
+        }
+
+        auto batchKey = [&instances](uint32_t instanceIdx)
+        {
+            const MeshInstance& instance = instances.data()[instanceIdx];
+            return std::make_tuple(instance.AssociatedMesh().Index, instance.LOD(), instance.AssociatedMaterial().Index, instanceIdx);
+        };
+
+        // Sorting by slot index of mesh, level of detail, slot index of material and then by instance index,
+        // keeps the order deterministic for the same set of visible instances
+        mBatchedInstances = visibleInstances;
+
+        std::sort(mBatchedInstances.begin(), mBatchedInstances.end(), [&batchKey](uint32_t left, uint32_t right)
+        {
+            return batchKey(left) < batchKey(right);
+        });
+
+        mBatches.clear();
+
+        for (uint32_t idx = 0; idx < mBatchedInstances.size(); ++idx)
+        {
+            const MeshInstance& instance = instances.data()[mBatchedInstances[idx]];
+
+            bool startsNewBatch = mBatches.empty() ||
+                mBatches.back().Mesh != instance.AssociatedMesh() ||
+                mBatches.back().LOD != instance.LOD() ||
+                mBatches.back().Material != instance.AssociatedMaterial();
+
+            if (startsNewBatch)
+            {
+                mBatches.push_back({ instance.AssociatedMesh(), instance.AssociatedMaterial(), instance.LOD(), idx, 0 });
+            }
+
+            mBatches.back().InstanceCount++;
+        }
+
+        mStatistics.BatchCount = (uint32_t)mBatches.size();
+        mStatistics.InstanceCount = (uint32_t)mBatchedInstances.size();
+        mStatistics.BatchingTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+        return true;
+    }
+
+    void MeshInstanceBatcher::GenerateDrawCommands(
+        const Foundation::SlotMap<MeshInstance>& instances,
+        const Foundation::SlotMap<Mesh>& meshes,
+        std::vector<GPUMeshInstanceDrawCommand>& commands,
+        std::vector<uint32_t>& batchInstanceList) const
+    {
+        commands.reserve(commands.size() + mBatches.size());
+        batchInstanceList.reserve(batchInstanceList.size() + mBatchedInstances.size());
+
+        for (const Batch& batch : mBatches)
+        {
+            GPUMeshInstanceDrawCommand& command = commands.emplace_back();
+            command.BatchInstanceListOffset = (uint32_t)batchInstanceList.size();
+            // Vertices are pulled in shaders through index buffer, so one vertex is drawn for every index
+            command.Draw.VertexCountPerInstance = meshes[batch.Mesh].LODLocationInIndexStorage(batch.LOD).IndexCount;
+            command.Draw.InstanceCount = batch.InstanceCount;
+
+            for (uint32_t idx = batch.FirstInstance; idx < batch.FirstInstance + batch.InstanceCount; ++idx)
+            {
+                batchInstanceList.push_back(instances.data()[mBatchedInstances[idx]].IndexInGPUTable());
+            }
+        }
+    }
+
+}
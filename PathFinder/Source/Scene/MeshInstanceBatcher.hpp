@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Mesh.hpp"
+#include "Material.hpp"
+#include "MeshInstance.hpp"
+
+#include <Foundation/SlotMap.hpp>
+#include <HardwareAbstractionLayer/IndirectArguments.hpp>
+
+#include <vector>
+#include <optional>
+#include <chrono>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    // Layout of a command of GBuffer mesh command signature.
+    // Draws every instance of a batch, instance table indices are read from the batch instance list.
+    struct GPUMeshInstanceDrawCommand
+    {
+        uint32_t BatchInstanceListOffset;
+        HAL::DrawArguments Draw;
+    };
+
+    /// Groups visible mesh instances sharing a mesh, its level of detail and a material into batches,
+    /// so that every batch can be drawn with a single instanced draw.
+    /// Batches are only regrouped when the set of visible instances or their levels of detail change,
+    /// therefore their order and contents stay the same between such changes.
+    class MeshInstanceBatcher
+    {
+    public:
+        struct Batch
+        {
+            MeshHandle Mesh;
+            MaterialHandle Material;
+            uint32_t LOD = 0;
+
+            // Range in the batched instance list
+            uint32_t FirstInstance = 0;
+            uint32_t InstanceCount = 0;
+        };
+
+        struct Statistics
+        {
+            uint32_t BatchCount = 0;
+            uint32_t InstanceCount = 0;
+            bool WereBatchesRebuilt = false;
+            std::chrono::microseconds BatchingTime{ 0 };
+        };
+
+        /// Returns true when batches were rebuilt
+        bool Update(const Foundation::SlotMap<MeshInstance>& instances, const std::vector<uint32_t>& visibleInstances, uint64_t sceneLayoutVersion);
+
+        /// Appends an instanced draw command for every batch and a list of instance table indices the commands refer to
+        void GenerateDrawCommands(
+            const Foundation::SlotMap<MeshInstance>& instances,
+            const Foundation::SlotMap<Mesh>& meshes,
+            std::vector<GPUMeshInstanceDrawCommand>& commands,
+            std::vector<uint32_t>& batchInstanceList) const;
+
+    private:
+        // Dense instance indices, batch after batch
+        std::vector<uint32_t> mBatchedInstances;
+        std::vector<Batch> mBatches;
+
+        // Input of the last rebuild used to detect membership changes
+        std::vector<uint32_t> mBatchedVisibleInstances;
+        std::vector<uint32_t> mBatchedVisibleInstanceLODs;
+        std::optional<uint64_t> mSceneLayoutVersion;
+
+        Statistics mStatistics;
+
+    public:
+        inline const auto& Batches() const { return mBatches; }
+        inline const auto& BatchedInstances() const { return mBatchedInstances; }
+        inline const auto& GetStatistics() const { return mStatistics; }
+    };
+
+}
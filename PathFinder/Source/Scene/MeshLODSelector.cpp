@@ -0,0 +1,142 @@
+#include "MeshLODSelector.hpp"
+
+#include <glm/gtx/component_wise.hpp>
+
+#include <algorithm>
+#include <queue>
+#include <tuple>
+#include <limits>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    void MeshLODSelector::SelectLODs(
+        Foundation::SlotMap<MeshInstance>& instances,
+        const Foundation::SlotMap<Mesh>& meshes,
+        const std::vector<uint32_t>& visibleInstances,
+        const glm::vec3& viewerPosition,
+        float verticalFOVRadians,
+        float viewportHeight)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        mStatistics = {};
+        mProjectionScale = viewportHeight / (2.0f * std::tan(verticalFOVRadians * 0.5f));
+
+        // Mesh space errors are scaled by the largest scale of instance transform
+        // and projected from the point of instance bounds closest to the viewer
+        struct Candidate
+        {
+            uint32_t InstanceIndex = 0;
+            float Scale = 0.0f;
+            float Distance = 0.0f;
+            uint32_t PreviousLOD = 0;
+        };
+
+        std::vector<Candidate> candidates;
+        candidates.reserve(visibleInstances.size());
+
+        for (uint32_t instanceIdx : visibleInstances)
+        {
+            MeshInstance& instance = instances.data()[instanceIdx];
+            const Mesh& mesh = meshes[instance.AssociatedMesh()];
+
+            Geometry::AxisAlignedBox3D bounds = instance.BoundingBox(mesh);
+            glm::vec3 closestPoint = glm::clamp(viewerPosition, bounds.Min, bounds.Max);
+
+            Candidate candidate{};
+            candidate.InstanceIndex = instanceIdx;
+            candidate.Scale = glm::compMax(glm::abs(instance.Transformation().Scale));
+            candidate.Distance = std::max(glm::distance(viewerPosition, closestPoint), std::numeric_limits<float>::epsilon());
+
+            candidate.PreviousLOD = instance.LOD();
+
+            uint32_t currentLOD = std::min(instance.LOD(), mesh.LODCount() - 1);
+            uint32_t lod = 0;
+
+            // Finer LODs are switched to as soon as the error becomes visible,
+            // coarser ones only when the error is below the threshold by the hysteresis margin
+            for (uint32_t nextLOD = 1; nextLOD < mesh.LODCount(); ++nextLOD)
+            {
+                float threshold = nextLOD > currentLOD ?
+                    mSettings.MaxScreenSpaceError * (1.0f - mSettings.Hysteresis) :
+                    mSettings.MaxScreenSpaceError;
+
+                if (ProjectedError(mesh.LODError(nextLOD) * candidate.Scale, candidate.Distance) > threshold) break;
+
+                lod = nextLOD;
+            }
+
+            instance.SetLOD(lod);
+            mStatistics.TriangleCount += mesh.LODIndices(lod).size() / 3;
+
+            candidates.push_back(candidate);
+        }
+
+        if (mSettings.TriangleBudget > 0 && mStatistics.TriangleCount > mSettings.TriangleBudget)
+        {
+            mStatistics.IsBudgetLimited = true;
+
+            struct Coarsening
+            {
+                float ProjectedError = 0.0f;
+                uint32_t CandidateIndex = 0;
+
+                bool operator>(const Coarsening& other) const
+                {
+                    return std::tie(ProjectedError, CandidateIndex) > std::tie(other.ProjectedError, other.CandidateIndex);
+                }
+            };
+
+            std::priority_queue<Coarsening, std::vector<Coarsening>, std::greater<Coarsening>> coarsenings;
+
+            auto pushNextLOD = [&](uint32_t candidateIdx)
+            {
+                const Candidate& candidate = candidates[candidateIdx];
+                const MeshInstance& instance = instances.data()[candidate.InstanceIndex];
+                const Mesh& mesh = meshes[instance.AssociatedMesh()];
+
+                if (instance.LOD() + 1 >= mesh.LODCount()) return;
+
+                coarsenings.push({ ProjectedError(mesh.LODError(instance.LOD() + 1) * candidate.Scale, candidate.Distance), candidateIdx });
+            };
+
+            for (uint32_t candidateIdx = 0; candidateIdx < candidates.size(); ++candidateIdx)
+            {
+                pushNextLOD(candidateIdx);
+            }
+
+            while (mStatistics.TriangleCount > mSettings.TriangleBudget && !coarsenings.empty())
+            {
+                uint32_t candidateIdx = coarsenings.top().CandidateIndex;
+                coarsenings.pop();
+
+                MeshInstance& instance = instances.data()[candidates[candidateIdx].InstanceIndex];
+                const Mesh& mesh = meshes[instance.AssociatedMesh()];
+
+                mStatistics.TriangleCount -= mesh.LODIndices(instance.LOD()).size() / 3;
+                instance.SetLOD(instance.LOD() + 1);
+                mStatistics.TriangleCount += mesh.LODIndices(instance.LOD()).size() / 3;
+
+                pushNextLOD(candidateIdx);
+            }
+        }
+
+        for (const Candidate& candidate : candidates)
+        {
+            if (instances.data()[candidate.InstanceIndex].LOD() != candidate.PreviousLOD)
+            {
+                mStatistics.LODChangeCount++;
+            }
+        }
+
+        mStatistics.SelectionTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+    }
+
+    float MeshLODSelector::ProjectedError(float error, float distance) const
+    {
+        return error / distance * mProjectionScale;
+    }
+
+}
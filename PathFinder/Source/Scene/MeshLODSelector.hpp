@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Mesh.hpp"
+#include "MeshInstance.hpp"
+
+#include <Foundation/SlotMap.hpp>
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Chooses level of detail of every visible mesh instance from projected size of LOD error on screen.
+    /// Coarser LODs are only taken once their error stays below the threshold by a margin,
+    /// so that instances hovering around a switching distance don't flicker between LODs.
+    /// When visible triangle count exceeds the budget, instances whose next LOD
+    /// introduces the smallest error on screen are coarsened first.
+    class MeshLODSelector
+    {
+    public:
+        struct Settings
+        {
+            // Largest LOD error allowed on screen, in pixels
+            float MaxScreenSpaceError = 1.0f;
+
+            // Fraction of the threshold projected error of a coarser LOD has to drop below before it's switched to
+            float Hysteresis = 0.25f;
+
+            // Visible triangle count the selection tries to stay within, 0 for unlimited
+            uint64_t TriangleBudget = 0;
+        };
+
+        struct Statistics
+        {
+            uint64_t TriangleCount = 0;
+            uint32_t LODChangeCount = 0;
+            bool IsBudgetLimited = false;
+            std::chrono::microseconds SelectionTime{ 0 };
+        };
+
+        void SelectLODs(
+            Foundation::SlotMap<MeshInstance>& instances,
+            const Foundation::SlotMap<Mesh>& meshes,
+            const std::vector<uint32_t>& visibleInstances,
+            const glm::vec3& viewerPosition,
+            float verticalFOVRadians,
+            float viewportHeight);
+
+    private:
+        // Size of LOD error on screen, in pixels
+        float ProjectedError(float error, float distance) const;
+
+        Settings mSettings;
+        Statistics mStatistics;
+
+        // Pixels per world unit at the distance of one unit from the viewer
+        float mProjectionScale = 0.0f;
+
+    public:
+        inline const auto& GetSettings() const { return mSettings; }
+        inline const auto& GetStatistics() const { return mStatistics; }
+
+        inline void SetSettings(const Settings& settings) { mSettings = settings; }
+    };
+
+}
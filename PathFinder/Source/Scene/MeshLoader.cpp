@@ -1,19 +1,110 @@
 #include "MeshLoader.hpp"
 
+#include <robinhood/robin_hood.h>
+#include <glm/packing.hpp>
+#include <glm/gtx/norm.hpp>
 
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <limits>
 
 namespace PathFinder
 {
 
-    MeshLoader::MeshLoader(const std::filesystem::path& fileRoot)
-        : mRootPath{ fileRoot } {}
+    MeshLoader::MeshLoader(const std::filesystem::path& fileRoot, const std::filesystem::path& cookedMeshRoot)
+        : mRootPath{ fileRoot }
+    {
+        if (!cookedMeshRoot.empty())
+        {
+            mCookedMeshCache.emplace(cookedMeshRoot);
+        }
+    }
 
     std::vector<Mesh> MeshLoader::Load(const std::string& fileName)
     {
-        Assimp::Importer importer;
+        return std::move(LoadFiles({ fileName }).front());
+    }
+
+    std::vector<std::vector<Mesh>> MeshLoader::LoadFiles(const std::vector<std::string>& fileNames)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        std::vector<FileLoadResult> results(fileNames.size());
+
+        // Files are independent of each other, every one of them gets its own importer
+        std::transform(std::execution::par, fileNames.begin(), fileNames.end(), results.begin(), [this](const std::string& fileName)
+        {
+            return LoadFile(fileName);
+        });
+
+        mStatistics = {};
+        mStatistics.FileCount = (uint32_t)fileNames.size();
+
+        std::vector<std::vector<Mesh>> meshes;
+        meshes.reserve(results.size());
+
+        for (FileLoadResult& result : results)
+        {
+            mStatistics.OptimizationTime += result.OptimizationTime;
+            mStatistics.LODGenerationTime += result.LODGenerationTime;
+            mStatistics.MeshletGenerationTime += result.MeshletGenerationTime;
+            mStatistics.FilesLoadedFromCache += result.IsLoadedFromCache;
+
+            meshes.emplace_back(std::move(result.Meshes));
+        }
+
+        GatherStatistics(meshes);
+
+        mStatistics.LoadTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+        return meshes;
+    }
+
+    MeshLoader::FileLoadResult MeshLoader::LoadFile(const std::string& fileName) const
+    {
         auto rootPath = mRootPath;
+        std::filesystem::path fullPath = rootPath.append(fileName);
+
+        FileLoadResult result{};
+        std::optional<CookedMeshCache::Key> cacheKey;
+
+        if (mCookedMeshCache)
+        {
+            cacheKey = mCookedMeshCache->MakeKey(mRootPath, fileName, ImportSettingsHash());
+
+            if (cacheKey)
+            {
+                if (std::optional<std::vector<Mesh>> cookedMeshes = mCookedMeshCache->Load(*cacheKey))
+                {
+                    result.Meshes = std::move(*cookedMeshes);
+                    result.IsLoadedFromCache = true;
+                }
+            }
+        }
+
+        if (!result.IsLoadedFromCache)
+        {
+            Import(fullPath, result);
 
-        std::string fullPath{ rootPath.append(fileName).string() };
+            if (cacheKey)
+            {
+                mCookedMeshCache->Store(*cacheKey, result.Meshes);
+            }
+        }
+
+        // Not cooked, the same cooked file can be reached through different relative paths
+        for (uint32_t meshIdx = 0; meshIdx < result.Meshes.size(); ++meshIdx)
+        {
+            result.Meshes[meshIdx].SetSource(fileName, meshIdx);
+        }
+
+        return result;
+    }
+
+    void MeshLoader::Import(const std::filesystem::path& path, FileLoadResult& result) const
+    {
+        Assimp::Importer importer;
 
         auto postProcessSteps = (aiPostProcessSteps)(
             aiProcess_Triangulate |
@@ -25,20 +116,106 @@ namespace PathFinder
             aiProcess_JoinIdenticalVertices |
             aiProcess_ConvertToLeftHanded);
 
-        const aiScene* pScene = importer.ReadFile(fullPath, postProcessSteps);
+        const aiScene* pScene = importer.ReadFile(path.string(), postProcessSteps);
 
         assert_format(pScene, "Unable to read mesh file"); 
 
-        mLoadedMeshes.clear();
+        std::vector<const aiMesh*> assimpMeshes;
+        CollectMeshes(pScene->mRootNode, pScene, assimpMeshes);
+
+        // Every mesh is processed into its own slot, so that the order follows
+        // node traversal no matter how the work is scheduled
+        std::vector<uint32_t> meshIndices(assimpMeshes.size());
+        std::vector<FileLoadResult> meshResults(assimpMeshes.size());
+        std::iota(meshIndices.begin(), meshIndices.end(), 0);
 
-        ProcessNode(pScene->mRootNode, pScene);
+        result.Meshes.resize(assimpMeshes.size());
 
-        return mLoadedMeshes;
+        std::for_each(std::execution::par, meshIndices.begin(), meshIndices.end(), [&](uint32_t meshIdx)
+        {
+            result.Meshes[meshIdx] = ProcessMesh(assimpMeshes[meshIdx], meshResults[meshIdx]);
+        });
+
+        for (const FileLoadResult& meshResult : meshResults)
+        {
+            result.OptimizationTime += meshResult.OptimizationTime;
+            result.LODGenerationTime += meshResult.LODGenerationTime;
+            result.MeshletGenerationTime += meshResult.MeshletGenerationTime;
+        }
     }
 
-    Mesh MeshLoader::ProcessMesh(aiMesh* mesh, const aiScene* scene)
+    void MeshLoader::GatherStatistics(const std::vector<std::vector<Mesh>>& meshes)
+    {
+        // Per mesh ratios are weighted by triangle and vertex counts they were averaged over
+        uint64_t triangleCount = 0;
+        uint64_t vertexCount = 0;
+
+        for (const std::vector<Mesh>& fileMeshes : meshes)
+        {
+            for (const Mesh& mesh : fileMeshes)
+            {
+                mStatistics.MeshCount++;
+                mStatistics.MeshletCount += mesh.Meshlets().size();
+                mStatistics.LODCount += mesh.LODs().size();
+
+                if (!mSettings.OptimizeIndexBuffers) continue;
+
+                float meshTriangleCount = float(mesh.Indices().size() / 3);
+                float meshVertexCount = float(mesh.Vertices().size());
+                const MeshOptimizationReport& report = mesh.OptimizationReport();
+
+                mStatistics.UnoptimizedVertexCache.ACMR += report.Unoptimized.ACMR * meshTriangleCount;
+                mStatistics.UnoptimizedVertexCache.ATVR += report.Unoptimized.ATVR * meshVertexCount;
+                mStatistics.OptimizedVertexCache.ACMR += report.Optimized.ACMR * meshTriangleCount;
+                mStatistics.OptimizedVertexCache.ATVR += report.Optimized.ATVR * meshVertexCount;
+
+                triangleCount += mesh.Indices().size() / 3;
+                vertexCount += mesh.Vertices().size();
+            }
+        }
+
+        if (triangleCount > 0)
+        {
+            mStatistics.UnoptimizedVertexCache.ACMR /= triangleCount;
+            mStatistics.OptimizedVertexCache.ACMR /= triangleCount;
+            mStatistics.UnoptimizedVertexCache.ATVR /= vertexCount;
+            mStatistics.OptimizedVertexCache.ATVR /= vertexCount;
+        }
+    }
+
+    uint64_t MeshLoader::ImportSettingsHash() const
+    {
+        // Fields are hashed one by one, since padding bytes of the settings struct are undefined
+        std::vector<uint8_t> bytes;
+
+        auto append = [&bytes](auto value)
+        {
+            const uint8_t* valueBytes = reinterpret_cast<const uint8_t*>(&value);
+            bytes.insert(bytes.end(), valueBytes, valueBytes + sizeof(value));
+        };
+
+        append(mSettings.OptimizeIndexBuffers);
+        append(mSettings.OverdrawACMRThreshold);
+        append(mSettings.PackVertices);
+        append(mSettings.MaxPackedUVError);
+        append(mSettings.GenerateLODs);
+        append(mSettings.LODGeneration.MaxLODCount);
+        append(mSettings.LODGeneration.TriangleRatio);
+        append(mSettings.LODGeneration.MinTriangleCount);
+        append(mSettings.LODGeneration.MaxError);
+        append(mSettings.LODGeneration.AttributeWeight);
+        append(mSettings.LODGeneration.LockBorders);
+        append(mSettings.BuildMeshlets);
+        append(mSettings.MaxMeshletVertexCount);
+        append(mSettings.MaxMeshletTriangleCount);
+
+        return robin_hood::hash_bytes(bytes.data(), bytes.size());
+    }
+
+    Mesh MeshLoader::ProcessMesh(const aiMesh* mesh, FileLoadResult& timings) const
     {
         Mesh subMesh;
+        subMesh.Vertices().reserve(mesh->mNumVertices);
 
         // Walk through each of the mesh's vertices
         for (auto i = 0u; i < mesh->mNumVertices; i++)
@@ -77,32 +254,425 @@ namespace PathFinder
             subMesh.AddVertex(vertex);
         }
 
+        std::vector<uint32_t> indices;
+        indices.reserve(uint64_t(mesh->mNumFaces) * 3);
+
         for (auto i = 0u; i < mesh->mNumFaces; i++)
         {
-            aiFace face = mesh->mFaces[i];
+            const aiFace& face = mesh->mFaces[i];
+            indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+        }
+
+        subMesh.SetIndices(std::move(indices));
+
+        subMesh.SetName(mesh->mName.data);
+
+        if (mSettings.OptimizeIndexBuffers)
+        {
+            auto startTime = std::chrono::steady_clock::now();
+
+            OptimizeMesh(subMesh, mSettings.OverdrawACMRThreshold);
+
+            timings.OptimizationTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+        }
+
+        if (mSettings.GenerateLODs)
+        {
+            auto startTime = std::chrono::steady_clock::now();
+
+            GenerateLODs(subMesh, mSettings.LODGeneration);
+
+            timings.LODGenerationTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+        }
+
+        if (mSettings.PackVertices)
+        {
+            PackVertices(subMesh, mSettings.MaxPackedUVError);
+        }
+
+        if (mSettings.BuildMeshlets)
+        {
+            auto startTime = std::chrono::steady_clock::now();
+
+            BuildMeshlets(subMesh, mSettings.MaxMeshletVertexCount, mSettings.MaxMeshletTriangleCount);
+
+            timings.MeshletGenerationTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+        }
+
+        return subMesh;
+    }
+
+    void MeshLoader::OptimizeMesh(Mesh& mesh, float overdrawACMRThreshold)
+    {
+        uint32_t vertexCount = (uint32_t)mesh.Vertices().size();
+
+        MeshOptimizationReport report{};
+        report.Unoptimized = MeshOptimizer::AnalyzeVertexCache(mesh.Indices(), vertexCount);
+
+        std::vector<uint32_t> indices = MeshOptimizer::OptimizeVertexCache(mesh.Indices(), vertexCount);
+        indices = MeshOptimizer::OptimizeOverdraw(indices, mesh.Vertices(), overdrawACMRThreshold);
+
+        // Fetch order only renames vertices, so it doesn't affect cache efficiency
+        MeshOptimizer::OptimizeVertexFetch(mesh.Vertices(), indices);
+
+        report.Optimized = MeshOptimizer::AnalyzeVertexCache(indices, vertexCount);
+
+        mesh.SetIndices(std::move(indices));
+        mesh.SetOptimizationReport(report);
+    }
+
+    void MeshLoader::GenerateLODs(Mesh& mesh, const LODGenerationSettings& settings)
+    {
+        const Geometry::AxisAlignedBox3D& bounds = mesh.BoundingBox();
+        glm::vec3 extent = bounds.Max - bounds.Min;
+        float maxExtent = std::max({ extent.x, extent.y, extent.z });
+
+        uint32_t vertexCount = (uint32_t)mesh.Vertices().size();
+        uint32_t triangleCount = uint32_t(mesh.Indices().size() / 3);
+
+        MeshSimplifier::Settings simplifierSettings{};
+        simplifierSettings.AttributeWeight = settings.AttributeWeight;
+        simplifierSettings.LockBorders = settings.LockBorders;
+
+        float error = 0.0f;
+
+        for (uint32_t lod = 1; lod < settings.MaxLODCount; ++lod)
+        {
+            simplifierSettings.TargetTriangleCount = uint32_t(triangleCount * settings.TriangleRatio);
+
+            if (simplifierSettings.TargetTriangleCount < settings.MinTriangleCount) break;
+
+            // Each LOD is simplified from the previous one, so their errors add up
+            simplifierSettings.MaxError = settings.MaxError - error;
+
+            if (simplifierSettings.MaxError <= 0.0f) break;
+
+            MeshSimplifier::Result result = MeshSimplifier::Simplify(mesh.Vertices(), mesh.LODIndices(lod - 1), simplifierSettings);
+
+            uint32_t lodTriangleCount = uint32_t(result.Indices.size() / 3);
+
+            // Error limit is reached, another LOD would be nearly identical to the previous one
+            if (lodTriangleCount == 0 || lodTriangleCount > triangleCount * 0.9f) break;
+
+            error += result.Error;
+
+            MeshLOD meshLOD{};
+            meshLOD.Indices = MeshOptimizer::OptimizeVertexCache(result.Indices, vertexCount);
+            meshLOD.Error = error * maxExtent;
+
+            mesh.AddLOD(std::move(meshLOD));
+
+            triangleCount = lodTriangleCount;
+        }
+    }
+
+    void MeshLoader::PackVertices(Mesh& mesh, float maxUVError)
+    {
+        const Geometry::AxisAlignedBox3D& bounds = mesh.BoundingBox();
+
+        std::vector<Vertex1P1N1UV1T1BTPacked> packedVertices;
+        packedVertices.reserve(mesh.Vertices().size());
+
+        VertexPackingError error{};
+
+        auto angleBetween = [](const glm::vec3& source, const glm::vec3& unpacked)
+        {
+            // Degenerate source directions carry no information to lose
+            if (glm::length2(source) <= 0.0f) return 0.0f;
+
+            return std::acos(std::clamp(glm::dot(glm::normalize(source), unpacked), -1.0f, 1.0f));
+        };
+
+        for (const Vertex1P1N1UV1T1BT& vertex : mesh.Vertices())
+        {
+            Vertex1P1N1UV1T1BTPacked packedVertex = PackVertex(vertex, bounds);
+            Vertex1P1N1UV1T1BT unpackedVertex = UnpackVertex(packedVertex, bounds);
 
-            for (auto j = 0u; j < face.mNumIndices; j++) 
+            glm::vec2 uvError = glm::abs(unpackedVertex.UV - vertex.UV);
+
+            error.MaxPositionError = std::max(error.MaxPositionError, glm::distance(glm::vec3{ unpackedVertex.Position }, glm::vec3{ vertex.Position }));
+            error.MaxNormalError = std::max(error.MaxNormalError, angleBetween(vertex.Normal, unpackedVertex.Normal));
+            error.MaxUVError = std::max({ error.MaxUVError, uvError.x, uvError.y });
+
+            if (mesh.HasTangentSpace())
             {
-                subMesh.AddIndex(face.mIndices[j]);
+                error.MaxTangentError = std::max(error.MaxTangentError, angleBetween(vertex.Tangent, unpackedVertex.Tangent));
             }
+
+            packedVertices.push_back(packedVertex);
         }
 
-        subMesh.SetName(mesh->mName.data);
+        if (error.MaxUVError > maxUVError)
+        {
+            packedVertices.clear();
+        }
 
-        return subMesh;
+        mesh.SetPackedVertices(std::move(packedVertices), error);
+    }
+
+    void MeshLoader::BuildMeshlets(Mesh& mesh, uint32_t maxVertexCount, uint32_t maxTriangleCount)
+    {
+        // Triangles address meshlet vertices with 8-bit indices
+        assert_format(maxVertexCount >= 3 && maxVertexCount <= 256, "Meshlet vertex limit must be in [3, 256] range");
+        assert_format(maxTriangleCount > 0, "Meshlet must be able to hold at least one triangle");
+
+        const std::vector<uint32_t>& indices = mesh.Indices();
+
+        std::vector<Meshlet> meshlets;
+        std::vector<uint32_t> vertexIndices;
+        std::vector<uint32_t> triangles;
+
+        vertexIndices.reserve(indices.size());
+        triangles.reserve(indices.size() / 3);
+
+        // Local index of every mesh vertex in the meshlet being built, if it was added to it
+        static const uint32_t NotInMeshlet = std::numeric_limits<uint32_t>::max();
+        std::vector<uint32_t> localIndices(mesh.Vertices().size(), NotInMeshlet);
+
+        Meshlet meshlet{};
+
+        auto finishMeshlet = [&]()
+        {
+            if (meshlet.TriangleCount == 0) return;
+
+            ComputeMeshletBounds(mesh, meshlet, &vertexIndices[meshlet.VertexOffset], &triangles[meshlet.TriangleOffset]);
+
+            for (uint32_t idx = meshlet.VertexOffset; idx < meshlet.VertexOffset + meshlet.VertexCount; ++idx)
+            {
+                localIndices[vertexIndices[idx]] = NotInMeshlet;
+            }
+
+            meshlets.push_back(meshlet);
+
+            meshlet = Meshlet{};
+            meshlet.VertexOffset = (uint32_t)vertexIndices.size();
+            meshlet.TriangleOffset = (uint32_t)triangles.size();
+        };
+
+        for (uint64_t idx = 0; idx + 2 < indices.size(); idx += 3)
+        {
+            uint32_t newVertexCount =
+                (localIndices[indices[idx]] == NotInMeshlet) +
+                (localIndices[indices[idx + 1]] == NotInMeshlet) +
+                (localIndices[indices[idx + 2]] == NotInMeshlet);
+
+            if (meshlet.VertexCount + newVertexCount > maxVertexCount || meshlet.TriangleCount + 1 > maxTriangleCount)
+            {
+                finishMeshlet();
+            }
+
+            uint32_t triangle = 0;
+
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                uint32_t& localIndex = localIndices[indices[idx + corner]];
+
+                if (localIndex == NotInMeshlet)
+                {
+                    localIndex = meshlet.VertexCount++;
+                    vertexIndices.push_back(indices[idx + corner]);
+                }
+
+                triangle |= localIndex << (corner * 8);
+            }
+
+            triangles.push_back(triangle);
+            meshlet.TriangleCount++;
+        }
+
+        finishMeshlet();
+
+        mesh.SetMeshlets(std::move(meshlets), std::move(vertexIndices), std::move(triangles));
+    }
+
+    void MeshLoader::ComputeMeshletBounds(const Mesh& mesh, Meshlet& meshlet, const uint32_t* vertexIndices, const uint32_t* triangles)
+    {
+        auto position = [&](uint32_t localIndex) { return glm::vec3{ mesh.Vertices()[vertexIndices[localIndex]].Position }; };
+
+        // Sphere around box center is not the tightest one, but is cheap and stable
+        Geometry::AxisAlignedBox3D box = Geometry::AxisAlignedBox3D::MaximumReversed();
+
+        for (uint32_t idx = 0; idx < meshlet.VertexCount; ++idx)
+        {
+            box.Min = glm::min(box.Min, position(idx));
+            box.Max = glm::max(box.Max, position(idx));
+        }
+
+        glm::vec3 center = (box.Min + box.Max) * 0.5f;
+        float radius = 0.0f;
+
+        for (uint32_t idx = 0; idx < meshlet.VertexCount; ++idx)
+        {
+            radius = std::max(radius, glm::distance(center, position(idx)));
+        }
+
+        meshlet.BoundingSphereCenter = center;
+        meshlet.BoundingSphereRadius = radius;
+
+        // Front faces are clockwise, which makes the cross product below point at the viewer
+        std::vector<std::pair<glm::vec3, glm::vec3>> triangleNormalsAndPoints;
+        triangleNormalsAndPoints.reserve(meshlet.TriangleCount);
+
+        glm::vec3 normalSum{ 0.0f };
+
+        for (uint32_t idx = 0; idx < meshlet.TriangleCount; ++idx)
+        {
+            glm::vec3 p0 = position(triangles[idx] & 0xFF);
+            glm::vec3 p1 = position((triangles[idx] >> 8) & 0xFF);
+            glm::vec3 p2 = position((triangles[idx] >> 16) & 0xFF);
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+
+            // Degenerate triangles are never rasterized
+            if (glm::length2(normal) <= 0.0f) continue;
+
+            normal = glm::normalize(normal);
+            normalSum += normal;
+            triangleNormalsAndPoints.emplace_back(normal, p0);
+        }
+
+        meshlet.ConeApex = center;
+        meshlet.ConeAxis = glm::vec3{ 0.0f, 0.0f, 1.0f };
+        meshlet.ConeCutoff = 1.0f;
+
+        if (triangleNormalsAndPoints.empty() || glm::length2(normalSum) <= 0.0f) return;
+
+        glm::vec3 axis = glm::normalize(normalSum);
+        float minDot = 1.0f;
+
+        for (const auto& [normal, point] : triangleNormalsAndPoints)
+        {
+            minDot = std::min(minDot, glm::dot(axis, normal));
+        }
+
+        // Cones of nearly a hemisphere and wider reject almost nothing
+        if (minDot <= 0.1f) return;
+
+        // Apex is moved back along the axis until every triangle plane has it on its front side,
+        // so any viewer inside of the cone sees all triangles from behind
+        float apexDistance = 0.0f;
+
+        for (const auto& [normal, point] : triangleNormalsAndPoints)
+        {
+            apexDistance = std::max(apexDistance, glm::dot(center - point, normal) / glm::dot(axis, normal));
+        }
+
+        meshlet.ConeAxis = axis;
+        meshlet.ConeApex = center - axis * apexDistance;
+        meshlet.ConeCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+
+    Vertex1P1N1UV1T1BTPacked MeshLoader::PackVertex(const Vertex1P1N1UV1T1BT& vertex, const Geometry::AxisAlignedBox3D& bounds)
+    {
+        static const float QuantizationMax = float(Vertex1P1N1UV1T1BTPacked::PositionQuantizationMax);
+
+        glm::vec3 extent = bounds.Max - bounds.Min;
+        glm::vec3 scale{
+            extent.x > 0.0f ? QuantizationMax / extent.x : 0.0f,
+            extent.y > 0.0f ? QuantizationMax / extent.y : 0.0f,
+            extent.z > 0.0f ? QuantizationMax / extent.z : 0.0f
+        };
+
+        glm::uvec3 position{ glm::round(glm::clamp((glm::vec3{ vertex.Position } - bounds.Min) * scale, 0.0f, QuantizationMax)) };
+
+        // Bitangent is restored as a cross product of normal and tangent, only its direction has to be stored
+        bool isBitangentFlipped = glm::dot(glm::cross(vertex.Normal, vertex.Tangent), vertex.Bitangent) < 0.0f;
+
+        // 21 bits of X, 21 bits of Y split between words, 21 bits of Z and a sign bit
+        Vertex1P1N1UV1T1BTPacked packed{};
+        packed.PositionAndBitangentSign.x = position.x | (position.y << 21);
+        packed.PositionAndBitangentSign.y = (position.y >> 11) | (position.z << 10) | (uint32_t(isBitangentFlipped) << 31);
+        packed.Normal = OctEncode(vertex.Normal);
+        packed.Tangent = OctEncode(vertex.Tangent);
+        packed.UV = glm::packHalf2x16(vertex.UV);
+
+        return packed;
+    }
+
+    Vertex1P1N1UV1T1BT MeshLoader::UnpackVertex(const Vertex1P1N1UV1T1BTPacked& vertex, const Geometry::AxisAlignedBox3D& bounds)
+    {
+        static const uint32_t QuantizationMax = Vertex1P1N1UV1T1BTPacked::PositionQuantizationMax;
+
+        glm::uvec3 quantizedPosition{
+            vertex.PositionAndBitangentSign.x & QuantizationMax,
+            (vertex.PositionAndBitangentSign.x >> 21) | ((vertex.PositionAndBitangentSign.y & 0x3FFu) << 11),
+            (vertex.PositionAndBitangentSign.y >> 10) & QuantizationMax
+        };
+
+        glm::vec3 position = bounds.Min + glm::vec3{ quantizedPosition } * (bounds.Max - bounds.Min) / float(QuantizationMax);
+        float bitangentSign = (vertex.PositionAndBitangentSign.y >> 31) ? -1.0f : 1.0f;
+
+        glm::vec3 normal = OctDecode(vertex.Normal);
+        glm::vec3 tangent = OctDecode(vertex.Tangent);
+
+        return Vertex1P1N1UV1T1BT{
+            glm::vec4{ position, 1.0f },
+            glm::unpackHalf2x16(vertex.UV),
+            normal,
+            tangent,
+            glm::cross(normal, tangent) * bitangentSign
+        };
+    }
+
+    uint32_t MeshLoader::OctEncode(const glm::vec3& direction)
+    {
+        // Zero vectors decode to +Z
+        if (glm::length2(direction) <= 0.0f) return 0;
+
+        glm::vec3 n = glm::normalize(direction);
+        glm::vec3 projected = n / (std::abs(n.x) + std::abs(n.y) + std::abs(n.z));
+        glm::vec2 octahedral{ projected };
+
+        // Lower hemisphere is folded over the diagonals
+        if (projected.z < 0.0f)
+        {
+            glm::vec2 signs{ octahedral.x >= 0.0f ? 1.0f : -1.0f, octahedral.y >= 0.0f ? 1.0f : -1.0f };
+            octahedral = (1.0f - glm::abs(glm::vec2{ octahedral.y, octahedral.x })) * signs;
+        }
+
+        // Rounding to the nearest quantized value is not the most accurate on the sphere,
+        // so every corner of the enclosing quantization cell is tried
+        glm::vec2 cellMin = glm::floor(octahedral * 32767.0f);
+        uint32_t bestEncoded = 0;
+        float bestDot = -2.0f;
+
+        for (uint32_t corner = 0; corner < 4; ++corner)
+        {
+            glm::vec2 candidate = (cellMin + glm::vec2{ float(corner & 1), float(corner >> 1) }) / 32767.0f;
+            uint32_t encoded = glm::packSnorm2x16(glm::clamp(candidate, -1.0f, 1.0f));
+            float cosine = glm::dot(OctDecode(encoded), n);
+
+            if (cosine > bestDot)
+            {
+                bestDot = cosine;
+                bestEncoded = encoded;
+            }
+        }
+
+        return bestEncoded;
+    }
+
+    glm::vec3 MeshLoader::OctDecode(uint32_t encoded)
+    {
+        glm::vec2 octahedral = glm::unpackSnorm2x16(encoded);
+        glm::vec3 n{ octahedral, 1.0f - std::abs(octahedral.x) - std::abs(octahedral.y) };
+
+        float fold = std::max(-n.z, 0.0f);
+        n.x += n.x >= 0.0f ? -fold : fold;
+        n.y += n.y >= 0.0f ? -fold : fold;
+
+        return glm::normalize(n);
     }
 
-    void MeshLoader::ProcessNode(aiNode* node, const aiScene* scene)
+    void MeshLoader::CollectMeshes(const aiNode* node, const aiScene* scene, std::vector<const aiMesh*>& meshes) const
     {
         for (auto i = 0u; i < node->mNumMeshes; i++)
         {
-            aiMesh* assimpMesh = scene->mMeshes[node->mMeshes[i]];
-            mLoadedMeshes.emplace_back(ProcessMesh(assimpMesh, scene));
+            meshes.push_back(scene->mMeshes[node->mMeshes[i]]);
         }
 
         for (auto i = 0u; i < node->mNumChildren; i++)
         {
-            ProcessNode(node->mChildren[i], scene);
+            CollectMeshes(node->mChildren[i], scene, meshes);
         }
     }
 
@@ -1,7 +1,11 @@
 #pragma once
 
 #include "Vertices/Vertex1P1N1UV1T1BT.hpp"
+#include "Vertices/Vertex1P1N1UV1T1BTPacked.hpp"
 #include "Mesh.hpp"
+#include "MeshOptimizer.hpp"
+#include "MeshSimplifier.hpp"
+#include "CookedMeshCache.hpp"
 
 // Assimp is in conflict with windows.h definitions of min and max
 #ifndef NOMINMAX 
@@ -17,7 +21,9 @@
 #endif
 
 #include <vector>
+#include <optional>
 #include <filesystem>
+#include <chrono>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
@@ -28,17 +34,135 @@ namespace PathFinder
     class MeshLoader
     {
     public:
-        MeshLoader(const std::filesystem::path& fileRoot);
+        struct LODGenerationSettings
+        {
+            // Including LOD 0
+            uint32_t MaxLODCount = 4;
+
+            // Triangle count of each LOD relative to the previous one
+            float TriangleRatio = 0.5f;
+
+            // LODs are not generated below this triangle count
+            uint32_t MinTriangleCount = 64;
+
+            // Largest error of the coarsest LOD, relative to the largest dimension of mesh bounding box
+            float MaxError = 0.05f;
+
+            float AttributeWeight = 1.0f;
+            bool LockBorders = true;
+        };
+
+        struct ImportSettings
+        {
+            // Triangles are reordered for vertex cache efficiency and reduced overdraw,
+            // then vertices are reordered for fetch locality
+            bool OptimizeIndexBuffers = true;
+
+            // Largest ACMR increase, relative to cache optimized triangles, overdraw optimization can introduce
+            float OverdrawACMRThreshold = 1.05f;
+
+            // Loaded meshes also carry a packed copy of their vertices, which GBuffer reads instead of full precision ones.
+            // Packing is dropped for meshes whose UVs lose more than the tolerance, heavily tiled UVs exceed half precision.
+            bool PackVertices = true;
+            float MaxPackedUVError = 1.0f / 2048.0f;
+
+            bool GenerateLODs = true;
+            LODGenerationSettings LODGeneration;
+
+            // Meshlets of LOD 0 are culled on GPU before GBuffer draws them
+            bool BuildMeshlets = true;
+            uint32_t MaxMeshletVertexCount = 64;
+            uint32_t MaxMeshletTriangleCount = 124;
+        };
+
+        struct Statistics
+        {
+            // Of all meshes of the last load
+            VertexCacheStatistics UnoptimizedVertexCache;
+            VertexCacheStatistics OptimizedVertexCache;
+            std::chrono::microseconds OptimizationTime{ 0 };
+
+            // LODs besides LOD 0
+            uint64_t LODCount = 0;
+            std::chrono::microseconds LODGenerationTime{ 0 };
+
+            uint64_t MeshletCount = 0;
+            std::chrono::microseconds MeshletGenerationTime{ 0 };
+
+            // Wall time of the whole last load. Files loaded from cache were loaded warm,
+            // the rest were imported cold. Times of individual stages are summed over all meshes.
+            uint32_t FileCount = 0;
+            uint32_t FilesLoadedFromCache = 0;
+            uint64_t MeshCount = 0;
+            std::chrono::microseconds LoadTime{ 0 };
+        };
+
+        /// Imported meshes are cooked into 'cookedMeshRoot' and later loaded from there
+        /// while the source file and settings stay the same. Empty root disables cooking.
+        MeshLoader(const std::filesystem::path& fileRoot, const std::filesystem::path& cookedMeshRoot = {});
 
         std::vector<Mesh> Load(const std::string& fileName);
 
+        /// Loads files concurrently and processes meshes of every file in parallel.
+        /// Meshes are returned in order of file names and, within a file, in order of scene node traversal.
+        std::vector<std::vector<Mesh>> LoadFiles(const std::vector<std::string>& fileNames);
+
+        /// Reorders triangles and vertices of a mesh and records vertex cache efficiency before and after.
+        /// Has to run before vertices are packed and meshlets are built, since they depend on the order.
+        static void OptimizeMesh(Mesh& mesh, float overdrawACMRThreshold);
+
+        /// Simplifies the mesh into a chain of LODs sharing its vertices, each LOD is simplified from the previous one.
+        /// Generation stops once the error limit or the minimum triangle count prevents meaningful reduction.
+        /// Has to run after the mesh is optimized, since LODs refer to the final vertex order.
+        static void GenerateLODs(Mesh& mesh, const LODGenerationSettings& settings);
+
+        /// Produces packed vertices of a mesh and measures the error they introduce.
+        /// Only the error is kept when UV error exceeds the tolerance, the mesh then stays unpacked.
+        static void PackVertices(Mesh& mesh, float maxUVError);
+
+        /// Splits mesh triangles into meshlets in index buffer order and computes their culling data.
+        /// Output depends only on mesh geometry, so repeated imports produce identical meshlets.
+        static void BuildMeshlets(Mesh& mesh, uint32_t maxVertexCount, uint32_t maxTriangleCount);
+
+        static Vertex1P1N1UV1T1BTPacked PackVertex(const Vertex1P1N1UV1T1BT& vertex, const Geometry::AxisAlignedBox3D& bounds);
+        static Vertex1P1N1UV1T1BT UnpackVertex(const Vertex1P1N1UV1T1BTPacked& vertex, const Geometry::AxisAlignedBox3D& bounds);
+
     private:
-        Mesh ProcessMesh(aiMesh* mesh, const aiScene* scene);
-        void ProcessNode(aiNode* node, const aiScene* scene);
+        static uint32_t OctEncode(const glm::vec3& direction);
+        static glm::vec3 OctDecode(uint32_t encoded);
+        static void ComputeMeshletBounds(const Mesh& mesh, Meshlet& meshlet, const uint32_t* vertexIndices, const uint32_t* triangles);
+
+        struct FileLoadResult
+        {
+            std::vector<Mesh> Meshes;
+            bool IsLoadedFromCache = false;
+            std::chrono::microseconds OptimizationTime{ 0 };
+            std::chrono::microseconds LODGenerationTime{ 0 };
+            std::chrono::microseconds MeshletGenerationTime{ 0 };
+        };
+
+        // Loading and importing only read settings, so they can run concurrently
+        FileLoadResult LoadFile(const std::string& fileName) const;
+        void Import(const std::filesystem::path& path, FileLoadResult& result) const;
+        void GatherStatistics(const std::vector<std::vector<Mesh>>& meshes);
+
+        // Cooked meshes are only valid for settings they were produced with
+        uint64_t ImportSettingsHash() const;
+
+        Mesh ProcessMesh(const aiMesh* mesh, FileLoadResult& timings) const;
+        void CollectMeshes(const aiNode* node, const aiScene* scene, std::vector<const aiMesh*>& meshes) const;
         void CalculateTangentSpace(Mesh* mesh);
 
-        std::vector<Mesh> mLoadedMeshes;
         std::filesystem::path mRootPath;
+        std::optional<CookedMeshCache> mCookedMeshCache;
+        ImportSettings mSettings;
+        Statistics mStatistics;
+
+    public:
+        inline const auto& Settings() const { return mSettings; }
+        inline const auto& GetStatistics() const { return mStatistics; }
+
+        inline void SetSettings(const ImportSettings& settings) { mSettings = settings; }
     };
 
 }
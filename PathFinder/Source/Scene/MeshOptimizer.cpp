@@ -0,0 +1,425 @@
+#include "MeshOptimizer.hpp"
+
+#include <Foundation/Assert.hpp>
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <limits>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    std::vector<uint32_t> MeshOptimizer::OptimizeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount)
+    {
+        assert_format(indices.size() % 3 == 0, "Index buffer must describe a triangle list");
+
+        uint32_t triangleCount = uint32_t(indices.size() / 3);
+
+        if (triangleCount == 0) return indices;
+
+        // Triangles adjacent to every vertex, not yet emitted ones are kept at the front of each range
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        std::vector<uint32_t> remainingTriangleCounts(vertexCount, 0);
+
+        for (uint32_t index : indices)
+        {
+            assert_format(index < vertexCount, "Index is out of vertex range");
+            remainingTriangleCounts[index]++;
+        }
+
+        std::partial_sum(remainingTriangleCounts.begin(), remainingTriangleCounts.end(), adjacencyOffsets.begin() + 1);
+
+        std::vector<uint32_t> adjacentTriangles(indices.size());
+        std::vector<uint32_t> fillCounts(vertexCount, 0);
+
+        for (uint32_t triangleIdx = 0; triangleIdx < triangleCount; ++triangleIdx)
+        {
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                uint32_t vertexIdx = indices[triangleIdx * 3 + corner];
+                adjacentTriangles[adjacencyOffsets[vertexIdx] + fillCounts[vertexIdx]++] = triangleIdx;
+            }
+        }
+
+        std::vector<float> vertexScores(vertexCount);
+        std::vector<int32_t> cachePositions(vertexCount, -1);
+
+        for (uint32_t vertexIdx = 0; vertexIdx < vertexCount; ++vertexIdx)
+        {
+            vertexScores[vertexIdx] = VertexScore(-1, remainingTriangleCounts[vertexIdx]);
+        }
+
+        std::vector<float> triangleScores(triangleCount);
+        std::vector<bool> isTriangleEmitted(triangleCount, false);
+
+        for (uint32_t triangleIdx = 0; triangleIdx < triangleCount; ++triangleIdx)
+        {
+            triangleScores[triangleIdx] =
+                vertexScores[indices[triangleIdx * 3]] +
+                vertexScores[indices[triangleIdx * 3 + 1]] +
+                vertexScores[indices[triangleIdx * 3 + 2]];
+        }
+
+        std::vector<uint32_t> optimizedIndices;
+        optimizedIndices.reserve(indices.size());
+
+        // Cache holds 3 extra entries for vertices of the emitted triangle pushing older ones out
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> newCache;
+        cache.reserve(OptimizationCacheSize + 3);
+        newCache.reserve(OptimizationCacheSize + 3);
+
+        static const uint32_t NoTriangle = std::numeric_limits<uint32_t>::max();
+
+        uint32_t bestTriangle = uint32_t(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+        uint32_t inputOrderCursor = 0;
+
+        for (uint32_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+        {
+            // No cached vertex has triangles left, so continue with the next triangle in input order
+            if (bestTriangle == NoTriangle)
+            {
+                while (isTriangleEmitted[inputOrderCursor]) ++inputOrderCursor;
+                bestTriangle = inputOrderCursor;
+            }
+
+            isTriangleEmitted[bestTriangle] = true;
+            newCache.clear();
+
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                uint32_t vertexIdx = indices[bestTriangle * 3 + corner];
+                optimizedIndices.push_back(vertexIdx);
+                newCache.push_back(vertexIdx);
+
+                // Move emitted triangle past the not emitted ones of the vertex
+                uint32_t* adjacency = &adjacentTriangles[adjacencyOffsets[vertexIdx]];
+                uint32_t* emittedTriangle = std::find(adjacency, adjacency + remainingTriangleCounts[vertexIdx], bestTriangle);
+                std::swap(*emittedTriangle, adjacency[remainingTriangleCounts[vertexIdx] - 1]);
+                remainingTriangleCounts[vertexIdx]--;
+            }
+
+            for (uint32_t vertexIdx : cache)
+            {
+                if (std::find(newCache.begin(), newCache.end(), vertexIdx) == newCache.end())
+                {
+                    newCache.push_back(vertexIdx);
+                }
+            }
+
+            std::swap(cache, newCache);
+
+            // Vertices pushed out of the cache lose their cache score
+            for (uint32_t position = 0; position < cache.size(); ++position)
+            {
+                cachePositions[cache[position]] = position < OptimizationCacheSize ? int32_t(position) : -1;
+            }
+
+            for (uint32_t vertexIdx : cache)
+            {
+                float newScore = VertexScore(cachePositions[vertexIdx], remainingTriangleCounts[vertexIdx]);
+                float scoreDelta = newScore - vertexScores[vertexIdx];
+                vertexScores[vertexIdx] = newScore;
+
+                const uint32_t* adjacency = &adjacentTriangles[adjacencyOffsets[vertexIdx]];
+
+                for (uint32_t idx = 0; idx < remainingTriangleCounts[vertexIdx]; ++idx)
+                {
+                    triangleScores[adjacency[idx]] += scoreDelta;
+                }
+            }
+
+            // Only triangles touching cached vertices changed their scores, so the best one is among them
+            float bestScore = -std::numeric_limits<float>::max();
+            bestTriangle = NoTriangle;
+
+            for (uint32_t vertexIdx : cache)
+            {
+                const uint32_t* adjacency = &adjacentTriangles[adjacencyOffsets[vertexIdx]];
+
+                for (uint32_t idx = 0; idx < remainingTriangleCounts[vertexIdx]; ++idx)
+                {
+                    uint32_t triangleIdx = adjacency[idx];
+
+                    // Ties are resolved in favor of earlier triangles to stay independent of cache order
+                    if (triangleScores[triangleIdx] > bestScore || (triangleScores[triangleIdx] == bestScore && triangleIdx < bestTriangle))
+                    {
+                        bestScore = triangleScores[triangleIdx];
+                        bestTriangle = triangleIdx;
+                    }
+                }
+            }
+
+            if (cache.size() > OptimizationCacheSize)
+            {
+                cache.resize(OptimizationCacheSize);
+            }
+        }
+
+        return optimizedIndices;
+    }
+
+    std::vector<uint32_t> MeshOptimizer::OptimizeOverdraw(const std::vector<uint32_t>& indices, const std::vector<Vertex1P1N1UV1T1BT>& vertices, float threshold)
+    {
+        assert_format(indices.size() % 3 == 0, "Index buffer must describe a triangle list");
+
+        uint32_t triangleCount = uint32_t(indices.size() / 3);
+
+        if (triangleCount == 0) return indices;
+
+        // Simulated FIFO cache, a vertex is cached if it was inserted less than cache size insertions ago
+        std::vector<uint64_t> insertionTimes(vertices.size(), 0);
+        uint64_t time = AnalysisCacheSize + 1;
+
+        auto resetCache = [&]() { time += AnalysisCacheSize + 1; };
+
+        auto triangleMissCount = [&](uint32_t triangleIdx)
+        {
+            uint32_t missCount = 0;
+
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                uint32_t vertexIdx = indices[triangleIdx * 3 + corner];
+
+                if (time - insertionTimes[vertexIdx] > AnalysisCacheSize)
+                {
+                    insertionTimes[vertexIdx] = time++;
+                    missCount++;
+                }
+            }
+
+            return missCount;
+        };
+
+        // Triangles missing every vertex start new clusters without hurting cache efficiency
+        std::vector<uint32_t> hardBoundaries;
+
+        for (uint32_t triangleIdx = 0; triangleIdx < triangleCount; ++triangleIdx)
+        {
+            if (triangleMissCount(triangleIdx) == 3)
+            {
+                hardBoundaries.push_back(triangleIdx);
+            }
+        }
+
+        hardBoundaries.push_back(triangleCount);
+
+        // Hard clusters are further split wherever ACMR of a cluster prefix stays within the threshold
+        std::vector<uint32_t> clusterStarts;
+
+        for (uint32_t clusterIdx = 0; clusterIdx + 1 < hardBoundaries.size(); ++clusterIdx)
+        {
+            uint32_t clusterStart = hardBoundaries[clusterIdx];
+            uint32_t clusterEnd = hardBoundaries[clusterIdx + 1];
+
+            resetCache();
+            uint32_t clusterMissCount = 0;
+
+            for (uint32_t triangleIdx = clusterStart; triangleIdx < clusterEnd; ++triangleIdx)
+            {
+                clusterMissCount += triangleMissCount(triangleIdx);
+            }
+
+            float missThreshold = threshold * float(clusterMissCount) / float(clusterEnd - clusterStart);
+
+            resetCache();
+            clusterStarts.push_back(clusterStart);
+
+            uint32_t start = clusterStart;
+            uint32_t missCount = 0;
+
+            for (uint32_t triangleIdx = clusterStart; triangleIdx < clusterEnd; ++triangleIdx)
+            {
+                missCount += triangleMissCount(triangleIdx);
+
+                if (triangleIdx + 1 < clusterEnd && float(missCount) / float(triangleIdx + 1 - start) <= missThreshold)
+                {
+                    start = triangleIdx + 1;
+                    missCount = 0;
+                    clusterStarts.push_back(start);
+                    resetCache();
+                }
+            }
+        }
+
+        clusterStarts.push_back(triangleCount);
+
+        auto position = [&](uint32_t index) { return glm::vec3{ vertices[index].Position }; };
+
+        glm::vec3 meshCentroid{ 0.0f };
+
+        for (uint32_t index : indices)
+        {
+            meshCentroid += position(index);
+        }
+
+        meshCentroid /= float(indices.size());
+
+        // Clusters facing away from the mesh center are likely to occlude the rest
+        uint32_t clusterCount = uint32_t(clusterStarts.size() - 1);
+        std::vector<float> clusterSortKeys(clusterCount);
+
+        for (uint32_t clusterIdx = 0; clusterIdx < clusterCount; ++clusterIdx)
+        {
+            glm::vec3 centroid{ 0.0f };
+            glm::vec3 normal{ 0.0f };
+            float area = 0.0f;
+
+            for (uint32_t triangleIdx = clusterStarts[clusterIdx]; triangleIdx < clusterStarts[clusterIdx + 1]; ++triangleIdx)
+            {
+                glm::vec3 p0 = position(indices[triangleIdx * 3]);
+                glm::vec3 p1 = position(indices[triangleIdx * 3 + 1]);
+                glm::vec3 p2 = position(indices[triangleIdx * 3 + 2]);
+
+                // Clockwise front faces make the cross product point outwards
+                glm::vec3 triangleNormal = glm::cross(p1 - p0, p2 - p0);
+                float triangleArea = glm::length(triangleNormal);
+
+                centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+                normal += triangleNormal;
+                area += triangleArea;
+            }
+
+            float normalLength = glm::length(normal);
+
+            clusterSortKeys[clusterIdx] = area > 0.0f && normalLength > 0.0f ?
+                glm::dot(centroid / area - meshCentroid, normal / normalLength) : 0.0f;
+        }
+
+        std::vector<uint32_t> clusterOrder(clusterCount);
+        std::iota(clusterOrder.begin(), clusterOrder.end(), 0);
+        std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&](uint32_t left, uint32_t right)
+        {
+            return clusterSortKeys[left] > clusterSortKeys[right];
+        });
+
+        std::vector<uint32_t> optimizedIndices;
+        optimizedIndices.reserve(indices.size());
+
+        for (uint32_t clusterIdx : clusterOrder)
+        {
+            optimizedIndices.insert(optimizedIndices.end(),
+                indices.begin() + clusterStarts[clusterIdx] * 3,
+                indices.begin() + clusterStarts[clusterIdx + 1] * 3);
+        }
+
+        return optimizedIndices;
+    }
+
+    void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex1P1N1UV1T1BT>& vertices, std::vector<uint32_t>& indices)
+    {
+        static const uint32_t NotRemapped = std::numeric_limits<uint32_t>::max();
+
+        std::vector<uint32_t> remap(vertices.size(), NotRemapped);
+        std::vector<Vertex1P1N1UV1T1BT> optimizedVertices;
+        optimizedVertices.reserve(vertices.size());
+
+        for (uint32_t& index : indices)
+        {
+            if (remap[index] == NotRemapped)
+            {
+                remap[index] = uint32_t(optimizedVertices.size());
+                optimizedVertices.push_back(vertices[index]);
+            }
+
+            index = remap[index];
+        }
+
+        for (uint32_t vertexIdx = 0; vertexIdx < vertices.size(); ++vertexIdx)
+        {
+            if (remap[vertexIdx] == NotRemapped)
+            {
+                optimizedVertices.push_back(vertices[vertexIdx]);
+            }
+        }
+
+        vertices = std::move(optimizedVertices);
+    }
+
+    VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize)
+    {
+        VertexCacheStatistics statistics{};
+
+        if (indices.empty()) return statistics;
+
+        std::vector<uint64_t> insertionTimes(vertexCount, 0);
+        std::vector<bool> isReferenced(vertexCount, false);
+        uint64_t time = cacheSize + 1;
+        uint64_t missCount = 0;
+        uint64_t referencedVertexCount = 0;
+
+        for (uint32_t index : indices)
+        {
+            if (time - insertionTimes[index] > cacheSize)
+            {
+                insertionTimes[index] = time++;
+                missCount++;
+            }
+
+            if (!isReferenced[index])
+            {
+                isReferenced[index] = true;
+                referencedVertexCount++;
+            }
+        }
+
+        statistics.ACMR = float(missCount) / float(indices.size() / 3);
+        statistics.ATVR = float(missCount) / float(referencedVertexCount);
+
+        return statistics;
+    }
+
+    float MeshOptimizer::VertexScore(int32_t cachePosition, uint32_t remainingTriangleCount)
+    {
+        static const float CacheDecayPower = 1.5f;
+        static const float LastTriangleScore = 0.75f;
+        static const float ValenceBoostScale = 2.0f;
+        static const float ValenceBoostPower = 0.5f;
+        static const uint32_t MaxTabulatedValence = 32;
+
+        struct ScoreTables
+        {
+            std::array<float, OptimizationCacheSize> CacheScores{};
+            std::array<float, MaxTabulatedValence + 1> ValenceScores{};
+        };
+
+        // Scores are evaluated for every cached vertex after every emitted triangle, so they are tabulated
+        static const ScoreTables Tables = []()
+        {
+            ScoreTables tables{};
+
+            for (uint32_t position = 0; position < OptimizationCacheSize; ++position)
+            {
+                // Vertices of the last triangle get a fixed score, so that the very same triangle
+                // is not favored and strips don't bounce back and forth
+                tables.CacheScores[position] = position < 3 ?
+                    LastTriangleScore :
+                    std::pow(1.0f - float(position - 3) / float(OptimizationCacheSize - 3), CacheDecayPower);
+            }
+
+            // Vertices with few triangles left are prioritized to get rid of them
+            for (uint32_t valence = 1; valence <= MaxTabulatedValence; ++valence)
+            {
+                tables.ValenceScores[valence] = ValenceBoostScale * std::pow(float(valence), -ValenceBoostPower);
+            }
+
+            return tables;
+        }();
+
+        // Vertex is not going to be used again
+        if (remainingTriangleCount == 0) return -1.0f;
+
+        float score = cachePosition >= 0 ? Tables.CacheScores[cachePosition] : 0.0f;
+
+        score += remainingTriangleCount <= MaxTabulatedValence ?
+            Tables.ValenceScores[remainingTriangleCount] :
+            ValenceBoostScale * std::pow(float(remainingTriangleCount), -ValenceBoostPower);
+
+        return score;
+    }
+
+}
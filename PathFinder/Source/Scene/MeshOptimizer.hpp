@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Vertices/Vertex1P1N1UV1T1BT.hpp"
+
+#include <bitsery/bitsery.h>
+
+#include <vector>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Efficiency of an index buffer on a simulated FIFO post-transform cache
+    struct VertexCacheStatistics
+    {
+        // Average cache miss count per triangle, 0.5 is the ideal for large regular meshes, 3 is the worst
+        float ACMR = 0.0f;
+
+        // Average transform count per referenced vertex, 1 is the ideal
+        float ATVR = 0.0f;
+
+        template <typename S>
+        void serialize(S& s)
+        {
+            s.value4b(ACMR);
+            s.value4b(ATVR);
+        }
+    };
+
+    struct MeshOptimizationReport
+    {
+        VertexCacheStatistics Unoptimized;
+        VertexCacheStatistics Optimized;
+
+        template <typename S>
+        void serialize(S& s)
+        {
+            s.object(Unoptimized);
+            s.object(Optimized);
+        }
+    };
+
+    /// Offline reordering of indexed triangle lists. Results depend only on the input,
+    /// so repeated imports of the same geometry produce identical buffers.
+    class MeshOptimizer
+    {
+    public:
+        /// Reorders triangles so that they reuse recently transformed vertices.
+        /// Tom Forsyth's linear-speed vertex cache optimization.
+        static std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount);
+
+        /// Splits cache optimized triangles into clusters and draws outward facing clusters first,
+        /// so that they occlude the rest of the mesh. Clusters are kept large enough for ACMR
+        /// to stay within 'threshold' times the ACMR of the input.
+        static std::vector<uint32_t> OptimizeOverdraw(const std::vector<uint32_t>& indices, const std::vector<Vertex1P1N1UV1T1BT>& vertices, float threshold);
+
+        /// Orders vertices by their first use in the index buffer.
+        /// Vertices no triangle refers to are moved to the end.
+        static void OptimizeVertexFetch(std::vector<Vertex1P1N1UV1T1BT>& vertices, std::vector<uint32_t>& indices);
+
+        static VertexCacheStatistics AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize = AnalysisCacheSize);
+
+    private:
+        inline static const uint32_t AnalysisCacheSize = 16;
+        inline static const uint32_t OptimizationCacheSize = 32;
+
+        static float VertexScore(int32_t cachePosition, uint32_t remainingTriangleCount);
+    };
+
+}
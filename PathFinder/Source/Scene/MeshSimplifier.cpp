@@ -0,0 +1,347 @@
+#include "MeshSimplifier.hpp"
+
+#include <Foundation/Assert.hpp>
+
+#include <glm/geometric.hpp>
+#include <robinhood/robin_hood.h>
+
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    MeshSimplifier::Result MeshSimplifier::Simplify(const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices, const Settings& settings)
+    {
+        assert_format(indices.size() % 3 == 0, "Index buffer must describe a triangle list");
+
+        Result result{ indices, 0.0f };
+
+        uint32_t vertexCount = (uint32_t)vertices.size();
+
+        if (indices.size() / 3 <= settings.TargetTriangleCount || vertexCount == 0) return result;
+
+        // Positions are brought to a unit sized box, so that errors don't depend on mesh scale
+        glm::vec3 boundsMin{ std::numeric_limits<float>::max() };
+        glm::vec3 boundsMax{ std::numeric_limits<float>::lowest() };
+
+        for (const Vertex1P1N1UV1T1BT& vertex : vertices)
+        {
+            boundsMin = glm::min(boundsMin, glm::vec3{ vertex.Position });
+            boundsMax = glm::max(boundsMax, glm::vec3{ vertex.Position });
+        }
+
+        glm::vec3 extent = boundsMax - boundsMin;
+        float maxExtent = std::max({ extent.x, extent.y, extent.z });
+        double scale = maxExtent > 0.0f ? 1.0 / maxExtent : 1.0;
+
+        std::vector<glm::dvec3> positions(vertexCount);
+
+        for (uint32_t vertexIdx = 0; vertexIdx < vertexCount; ++vertexIdx)
+        {
+            positions[vertexIdx] = glm::dvec3{ glm::vec3{ vertices[vertexIdx].Position } - boundsMin } * scale;
+        }
+
+        std::vector<Quadric> quadrics(vertexCount);
+        robin_hood::unordered_flat_map<uint64_t, uint32_t> edgeTriangleCounts;
+
+        auto edgeKey = [](uint32_t a, uint32_t b) { return (uint64_t(std::min(a, b)) << 32) | std::max(a, b); };
+
+        for (uint64_t idx = 0; idx < indices.size(); idx += 3)
+        {
+            const glm::dvec3& p0 = positions[indices[idx]];
+            const glm::dvec3& p1 = positions[indices[idx + 1]];
+            const glm::dvec3& p2 = positions[indices[idx + 2]];
+
+            glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+            double doubleArea = glm::length(normal);
+
+            if (doubleArea > 0.0)
+            {
+                normal /= doubleArea;
+
+                // Planes of larger triangles contribute more to the error
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    quadrics[indices[idx + corner]].AddPlane(normal, -glm::dot(normal, p0), doubleArea * 0.5);
+                }
+            }
+
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                edgeTriangleCounts[edgeKey(indices[idx + corner], indices[idx + (corner + 1) % 3])]++;
+            }
+        }
+
+        // Edges used by a single triangle are borders, edges used by more than two are non-manifold.
+        // Neither can be collapsed without tearing or folding the surface.
+        std::vector<bool> isLocked(vertexCount, false);
+
+        for (const auto& [key, triangleCount] : edgeTriangleCounts)
+        {
+            if ((settings.LockBorders && triangleCount == 1) || triangleCount > 2)
+            {
+                isLocked[uint32_t(key >> 32)] = true;
+                isLocked[uint32_t(key & 0xFFFFFFFF)] = true;
+            }
+        }
+
+        double maxCost = double(settings.MaxError) * double(settings.MaxError);
+        double resultCost = 0.0;
+
+        std::vector<uint32_t>& currentIndices = result.Indices;
+        std::vector<uint32_t> remap(vertexCount);
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1);
+        std::vector<uint32_t> adjacentTriangles;
+        std::vector<bool> isAffected(vertexCount);
+        std::vector<Collapse> collapses;
+
+        // Collapses are performed in passes, each pass picks the cheapest collapses
+        // that don't touch neighborhoods of each other, so that costs computed for the pass remain valid
+        while (currentIndices.size() / 3 > settings.TargetTriangleCount)
+        {
+            uint32_t triangleCount = uint32_t(currentIndices.size() / 3);
+
+            std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+
+            for (uint32_t index : currentIndices)
+            {
+                adjacencyOffsets[index + 1]++;
+            }
+
+            std::partial_sum(adjacencyOffsets.begin(), adjacencyOffsets.end(), adjacencyOffsets.begin());
+
+            adjacentTriangles.resize(currentIndices.size());
+            std::vector<uint32_t> fillCounts(vertexCount, 0);
+
+            for (uint32_t triangleIdx = 0; triangleIdx < triangleCount; ++triangleIdx)
+            {
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    uint32_t vertexIdx = currentIndices[triangleIdx * 3 + corner];
+                    adjacentTriangles[adjacencyOffsets[vertexIdx] + fillCounts[vertexIdx]++] = triangleIdx;
+                }
+            }
+
+            // Every interior edge is met twice with opposite directions, which gives both collapse directions
+            collapses.clear();
+
+            for (uint32_t triangleIdx = 0; triangleIdx < triangleCount; ++triangleIdx)
+            {
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    uint32_t from = currentIndices[triangleIdx * 3 + corner];
+                    uint32_t to = currentIndices[triangleIdx * 3 + (corner + 1) % 3];
+
+                    if (isLocked[from]) continue;
+
+                    Quadric quadric = quadrics[from];
+                    quadric += quadrics[to];
+
+                    double cost = quadric.Evaluate(positions[to]);
+
+                    if (cost > maxCost) continue;
+
+                    cost += settings.AttributeWeight * AttributeError(vertices, positions, currentIndices, &adjacentTriangles[adjacencyOffsets[from]], adjacencyOffsets[from + 1] - adjacencyOffsets[from], from, to);
+
+                    if (cost <= maxCost)
+                    {
+                        collapses.push_back({ from, to, cost });
+                    }
+                }
+            }
+
+            // Ties are resolved by vertex indices to keep results deterministic
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& left, const Collapse& right)
+            {
+                return std::tie(left.Cost, left.From, left.To) < std::tie(right.Cost, right.From, right.To);
+            });
+
+            std::iota(remap.begin(), remap.end(), 0);
+            std::fill(isAffected.begin(), isAffected.end(), false);
+
+            // A collapse removes two triangles of an interior edge
+            uint32_t trianglesToRemove = triangleCount - settings.TargetTriangleCount;
+            uint32_t removedTriangleCount = 0;
+
+            for (const Collapse& collapse : collapses)
+            {
+                if (removedTriangleCount >= trianglesToRemove) break;
+                if (isAffected[collapse.From] || isAffected[collapse.To]) continue;
+
+                const uint32_t* fromTriangles = &adjacentTriangles[adjacencyOffsets[collapse.From]];
+                uint32_t fromTriangleCount = adjacencyOffsets[collapse.From + 1] - adjacencyOffsets[collapse.From];
+
+                // Triangles that stay must not flip or degenerate when their vertex is moved
+                bool isValid = true;
+                uint32_t collapsedTriangleCount = 0;
+
+                for (uint32_t idx = 0; idx < fromTriangleCount && isValid; ++idx)
+                {
+                    const uint32_t* triangle = &currentIndices[fromTriangles[idx] * 3];
+
+                    if (triangle[0] == collapse.To || triangle[1] == collapse.To || triangle[2] == collapse.To)
+                    {
+                        collapsedTriangleCount++;
+                        continue;
+                    }
+
+                    glm::dvec3 oldPositions[3];
+                    glm::dvec3 newPositions[3];
+
+                    for (uint32_t corner = 0; corner < 3; ++corner)
+                    {
+                        oldPositions[corner] = positions[triangle[corner]];
+                        newPositions[corner] = positions[triangle[corner] == collapse.From ? collapse.To : triangle[corner]];
+                    }
+
+                    glm::dvec3 oldNormal = glm::cross(oldPositions[1] - oldPositions[0], oldPositions[2] - oldPositions[0]);
+                    glm::dvec3 newNormal = glm::cross(newPositions[1] - newPositions[0], newPositions[2] - newPositions[0]);
+
+                    // Rotations close to 90 degrees are rejected as well, they produce slivers that flip on later collapses
+                    isValid = glm::dot(oldNormal, newNormal) > 0.25 * glm::length(oldNormal) * glm::length(newNormal);
+                }
+
+                if (!isValid) continue;
+
+                remap[collapse.From] = collapse.To;
+                quadrics[collapse.To] += quadrics[collapse.From];
+                resultCost = std::max(resultCost, collapse.Cost);
+                removedTriangleCount += collapsedTriangleCount;
+
+                for (uint32_t idx = 0; idx < fromTriangleCount; ++idx)
+                {
+                    const uint32_t* triangle = &currentIndices[fromTriangles[idx] * 3];
+                    isAffected[triangle[0]] = isAffected[triangle[1]] = isAffected[triangle[2]] = true;
+                }
+            }
+
+            if (removedTriangleCount == 0) break;
+
+            uint64_t writeIdx = 0;
+
+            for (uint64_t idx = 0; idx < currentIndices.size(); idx += 3)
+            {
+                uint32_t i0 = remap[currentIndices[idx]];
+                uint32_t i1 = remap[currentIndices[idx + 1]];
+                uint32_t i2 = remap[currentIndices[idx + 2]];
+
+                if (i0 == i1 || i1 == i2 || i2 == i0) continue;
+
+                currentIndices[writeIdx++] = i0;
+                currentIndices[writeIdx++] = i1;
+                currentIndices[writeIdx++] = i2;
+            }
+
+            currentIndices.resize(writeIdx);
+        }
+
+        result.Error = float(std::sqrt(resultCost));
+
+        return result;
+    }
+
+    double MeshSimplifier::AttributeError(
+        const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<glm::dvec3>& positions, const std::vector<uint32_t>& indices,
+        const uint32_t* fromTriangles, uint32_t fromTriangleCount, uint32_t from, uint32_t to)
+    {
+        // Attributes at the position of the removed vertex are interpolated from the triangle that covers it after the collapse.
+        // The covering triangle is the one the vertex is the deepest inside of, which makes linear attribute fields collapse with no error.
+        double bestMinBarycentric = std::numeric_limits<double>::lowest();
+        glm::vec3 normal = vertices[to].Normal;
+        glm::vec2 uv = vertices[to].UV;
+
+        const glm::dvec3& point = positions[from];
+
+        for (uint32_t idx = 0; idx < fromTriangleCount; ++idx)
+        {
+            const uint32_t* triangle = &indices[fromTriangles[idx] * 3];
+
+            if (triangle[0] == to || triangle[1] == to || triangle[2] == to) continue;
+
+            uint32_t corners[3];
+
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                corners[corner] = triangle[corner] == from ? to : triangle[corner];
+            }
+
+            glm::dvec3 e0 = positions[corners[1]] - positions[corners[0]];
+            glm::dvec3 e1 = positions[corners[2]] - positions[corners[0]];
+            glm::dvec3 e2 = point - positions[corners[0]];
+
+            double d00 = glm::dot(e0, e0);
+            double d01 = glm::dot(e0, e1);
+            double d11 = glm::dot(e1, e1);
+            double d20 = glm::dot(e2, e0);
+            double d21 = glm::dot(e2, e1);
+            double denominator = d00 * d11 - d01 * d01;
+
+            if (denominator <= 0.0) continue;
+
+            double v = (d11 * d20 - d01 * d21) / denominator;
+            double w = (d00 * d21 - d01 * d20) / denominator;
+            double u = 1.0 - v - w;
+            double minBarycentric = std::min({ u, v, w });
+
+            if (minBarycentric <= bestMinBarycentric) continue;
+
+            bestMinBarycentric = minBarycentric;
+
+            // Barycentrics outside of the triangle would extrapolate attributes
+            glm::vec3 weights = glm::clamp(glm::vec3{ u, v, w }, 0.0f, 1.0f);
+            weights /= std::max(weights.x + weights.y + weights.z, 1e-6f);
+
+            normal = vertices[corners[0]].Normal * weights.x + vertices[corners[1]].Normal * weights.y + vertices[corners[2]].Normal * weights.z;
+            uv = vertices[corners[0]].UV * weights.x + vertices[corners[1]].UV * weights.y + vertices[corners[2]].UV * weights.z;
+        }
+
+        glm::vec3 normalDelta = normal - vertices[from].Normal;
+        glm::vec2 uvDelta = uv - vertices[from].UV;
+
+        return glm::dot(normalDelta, normalDelta) + glm::dot(uvDelta, uvDelta);
+    }
+
+    void MeshSimplifier::Quadric::AddPlane(const glm::dvec3& normal, double distance, double weight)
+    {
+        double a = normal.x;
+        double b = normal.y;
+        double c = normal.z;
+        double d = distance;
+
+        A[0] += weight * a * a; A[1] += weight * a * b; A[2] += weight * a * c; A[3] += weight * a * d;
+        A[4] += weight * b * b; A[5] += weight * b * c; A[6] += weight * b * d;
+        A[7] += weight * c * c; A[8] += weight * c * d;
+        A[9] += weight * d * d;
+        Weight += weight;
+    }
+
+    double MeshSimplifier::Quadric::Evaluate(const glm::dvec3& p) const
+    {
+        if (Weight <= 0.0) return 0.0;
+
+        double error =
+            A[0] * p.x * p.x + 2.0 * A[1] * p.x * p.y + 2.0 * A[2] * p.x * p.z + 2.0 * A[3] * p.x +
+            A[4] * p.y * p.y + 2.0 * A[5] * p.y * p.z + 2.0 * A[6] * p.y +
+            A[7] * p.z * p.z + 2.0 * A[8] * p.z +
+            A[9];
+
+        // Weighted mean of squared distances to accumulated planes
+        return std::max(error, 0.0) / Weight;
+    }
+
+    MeshSimplifier::Quadric& MeshSimplifier::Quadric::operator+=(const Quadric& other)
+    {
+        for (uint32_t idx = 0; idx < 10; ++idx)
+        {
+            A[idx] += other.A[idx];
+        }
+
+        Weight += other.Weight;
+
+        return *this;
+    }
+
+}
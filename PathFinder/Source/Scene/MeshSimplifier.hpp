@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Vertices/Vertex1P1N1UV1T1BT.hpp"
+
+#include <vector>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Reduces triangle count of an indexed mesh by collapsing edges onto one of their vertices,
+    /// cheapest first by quadric error metric. Vertices are never moved or created,
+    /// so simplified index buffers can share the vertex buffer of the source mesh.
+    class MeshSimplifier
+    {
+    public:
+        struct Settings
+        {
+            uint32_t TargetTriangleCount = 0;
+
+            // Largest error allowed, relative to the largest dimension of mesh bounding box
+            float MaxError = 0.01f;
+
+            // Scale of normal and UV error added to geometric error. Attribute error of a collapse is the difference
+            // between attributes of the removed vertex and attributes interpolated at its position after the collapse.
+            float AttributeWeight = 1.0f;
+
+            // Vertices on open edges are kept in place. Attribute seams are open edges
+            // in terms of topology, so they are kept as well.
+            bool LockBorders = true;
+        };
+
+        struct Result
+        {
+            std::vector<uint32_t> Indices;
+
+            // Largest error introduced, relative to the largest dimension of mesh bounding box
+            float Error = 0.0f;
+        };
+
+        static Result Simplify(const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices, const Settings& settings);
+
+    private:
+        // Symmetric 4x4 matrix, upper triangle row by row
+        struct Quadric
+        {
+            double A[10] = {};
+            double Weight = 0.0;
+
+            void AddPlane(const glm::dvec3& normal, double distance, double weight);
+            double Evaluate(const glm::dvec3& point) const;
+
+            Quadric& operator+=(const Quadric& other);
+        };
+
+        static double AttributeError(
+            const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<glm::dvec3>& positions, const std::vector<uint32_t>& indices,
+            const uint32_t* fromTriangles, uint32_t fromTriangleCount, uint32_t from, uint32_t to);
+
+        struct Collapse
+        {
+            uint32_t From = 0;
+            uint32_t To = 0;
+            double Cost = 0.0;
+        };
+    };
+
+}
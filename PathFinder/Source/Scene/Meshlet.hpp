@@ -0,0 +1,48 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+
+#include <bitsery/bitsery.h>
+#include <Utility/SerializationAdapters.hpp>
+
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Cluster of a mesh with bounded vertex and triangle counts.
+    /// Vertex and triangle ranges refer to meshlet vertex index and triangle lists of the mesh.
+    /// Every triangle is packed into a single uint32_t as three 8-bit meshlet-local vertex indices.
+    struct Meshlet
+    {
+        uint32_t VertexOffset = 0;
+        uint32_t VertexCount = 0;
+        uint32_t TriangleOffset = 0;
+        uint32_t TriangleCount = 0;
+
+        glm::vec3 BoundingSphereCenter{ 0.0f };
+        float BoundingSphereRadius = 0.0f;
+
+        // Meshlet is back facing for every viewer at position P for which
+        // dot(normalize(ConeApex - P), ConeAxis) >= ConeCutoff.
+        // Cutoff of 1 means normals are too spread for the cone to be of any use.
+        glm::vec3 ConeApex{ 0.0f };
+        glm::vec3 ConeAxis{ 0.0f, 0.0f, 1.0f };
+        float ConeCutoff = 1.0f;
+
+        template <typename S>
+        void serialize(S& s)
+        {
+            s.value4b(VertexOffset);
+            s.value4b(VertexCount);
+            s.value4b(TriangleOffset);
+            s.value4b(TriangleCount);
+            s.object(BoundingSphereCenter);
+            s.value4b(BoundingSphereRadius);
+            s.object(ConeApex);
+            s.object(ConeAxis);
+            s.value4b(ConeCutoff);
+        }
+    };
+
+}
@@ -2,10 +2,11 @@
 
 #include "ResourceLoader.hpp"
 
+#include <Foundation/FileWriting.hpp>
 
-
+#include <algorithm>
+#include <cstring>
 #include <fstream>
-#include <iterator>
 #include <vector>
 
 namespace PathFinder
@@ -14,94 +15,317 @@ namespace PathFinder
     ResourceLoader::ResourceLoader(const std::filesystem::path& rootPath, Memory::GPUResourceProducer* resourceProducer)
         : mRootPath{ rootPath }, mResourceProducer{ resourceProducer } {}
 
-    Memory::GPUResourceProducer::TexturePtr ResourceLoader::LoadTexture(const std::string& relativeFilePath) const
+    Memory::GPUResourceProducer::TexturePtr ResourceLoader::LoadTexture(const std::string& relativeFilePath)
     {
-        std::filesystem::path fullPath = mRootPath;
-        fullPath += relativeFilePath;
+        std::optional<MappedTexture> mappedTexture = MapTexture(relativeFilePath);
 
-        std::ifstream input{ fullPath.string(), std::ios::binary };
-
-        if (!input.is_open())
+        if (!mappedTexture)
         {
             return nullptr;
         }
-        
-        std::uintmax_t fileSize = std::filesystem::file_size(fullPath);
 
-        std::vector<uint8_t> bytes;
-        bytes.resize(fileSize);
+        return CreateTexture(*mappedTexture);
+    }
+
+    std::optional<ResourceLoader::MappedTexture> ResourceLoader::MapTexture(const std::string& relativeFilePath) const
+    {
+        std::filesystem::path fullPath = mRootPath;
+        fullPath += relativeFilePath;
+
+        MappedTexture texture{ Foundation::MemoryMappedFile{ fullPath } };
 
-        input.read((char *)bytes.data(), bytes.size());
+        if (!texture.File.IsOpen())
+        {
+            return std::nullopt;
+        }
 
-        ddsktx_texture_info textureInfo;
         ddsktx_error error;
 
-        if (!ddsktx_parse(&textureInfo, bytes.data(), (int)bytes.size(), &error))
+        if (!ddsktx_parse(&texture.Info, texture.File.Data(), (int)texture.File.Size(), &error))
         {
-            return nullptr;
+            return std::nullopt;
         }
 
-        assert_format(textureInfo.num_layers == 1, "Texture arrays are not supported yet");
+        texture.Name = fullPath.filename().string();
+
+        return texture;
+    }
+
+    Memory::GPUResourceProducer::TexturePtr ResourceLoader::CreateTexture(const MappedTexture& mappedTexture, uint32_t mostDetailedMip)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        assert_format(mostDetailedMip < (uint32_t)mappedTexture.Info.num_mips, "Mip ", mostDetailedMip, " does not exist");
 
-        auto texture = AllocateTexture(textureInfo);
+        auto texture = AllocateTexture(mappedTexture.Info, mostDetailedMip);
         HAL::ResourceFootprint textureFootprint{ *texture->HALTexture() };
 
         texture->RequestWrite();
 
-        uint64_t uploadMemoryOffset = 0;
+        // Every subresource is written below, so upload memory is accessed directly and uploaded as a whole
+        uint64_t copiedBytes = CopySubresources(mappedTexture, mostDetailedMip, 0, textureFootprint, texture->WriteOnlyPtr());
 
-        for (int mip = 0; mip < textureInfo.num_mips; ++mip)
+        texture->SetDebugName(mappedTexture.Name);
+
+        UpdateStatistics(1, copiedBytes, startTime);
+
+        return std::move(texture);
+    }
+
+    Memory::GPUResourceProducer::TexturePtr ResourceLoader::CreateTextureArray(const std::vector<const MappedTexture*>& textures, const std::string& debugName)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        assert_format(!textures.empty(), "Texture array must have at least one texture");
+
+        for (const MappedTexture* texture : textures)
+        {
+            assert_format(AreArrayCompatible(*textures.front(), *texture), "Texture ", texture->Name, " differs from ", textures.front()->Name, " in format, size or mip count");
+        }
+
+        auto textureArray = AllocateTexture(textures.front()->Info, 0, (uint32_t)textures.size());
+        HAL::ResourceFootprint textureFootprint{ *textureArray->HALTexture() };
+
+        textureArray->RequestWrite();
+
+        uint8_t* uploadMemory = textureArray->WriteOnlyPtr();
+        uint32_t slicesPerTexture = ArraySliceCount(textures.front()->Info);
+        uint64_t copiedBytes = 0;
+
+        for (uint32_t textureIdx = 0; textureIdx < textures.size(); ++textureIdx)
         {
-            const HAL::SubresourceFootprint& mipFootprint = textureFootprint.GetSubresourceFootprint(mip);
-            uploadMemoryOffset = mipFootprint.Offset();
+            copiedBytes += CopySubresources(*textures[textureIdx], 0, textureIdx * slicesPerTexture, textureFootprint, uploadMemory);
+        }
+
+        textureArray->SetDebugName(debugName);
 
-            for (int depthLayer = 0; depthLayer < textureInfo.depth; ++depthLayer)
+        UpdateStatistics((uint32_t)textures.size(), copiedBytes, startTime);
+
+        return std::move(textureArray);
+    }
+
+    bool ResourceLoader::AreArrayCompatible(const MappedTexture& first, const MappedTexture& second)
+    {
+        const ddsktx_texture_info& firstInfo = first.Info;
+        const ddsktx_texture_info& secondInfo = second.Info;
+
+        // Volume textures can't be arrays
+        return firstInfo.depth == 1 && secondInfo.depth == 1 &&
+            firstInfo.format == secondInfo.format &&
+            firstInfo.width == secondInfo.width &&
+            firstInfo.height == secondInfo.height &&
+            firstInfo.num_mips == secondInfo.num_mips &&
+            firstInfo.num_layers == secondInfo.num_layers &&
+            (firstInfo.flags & DDSKTX_TEXTURE_FLAG_CUBEMAP) == (secondInfo.flags & DDSKTX_TEXTURE_FLAG_CUBEMAP);
+    }
+
+    void ResourceLoader::Prefetch(const MappedTexture& mappedTexture, uint32_t mostDetailedMip)
+    {
+        const uint64_t PageSize = 4096;
+
+        ForEachSubresourceSlice(mappedTexture, mostDetailedMip, [PageSize](const ddsktx_sub_data& subData, uint32_t, uint32_t, uint32_t)
+        {
+            const volatile uint8_t* data = reinterpret_cast<const uint8_t*>(subData.buff);
+
+            // Touching a byte of every page is enough for the OS to read it in
+            for (uint64_t offset = 0; offset < (uint64_t)subData.size_bytes; offset += PageSize)
             {
-                ddsktx_sub_data subData;
-                ddsktx_get_sub(&textureInfo, &subData, bytes.data(), (int)bytes.size(), 0, depthLayer, mip);
+                data[offset];
+            }
+        });
+    }
+
+    uint64_t ResourceLoader::MipSizeInBytes(const MappedTexture& mappedTexture, uint32_t mip)
+    {
+        const ddsktx_texture_info& textureInfo = mappedTexture.Info;
+        int mipDepth = std::max(textureInfo.depth >> mip, 1);
 
-                bool imageDataSatisfiesTextureRowAlignment =
-                    mipFootprint.RowPitch() == subData.row_pitch_bytes &&
-                    mipFootprint.RowSizeInBytes() == subData.row_pitch_bytes;
+        ddsktx_sub_data subData;
+        ddsktx_get_sub(&textureInfo, &subData, mappedTexture.File.Data(), (int)mappedTexture.File.Size(), 0, 0, mip);
+
+        return uint64_t(subData.size_bytes) * mipDepth * ArraySliceCount(textureInfo);
+    }
 
-                if (imageDataSatisfiesTextureRowAlignment)
+    uint32_t ResourceLoader::ArraySliceCount(const ddsktx_texture_info& textureInfo)
+    {
+        bool isCube = textureInfo.flags & DDSKTX_TEXTURE_FLAG_CUBEMAP;
+        return textureInfo.num_layers * (isCube ? DDSKTX_CUBE_FACE_COUNT : 1);
+    }
+
+    bool ResourceLoader::StoreResource(const Memory::GPUResource& resource, const std::string& relativeFilePath) const
+    {
+        std::filesystem::path fullPath = mRootPath;
+        fullPath += relativeFilePath;
+
+        std::vector<uint8_t> contents;
+
+        if (auto texture = dynamic_cast<const Memory::Texture*>(&resource))
+        {
+            texture->Read<uint8_t>([&](const uint8_t* data)
+            {
+                if (!data) return;
+
+                DDSFileHeader header = StoredTextureHeader(*texture->HALTexture());
+                const uint8_t* headerBytes = reinterpret_cast<const uint8_t*>(&header);
+
+                contents.insert(contents.end(), headerBytes, headerBytes + sizeof(DDSFileHeader));
+
+                // Readback memory is laid out the same way as upload one, with rows padded to pitch alignment
+                ForEachStoredRow(HAL::ResourceFootprint{ *texture->HALTexture() }, [&](uint64_t offset, uint64_t rowSize)
                 {
-                    // Copy whole subresource
-                    texture->Write((uint8_t*)subData.buff, uploadMemoryOffset, subData.size_bytes);
-                    uploadMemoryOffset += subData.size_bytes;
-                }
-                else {
-                    // Have to copy row-by-row
-                    uint8_t* rowData = (uint8_t*)subData.buff;
-                    uint64_t rowReadCountAtOnce = mipFootprint.RowSizeInBytes() / subData.row_pitch_bytes;
-                    uint64_t readMemoryOffset = 0;
-
-                    for (auto row = 0; row < subData.height; row += rowReadCountAtOnce)
-                    {
-                        uint64_t bytesToRead = subData.row_pitch_bytes * rowReadCountAtOnce;
-                        texture->Write((uint8_t*)subData.buff + readMemoryOffset, uploadMemoryOffset, bytesToRead);
-                        uploadMemoryOffset += mipFootprint.RowPitch();
-                        readMemoryOffset += bytesToRead;
-                    }
-                }
-            }
+                    contents.insert(contents.end(), data + offset, data + offset + rowSize);
+                });
+            });
+        }
+        else if (auto buffer = dynamic_cast<const Memory::Buffer*>(&resource))
+        {
+            buffer->Read<uint8_t>([&](const uint8_t* data)
+            {
+                if (data) contents.assign(data, data + buffer->HALBuffer()->ElementCapacity());
+            });
         }
 
-        texture->SetDebugName(fullPath.filename().string());
-        input.close();
-        
-        return std::move(texture);
+        return !contents.empty() && WriteFile(fullPath, contents);
     }
 
-    void ResourceLoader::StoreResource(const Memory::GPUResource& resource, const std::string& relativeFilePath) const
+    bool ResourceLoader::StoreTextureContents(const Memory::Texture& texture, const uint8_t* contents, const std::string& relativeFilePath) const
     {
+        std::filesystem::path fullPath = mRootPath;
+        fullPath += relativeFilePath;
+
+        DDSFileHeader header = StoredTextureHeader(*texture.HALTexture());
+        uint64_t contentsSize = 0;
 
+        ForEachStoredRow(HAL::ResourceFootprint{ *texture.HALTexture() }, [&](uint64_t offset, uint64_t rowSize) { contentsSize += rowSize; });
+
+        // Contents are already packed, so they're written as they are
+        return Foundation::WriteFileAtomically(fullPath, [&](std::ostream& stream)
+        {
+            stream.write(reinterpret_cast<const char*>(&header), sizeof(DDSFileHeader));
+            stream.write(reinterpret_cast<const char*>(contents), contentsSize);
+        });
+    }
+
+    bool ResourceLoader::LoadStoredResource(Memory::GPUResource& resource, const std::string& relativeFilePath)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        std::filesystem::path fullPath = mRootPath;
+        fullPath += relativeFilePath;
+
+        Foundation::MemoryMappedFile file{ fullPath };
+
+        if (!file.IsOpen())
+        {
+            return false;
+        }
+
+        if (auto buffer = dynamic_cast<Memory::Buffer*>(&resource))
+        {
+            if (file.Size() != buffer->HALBuffer()->ElementCapacity()) return false;
+
+            buffer->RequestWrite();
+            buffer->Write(file.Data(), 0, file.Size());
+
+            UpdateStatistics(0, file.Size(), startTime);
+            return true;
+        }
+
+        auto texture = dynamic_cast<Memory::Texture*>(&resource);
+
+        if (!texture || file.Size() < sizeof(DDSFileHeader))
+        {
+            return false;
+        }
+
+        DDSFileHeader header = StoredTextureHeader(*texture->HALTexture());
+
+        if (std::memcmp(&header, file.Data(), sizeof(DDSFileHeader)) != 0)
+        {
+            return false;
+        }
+
+        HAL::ResourceFootprint footprint{ *texture->HALTexture() };
+        uint64_t storedSize = sizeof(DDSFileHeader);
+
+        ForEachStoredRow(footprint, [&](uint64_t offset, uint64_t rowSize) { storedSize += rowSize; });
+
+        if (file.Size() != storedSize)
+        {
+            return false;
+        }
+
+        WriteTextureContents(*texture, file.Data() + sizeof(DDSFileHeader));
+        UpdateStatistics(1, storedSize - sizeof(DDSFileHeader), startTime);
+
+        return true;
+    }
+
+    void ResourceLoader::WriteTextureContents(Memory::Texture& texture, const uint8_t* contents)
+    {
+        HAL::ResourceFootprint footprint{ *texture.HALTexture() };
+
+        texture.RequestWrite();
+
+        uint8_t* uploadMemory = texture.WriteOnlyPtr();
+
+        ForEachStoredRow(footprint, [&](uint64_t offset, uint64_t rowSize)
+        {
+            std::memcpy(uploadMemory + offset, contents, rowSize);
+            contents += rowSize;
+        });
+    }
+
+    DDSFileHeader ResourceLoader::StoredTextureHeader(const HAL::Texture& texture)
+    {
+        const HAL::TextureProperties& properties = texture.Properties();
+
+        bool isVolume = properties.Kind == HAL::TextureKind::Texture3D;
+        bool isCube = properties.Kind == HAL::TextureKind::TextureCube;
+        bool hasMips = properties.MipCount > 1;
+
+        // Depth of 2D textures is their array size, cube faces count as array slices
+        uint32_t arraySize = isVolume ? 1 : properties.Dimensions.Depth;
+
+        DDSFileHeader header;
+        std::memset(&header, 0, sizeof(DDSFileHeader));
+
+        header.Magic = DDSMagic;
+        header.Size = DDSHeaderSize;
+        header.Flags = DDSDCaps | DDSDHeight | DDSDWidth | DDSDPixelFormat | DDSDMipCount | (isVolume ? DDSDDepth : 0);
+        header.Height = properties.Dimensions.Height;
+        header.Width = properties.Dimensions.Width;
+        header.Depth = isVolume ? properties.Dimensions.Depth : 1;
+        header.MipCount = properties.MipCount;
+        header.PixelFormatSize = 32;
+        header.PixelFormatFlags = DDPFFourCC;
+        header.FourCC = DX10FourCC;
+        header.Caps[0] = DDSCapsTexture | (hasMips || arraySize > 1 ? DDSCapsComplex : 0) | (hasMips ? DDSCapsMipMap : 0);
+        header.Caps[1] = isCube ? DDSCaps2CubeMapAllFaces : (isVolume ? DDSCaps2Volume : 0);
+        header.DXGIFormat = HAL::D3DFormat(properties.Format);
+        header.MiscFlags = isCube ? D3D10ResourceMiscTextureCube : 0;
+        header.ArraySize = isCube ? arraySize / 6 : arraySize;
+
+        switch (properties.Kind)
+        {
+        case HAL::TextureKind::Texture1D: header.ResourceDimension = D3D10ResourceDimensionTexture1D; break;
+        case HAL::TextureKind::Texture3D: header.ResourceDimension = D3D10ResourceDimensionTexture3D; break;
+        default: header.ResourceDimension = D3D10ResourceDimensionTexture2D; break;
+        }
+
+        return header;
+    }
+
+    bool ResourceLoader::WriteFile(const std::filesystem::path& path, const std::vector<uint8_t>& contents)
+    {
+        return Foundation::WriteFileAtomically(path, contents.data(), contents.size());
     }
 
     HAL::TextureKind ResourceLoader::ToKind(const ddsktx_texture_info& textureInfo) const
     {
         bool isArray = textureInfo.num_layers > 1;
 
+        if (textureInfo.flags & DDSKTX_TEXTURE_FLAG_CUBEMAP) return HAL::TextureKind::TextureCube;
         if (textureInfo.depth > 1 && !isArray) return HAL::TextureKind::Texture3D;
         if (textureInfo.depth > 1 || textureInfo.width > 1) return HAL::TextureKind::Texture2D;
 
@@ -167,13 +391,71 @@ namespace PathFinder
         }
     }
 
-    Memory::GPUResourceProducer::TexturePtr ResourceLoader::AllocateTexture(const ddsktx_texture_info& textureInfo) const
+    void ResourceLoader::CopySubresourceSlice(const ddsktx_sub_data& source, const HAL::SubresourceFootprint& footprint, uint8_t* destination)
+    {
+        const uint8_t* sourceData = reinterpret_cast<const uint8_t*>(source.buff);
+        uint64_t sourceRowPitch = source.row_pitch_bytes;
+
+        if (footprint.RowPitch() == sourceRowPitch)
+        {
+            std::memcpy(destination, sourceData, source.size_bytes);
+            return;
+        }
+
+        // Rows of block compressed formats are rows of blocks, so row count is derived from sizes rather than height
+        uint64_t rowCount = std::min<uint64_t>(source.size_bytes / sourceRowPitch, footprint.RowCount());
+        uint64_t rowSize = std::min<uint64_t>(footprint.RowSizeInBytes(), sourceRowPitch);
+
+        for (uint64_t row = 0; row < rowCount; ++row)
+        {
+            std::memcpy(destination + row * footprint.RowPitch(), sourceData + row * sourceRowPitch, rowSize);
+        }
+    }
+
+    uint64_t ResourceLoader::CopySubresources(
+        const MappedTexture& mappedTexture, 
+        uint32_t mostDetailedMip,
+        uint32_t firstArraySlice,
+        const HAL::ResourceFootprint& footprint, 
+        uint8_t* uploadMemory)
+    {
+        uint32_t resourceMipCount = mappedTexture.Info.num_mips - mostDetailedMip;
+        uint64_t copiedBytes = 0;
+
+        ForEachSubresourceSlice(mappedTexture, mostDetailedMip, [&](const ddsktx_sub_data& subData, uint32_t arraySlice, uint32_t depthSlice, uint32_t mip)
+        {
+            // Subresources of array slices follow each other with all their mips
+            uint32_t subresourceIdx = (mip - mostDetailedMip) + (firstArraySlice + arraySlice) * resourceMipCount;
+
+            const HAL::SubresourceFootprint& mipFootprint = footprint.GetSubresourceFootprint(subresourceIdx);
+            uint64_t depthSlicePitch = mipFootprint.RowPitch() * mipFootprint.RowCount();
+
+            CopySubresourceSlice(subData, mipFootprint, uploadMemory + mipFootprint.Offset() + depthSlice * depthSlicePitch);
+            copiedBytes += subData.size_bytes;
+        });
+
+        return copiedBytes;
+    }
+
+    void ResourceLoader::UpdateStatistics(uint32_t textureCount, uint64_t copiedBytes, std::chrono::steady_clock::time_point startTime)
+    {
+        mStatistics.TextureCount += textureCount;
+        mStatistics.LoadedBytes += copiedBytes;
+        mStatistics.LoadTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+        mStatistics.Throughput = mStatistics.LoadTime.count() > 0 ? float(mStatistics.LoadedBytes) / mStatistics.LoadTime.count() : 0.0f;
+    }
+
+    Memory::GPUResourceProducer::TexturePtr ResourceLoader::AllocateTexture(const ddsktx_texture_info& textureInfo, uint32_t mostDetailedMip, uint32_t textureCount) const
     {
         HAL::FormatVariant format = ToResourceFormat(textureInfo.format);
-        Geometry::Dimensions dimensions(textureInfo.width, textureInfo.height, textureInfo.depth);
         HAL::TextureKind kind = ToKind(textureInfo);
 
-        HAL::TextureProperties properties{ format, kind, dimensions, HAL::ResourceState::AnyShaderAccess, (uint16_t)textureInfo.num_mips };
+        Geometry::Dimensions dimensions(
+            std::max(textureInfo.width >> mostDetailedMip, 1),
+            std::max(textureInfo.height >> mostDetailedMip, 1),
+            kind == HAL::TextureKind::Texture3D ? std::max(textureInfo.depth >> mostDetailedMip, 1) : ArraySliceCount(textureInfo) * textureCount);
+
+        HAL::TextureProperties properties{ format, kind, dimensions, HAL::ResourceState::AnyShaderAccess, uint16_t(textureInfo.num_mips - mostDetailedMip) };
 
         return mResourceProducer->NewTexture(properties);
     }
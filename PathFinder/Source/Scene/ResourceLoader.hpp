@@ -1,11 +1,19 @@
 #pragma once
 
+#include "DDSFileHeader.hpp"
+
 #include <Memory/GPUResourceProducer.hpp>
 #include <HardwareAbstractionLayer/Texture.hpp>
+#include <HardwareAbstractionLayer/ResourceFootprint.hpp>
+#include <Foundation/MemoryMappedFile.hpp>
 #include <ThirdParty/dds/dds-ktx.h>
 
 #include <filesystem>
+#include <algorithm>
 #include <vector>
+#include <optional>
+#include <string>
+#include <chrono>
 
 namespace PathFinder 
 {
@@ -13,18 +21,110 @@ namespace PathFinder
     class ResourceLoader
     {
     public:
+        struct Statistics
+        {
+            // Of all textures loaded so far
+            uint32_t TextureCount = 0;
+            uint64_t LoadedBytes = 0;
+            std::chrono::microseconds LoadTime{ 0 };
+
+            // Megabytes of texture files per second of load time
+            float Throughput = 0.0f;
+        };
+
+        /// Texture file mapped into memory with its headers parsed in place
+        struct MappedTexture
+        {
+            Foundation::MemoryMappedFile File;
+            ddsktx_texture_info Info{};
+            std::string Name;
+        };
+
         ResourceLoader(const std::filesystem::path& rootPath, Memory::GPUResourceProducer* resourceProducer);
 
-        Memory::GPUResourceProducer::TexturePtr LoadTexture(const std::string& relativeFilePath) const;
-        void StoreResource(const Memory::GPUResource& resource, const std::string& relativeFilePath) const;
+        /// Texture files are memory-mapped, parsed in place and their subresources
+        /// are copied straight into upload memory of the texture
+        Memory::GPUResourceProducer::TexturePtr LoadTexture(const std::string& relativeFilePath);
+
+        /// Doesn't touch GPU resources, so it's safe to call from any thread
+        std::optional<MappedTexture> MapTexture(const std::string& relativeFilePath) const;
+
+        /// Creates a texture out of mips starting from 'mostDetailedMip', the rest of mips are skipped
+        Memory::GPUResourceProducer::TexturePtr CreateTexture(const MappedTexture& texture, uint32_t mostDetailedMip = 0);
+
+        /// Packs textures into a single array, slices of every texture follow slices of the previous one.
+        /// Textures must be array compatible.
+        Memory::GPUResourceProducer::TexturePtr CreateTextureArray(const std::vector<const MappedTexture*>& textures, const std::string& debugName);
+
+        /// Textures of the same format, size, mip and layer count can be slices of one array
+        static bool AreArrayCompatible(const MappedTexture& first, const MappedTexture& second);
+
+        /// Brings pages of mips starting from 'mostDetailedMip' into memory,
+        /// so that a texture can later be created out of them without waiting for disk
+        static void Prefetch(const MappedTexture& texture, uint32_t mostDetailedMip);
+
+        /// Size of a mip across all array slices or depth slices
+        static uint64_t MipSizeInBytes(const MappedTexture& texture, uint32_t mip);
+
+        /// Cube faces count as separate slices
+        static uint32_t ArraySliceCount(const ddsktx_texture_info& textureInfo);
+
+        /// Writes contents the resource was read back with: textures as DDS files with every mip and slice, buffers as raw blobs.
+        /// Returns false if the resource has no read back contents or the file can't be written.
+        bool StoreResource(const Memory::GPUResource& resource, const std::string& relativeFilePath) const;
+
+        /// Writes contents packed the way WriteTextureContents() takes them into a file LoadStoredResource() can fill the texture from,
+        /// for textures computed on CPU, which have nothing to read back. Returns false if the file can't be written.
+        bool StoreTextureContents(const Memory::Texture& texture, const uint8_t* contents, const std::string& relativeFilePath) const;
+
+        /// Fills the resource with contents written by StoreResource().
+        /// Returns false if the file is missing or was stored from a resource of another format or size.
+        bool LoadStoredResource(Memory::GPUResource& resource, const std::string& relativeFilePath);
+
+        /// Fills every subresource of the texture with rows packed tightly in the order StoreResource() writes them
+        static void WriteTextureContents(Memory::Texture& texture, const uint8_t* contents);
 
     private:
         HAL::TextureKind ToKind(const ddsktx_texture_info& textureInfo) const;
         HAL::FormatVariant ToResourceFormat(const ddsktx_format& parserFormat) const;
-        Memory::GPUResourceProducer::TexturePtr AllocateTexture(const ddsktx_texture_info& textureInfo) const;
+        Memory::GPUResourceProducer::TexturePtr AllocateTexture(const ddsktx_texture_info& textureInfo, uint32_t mostDetailedMip, uint32_t textureCount = 1) const;
+
+        // Copies every slice of every mip starting from 'mostDetailedMip' into subresources starting at 'firstArraySlice'
+        static uint64_t CopySubresources(
+            const MappedTexture& texture,
+            uint32_t mostDetailedMip,
+            uint32_t firstArraySlice,
+            const HAL::ResourceFootprint& footprint,
+            uint8_t* uploadMemory);
+
+        // Visits 2D slices of subresources: every depth slice of volume textures, every face of every layer otherwise
+        template <class Visitor>
+        static void ForEachSubresourceSlice(const MappedTexture& texture, uint32_t mostDetailedMip, const Visitor& visitor);
+
+        void UpdateStatistics(uint32_t textureCount, uint64_t copiedBytes, std::chrono::steady_clock::time_point startTime);
+
+        // Header a texture is stored with, files are only loaded into textures they have identical headers with
+        static DDSFileHeader StoredTextureHeader(const HAL::Texture& texture);
+
+        // Visits rows of every subresource in the order they're stored in files:
+        // mips of array slices, depth slices of mips, rows of depth slices
+        template <class Visitor>
+        static void ForEachStoredRow(const HAL::ResourceFootprint& footprint, const Visitor& visitor);
+
+        // Replaces the file only once it's written in full
+        static bool WriteFile(const std::filesystem::path& path, const std::vector<uint8_t>& contents);
+
+        // Copies a 2D slice of a subresource, in one go when row pitches of file and upload memory match
+        static void CopySubresourceSlice(const ddsktx_sub_data& source, const HAL::SubresourceFootprint& footprint, uint8_t* destination);
 
         std::filesystem::path mRootPath;
         Memory::GPUResourceProducer* mResourceProducer;
+        Statistics mStatistics;
+
+    public:
+        inline const auto& GetStatistics() const { return mStatistics; }
     };
 
 }
+
+#include "ResourceLoader.inl"
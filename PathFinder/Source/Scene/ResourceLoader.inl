@@ -0,0 +1,54 @@
+namespace PathFinder
+{
+
+    template <class Visitor>
+    void ResourceLoader::ForEachSubresourceSlice(const MappedTexture& texture, uint32_t mostDetailedMip, const Visitor& visitor)
+    {
+        const ddsktx_texture_info& textureInfo = texture.Info;
+
+        bool isCube = textureInfo.flags & DDSKTX_TEXTURE_FLAG_CUBEMAP;
+        uint32_t faceCount = isCube ? DDSKTX_CUBE_FACE_COUNT : 1;
+
+        for (uint32_t layer = 0; layer < (uint32_t)textureInfo.num_layers; ++layer)
+        {
+            for (uint32_t face = 0; face < faceCount; ++face)
+            {
+                uint32_t arraySlice = layer * faceCount + face;
+
+                for (uint32_t mip = mostDetailedMip; mip < (uint32_t)textureInfo.num_mips; ++mip)
+                {
+                    // Depth of volume textures shrinks with every mip as well
+                    uint32_t mipDepth = isCube ? 1 : (uint32_t)std::max(textureInfo.depth >> mip, 1);
+
+                    for (uint32_t depthSlice = 0; depthSlice < mipDepth; ++depthSlice)
+                    {
+                        // Parser addresses cube faces and depth slices through the same index
+                        ddsktx_sub_data subData;
+                        ddsktx_get_sub(&textureInfo, &subData, texture.File.Data(), (int)texture.File.Size(), layer, isCube ? face : depthSlice, mip);
+
+                        visitor(subData, arraySlice, depthSlice, mip);
+                    }
+                }
+            }
+        }
+    }
+
+    template <class Visitor>
+    void ResourceLoader::ForEachStoredRow(const HAL::ResourceFootprint& footprint, const Visitor& visitor)
+    {
+        for (const HAL::SubresourceFootprint& subresourceFootprint : footprint.SubresourceFootprints())
+        {
+            uint64_t depthSlicePitch = subresourceFootprint.RowPitch() * subresourceFootprint.RowCount();
+
+            for (uint32_t depthSlice = 0; depthSlice < subresourceFootprint.D3DFootprint().Footprint.Depth; ++depthSlice)
+            {
+                for (uint32_t row = 0; row < subresourceFootprint.RowCount(); ++row)
+                {
+                    uint64_t offset = subresourceFootprint.Offset() + depthSlice * depthSlicePitch + row * subresourceFootprint.RowPitch();
+                    visitor(offset, subresourceFootprint.RowSizeInBytes());
+                }
+            }
+        }
+    }
+
+}
@@ -1,10 +1,12 @@
 #include "Scene.hpp"
 
-#include <bitsery/bitsery.h>
-#include <bitsery/adapter/buffer.h>
-#include <bitsery/traits/vector.h>
+#include <Foundation/Assert.hpp>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
 
 #include <fstream>
+#include <algorithm>
+#include <cmath>
 
 namespace PathFinder 
 {
@@ -15,40 +17,61 @@ namespace PathFinder
         LoadUtilityResources();
     }
 
-    Mesh& Scene::AddMesh(Mesh&& mesh)
+    MeshHandle Scene::AddMesh(Mesh&& mesh)
     {
-        mMeshes.emplace_back(std::move(mesh));
-        return mMeshes.back();
+        ++mLayoutVersion;
+        return mMeshes.Insert(std::move(mesh));
     }
 
-    MeshInstance& Scene::AddMeshInstance(MeshInstance&& instance)
+    MeshInstanceHandle Scene::AddMeshInstance(MeshInstance&& instance)
     {
-        mMeshInstances.emplace_back(std::move(instance));
-        return mMeshInstances.back();
+        ++mLayoutVersion;
+        return mMeshInstances.Insert(std::move(instance));
     }
 
-    Material& Scene::AddMaterial(Material&& material)
+    MaterialHandle Scene::AddMaterial(Material&& material)
     {
-        mMaterials.emplace_back(std::move(material));
-        return mMaterials.back();
+        ++mLayoutVersion;
+        return mMaterials.Insert(std::move(material));
     }
 
-    Scene::FlatLightIt Scene::EmplaceDiskLight()
+    FlatLightHandle Scene::EmplaceDiskLight()
     {
-        mDiskLights.emplace_back(FlatLight::Type::Disk);
-        return std::prev(mDiskLights.end());
+        ++mLayoutVersion;
+        return mFlatLights.Emplace(FlatLight::Type::Disk);
     }
 
-    Scene::FlatLightIt Scene::EmplaceRectangularLight()
+    FlatLightHandle Scene::EmplaceRectangularLight()
     {
-        mRectangularLights.emplace_back(FlatLight::Type::Rectangle);
-        return std::prev(mRectangularLights.end());
+        ++mLayoutVersion;
+        return mFlatLights.Emplace(FlatLight::Type::Rectangle);
     }
 
-    Scene::SphericalLightIt Scene::EmplaceSphericalLight()
+    SphericalLightHandle Scene::EmplaceSphericalLight()
     {
-        mSphericalLights.emplace_back();
-        return std::prev(mSphericalLights.end());
+        ++mLayoutVersion;
+        return mSphericalLights.Emplace();
+    }
+
+    bool Scene::RemoveMeshInstance(MeshInstanceHandle handle)
+    {
+        bool isErased = mMeshInstances.Erase(handle);
+        if (isErased) ++mLayoutVersion;
+        return isErased;
+    }
+
+    bool Scene::RemoveFlatLight(FlatLightHandle handle)
+    {
+        bool isErased = mFlatLights.Erase(handle);
+        if (isErased) ++mLayoutVersion;
+        return isErased;
+    }
+
+    bool Scene::RemoveSphericalLight(SphericalLightHandle handle)
+    {
+        bool isErased = mSphericalLights.Erase(handle);
+        if (isErased) ++mLayoutVersion;
+        return isErased;
     }
 
     std::optional<Scene::EntityVariant> Scene::GetEntityByID(const EntityID& id) const
@@ -63,52 +86,463 @@ namespace PathFinder
 
         auto remap = [this](auto&& entities)
         {
-            for (auto& entity : entities)
+            for (auto denseIdx = 0u; denseIdx < entities.size(); ++denseIdx)
             {
-                mMappedEntities[entity.ID()] = &entity;
+                mMappedEntities[entities.data()[denseIdx].ID()] = entities.HandleAt(denseIdx);
             }
         };
 
         remap(mMeshInstances);
         remap(mSphericalLights);
-        remap(mDiskLights);
-        remap(mRectangularLights);
+        remap(mFlatLights);
+    }
+
+    void Scene::UpdateMeshInstanceBVH()
+    {
+        auto instanceBounds = [this](const MeshInstance& instance)
+        {
+            return instance.BoundingBox(mMeshes[instance.AssociatedMesh()]);
+        };
+
+        bool isLayoutChanged = mMeshInstanceBVHLayoutVersion != mLayoutVersion;
+
+        if (!isLayoutChanged)
+        {
+            for (auto denseIdx = 0u; denseIdx < mMeshInstances.size(); ++denseIdx)
+            {
+                const MeshInstance& instance = mMeshInstances.data()[denseIdx];
+
+                if (mMeshInstanceBVHVersions[denseIdx] != instance.Version())
+                {
+                    mMeshInstanceBVH.SetPrimitiveBounds(denseIdx, instanceBounds(instance));
+                    mMeshInstanceBVHVersions[denseIdx] = instance.Version();
+                }
+            }
+
+            if (!mMeshInstanceBVH.NeedsRefit()) return;
+
+            mMeshInstanceBVH.Refit();
+
+            // Refitting keeps topology, which gets worse the further instances move from where they were at build time
+            if (mMeshInstanceBVH.SAHCost() <= mMeshInstanceBVHBuildCost * mMeshInstanceBVHRebuildThreshold) return;
+        }
+
+        std::vector<Geometry::AxisAlignedBox3D> bounds;
+        bounds.reserve(mMeshInstances.size());
+        mMeshInstanceBVHVersions.resize(mMeshInstances.size());
+
+        for (auto denseIdx = 0u; denseIdx < mMeshInstances.size(); ++denseIdx)
+        {
+            const MeshInstance& instance = mMeshInstances.data()[denseIdx];
+            bounds.push_back(instanceBounds(instance));
+            mMeshInstanceBVHVersions[denseIdx] = instance.Version();
+        }
+
+        mMeshInstanceBVH.Build(bounds);
+        mMeshInstanceBVHBuildCost = mMeshInstanceBVH.SAHCost();
+        mMeshInstanceBVHLayoutVersion = mLayoutVersion;
+    }
+
+    void Scene::CullMeshInstances()
+    {
+        mVisibilityCuller.UpdateInstanceBounds(mMeshInstances, mMeshes, mLayoutVersion);
+
+        // Pyramid is a few frames old by the time it's read back and was built from another camera,
+        // so instances it occludes are only candidates that GPU tests again against Hi-Z of the current frame
+        mVisibilityCuller.CullView(MainCameraViewName, Geometry::Frustum{ mCamera.ViewProjection() }, &mHiZPyramid, &mMeshInstanceBVH);
+    }
+
+    void Scene::SelectMeshInstanceLODs(float viewportHeight)
+    {
+        const VisibilityCuller::ViewVisibility* visibility = mVisibilityCuller.GetViewVisibility(MainCameraViewName);
+
+        if (!visibility) return;
+
+        // Occluded instances may still be drawn in the second phase, so their levels have to be current too
+        mLODSelectionInstances.assign(visibility->VisibleInstances.begin(), visibility->VisibleInstances.end());
+        mLODSelectionInstances.insert(mLODSelectionInstances.end(), visibility->OccludedInstances.begin(), visibility->OccludedInstances.end());
+
+        mMeshLODSelector.SelectLODs(
+            mMeshInstances, mMeshes, mLODSelectionInstances,
+            mCamera.Position(), glm::radians(mCamera.FOVV()), viewportHeight);
+    }
+
+    void Scene::ReportMaterialTextureUsage(TextureStreamer& streamer, float viewportHeight) const
+    {
+        const VisibilityCuller::ViewVisibility* visibility = mVisibilityCuller.GetViewVisibility(MainCameraViewName);
+
+        if (!visibility) return;
+
+        // Pixels per world unit at the distance of one unit from the camera
+        float projectionScale = viewportHeight / (2.0f * std::tan(glm::radians(mCamera.FOVV()) * 0.5f));
+
+        for (uint32_t instanceIdx : visibility->VisibleInstances)
+        {
+            const MeshInstance& instance = mMeshInstances.data()[instanceIdx];
+            const Material& material = mMaterials[instance.AssociatedMaterial()];
+
+            // Texture is assumed to span instance bounds once, sized from the point of bounds closest to the camera
+            Geometry::AxisAlignedBox3D bounds = instance.BoundingBox(mMeshes[instance.AssociatedMesh()]);
+            glm::vec3 closestPoint = glm::clamp(mCamera.Position(), bounds.Min, bounds.Max);
+            float distance = std::max(glm::distance(mCamera.Position(), closestPoint), mCamera.NearClipPlane());
+            float projectedSize = glm::distance(bounds.Min, bounds.Max) * projectionScale / distance;
+
+            for (const Memory::Texture* texture : { material.AlbedoMap, material.NormalMap, material.RoughnessMap, material.MetalnessMap, material.AOMap })
+            {
+                streamer.ReportUsage(texture, projectedSize);
+            }
+        }
+    }
+
+    bool Scene::ReplaceMaterialTextures(const std::vector<TextureStreamer::TextureReplacement>& replacements)
+    {
+        if (replacements.empty()) return false;
+
+        robin_hood::unordered_flat_map<const Memory::Texture*, Memory::Texture*> newTextures;
+
+        for (const TextureStreamer::TextureReplacement& replacement : replacements)
+        {
+            newTextures[replacement.OldTexture] = replacement.NewTexture;
+        }
+
+        bool isAnyMaterialChanged = false;
+
+        for (Material& material : mMaterials)
+        {
+            for (Memory::Texture** texture : { &material.AlbedoMap, &material.NormalMap, &material.RoughnessMap, &material.MetalnessMap, &material.AOMap })
+            {
+                auto textureIt = newTextures.find(*texture);
+
+                if (textureIt != newTextures.end())
+                {
+                    *texture = textureIt->second;
+                    isAnyMaterialChanged = true;
+                }
+            }
+        }
+
+        return isAnyMaterialChanged;
+    }
+
+    void Scene::UpdateHiZPyramid(
+        const float* baseLevelDepth,
+        const Geometry::Dimensions& viewportDimensions,
+        uint32_t baseTexelSize,
+        const glm::mat4& view,
+        const glm::mat4& viewProjection,
+        uint64_t frameNumber)
+    {
+        if (mHiZPyramidFrameNumber == frameNumber) return;
+
+        mHiZPyramid.Build(baseLevelDepth, viewportDimensions, baseTexelSize, view, viewProjection);
+        mHiZPyramidFrameNumber = frameNumber;
+    }
+
+    bool Scene::Serialize(const std::filesystem::path& destination) const
+    {
+        // Handles are only valid for this instance of the scene, files refer to entities by dense indices
+        robin_hood::unordered_flat_map<uint32_t, uint32_t> meshIndices;
+        robin_hood::unordered_flat_map<uint32_t, uint32_t> materialIndices;
+
+        SerializedList<SerializedMesh> meshes;
+        SerializedList<Material> materials;
+        SerializedList<SerializedMeshInstance> meshInstances;
+        SerializedList<SerializedFlatLight> flatLights;
+        SerializedList<SerializedSphericalLight> sphericalLights;
+
+        for (uint64_t meshIdx = 0; meshIdx < mMeshes.size(); ++meshIdx)
+        {
+            const Mesh& mesh = mMeshes.data()[meshIdx];
+
+            assert_format(!mesh.SourceFile().empty(), "Mesh ", mesh.Name(), " wasn't loaded from a file and can't be serialized");
+
+            meshIndices[mMeshes.HandleAt(meshIdx).Index] = (uint32_t)meshIdx;
+            meshes.Items.push_back({ mesh.SourceFile(), mesh.IndexInSourceFile() });
+        }
+
+        for (uint64_t materialIdx = 0; materialIdx < mMaterials.size(); ++materialIdx)
+        {
+            materialIndices[mMaterials.HandleAt(materialIdx).Index] = (uint32_t)materialIdx;
+            materials.Items.push_back(mMaterials.data()[materialIdx]);
+        }
+
+        for (const MeshInstance& instance : mMeshInstances)
+        {
+            SerializedMeshInstance& serializedInstance = meshInstances.Items.emplace_back();
+            serializedInstance.MeshIndex = meshIndices.at(instance.AssociatedMesh().Index);
+            serializedInstance.MaterialIndex = materialIndices.at(instance.AssociatedMaterial().Index);
+            serializedInstance.Transformation = instance.Transformation();
+        }
+
+        for (const FlatLight& light : mFlatLights)
+        {
+            SerializedFlatLight& serializedLight = flatLights.Items.emplace_back();
+            serializedLight.Light = SerializeLight(light);
+            serializedLight.Light.Position = light.Position();
+            serializedLight.Type = std::underlying_type_t<FlatLight::Type>(light.LightType());
+            serializedLight.Normal = light.Normal();
+            serializedLight.Width = light.Width();
+            serializedLight.Height = light.Height();
+        }
+
+        for (const SphericalLight& light : mSphericalLights)
+        {
+            SerializedSphericalLight& serializedLight = sphericalLights.Items.emplace_back();
+            serializedLight.Light = SerializeLight(light);
+            serializedLight.Light.Position = light.Position();
+            serializedLight.Radius = light.Radius();
+        }
+
+        SceneArchiveWriter archive;
+        archive.AddChunk(SceneChunk::Camera, mCamera);
+        archive.AddChunk(SceneChunk::Materials, materials);
+        archive.AddChunk(SceneChunk::Meshes, meshes);
+        archive.AddChunk(SceneChunk::MeshInstances, meshInstances);
+        archive.AddChunk(SceneChunk::FlatLights, flatLights);
+        archive.AddChunk(SceneChunk::SphericalLights, sphericalLights);
+
+        return archive.Write(destination);
     }
 
-    void Scene::Serialize(const std::filesystem::path& destination) const
+    bool Scene::Deserialize(const std::filesystem::path& source, MeshLoader& meshLoader, MaterialLoader& materialLoader, SceneChunk chunks)
     {
-        using Buffer = std::vector<uint8_t>;
-        using Writer = bitsery::OutputBufferAdapter<Buffer>;
-        using Reader = bitsery::InputBufferAdapter<Buffer>;
+        auto startTime = std::chrono::steady_clock::now();
+
+        SceneArchiveReader archive;
+
+        if (!archive.Open(source)) return false;
 
-        Buffer buffer{};
-        size_t writtenSize{};
+        auto openTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+        if (!Deserialize(archive, meshLoader, materialLoader, chunks)) return false;
+
+        mDeserializationStatistics.OpenTime = openTime;
+        mDeserializationStatistics.LoadTime += openTime;
+
+        return true;
+    }
+
+    bool Scene::Deserialize(const SceneArchiveReader& archive, MeshLoader& meshLoader, MaterialLoader& materialLoader, SceneChunk chunks)
+    {
+        auto startTime = std::chrono::steady_clock::now();
 
-        bitsery::ext::PointerLinkingContext ctx{};
-        writtenSize = bitsery::quickSerialization(ctx, Writer{ buffer }, mCamera);
+        // Changes are made to a copy, so that a failed call doesn't affect later ones
+        std::string archiveKey = archive.SourcePath().lexically_normal().generic_string();
+        auto archiveIt = mDeserializedArchives.find(archiveKey);
 
-        //make sure that pointer linking context is valid
-        //this ensures that all non-owning pointers points to data that has been serialized,
-        //so we can successfully reconstruct pointers after deserialization
-        assert(ctx.isValid());
+        DeserializedArchive deserializedArchive = archiveIt != mDeserializedArchives.end() && IsSameArchive(archiveIt->second, archive) ?
+            archiveIt->second : DeserializedArchive{ archive.FileSize(), archive.ChunkTable() };
 
-        std::filesystem::path directory = destination;
-        directory.remove_filename();
+        // Nothing refers to instances and lights, so adding them again would only duplicate them
+        chunks &= ~(deserializedArchive.LoadedChunks & (SceneChunk::MeshInstances | SceneChunk::FlatLights | SceneChunk::SphericalLights));
 
-        std::filesystem::create_directories(directory);
+        // Instances refer to meshes and materials by their indices in the file, so both lists are read along with them
+        SceneChunk readChunks = chunks;
 
-        std::ofstream sceneFile{ destination, std::ios::out | std::ios::binary };
+        if (EnumMaskContains(chunks, SceneChunk::MeshInstances))
+        {
+            readChunks |= SceneChunk::Meshes | SceneChunk::Materials;
+        }
+
+        Camera camera = mCamera;
+        SerializedList<SerializedMesh> meshes;
+        SerializedList<Material> materials;
+        SerializedList<SerializedMeshInstance> meshInstances;
+        SerializedList<SerializedFlatLight> flatLights;
+        SerializedList<SerializedSphericalLight> sphericalLights;
+
+        // Every requested chunk is read and validated before the scene is modified
+        auto readChunk = [&archive, readChunks](SceneChunk chunk, auto& object)
+        {
+            return !EnumMaskContains(readChunks, chunk) || !archive.HasChunk(chunk) || archive.ReadChunk(chunk, object);
+        };
+
+        bool areChunksValid =
+            readChunk(SceneChunk::Camera, camera) &&
+            readChunk(SceneChunk::Materials, materials) &&
+            readChunk(SceneChunk::Meshes, meshes) &&
+            readChunk(SceneChunk::MeshInstances, meshInstances) &&
+            readChunk(SceneChunk::FlatLights, flatLights) &&
+            readChunk(SceneChunk::SphericalLights, sphericalLights);
+
+        if (!areChunksValid) return false;
+
+        for (const SerializedMeshInstance& instance : meshInstances.Items)
+        {
+            if (instance.MeshIndex >= meshes.Items.size() || instance.MaterialIndex >= materials.Items.size()) return false;
+        }
 
-        if (sceneFile)
+        for (const SerializedFlatLight& light : flatLights.Items)
         {
-            sceneFile.write((const char*)buffer.data(), writtenSize);
-            sceneFile.close();
+            if (light.Type > std::underlying_type_t<FlatLight::Type>(FlatLight::Type::Rectangle)) return false;
         }
+
+        auto chunkReadEndTime = std::chrono::steady_clock::now();
+
+        // Meshes and materials are needed when their chunks are requested or instances refer to them
+        std::vector<bool> isMeshNeeded(meshes.Items.size(), EnumMaskContains(chunks, SceneChunk::Meshes));
+        std::vector<bool> isMaterialNeeded(materials.Items.size(), EnumMaskContains(chunks, SceneChunk::Materials));
+
+        for (const SerializedMeshInstance& instance : meshInstances.Items)
+        {
+            isMeshNeeded[instance.MeshIndex] = true;
+            isMaterialNeeded[instance.MaterialIndex] = true;
+        }
+
+        deserializedArchive.Meshes.resize(std::max(deserializedArchive.Meshes.size(), meshes.Items.size()));
+        deserializedArchive.Materials.resize(std::max(deserializedArchive.Materials.size(), materials.Items.size()));
+
+        // Only the ones earlier calls didn't add are loaded
+        std::vector<uint32_t> newMeshIndices;
+        std::vector<uint32_t> newMaterialIndices;
+
+        for (uint32_t meshIdx = 0; meshIdx < meshes.Items.size(); ++meshIdx)
+        {
+            if (isMeshNeeded[meshIdx] && !deserializedArchive.Meshes[meshIdx]) newMeshIndices.push_back(meshIdx);
+        }
+
+        for (uint32_t materialIdx = 0; materialIdx < materials.Items.size(); ++materialIdx)
+        {
+            if (isMaterialNeeded[materialIdx] && !deserializedArchive.Materials[materialIdx]) newMaterialIndices.push_back(materialIdx);
+        }
+
+        // Every file is loaded once, loader handles files in parallel and takes unchanged ones from its cache
+        std::vector<std::string> meshFiles;
+        robin_hood::unordered_flat_map<std::string, uint32_t> meshFileIndices;
+
+        for (uint32_t meshIdx : newMeshIndices)
+        {
+            const SerializedMesh& mesh = meshes.Items[meshIdx];
+            auto [fileIt, isInserted] = meshFileIndices.emplace(mesh.SourceFile, (uint32_t)meshFiles.size());
+            if (isInserted) meshFiles.push_back(mesh.SourceFile);
+        }
+
+        std::vector<std::vector<Mesh>> loadedMeshes = meshFiles.empty() ? std::vector<std::vector<Mesh>>{} : meshLoader.LoadFiles(meshFiles);
+
+        for (uint32_t meshIdx : newMeshIndices)
+        {
+            const SerializedMesh& mesh = meshes.Items[meshIdx];
+            if (mesh.IndexInSourceFile >= loadedMeshes[meshFileIndices[mesh.SourceFile]].size()) return false;
+        }
+
+        std::vector<MaterialLoader::MaterialFiles> materialFiles;
+
+        for (uint32_t materialIdx : newMaterialIndices)
+        {
+            const Material& material = materials.Items[materialIdx];
+
+            materialFiles.push_back({
+                material.AlbedoMapPath,
+                material.NormalMapPath,
+                material.RoughnessMapPath,
+                material.MetalnessMapPath,
+                material.DisplacementMapPath,
+                material.DistanceFieldPath,
+                material.AOMapPath });
+        }
+
+        std::vector<Material> loadedMaterials = materialFiles.empty() ? std::vector<Material>{} : materialLoader.LoadMaterials(materialFiles);
+
+        for (auto newMaterialIdx = 0u; newMaterialIdx < newMaterialIndices.size(); ++newMaterialIdx)
+        {
+            deserializedArchive.Materials[newMaterialIndices[newMaterialIdx]] = AddMaterial(std::move(loadedMaterials[newMaterialIdx]));
+        }
+
+        auto assetLoadEndTime = std::chrono::steady_clock::now();
+
+        for (uint32_t meshIdx : newMeshIndices)
+        {
+            const SerializedMesh& mesh = meshes.Items[meshIdx];
+
+            // The same mesh may be referenced more than once, so it's copied out of loaded ones
+            deserializedArchive.Meshes[meshIdx] = AddMesh(Mesh{ loadedMeshes[meshFileIndices[mesh.SourceFile]][mesh.IndexInSourceFile] });
+        }
+
+        for (const SerializedMeshInstance& instance : meshInstances.Items)
+        {
+            MeshInstanceHandle handle = AddMeshInstance({ *deserializedArchive.Meshes[instance.MeshIndex], *deserializedArchive.Materials[instance.MaterialIndex] });
+            mMeshInstances[handle].SetTransformation(instance.Transformation);
+        }
+
+        for (const SerializedFlatLight& serializedLight : flatLights.Items)
+        {
+            FlatLightHandle handle = serializedLight.Type == std::underlying_type_t<FlatLight::Type>(FlatLight::Type::Disk) ?
+                EmplaceDiskLight() : EmplaceRectangularLight();
+
+            FlatLight& light = mFlatLights[handle];
+
+            // Luminance depends on area, so dimensions go first
+            light.SetNormal(serializedLight.Normal);
+            light.SetPosition(serializedLight.Light.Position);
+            light.SetWidth(serializedLight.Width);
+            light.SetHeight(serializedLight.Height);
+            DeserializeLight(serializedLight.Light, light);
+        }
+
+        for (const SerializedSphericalLight& serializedLight : sphericalLights.Items)
+        {
+            SphericalLight& light = mSphericalLights[EmplaceSphericalLight()];
+            light.SetPosition(serializedLight.Light.Position);
+            light.SetRadius(serializedLight.Radius);
+            DeserializeLight(serializedLight.Light, light);
+        }
+
+        if (EnumMaskContains(chunks, SceneChunk::Camera) && archive.HasChunk(SceneChunk::Camera))
+        {
+            mCamera = camera;
+        }
+
+        SceneChunk loadedChunks = SceneChunk::None;
+
+        for (const SceneArchiveFormat::ChunkEntry& entry : archive.ChunkTable())
+        {
+            loadedChunks |= SceneChunk(entry.Type) & chunks;
+        }
+
+        deserializedArchive.LoadedChunks |= loadedChunks;
+        mDeserializedArchives[archiveKey] = std::move(deserializedArchive);
+
+        auto endTime = std::chrono::steady_clock::now();
+
+        mDeserializationStatistics = {};
+        mDeserializationStatistics.FileSize = archive.FileSize();
+        mDeserializationStatistics.LoadedChunks = loadedChunks;
+        mDeserializationStatistics.ChunkReadTime = std::chrono::duration_cast<std::chrono::microseconds>(chunkReadEndTime - startTime);
+        mDeserializationStatistics.AssetLoadTime = std::chrono::duration_cast<std::chrono::microseconds>(assetLoadEndTime - chunkReadEndTime);
+        mDeserializationStatistics.LoadTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
+
+        return true;
+    }
+
+    bool Scene::IsSameArchive(const DeserializedArchive& deserializedArchive, const SceneArchiveReader& archive)
+    {
+        auto isSameEntry = [](const SceneArchiveFormat::ChunkEntry& lhs, const SceneArchiveFormat::ChunkEntry& rhs)
+        {
+            return lhs.Type == rhs.Type && lhs.Offset == rhs.Offset && lhs.Size == rhs.Size;
+        };
+
+        return deserializedArchive.FileSize == archive.FileSize() &&
+            std::equal(deserializedArchive.ChunkTable.begin(), deserializedArchive.ChunkTable.end(),
+                archive.ChunkTable().begin(), archive.ChunkTable().end(), isSameEntry);
+    }
+
+    SerializedLight Scene::SerializeLight(const Light& light)
+    {
+        SerializedLight serializedLight{};
+        serializedLight.Color = glm::vec4{ light.Color().R(), light.Color().G(), light.Color().B(), light.Color().A() };
+        serializedLight.ColorSpace = std::underlying_type_t<Foundation::Color::Space>(light.Color().CurrentSpace());
+        serializedLight.LuminousPower = light.LuminousPower();
+        return serializedLight;
     }
 
-    void Scene::Deserialize(const std::filesystem::path& source)
+    void Scene::DeserializeLight(const SerializedLight& serializedLight, Light& light)
     {
+        Foundation::Color color{
+            serializedLight.Color.r, serializedLight.Color.g, serializedLight.Color.b, serializedLight.Color.a,
+            Foundation::Color::Space(serializedLight.ColorSpace) };
 
+        light.SetColor(color);
+        light.SetLuminousPower(serializedLight.LuminousPower);
     }
 
     void Scene::LoadUtilityResources()
@@ -8,18 +8,28 @@
 #include "BloomParameters.hpp"
 #include "ResourceLoader.hpp"
 #include "MeshLoader.hpp"
+#include "MaterialLoader.hpp"
 #include "FlatLight.hpp"
 #include "SphericalLight.hpp"
 #include "LuminanceMeter.hpp"
 #include "SceneGPUStorage.hpp"
+#include "VisibilityCuller.hpp"
+#include "MeshLODSelector.hpp"
+#include "SceneArchive.hpp"
+#include "SceneArchiveRecords.hpp"
 
 #include <Memory/GPUResourceProducer.hpp>
+#include <Foundation/SlotMap.hpp>
+#include <Geometry/BoundingVolumeHierarchy.hpp>
+#include <Geometry/HiZPyramid.hpp>
 #include <robinhood/robin_hood.h>
 
 #include <functional>
 #include <vector>
+#include <optional>
 #include <memory>
 #include <filesystem>
+#include <chrono>
 
 namespace PathFinder 
 {
@@ -27,39 +37,135 @@ namespace PathFinder
     class Scene 
     {
     public:
-        using FlatLightIt = std::list<FlatLight>::iterator;
-        using SphericalLightIt = std::list<SphericalLight>::iterator;
+        using EntityVariant = std::variant<MeshInstanceHandle, FlatLightHandle, SphericalLightHandle>;
 
-        using EntityVariant = std::variant<MeshInstance*, FlatLight*, SphericalLight*>;
+        inline static const Foundation::Name MainCameraViewName{ "MainCamera" };
+
+        struct DeserializationStatistics
+        {
+            uint64_t FileSize = 0;
+            SceneChunk LoadedChunks = SceneChunk::None;
+
+            // Mapping of the file and parsing of its chunk table
+            std::chrono::microseconds OpenTime{ 0 };
+
+            // Deserialization of chunk payloads
+            std::chrono::microseconds ChunkReadTime{ 0 };
+
+            // Loading of meshes and textures chunks refer to
+            std::chrono::microseconds AssetLoadTime{ 0 };
+
+            std::chrono::microseconds LoadTime{ 0 };
+        };
 
         Scene(const std::filesystem::path& executableFolder, const HAL::Device* device, Memory::GPUResourceProducer* resourceProducer);
 
-        Mesh& AddMesh(Mesh&& mesh);
-        MeshInstance& AddMeshInstance(MeshInstance&& instance);
-        Material& AddMaterial(Material&& material);
-        FlatLightIt EmplaceDiskLight();
-        FlatLightIt EmplaceRectangularLight();
-        SphericalLightIt EmplaceSphericalLight();
+        MeshHandle AddMesh(Mesh&& mesh);
+        MeshInstanceHandle AddMeshInstance(MeshInstance&& instance);
+        MaterialHandle AddMaterial(Material&& material);
+        FlatLightHandle EmplaceDiskLight();
+        FlatLightHandle EmplaceRectangularLight();
+        SphericalLightHandle EmplaceSphericalLight();
+
+        bool RemoveMeshInstance(MeshInstanceHandle handle);
+        bool RemoveFlatLight(FlatLightHandle handle);
+        bool RemoveSphericalLight(SphericalLightHandle handle);
 
         std::optional<EntityVariant> GetEntityByID(const EntityID& id) const;
 
         void RemapEntityIDs();
 
-        void Serialize(const std::filesystem::path& destination) const;
-        void Deserialize(const std::filesystem::path& source);
+        // Rebuilds instance BVH when instances were added or removed or when refits degraded it too much,
+        // otherwise refits bounds of instances that changed since last update
+        void UpdateMeshInstanceBVH();
+
+        // Refreshes packed instance bounds and determines instances visible from the main camera.
+        // Frustum is tested against instance BVH, so it has to be updated first.
+        // Instances inside of the frustum are then tested against the latest depth pyramid read back from GPU.
+        // Occluded ones aren't rejected for good, they are drawn in the second GBuffer phase if Hi-Z of the current frame doesn't occlude them.
+        void CullMeshInstances();
+
+        // Chooses levels of detail of instances visible from the main camera and of occluded ones that may be drawn in the second phase.
+        // Has to be called after instances are culled and before they are uploaded.
+        void SelectMeshInstanceLODs(float viewportHeight);
+
+        // Reports size on screen of material textures of instances visible from the main camera.
+        // Has to be called after instances are culled.
+        void ReportMaterialTextureUsage(TextureStreamer& streamer, float viewportHeight) const;
+
+        // Points materials to textures recreated by the streamer.
+        // Returns whether any material changed, the material table has to be uploaded again then.
+        bool ReplaceMaterialTextures(const std::vector<TextureStreamer::TextureReplacement>& replacements);
+
+        // Accepts main camera's depth pyramid base level that was read back from GPU.
+        // Pyramids are identified by frame number, repeated reads of the same frame are ignored.
+        void UpdateHiZPyramid(
+            const float* baseLevelDepth,
+            const Geometry::Dimensions& viewportDimensions,
+            uint32_t baseTexelSize,
+            const glm::mat4& view,
+            const glm::mat4& viewProjection,
+            uint64_t frameNumber);
+
+        // Writes the scene to a chunked scene file. Meshes are stored as references to their source files,
+        // materials as paths of their textures, so the file stays small and assets are loaded through their caches.
+        bool Serialize(const std::filesystem::path& destination) const;
+
+        // Adds entities of requested chunks of a scene file to the scene. Instances are loaded
+        // together with meshes and materials they refer to. Chunks the file doesn't have are skipped.
+        // Meshes and materials added by earlier calls on the same file are reused, instances and lights are added once per file.
+        // Returns false and leaves the scene untouched if the file can't be opened or a chunk is damaged.
+        bool Deserialize(const std::filesystem::path& source, MeshLoader& meshLoader, MaterialLoader& materialLoader, SceneChunk chunks = SceneChunk::All);
+
+        // Same as above, for archives opened by the caller, so that chunks can be loaded lazily over time
+        bool Deserialize(const SceneArchiveReader& archive, MeshLoader& meshLoader, MaterialLoader& materialLoader, SceneChunk chunks = SceneChunk::All);
 
     private:
+        // Entities created from a scene file so far, indexed by their indices in the file.
+        // A file whose chunk table changed since is treated as a new one.
+        struct DeserializedArchive
+        {
+            uint64_t FileSize = 0;
+            std::vector<SceneArchiveFormat::ChunkEntry> ChunkTable;
+            std::vector<std::optional<MeshHandle>> Meshes;
+            std::vector<std::optional<MaterialHandle>> Materials;
+            SceneChunk LoadedChunks = SceneChunk::None;
+        };
+
+        static bool IsSameArchive(const DeserializedArchive& deserializedArchive, const SceneArchiveReader& archive);
+
+        static SerializedLight SerializeLight(const Light& light);
+        static void DeserializeLight(const SerializedLight& serializedLight, Light& light);
+
         void LoadUtilityResources();
 
-        std::list<Mesh> mMeshes;
-        std::list<MeshInstance> mMeshInstances;
-        std::list<Material> mMaterials;
-        std::list<FlatLight> mRectangularLights;
-        std::list<FlatLight> mDiskLights;
-        std::list<SphericalLight> mSphericalLights;
+        Foundation::SlotMap<Mesh> mMeshes;
+        Foundation::SlotMap<MeshInstance> mMeshInstances;
+        Foundation::SlotMap<Material> mMaterials;
+        Foundation::SlotMap<FlatLight> mFlatLights;
+        Foundation::SlotMap<SphericalLight> mSphericalLights;
 
         robin_hood::unordered_flat_map<EntityID, EntityVariant> mMappedEntities;
 
+        // Incremented whenever entities are added or removed, which reorders GPU tables
+        uint64_t mLayoutVersion = 0;
+
+        // Primitive indices of the hierarchy are dense indices of mesh instances
+        Geometry::BoundingVolumeHierarchy mMeshInstanceBVH;
+        std::vector<uint64_t> mMeshInstanceBVHVersions;
+        std::optional<uint64_t> mMeshInstanceBVHLayoutVersion;
+        float mMeshInstanceBVHBuildCost = 0.0f;
+
+        // Relative SAH cost growth after which refitting is abandoned in favor of a full rebuild
+        float mMeshInstanceBVHRebuildThreshold = 1.5f;
+
+        VisibilityCuller mVisibilityCuller;
+        MeshLODSelector mMeshLODSelector;
+        std::vector<uint32_t> mLODSelectionInstances;
+
+        Geometry::HiZPyramid mHiZPyramid;
+        std::optional<uint64_t> mHiZPyramidFrameNumber;
+
         Camera mCamera;
         LuminanceMeter mLuminanceMeter;
         GTTonemappingParameterss mTonemappingParams;
@@ -71,6 +177,11 @@ namespace PathFinder
         Mesh mUnitCube;
         Mesh mUnitSphere;
 
+        DeserializationStatistics mDeserializationStatistics;
+
+        // Keyed by normalized file path
+        robin_hood::unordered_node_map<std::string, DeserializedArchive> mDeserializedArchives;
+
         ResourceLoader mResourceLoader;
         MeshLoader mMeshLoader;
         SceneGPUStorage mGPUStorage;
@@ -83,8 +194,7 @@ namespace PathFinder
         inline const auto& Meshes() const { return mMeshes; }
         inline const auto& MeshInstances() const { return mMeshInstances; }
         inline const auto& Materials() const { return mMaterials; }
-        inline const auto& RectangularLights() const { return mRectangularLights; }
-        inline const auto& DiskLights() const { return mDiskLights; }
+        inline const auto& FlatLights() const { return mFlatLights; }
         inline const auto& SphericalLights() const { return mSphericalLights; }
         inline const auto& TonemappingParams() const { return mTonemappingParams; }
         inline const auto& BloomParams() const { return mBloomParameters; }
@@ -92,13 +202,19 @@ namespace PathFinder
         inline auto& Meshes() { return mMeshes; }
         inline auto& MeshInstances() { return mMeshInstances; }
         inline auto& Materials() { return mMaterials; }
-        inline auto& RectangularLights() { return mRectangularLights; }
-        inline auto& DiskLights() { return mDiskLights; }
+        inline auto& FlatLights() { return mFlatLights; }
         inline auto& SphericalLights() { return mSphericalLights; }
         inline auto& TonemappingParams() { return mTonemappingParams; }
         inline auto& BloomParams() { return mBloomParameters; }
-
-        inline auto TotalLightCount() const { return mRectangularLights.size() + mDiskLights.size() + mSphericalLights.size(); }
+        inline auto& MeshInstanceLODSelector() { return mMeshLODSelector; }
+        inline const auto& LastDeserializationStatistics() const { return mDeserializationStatistics; }
+
+        inline auto TotalLightCount() const { return mFlatLights.size() + mSphericalLights.size(); }
+        inline auto LayoutVersion() const { return mLayoutVersion; }
+        inline const auto& MeshInstanceBVH() const { return mMeshInstanceBVH; }
+        inline const auto& MeshInstanceVisibility() const { return mVisibilityCuller; }
+        inline const auto& MeshInstanceLODSelector() const { return mMeshLODSelector; }
+        inline const auto& LatestHiZPyramid() const { return mHiZPyramid; }
 
         inline const auto BlueNoiseTexture() const { return mBlueNoiseTexture.get(); }
         inline const auto SMAASearchTexture() const { return mSMAASearchTexture.get(); }
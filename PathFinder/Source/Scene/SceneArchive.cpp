@@ -0,0 +1,126 @@
+#include "SceneArchive.hpp"
+
+#include <Foundation/FileWriting.hpp>
+
+#include <string>
+
+namespace PathFinder
+{
+
+    bool SceneArchiveWriter::Write(const std::filesystem::path& destination) const
+    {
+        uint64_t tableOffset = sizeof(SceneArchiveFormat::FileHeader);
+        uint64_t payloadOffset = tableOffset + mChunks.size() * sizeof(SceneArchiveFormat::ChunkEntry);
+
+        std::vector<SceneArchiveFormat::ChunkEntry> table(mChunks.size());
+
+        for (uint64_t chunkIdx = 0; chunkIdx < mChunks.size(); ++chunkIdx)
+        {
+            SceneArchiveFormat::ChunkEntry& entry = table[chunkIdx];
+
+            // Padding is zeroed to keep files identical for identical scenes
+            std::memset(static_cast<void*>(&entry), 0, sizeof(SceneArchiveFormat::ChunkEntry));
+
+            payloadOffset = Foundation::MemoryUtils::Align(payloadOffset, SceneArchiveFormat::ChunkAlignment);
+
+            entry.Type = std::underlying_type_t<SceneChunk>(mChunks[chunkIdx].Type);
+            entry.Offset = payloadOffset;
+            entry.Size = mChunks[chunkIdx].Payload.size();
+
+            payloadOffset += entry.Size;
+        }
+
+        std::vector<uint8_t> buffer(payloadOffset, 0);
+
+        SceneArchiveFormat::FileHeader header{};
+        std::memset(static_cast<void*>(&header), 0, sizeof(SceneArchiveFormat::FileHeader));
+
+        header.Magic = SceneArchiveFormat::Magic;
+        header.Version = SceneArchiveFormat::Version;
+        header.FileSize = buffer.size();
+        header.ChunkCount = (uint32_t)mChunks.size();
+
+        std::memcpy(buffer.data(), &header, sizeof(SceneArchiveFormat::FileHeader));
+
+        if (!table.empty())
+        {
+            std::memcpy(buffer.data() + tableOffset, table.data(), table.size() * sizeof(SceneArchiveFormat::ChunkEntry));
+        }
+
+        for (uint64_t chunkIdx = 0; chunkIdx < mChunks.size(); ++chunkIdx)
+        {
+            const std::vector<uint8_t>& payload = mChunks[chunkIdx].Payload;
+
+            if (!payload.empty())
+            {
+                std::memcpy(buffer.data() + table[chunkIdx].Offset, payload.data(), payload.size());
+            }
+        }
+
+        return Foundation::WriteFileAtomically(destination, buffer.data(), buffer.size());
+    }
+
+    bool SceneArchiveReader::Open(const std::filesystem::path& source)
+    {
+        Close();
+
+        Foundation::MemoryMappedFile file{ source };
+
+        if (!file.IsOpen() || file.Size() < sizeof(SceneArchiveFormat::FileHeader)) return false;
+
+        SceneArchiveFormat::FileHeader header{};
+        std::memcpy(&header, file.Data(), sizeof(SceneArchiveFormat::FileHeader));
+
+        uint64_t tableOffset = sizeof(SceneArchiveFormat::FileHeader);
+        uint64_t tableSize = uint64_t(header.ChunkCount) * sizeof(SceneArchiveFormat::ChunkEntry);
+
+        bool isHeaderValid =
+            header.Magic == SceneArchiveFormat::Magic &&
+            header.Version == SceneArchiveFormat::Version &&
+            header.FileSize == file.Size() &&
+            tableSize <= file.Size() - tableOffset;
+
+        if (!isHeaderValid) return false;
+
+        std::vector<SceneArchiveFormat::ChunkEntry> table(header.ChunkCount);
+
+        if (tableSize > 0)
+        {
+            std::memcpy(table.data(), file.Data() + tableOffset, tableSize);
+        }
+
+        for (const SceneArchiveFormat::ChunkEntry& entry : table)
+        {
+            if (entry.Offset > file.Size() || entry.Size > file.Size() - entry.Offset) return false;
+        }
+
+        mFile = std::move(file);
+        mChunkTable = std::move(table);
+        mSourcePath = source;
+
+        return true;
+    }
+
+    void SceneArchiveReader::Close()
+    {
+        mFile.Close();
+        mChunkTable.clear();
+        mSourcePath.clear();
+    }
+
+    bool SceneArchiveReader::HasChunk(SceneChunk chunk) const
+    {
+        return FindChunk(chunk) != nullptr;
+    }
+
+    const SceneArchiveFormat::ChunkEntry* SceneArchiveReader::FindChunk(SceneChunk chunk) const
+    {
+        for (const SceneArchiveFormat::ChunkEntry& entry : mChunkTable)
+        {
+            if (entry.Type == std::underlying_type_t<SceneChunk>(chunk)) return &entry;
+        }
+
+        return nullptr;
+    }
+
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <Foundation/MemoryMappedFile.hpp>
+#include <Foundation/MemoryUtils.hpp>
+#include <Foundation/BitwiseEnum.hpp>
+
+#include <bitsery/bitsery.h>
+#include <bitsery/adapter/buffer.h>
+#include <bitsery/traits/vector.h>
+#include <bitsery/traits/string.h>
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <cstring>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    // Values are stored in chunk tables of scene files and must never change
+    enum class SceneChunk : uint32_t
+    {
+        None            = 0,
+        Camera          = 1 << 0,
+        Materials       = 1 << 1,
+        Meshes          = 1 << 2,
+        MeshInstances   = 1 << 3,
+        FlatLights      = 1 << 4,
+        SphericalLights = 1 << 5,
+
+        All = Camera | Materials | Meshes | MeshInstances | FlatLights | SphericalLights
+    };
+
+}
+
+ENABLE_BITMASK_OPERATORS(PathFinder::SceneChunk);
+
+namespace PathFinder
+{
+
+    /// Layout of scene files. A header and a table of chunks are followed by chunk payloads,
+    /// each payload is an independently serialized object starting at an aligned offset.
+    /// Chunks of unknown types are skipped by readers, so new chunk types don't require a version bump.
+    struct SceneArchiveFormat
+    {
+        // Incremented on every change of the layout or of a chunk payload
+        inline static const uint32_t Version = 1;
+        inline static const uint32_t Magic = 0x4E435350; // 'PSCN'
+        inline static const uint64_t ChunkAlignment = 16;
+
+        struct FileHeader
+        {
+            uint32_t Magic = 0;
+            uint32_t Version = 0;
+            uint64_t FileSize = 0;
+            uint32_t ChunkCount = 0;
+            uint32_t Reserved = 0;
+        };
+
+        // Chunk table follows the file header
+        struct ChunkEntry
+        {
+            uint32_t Type = 0;
+            uint32_t Reserved = 0;
+            uint64_t Offset = 0;
+            uint64_t Size = 0;
+        };
+    };
+
+    /// Accumulates serialized chunks in memory and writes them to a file at once
+    class SceneArchiveWriter
+    {
+    public:
+        /// Replaces a previously added chunk of the same type
+        template <class T>
+        void AddChunk(SceneChunk chunk, const T& object);
+
+        /// Writes to a temporary file which is then renamed, an existing archive is never left half-written
+        bool Write(const std::filesystem::path& destination) const;
+
+    private:
+        struct Chunk
+        {
+            SceneChunk Type = SceneChunk::None;
+            std::vector<uint8_t> Payload;
+        };
+
+        std::vector<Chunk> mChunks;
+    };
+
+    /// Maps a scene file and parses only its header and chunk table on open.
+    /// Chunks are deserialized on request straight from the mapped view, so untouched chunks cost nothing.
+    class SceneArchiveReader
+    {
+    public:
+        /// Returns false if the file is missing, of another version or its chunk table is out of file bounds
+        bool Open(const std::filesystem::path& source);
+        void Close();
+
+        bool HasChunk(SceneChunk chunk) const;
+
+        /// Returns false if the archive has no such chunk or its payload is damaged
+        template <class T>
+        bool ReadChunk(SceneChunk chunk, T& object) const;
+
+    private:
+        const SceneArchiveFormat::ChunkEntry* FindChunk(SceneChunk chunk) const;
+
+        Foundation::MemoryMappedFile mFile;
+        std::vector<SceneArchiveFormat::ChunkEntry> mChunkTable;
+        std::filesystem::path mSourcePath;
+
+    public:
+        inline bool IsOpen() const { return mFile.IsOpen(); }
+        inline const auto& SourcePath() const { return mSourcePath; }
+        inline uint64_t FileSize() const { return mFile.Size(); }
+        inline const auto& ChunkTable() const { return mChunkTable; }
+    };
+
+}
+
+#include "SceneArchive.inl"
@@ -0,0 +1,39 @@
+namespace PathFinder
+{
+
+    template <class T>
+    void SceneArchiveWriter::AddChunk(SceneChunk chunk, const T& object)
+    {
+        using Writer = bitsery::OutputBufferAdapter<std::vector<uint8_t>>;
+
+        Chunk newChunk{ chunk };
+        size_t writtenSize = bitsery::quickSerialization(Writer{ newChunk.Payload }, object);
+        newChunk.Payload.resize(writtenSize);
+
+        auto chunkIt = std::find_if(mChunks.begin(), mChunks.end(), [chunk](const Chunk& existing) { return existing.Type == chunk; });
+
+        if (chunkIt != mChunks.end())
+        {
+            *chunkIt = std::move(newChunk);
+        }
+        else
+        {
+            mChunks.emplace_back(std::move(newChunk));
+        }
+    }
+
+    template <class T>
+    bool SceneArchiveReader::ReadChunk(SceneChunk chunk, T& object) const
+    {
+        using Reader = bitsery::InputBufferAdapter<const uint8_t*>;
+
+        const SceneArchiveFormat::ChunkEntry* entry = FindChunk(chunk);
+
+        if (!entry) return false;
+
+        auto [error, isCompleted] = bitsery::quickDeserialization(Reader{ mFile.Data() + entry->Offset, entry->Size }, object);
+
+        return error == bitsery::ReaderError::NoError && isCompleted;
+    }
+
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Material.hpp"
+#include "Light.hpp"
+
+#include <Geometry/Transformation.hpp>
+#include <Utility/SerializationAdapters.hpp>
+
+#include <bitsery/bitsery.h>
+#include <bitsery/traits/vector.h>
+#include <bitsery/traits/string.h>
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <string>
+#include <vector>
+
+namespace PathFinder
+{
+
+    // Chunk payloads of scene files. Entities refer to each other by their dense indices at the time of serialization.
+    template <class T>
+    struct SerializedList
+    {
+        inline static const uint64_t MaxSize = 1 << 24;
+
+        std::vector<T> Items;
+
+        template <typename S>
+        void serialize(S& s)
+        {
+            s.container(Items, MaxSize);
+        }
+    };
+
+    struct SerializedMesh
+    {
+        std::string SourceFile;
+        uint32_t IndexInSourceFile = 0;
+
+        template <typename S>
+        void serialize(S& s)
+        {
+            s.text1b(SourceFile, Material::MaxPathLength);
+            s.value4b(IndexInSourceFile);
+        }
+    };
+
+    struct SerializedMeshInstance
+    {
+        uint32_t MeshIndex = 0;
+        uint32_t MaterialIndex = 0;
+        Geometry::Transformation Transformation;
+
+        template <typename S>
+        void serialize(S& s)
+        {
+            s.value4b(MeshIndex);
+            s.value4b(MaterialIndex);
+            s.object(Transformation);
+        }
+    };
+
+    struct SerializedLight
+    {
+        glm::vec4 Color{ 1.0f };
+        uint32_t ColorSpace = 0;
+        Lumen LuminousPower = 0.0f;
+        glm::vec3 Position{ 0.0f };
+
+        template <typename S>
+        void serialize(S& s)
+        {
+            s.object(Color);
+            s.value4b(ColorSpace);
+            s.value4b(LuminousPower);
+            s.object(Position);
+        }
+    };
+
+    struct SerializedFlatLight
+    {
+        SerializedLight Light;
+        uint32_t Type = 0;
+        glm::vec3 Normal{ 0.0f, -1.0f, 0.0f };
+        float Width = 0.0f;
+        float Height = 0.0f;
+
+        template <typename S>
+        void serialize(S& s)
+        {
+            s.object(Light);
+            s.value4b(Type);
+            s.object(Normal);
+            s.value4b(Width);
+            s.value4b(Height);
+        }
+    };
+
+    struct SerializedSphericalLight
+    {
+        SerializedLight Light;
+        float Radius = 0.0f;
+
+        template <typename S>
+        void serialize(S& s)
+        {
+            s.object(Light);
+            s.value4b(Radius);
+        }
+    };
+
+}
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <chrono>
 
 #include <RenderPipeline/DrawablePrimitive.hpp>
 #include <fplus/fplus.hpp>
@@ -21,42 +22,131 @@ namespace PathFinder
     {
         auto& meshes = mScene->Meshes();
 
-        mBottomAccelerationStructures.clear();
-
+        // Meshes keep their geometry and acceleration structures for their whole lifetime
         for (Mesh& mesh : meshes)
         {
+            if (mesh.HasLocationInVertexStorage()) continue;
+
             assert_format(!mesh.Vertices().empty(), "Empty meshes are not allowed");
 
             VertexStorageLocation locationInStorage = WriteToTemporaryBuffers(
                 mesh.Vertices().data(), mesh.Vertices().size(), mesh.Indices().data(), mesh.Indices().size());
 
+            WritePackedVerticesToTemporaryBuffers(mesh, locationInStorage);
+            WriteMeshletsToTemporaryBuffers(mesh, locationInStorage);
+            WriteLODsToTemporaryBuffers(mesh);
+
             mesh.SetVertexStorageLocation(locationInStorage);
         }
 
-        auto quadVertices = fplus::transform([](const glm::vec3& p) { return Vertex1P1N1UV1T1BT{ glm::vec4{p, 1.0f} }; }, DrawablePrimitive::UnitQuadVertices);
+        if (!mArePrimitivesUploaded)
+        {
+            auto quadVertices = fplus::transform([](const glm::vec3& p) { return Vertex1P1N1UV1T1BT{ glm::vec4{p, 1.0f} }; }, DrawablePrimitive::UnitQuadVertices);
+
+            mUnitQuadVertexLocation = WriteToTemporaryBuffers(
+                quadVertices.data(), quadVertices.size(),
+                DrawablePrimitive::UnitQuadIndices.data(), DrawablePrimitive::UnitQuadIndices.size());
 
-        mUnitQuadVertexLocation = WriteToTemporaryBuffers(
-            quadVertices.data(), quadVertices.size(),
-            DrawablePrimitive::UnitQuadIndices.data(), DrawablePrimitive::UnitQuadIndices.size());
+            mUnitCubeVertexLocation = WriteToTemporaryBuffers(
+                mScene->UnitCube().Vertices().data(), mScene->UnitCube().Vertices().size(), 
+                mScene->UnitCube().Indices().data(), mScene->UnitCube().Indices().size());
 
-        mUnitCubeVertexLocation = WriteToTemporaryBuffers(
-            mScene->UnitCube().Vertices().data(), mScene->UnitCube().Vertices().size(), 
-            mScene->UnitCube().Indices().data(), mScene->UnitCube().Indices().size());
+            mUnitSphereVertexLocation = WriteToTemporaryBuffers(
+                mScene->UnitSphere().Vertices().data(), mScene->UnitSphere().Vertices().size(),
+                mScene->UnitSphere().Indices().data(), mScene->UnitSphere().Indices().size());
 
-        mUnitSphereVertexLocation = WriteToTemporaryBuffers(
-            mScene->UnitSphere().Vertices().data(), mScene->UnitSphere().Vertices().size(),
-            mScene->UnitSphere().Indices().data(), mScene->UnitSphere().Indices().size());
+            mArePrimitivesUploaded = true;
+        }
 
         SubmitTemporaryBuffersToGPU<Vertex1P1N1UV1T1BT>();
+        SubmitGrowingBufferToGPU(mPackedVertices, "Unified Packed Vertex Buffer");
+        SubmitGrowingBufferToGPU(mMeshletTable, "Meshlet Table");
+        SubmitGrowingBufferToGPU(mMeshletVertexIndices, "Unified Meshlet Vertex Index Buffer");
+        SubmitGrowingBufferToGPU(mMeshletTriangles, "Unified Meshlet Triangle Buffer");
+
+        // Vertex storage locations referenced by instance table might have changed
+        mUploadedSceneLayoutVersion = std::nullopt;
+    }
+
+    void SceneGPUStorage::WritePackedVerticesToTemporaryBuffers(const Mesh& mesh, VertexStorageLocation& location)
+    {
+        if (!mesh.HasPackedVertices()) return;
+
+        location.PackedVertexBufferOffset = (uint32_t)mPackedVertices.Elements.size();
+        std::copy(mesh.PackedVertices().begin(), mesh.PackedVertices().end(), std::back_inserter(mPackedVertices.Elements));
+    }
+
+    void SceneGPUStorage::WriteMeshletsToTemporaryBuffers(const Mesh& mesh, VertexStorageLocation& location)
+    {
+        auto vertexIndexOffset = (uint32_t)mMeshletVertexIndices.Elements.size();
+        auto triangleOffset = (uint32_t)mMeshletTriangles.Elements.size();
+
+        location.MeshletTableOffset = (uint32_t)mMeshletTable.Elements.size();
+        location.MeshletCount = (uint32_t)mesh.Meshlets().size();
+
+        for (const Meshlet& meshlet : mesh.Meshlets())
+        {
+            mMaxMeshletTriangleCount = std::max(mMaxMeshletTriangleCount, meshlet.TriangleCount);
+
+            mMeshletTable.Elements.push_back(GPUMeshletTableEntry{
+                meshlet.BoundingSphereCenter,
+                meshlet.BoundingSphereRadius,
+                meshlet.ConeApex,
+                meshlet.ConeCutoff,
+                meshlet.ConeAxis,
+                vertexIndexOffset + meshlet.VertexOffset,
+                meshlet.VertexCount,
+                triangleOffset + meshlet.TriangleOffset,
+                meshlet.TriangleCount
+            });
+        }
+
+        std::copy(mesh.MeshletVertexIndices().begin(), mesh.MeshletVertexIndices().end(), std::back_inserter(mMeshletVertexIndices.Elements));
+        std::copy(mesh.MeshletTriangles().begin(), mesh.MeshletTriangles().end(), std::back_inserter(mMeshletTriangles.Elements));
+    }
+
+    void SceneGPUStorage::WriteLODsToTemporaryBuffers(Mesh& mesh)
+    {
+        auto& package = std::get<UploadBufferPackage<Vertex1P1N1UV1T1BT>>(mUploadBuffers);
+
+        std::vector<IndexStorageLocation> locations;
+
+        // LODs share vertices of the full detail mesh, so only their indices are stored
+        for (const MeshLOD& lod : mesh.LODs())
+        {
+            locations.push_back({ (uint32_t)package.Indices.size(), (uint32_t)lod.Indices.size() });
+            std::copy(lod.Indices.begin(), lod.Indices.end(), std::back_inserter(package.Indices));
+        }
+
+        mesh.SetLODIndexStorageLocations(std::move(locations));
     }
 
     void SceneGPUStorage::UploadMaterials()
+    {
+        WriteMaterialTable();
+
+        // Material indices referenced by instance table might have changed
+        mUploadedSceneLayoutVersion = std::nullopt;
+    }
+
+    void SceneGPUStorage::UpdateMaterialTextures()
+    {
+        // Replaced textures only change descriptor indices, so instances keep referring to the same entries
+        if (WriteMaterialTable())
+        {
+            mUploadedSceneLayoutVersion = std::nullopt;
+        }
+    }
+
+    bool SceneGPUStorage::WriteMaterialTable()
     {
         auto& materials = mScene->Materials();
 
-        if (materials.empty()) return;
+        if (materials.empty()) return false;
 
-        if (!mMaterialTable || mMaterialTable->Capacity<GPUMaterialTableEntry>() < materials.size())
+        bool isTableReallocated = !mMaterialTable || mMaterialTable->Capacity<GPUMaterialTableEntry>() < materials.size();
+
+        if (isTableReallocated)
         {
             auto properties = HAL::BufferProperties::Create<GPUMaterialTableEntry>(materials.size());
             mMaterialTable = mResourceProducer->NewBuffer(properties);
@@ -65,7 +155,8 @@ namespace PathFinder
 
         mMaterialTable->RequestWrite();
 
-        uint64_t materialIndex = 0;
+        uint32_t materialIndex = 0;
+        bool areIndicesChanged = isTableReallocated;
 
         for (Material& material : materials)
         {
@@ -86,31 +177,309 @@ namespace PathFinder
                 material.LTC_LUT_MatrixInverse_Diffuse->GetSRDescriptor()->IndexInHeapRange(),
                 material.LTC_LUT_Matrix_Diffuse->GetSRDescriptor()->IndexInHeapRange(),
                 material.LTC_LUT_Terms_Diffuse->GetSRDescriptor()->IndexInHeapRange(),
-                lut0SpecularSize.Width
+                lut0SpecularSize.Width,
+                material.AlbedoMapSlice,
+                material.NormalMapSlice,
+                material.RoughnessMapSlice,
+                material.MetalnessMapSlice,
+                material.AOMapSlice
             };
 
+            areIndicesChanged = areIndicesChanged || material.GPUMaterialTableIndex != materialIndex;
             material.GPUMaterialTableIndex = materialIndex;
 
             mMaterialTable->Write(&materialEntry, materialIndex, 1);
             ++materialIndex;
         }
+
+        return areIndicesChanged;
     }
 
     void SceneGPUStorage::UploadInstances()
     {
+        // Adding or removing entities shifts table indices, so everything has to be rewritten
+        bool isLayoutChanged = mUploadedSceneLayoutVersion != mScene->LayoutVersion();
+
+        // Disabled lights are not present in the light table, 
+        // so toggling any of them changes table partitioning
+        isLayoutChanged = UpdateLightEnabledStates() || isLayoutChanged;
+
+        // Newly built and compacted bottom structures change their addresses
+        bool areBottomRTASesChanged = ScheduleBottomAccelerationStructures(isLayoutChanged);
+
         mUniqueEntityID = 0;
-        mTopAccelerationStructure.Clear();
-        UploadMeshInstances();
-        UploadLights();
-        mTopAccelerationStructure.Build();
+        UploadMeshInstances(isLayoutChanged);
+        UploadLights(isLayoutChanged);
+        UpdateTopAccelerationStructure(isLayoutChanged || areBottomRTASesChanged);
+
+        mUploadedSceneLayoutVersion = mScene->LayoutVersion();
+    }
+
+    void SceneGPUStorage::UploadMeshInstanceDrawCommands()
+    {
+        const VisibilityCuller::ViewVisibility* visibility = mScene->MeshInstanceVisibility().GetViewVisibility(Scene::MainCameraViewName);
+
+        if (!visibility)
+        {
+            mMeshInstanceDrawCommands.clear();
+            mClusteredInstances.clear();
+            mClusteredMeshletCount = 0;
+            mOcclusionCandidates.clear();
+            mOcclusionCandidateDrawCommands.clear();
+            return;
+        }
+
+        UploadClusteredInstances(visibility->VisibleInstances);
+        UploadVisibleInstanceDrawCommands(mBatchedVisibleInstances);
+        UploadOcclusionCandidates(visibility->OccludedInstances);
+    }
+
+    void SceneGPUStorage::UploadClusteredInstances(const std::vector<uint32_t>& visibleInstances)
+    {
+        const auto& instances = mScene->MeshInstances();
+
+        mClusteredInstances.clear();
+        mClusteredMeshletCount = 0;
+        mBatchedVisibleInstances.clear();
+
+        // Coarser LODs have no meshlets of their own and cover few pixels, batches draw them whole
+        for (uint32_t instanceIdx : visibleInstances)
+        {
+            const MeshInstance& instance = instances.data()[instanceIdx];
+            auto meshletCount = (uint32_t)mScene->Meshes()[instance.AssociatedMesh()].Meshlets().size();
+
+            if (instance.LOD() == 0 && meshletCount > 0)
+            {
+                mClusteredInstances.push_back(instance.IndexInGPUTable());
+                mClusteredMeshletCount += meshletCount;
+            }
+            else
+            {
+                mBatchedVisibleInstances.push_back(instanceIdx);
+            }
+        }
+
+        if (mClusteredInstances.empty())
+            return;
+
+        if (!mClusteredInstanceBuffer || mClusteredInstanceBuffer->Capacity<uint32_t>() < mClusteredInstances.size())
+        {
+            auto properties = HAL::BufferProperties::Create<uint32_t>(mClusteredInstances.size());
+            mClusteredInstanceBuffer = mResourceProducer->NewBuffer(properties);
+            mClusteredInstanceBuffer->SetDebugName("Clustered Mesh Instances");
+        }
+
+        // Instances move between clustered and batched ones with LOD changes, so the list is written every frame
+        mClusteredInstanceBuffer->RequestWrite();
+        mClusteredInstanceBuffer->Write(mClusteredInstances.data(), 0, mClusteredInstances.size());
     }
 
-    void SceneGPUStorage::UploadMeshInstances()
+    void SceneGPUStorage::UploadVisibleInstanceDrawCommands(const std::vector<uint32_t>& visibleInstances)
+    {
+        // Commands written earlier stay in GPU memory while batches don't change
+        if (!mMeshInstanceBatcher.Update(mScene->MeshInstances(), visibleInstances, mScene->LayoutVersion()))
+            return;
+
+        mMeshInstanceDrawCommands.clear();
+        mMeshInstanceBatchList.clear();
+
+        mMeshInstanceBatcher.GenerateDrawCommands(mScene->MeshInstances(), mScene->Meshes(), mMeshInstanceDrawCommands, mMeshInstanceBatchList);
+
+        if (mMeshInstanceDrawCommands.empty())
+            return;
+
+        if (!mMeshInstanceDrawCommandBuffer || mMeshInstanceDrawCommandBuffer->Capacity<GPUMeshInstanceDrawCommand>() < mMeshInstanceDrawCommands.size())
+        {
+            auto properties = HAL::BufferProperties::Create<GPUMeshInstanceDrawCommand>(
+                mMeshInstanceDrawCommands.size(), 1, HAL::ResourceState::Common, HAL::ResourceState::IndirectArgument);
+
+            mMeshInstanceDrawCommandBuffer = mResourceProducer->NewBuffer(properties);
+            mMeshInstanceDrawCommandBuffer->SetDebugName("Mesh Instance Draw Commands");
+        }
+
+        if (!mMeshInstanceBatchListBuffer || mMeshInstanceBatchListBuffer->Capacity<uint32_t>() < mMeshInstanceBatchList.size())
+        {
+            auto properties = HAL::BufferProperties::Create<uint32_t>(mMeshInstanceBatchList.size());
+            mMeshInstanceBatchListBuffer = mResourceProducer->NewBuffer(properties);
+            mMeshInstanceBatchListBuffer->SetDebugName("Mesh Instance Batch List");
+        }
+
+        mMeshInstanceDrawCommandBuffer->RequestWrite();
+        mMeshInstanceDrawCommandBuffer->Write(mMeshInstanceDrawCommands.data(), 0, mMeshInstanceDrawCommands.size());
+
+        mMeshInstanceBatchListBuffer->RequestWrite();
+        mMeshInstanceBatchListBuffer->Write(mMeshInstanceBatchList.data(), 0, mMeshInstanceBatchList.size());
+    }
+
+    void SceneGPUStorage::UploadOcclusionCandidates(const std::vector<uint32_t>& occludedInstances)
+    {
+        if (mOcclusionCandidateBatcher.Update(mScene->MeshInstances(), occludedInstances, mScene->LayoutVersion()))
+        {
+            mOcclusionCandidateDrawCommands.clear();
+            mOcclusionCandidateBatchList.clear();
+
+            mOcclusionCandidateBatcher.GenerateDrawCommands(
+                mScene->MeshInstances(), mScene->Meshes(), mOcclusionCandidateDrawCommands, mOcclusionCandidateBatchList);
+
+            if (!mOcclusionCandidateDrawCommands.empty())
+            {
+                if (!mOcclusionCandidateDrawCommandBuffer || 
+                    mOcclusionCandidateDrawCommandBuffer->Capacity<GPUMeshInstanceDrawCommand>() < mOcclusionCandidateDrawCommands.size())
+                {
+                    auto properties = HAL::BufferProperties::Create<GPUMeshInstanceDrawCommand>(mOcclusionCandidateDrawCommands.size());
+                    mOcclusionCandidateDrawCommandBuffer = mResourceProducer->NewBuffer(properties);
+                    mOcclusionCandidateDrawCommandBuffer->SetDebugName("Occlusion Candidate Draw Commands");
+                }
+
+                mOcclusionCandidateDrawCommandBuffer->RequestWrite();
+                mOcclusionCandidateDrawCommandBuffer->Write(mOcclusionCandidateDrawCommands.data(), 0, mOcclusionCandidateDrawCommands.size());
+            }
+        }
+
+        mOcclusionCandidates.clear();
+
+        if (mOcclusionCandidateDrawCommands.empty())
+            return;
+
+        // Candidates may move while batches stay the same, so their bounds are written every frame
+        const auto& instances = mScene->MeshInstances();
+        const auto& batches = mOcclusionCandidateBatcher.Batches();
+        const auto& batchedInstances = mOcclusionCandidateBatcher.BatchedInstances();
+
+        mOcclusionCandidates.reserve(batchedInstances.size());
+
+        for (auto batchIdx = 0u; batchIdx < batches.size(); ++batchIdx)
+        {
+            const MeshInstanceBatcher::Batch& batch = batches[batchIdx];
+
+            for (uint32_t idx = batch.FirstInstance; idx < batch.FirstInstance + batch.InstanceCount; ++idx)
+            {
+                const MeshInstance& instance = instances.data()[batchedInstances[idx]];
+                Geometry::AxisAlignedBox3D bounds = instance.BoundingBox(mScene->Meshes()[instance.AssociatedMesh()]);
+                mOcclusionCandidates.push_back({ bounds.Min, instance.IndexInGPUTable(), bounds.Max, batchIdx });
+            }
+        }
+
+        if (!mOcclusionCandidateBuffer || mOcclusionCandidateBuffer->Capacity<GPUOcclusionCandidate>() < mOcclusionCandidates.size())
+        {
+            auto properties = HAL::BufferProperties::Create<GPUOcclusionCandidate>(mOcclusionCandidates.size());
+            mOcclusionCandidateBuffer = mResourceProducer->NewBuffer(properties);
+            mOcclusionCandidateBuffer->SetDebugName("Occlusion Candidates");
+        }
+
+        mOcclusionCandidateBuffer->RequestWrite();
+        mOcclusionCandidateBuffer->Write(mOcclusionCandidates.data(), 0, mOcclusionCandidates.size());
+    }
+
+    void SceneGPUStorage::ReadbackBottomAccelerationStructureCompactedSizes()
+    {
+        // Depending on the amount of frames in flight sizes arrive a few frames after the build
+        std::vector<uint16_t> stillAwaiting;
+
+        for (uint16_t blasIdx : mBottomRTASesAwaitingCompactedSize)
+        {
+            if (mBottomAccelerationStructures[blasIdx].ReadCompactedSize())
+            {
+                mBottomRTASesReadyForCompaction.push_back(blasIdx);
+            }
+            else
+            {
+                stillAwaiting.push_back(blasIdx);
+            }
+        }
+
+        mBottomRTASesAwaitingCompactedSize = std::move(stillAwaiting);
+    }
+
+    bool SceneGPUStorage::ScheduleBottomAccelerationStructures(bool isLayoutChanged)
+    {
+        mScheduledBottomRTASes.clear();
+
+        bool areStructuresChanged = false;
+
+        if (isLayoutChanged)
+        {
+            ReleaseUnreferencedBottomAccelerationStructures();
+        }
+
+        // Compaction copies were recorded in the previous frame
+        for (uint16_t blasIdx : mBottomRTASesBeingCompacted)
+        {
+            mBottomAccelerationStructures[blasIdx].FinalizeCompaction();
+        }
+
+        mBottomRTASesBeingCompacted.clear();
+
+        for (uint16_t blasIdx : mBottomRTASesReadyForCompaction)
+        {
+            BottomRTAS& blas = mBottomAccelerationStructures[blasIdx];
+
+            if (blas.Compact())
+            {
+                mScheduledBottomRTASes.push_back(&blas);
+                mBottomRTASesBeingCompacted.push_back(blasIdx);
+                areStructuresChanged = true;
+            }
+        }
+
+        mBottomRTASesReadyForCompaction.clear();
+
+        // Builds are spread across frames to avoid spikes when a lot of meshes are added at once
+        uint64_t builtPrimitiveCount = 0;
+
+        std::apply([&](auto&... packages)
+        {
+            ((areStructuresChanged = BuildPendingBottomAccelerationStructures(packages, builtPrimitiveCount) || areStructuresChanged), ...);
+        }, 
+        mUploadBuffers);
+
+        return areStructuresChanged;
+    }
+
+    void SceneGPUStorage::ReleaseUnreferencedBottomAccelerationStructures()
+    {
+        std::vector<bool> isReferenced(mBottomAccelerationStructures.size(), false);
+
+        for (const Mesh& mesh : mScene->Meshes())
+        {
+            if (mesh.HasLocationInVertexStorage())
+            {
+                isReferenced[mesh.LocationInVertexStorage().BottomAccelerationStructureIndex] = true;
+            }
+        }
+
+        if (mArePrimitivesUploaded)
+        {
+            isReferenced[mUnitQuadVertexLocation.BottomAccelerationStructureIndex] = true;
+            isReferenced[mUnitCubeVertexLocation.BottomAccelerationStructureIndex] = true;
+            isReferenced[mUnitSphereVertexLocation.BottomAccelerationStructureIndex] = true;
+        }
+
+        for (auto blasIdx = 0u; blasIdx < mBottomAccelerationStructures.size(); ++blasIdx)
+        {
+            if (!isReferenced[blasIdx]) mBottomAccelerationStructures[blasIdx].Release();
+        }
+
+        auto isUnreferenced = [&isReferenced](uint16_t blasIdx) { return !isReferenced[blasIdx]; };
+        auto isLocationUnreferenced = [&isReferenced](const VertexStorageLocation& location) { return !isReferenced[location.BottomAccelerationStructureIndex]; };
+
+        auto eraseIf = [](auto& container, auto&& predicate)
+        {
+            container.erase(std::remove_if(container.begin(), container.end(), predicate), container.end());
+        };
+
+        eraseIf(mBottomRTASesAwaitingCompactedSize, isUnreferenced);
+        eraseIf(mBottomRTASesReadyForCompaction, isUnreferenced);
+        eraseIf(mBottomRTASesBeingCompacted, isUnreferenced);
+
+        std::apply([&](auto&... packages) { (eraseIf(packages.PendingBottomRTASBuilds, isLocationUnreferenced), ...); }, mUploadBuffers);
+    }
+
+    void SceneGPUStorage::UploadMeshInstances(bool forceFullUpload)
     {
         auto& meshInstances = mScene->MeshInstances();
-        auto& sphericalLights = mScene->SphericalLights();
-        auto& rectangularLights = mScene->RectangularLights();
-        auto& diskLights = mScene->DiskLights();
+        auto& meshes = mScene->Meshes();
+        auto& materials = mScene->Materials();
 
         auto requiredBufferSize = meshInstances.size() + mScene->TotalLightCount();
 
@@ -120,78 +489,95 @@ namespace PathFinder
         if (!mMeshInstanceTable || mMeshInstanceTable->Capacity<GPUMeshInstanceTableEntry>() < requiredBufferSize)
         {
             auto properties = HAL::BufferProperties::Create<GPUMeshInstanceTableEntry>(requiredBufferSize);
-            mMeshInstanceTable = mResourceProducer->NewBuffer(properties, Memory::GPUResource::UploadStrategy::DirectAccess);
+            mMeshInstanceTable = mResourceProducer->NewBuffer(properties);
             mMeshInstanceTable->SetDebugName("Mesh Instance Table");
+            forceFullUpload = true;
         }
 
-        mMeshInstanceTable->RequestWrite();
+        mMeshInstanceUploadStates.resize(meshInstances.size());
 
-        uint32_t instanceIdx = 0;
+        std::vector<GPUMeshInstanceTableEntry> dirtyEntries;
+        std::vector<uint32_t> dirtyEntryIndices;
 
-        auto uploadInstance = [&](const GPUMeshInstanceTableEntry& gpuInstance, const VertexStorageLocation& vertexLocations, EntityMask mask, auto&& sceneObject)
+        for (uint32_t instanceIdx = 0; instanceIdx < meshInstances.size(); ++instanceIdx)
         {
+            MeshInstance& instance = meshInstances.data()[instanceIdx];
+            EntityUploadState& uploadState = mMeshInstanceUploadStates[instanceIdx];
+            const Mesh& mesh = meshes[instance.AssociatedMesh()];
+
             EntityID entityId = GetNextEntityID();
 
-            sceneObject.SetIndexInGPUTable(instanceIdx);
-            sceneObject.SetEntityID(entityId);
+            instance.SetIndexInGPUTable(instanceIdx);
+            instance.SetEntityID(entityId);
 
-            BottomRTAS& blas = mBottomAccelerationStructures[vertexLocations.BottomAccelerationStructureIndex];
-            mTopAccelerationStructure.AddInstance(blas, RTASInstanceInfoForEntity(entityId, mask), gpuInstance.InstanceWorldMatrix);
-            mMeshInstanceTable->Write(&gpuInstance, instanceIdx, 1);
+            bool isDirty = forceFullUpload || uploadState.HasMotion || uploadState.Version != instance.Version() || uploadState.LOD != instance.LOD();
 
-            ++instanceIdx;
-        };
+            if (!isDirty) continue;
+
+            const Material& material = materials[instance.AssociatedMaterial()];
+            IndexStorageLocation indexLocation = mesh.LODLocationInIndexStorage(instance.LOD());
 
-        for (MeshInstance& instance : meshInstances)
-        {
             GPUMeshInstanceTableEntry instanceEntry{
                 instance.Transformation().ModelMatrix(),
                 instance.PrevTransformation().ModelMatrix(),
                 instance.Transformation().NormalMatrix(),
-                instance.AssociatedMaterial()->GPUMaterialTableIndex,
-                instance.AssociatedMesh()->LocationInVertexStorage().VertexBufferOffset,
-                instance.AssociatedMesh()->LocationInVertexStorage().IndexBufferOffset,
-                instance.AssociatedMesh()->LocationInVertexStorage().IndexCount,
-                instance.AssociatedMesh()->HasTangentSpace()
+                material.GPUMaterialTableIndex,
+                mesh.LocationInVertexStorage().VertexBufferOffset,
+                indexLocation.IndexBufferOffset,
+                indexLocation.IndexCount,
+                mesh.HasTangentSpace(),
+                mesh.LocationInVertexStorage().MeshletTableOffset,
+                mesh.LocationInVertexStorage().MeshletCount,
+                mesh.LocationInVertexStorage().PackedVertexBufferOffset,
+                mesh.BoundingBox().Min,
+                mesh.BoundingBox().Max
             };
 
-            uploadInstance(instanceEntry, instance.AssociatedMesh()->LocationInVertexStorage(), EntityMask::MeshInstance, instance);
+            dirtyEntries.push_back(instanceEntry);
+            dirtyEntryIndices.push_back(instanceIdx);
+
+            uploadState.Version = instance.Version();
+            uploadState.LOD = instance.LOD();
+            uploadState.HasMotion = instanceEntry.InstanceWorldMatrix != instanceEntry.InstancePrevWorldMatrix;
+
+            // Instances that did not move already have matching previous transforms
             instance.UpdatePreviousTransform();
         }
+
+        WriteDirtyTableEntries(*mMeshInstanceTable, dirtyEntries, dirtyEntryIndices);
     }
 
-    void SceneGPUStorage::UploadLights()
+    void SceneGPUStorage::UploadLights(bool forceFullUpload)
     {
-        auto& sphericalLights = mScene->SphericalLights();
-        auto& rectangularLights = mScene->RectangularLights();
-        auto& diskLights = mScene->DiskLights();
-
         auto requiredBufferSize = mScene->TotalLightCount();
 
         if (!mLightTable || mLightTable->Capacity<GPULightTableEntry>() < requiredBufferSize)
         {
             auto properties = HAL::BufferProperties::Create<GPULightTableEntry>(requiredBufferSize);
-            mLightTable = mResourceProducer->NewBuffer(properties, Memory::GPUResource::UploadStrategy::DirectAccess);
+            mLightTable = mResourceProducer->NewBuffer(properties);
             mLightTable->SetDebugName("Lights Instance Table");
+            forceFullUpload = true;
         }
 
-        mLightTable->RequestWrite();
+        std::vector<GPULightTableEntry> dirtyEntries;
+        std::vector<uint32_t> dirtyEntryIndices;
 
         uint32_t index = 0;
+        mLightsInTableOrder.clear();
         mLightTablePartitionInfo = {};
         mLightTablePartitionInfo.TotalLightsCount = 0;
         mLightTablePartitionInfo.SphericalLightsOffset = index;
 
-        auto uploadLights = [this, &index](auto&& lights, uint32_t& tableOffset, uint32_t& lightCount, const VertexStorageLocation& vertexLocation)
+        auto uploadLights = [&](auto&& lights, std::vector<EntityUploadState>& uploadStates, auto&& filter, uint32_t& tableOffset, uint32_t& lightCount, const VertexStorageLocation& vertexLocation)
         {
             tableOffset = index;
 
-            for (auto& light : lights)
+            for (auto lightIdx = 0u; lightIdx < lights.size(); ++lightIdx)
             {
-                if (light.LuminousPower() <= 0.0) continue;
+                auto& light = lights.data()[lightIdx];
+                EntityUploadState& uploadState = uploadStates[lightIdx];
 
-                GPULightTableEntry lightEntry = CreateLightGPUTableEntry(light);
-                mLightTable->Write(&lightEntry, index, 1);
+                if (!light.IsEnabled() || !filter(light)) continue;
 
                 EntityID entityId = GetNextEntityID();
 
@@ -199,8 +585,14 @@ namespace PathFinder
                 light.SetIndexInGPUTable(index);
                 light.SetVertexStorageLocation(vertexLocation);
 
-                BottomRTAS& blas = mBottomAccelerationStructures[vertexLocation.BottomAccelerationStructureIndex];
-                mTopAccelerationStructure.AddInstance(blas, RTASInstanceInfoForEntity(entityId, EntityMask::Light), light.ModelMatrix());
+                if (forceFullUpload || uploadState.Version != light.Version())
+                {
+                    dirtyEntries.push_back(CreateLightGPUTableEntry(light));
+                    dirtyEntryIndices.push_back(index);
+                    uploadState.Version = light.Version();
+                }
+
+                mLightsInTableOrder.emplace_back(&light, &uploadState);
 
                 ++index;
                 ++lightCount;
@@ -208,9 +600,128 @@ namespace PathFinder
             }
         };
 
-        uploadLights(mScene->SphericalLights(), mLightTablePartitionInfo.SphericalLightsOffset, mLightTablePartitionInfo.SphericalLightsCount, mUnitSphereVertexLocation);
-        uploadLights(mScene->DiskLights(), mLightTablePartitionInfo.EllipticalLightsOffset, mLightTablePartitionInfo.EllipticalLightsCount, mUnitQuadVertexLocation);
-        uploadLights(mScene->RectangularLights(), mLightTablePartitionInfo.RectangularLightsOffset, mLightTablePartitionInfo.RectangularLightsCount, mUnitQuadVertexLocation);
+        // Flat lights share storage, but light table is partitioned by light type
+        auto isDisk = [](const FlatLight& light) { return light.LightType() == FlatLight::Type::Disk; };
+        auto isRectangle = [](const FlatLight& light) { return light.LightType() == FlatLight::Type::Rectangle; };
+        auto any = [](const SphericalLight& light) { return true; };
+
+        uploadLights(mScene->SphericalLights(), mSphericalLightUploadStates, any, mLightTablePartitionInfo.SphericalLightsOffset, mLightTablePartitionInfo.SphericalLightsCount, mUnitSphereVertexLocation);
+        uploadLights(mScene->FlatLights(), mFlatLightUploadStates, isDisk, mLightTablePartitionInfo.EllipticalLightsOffset, mLightTablePartitionInfo.EllipticalLightsCount, mUnitQuadVertexLocation);
+        uploadLights(mScene->FlatLights(), mFlatLightUploadStates, isRectangle, mLightTablePartitionInfo.RectangularLightsOffset, mLightTablePartitionInfo.RectangularLightsCount, mUnitQuadVertexLocation);
+
+        WriteDirtyTableEntries(*mLightTable, dirtyEntries, dirtyEntryIndices);
+    }
+
+    bool SceneGPUStorage::UpdateLightEnabledStates()
+    {
+        bool isAnyLightToggled = false;
+
+        mSphericalLightUploadStates.resize(mScene->SphericalLights().size());
+        mFlatLightUploadStates.resize(mScene->FlatLights().size());
+
+        auto updateStates = [&isAnyLightToggled](auto&& lights, std::vector<EntityUploadState>& uploadStates)
+        {
+            for (auto lightIdx = 0u; lightIdx < lights.size(); ++lightIdx)
+            {
+                bool isEnabled = lights.data()[lightIdx].IsEnabled();
+                isAnyLightToggled = isAnyLightToggled || uploadStates[lightIdx].IsEnabled != isEnabled;
+                uploadStates[lightIdx].IsEnabled = isEnabled;
+            }
+        };
+
+        updateStates(mScene->SphericalLights(), mSphericalLightUploadStates);
+        updateStates(mScene->FlatLights(), mFlatLightUploadStates);
+
+        return isAnyLightToggled;
+    }
+
+    void SceneGPUStorage::UpdateTopAccelerationStructure(bool isLayoutChanged)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        // Instance order must match the one structure was built with to be able to refit it
+        bool isRebuildRequired = isLayoutChanged || !mTopAccelerationStructure.IsBuilt();
+
+        if (isRebuildRequired)
+        {
+            mTopAccelerationStructure.Clear();
+        }
+
+        uint64_t instanceIdx = 0;
+        uint64_t refittedInstanceCount = 0;
+
+        auto addOrRefitInstance = [&](const BottomRTAS& blas, EntityID entityId, EntityMask mask, const glm::mat4& transform, uint64_t version, EntityUploadState& uploadState)
+        {
+            // Entity joins the structure once its bottom structure is built, which triggers a rebuild
+            if (!blas.IsBuilt()) return;
+
+            if (isRebuildRequired)
+            {
+                mTopAccelerationStructure.AddInstance(blas, RTASInstanceInfoForEntity(entityId, mask), transform);
+            }
+            else if (uploadState.TopRTASVersion != version)
+            {
+                mTopAccelerationStructure.SetInstanceTransform(instanceIdx, transform);
+                ++refittedInstanceCount;
+            }
+
+            uploadState.TopRTASVersion = version;
+            ++instanceIdx;
+        };
+
+        auto& meshInstances = mScene->MeshInstances();
+        auto& meshes = mScene->Meshes();
+
+        for (auto denseIdx = 0u; denseIdx < meshInstances.size(); ++denseIdx)
+        {
+            const MeshInstance& instance = meshInstances.data()[denseIdx];
+            const Mesh& mesh = meshes[instance.AssociatedMesh()];
+            const BottomRTAS& blas = mBottomAccelerationStructures[mesh.LocationInVertexStorage().BottomAccelerationStructureIndex];
+
+            addOrRefitInstance(blas, instance.ID(), EntityMask::MeshInstance, instance.Transformation().ModelMatrix(), instance.Version(), mMeshInstanceUploadStates[denseIdx]);
+        }
+
+        for (auto [light, uploadState] : mLightsInTableOrder)
+        {
+            const BottomRTAS& blas = mBottomAccelerationStructures[light->LocationInVertexStorage().BottomAccelerationStructureIndex];
+            addOrRefitInstance(blas, light->ID(), EntityMask::Light, light->ModelMatrix(), light->Version(), *uploadState);
+        }
+
+        // Refitting keeps tree topology intact, so its quality degrades as instances move away from their
+        // original positions. Amount of refitted instances relative to instance count serves as a cheap estimate of that.
+        if (!isRebuildRequired && refittedInstanceCount > 0)
+        {
+            uint64_t refittedSinceRebuild = mTopRTASStatistics.RefittedInstancesSinceRebuild + refittedInstanceCount;
+
+            isRebuildRequired =
+                mTopRTASStatistics.RefitsSinceRebuild >= mTopRTASBuildPolicy.MaxRefitsBetweenRebuilds ||
+                refittedSinceRebuild > mTopRTASBuildPolicy.MaxRefittedInstanceRatio * mTopAccelerationStructure.InstanceCount();
+        }
+
+        if (isRebuildRequired)
+        {
+            mTopAccelerationStructure.Build();
+            mTopRTASStatistics.LastOperation = TopRTASOperation::Rebuild;
+            mTopRTASStatistics.RebuildCount++;
+            mTopRTASStatistics.RefitsSinceRebuild = 0;
+            mTopRTASStatistics.RefittedInstancesSinceRebuild = 0;
+        }
+        else if (refittedInstanceCount > 0)
+        {
+            mTopAccelerationStructure.Update();
+            mTopRTASStatistics.LastOperation = TopRTASOperation::Refit;
+            mTopRTASStatistics.RefitCount++;
+            mTopRTASStatistics.RefitsSinceRebuild++;
+            mTopRTASStatistics.RefittedInstancesSinceRebuild += refittedInstanceCount;
+        }
+        else
+        {
+            mTopRTASStatistics.LastOperation = TopRTASOperation::None;
+            mTopRTASStatistics.SkipCount++;
+        }
+
+        mTopRTASStatistics.InstanceDescriptorGenerationTime = 
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
     }
 
     EntityID SceneGPUStorage::GetNextEntityID()
@@ -4,24 +4,32 @@
 #include <HardwareAbstractionLayer/CommandQueue.hpp>
 #include <HardwareAbstractionLayer/Buffer.hpp>
 #include <HardwareAbstractionLayer/ResourceBarrier.hpp>
+#include <HardwareAbstractionLayer/CommandSignature.hpp>
+#include <HardwareAbstractionLayer/RayTracingAccelerationStructure.hpp>
 
 #include <Memory/GPUResourceProducer.hpp>
 
 #include "Mesh.hpp"
 #include "MeshInstance.hpp"
 #include "Vertices/Vertex1P1N1UV1T1BT.hpp"
+#include "Vertices/Vertex1P1N1UV1T1BTPacked.hpp"
 #include "Vertices/Vertex1P1N1UV.hpp"
 #include "Vertices/Vertex1P3.hpp"
 #include "FlatLight.hpp"
 #include "SphericalLight.hpp"
+#include "EntityID.hpp"
 #include "VertexStorageLocation.hpp"
+#include "MeshInstanceBatcher.hpp"
 
 #include <RenderPipeline/BottomRTAS.hpp>
 #include <RenderPipeline/TopRTAS.hpp>
 
 #include <vector>
+#include <deque>
 #include <memory>
 #include <tuple>
+#include <optional>
+#include <chrono>
 
 namespace PathFinder
 {
@@ -40,6 +48,31 @@ namespace PathFinder
         uint32_t IndexCount;
         // 16 byte boundary
         uint32_t HasTangentSpace;
+        uint32_t MeshletTableOffset;
+        uint32_t MeshletCount;
+        // Unpacked vertices are read from unified vertex buffer when there is no packed offset
+        uint32_t PackedVertexBufferOffset;
+        // 16 byte boundary
+        glm::vec3 PackedVertexBoundsMin;
+        glm::vec3 PackedVertexBoundsMax;
+    };
+
+    // Meshlet vertex indices are relative to the first vertex of the mesh in the unified vertex buffer,
+    // vertex and triangle offsets point into unified meshlet vertex index and triangle buffers
+    struct GPUMeshletTableEntry
+    {
+        glm::vec3 BoundingSphereCenter;
+        float BoundingSphereRadius;
+        // 16 byte boundary
+        glm::vec3 ConeApex;
+        float ConeCutoff;
+        // 16 byte boundary
+        glm::vec3 ConeAxis;
+        uint32_t VertexOffset;
+        // 16 byte boundary
+        uint32_t VertexCount;
+        uint32_t TriangleOffset;
+        uint32_t TriangleCount;
     };
 
     struct GPUMaterialTableEntry
@@ -61,6 +94,12 @@ namespace PathFinder
         // 16 byte boundary
         uint32_t LTC_LUT_Terms_Diffuse_Index;
         uint32_t LTC_LUT_TextureSize;
+        uint32_t AlbedoMapSlice;
+        uint32_t NormalMapSlice;
+        // 16 byte boundary
+        uint32_t RoughnessMapSlice;
+        uint32_t MetalnessMapSlice;
+        uint32_t AOMapSlice;
     };
 
     struct GPULightTableEntry
@@ -129,8 +168,52 @@ namespace PathFinder
         // 16 byte boundary
     };
 
+    // Instance that was occluded in an older Hi-Z and is tested again on GPU against the current one
+    struct GPUOcclusionCandidate
+    {
+        glm::vec3 BoundsMin;
+        uint32_t InstanceTableIndex;
+        // 16 byte boundary
+        glm::vec3 BoundsMax;
+        // Command of the candidate's batch, visible candidates are appended to its instance range
+        uint32_t DrawCommandIndex;
+    };
+
     using GPUInstanceIndex = uint64_t;
 
+    enum class TopRTASOperation
+    {
+        None, Refit, Rebuild
+    };
+
+    struct TopRTASBuildPolicy
+    {
+        // Refitted structures are rebuilt after this many consecutive refits
+        uint32_t MaxRefitsBetweenRebuilds = 64;
+
+        // Structures are rebuilt once the number of instances refitted since the last rebuild
+        // exceeds instance count multiplied by this ratio
+        float MaxRefittedInstanceRatio = 4.0f;
+    };
+
+    struct TopRTASBuildStatistics
+    {
+        TopRTASOperation LastOperation = TopRTASOperation::None;
+        uint64_t RebuildCount = 0;
+        uint64_t RefitCount = 0;
+        uint64_t SkipCount = 0;
+        uint32_t RefitsSinceRebuild = 0;
+        uint64_t RefittedInstancesSinceRebuild = 0;
+
+        // CPU time spent on producing instance descriptors in the last frame
+        std::chrono::microseconds InstanceDescriptorGenerationTime{ 0 };
+    };
+
+    inline HAL::RayTracingTopAccelerationStructure::InstanceInfo RTASInstanceInfoForEntity(EntityID id, EntityMask mask)
+    {
+        return { id, std::underlying_type_t<EntityMask>(mask) };
+    }
+
     class Scene;
 
     class SceneGPUStorage
@@ -142,15 +225,39 @@ namespace PathFinder
         void UploadMaterials();
         void UploadInstances();
 
+        /// Rewrites material table entries after material textures were replaced.
+        /// Instance and light tables are left alone as long as materials keep their table indices.
+        void UpdateMaterialTextures();
+
+        /// Batches mesh instances visible from the main camera and writes
+        /// an instanced draw command for every batch when batches change.
+        /// Instances occluded in an older Hi-Z are batched separately and uploaded as occlusion candidates
+        /// along with their batch commands, which GPU compacts down to candidates visible in this frame's Hi-Z.
+        /// Has to be called after instances are culled and uploaded.
+        void UploadMeshInstanceDrawCommands();
+
+        /// Picks up compacted sizes of recently built bottom acceleration structures.
+        /// Has to be called after a frame is rendered, when readback data is available.
+        void ReadbackBottomAccelerationStructureCompactedSizes();
+
         GPUCamera CameraGPURepresentation() const;
 
     private:
         template <class Vertex>
         struct UploadBufferPackage
         {
+            // CPU copies are retained so that unified buffers can be regrown when new meshes arrive
             std::vector<Vertex> Vertices;
             std::vector<uint32_t> Indices;
+
+            // Locations written since the last submission to GPU
             std::vector<VertexStorageLocation> Locations;
+
+            // Locations of geometry which acceleration structures are not built yet
+            std::deque<VertexStorageLocation> PendingBottomRTASBuilds;
+
+            uint64_t SubmittedVertexCount = 0;
+            uint64_t SubmittedIndexCount = 0;
         };
 
         template <class Vertex>
@@ -160,35 +267,143 @@ namespace PathFinder
             Memory::GPUResourceProducer::BufferPtr IndexBuffer;
         };
 
+        template <class Element>
+        struct GrowingBufferPackage
+        {
+            // CPU copy is retained so that the buffer can be regrown when new elements arrive
+            std::vector<Element> Elements;
+            Memory::GPUResourceProducer::BufferPtr Buffer;
+            uint64_t SubmittedElementCount = 0;
+        };
+
+        // Tracks what was last uploaded for an entity, so that unchanged entities can be skipped
+        struct EntityUploadState
+        {
+            uint64_t Version = 0;
+
+            // Instance was uploaded with differing current and previous transforms
+            // and needs to be uploaded once more for the previous transform to catch up
+            bool HasMotion = false;
+
+            bool IsEnabled = false;
+
+            // Level of detail of the mesh the entity was uploaded with
+            uint32_t LOD = 0;
+
+            // Version of the entity whose transform is in the top acceleration structure
+            uint64_t TopRTASVersion = 0;
+        };
+
         template <class Vertex>
         void SubmitTemporaryBuffersToGPU();
 
-        void UploadMeshInstances();
-        void UploadLights();
+        template <class Vertex>
+        bool BuildPendingBottomAccelerationStructures(UploadBufferPackage<Vertex>& package, uint64_t& builtPrimitiveCount);
+
+        // Returns true if any bottom structure changed its address and top structure needs a rebuild
+        bool ScheduleBottomAccelerationStructures(bool isLayoutChanged);
+        void ReleaseUnreferencedBottomAccelerationStructures();
+
+        // Writes every material to the table, returns true if any of them moved to another table index
+        bool WriteMaterialTable();
+
+        // Writes meshlets to CPU copies of unified meshlet buffers
+        void WriteMeshletsToTemporaryBuffers(const Mesh& mesh, VertexStorageLocation& location);
+
+        // Writes packed vertices, if the mesh has them, to CPU copy of unified packed vertex buffer
+        void WritePackedVerticesToTemporaryBuffers(const Mesh& mesh, VertexStorageLocation& location);
+
+        // Writes index buffers of mesh LODs to CPU copy of unified index buffer and records their locations in the mesh
+        void WriteLODsToTemporaryBuffers(Mesh& mesh);
+
+        // Uploads elements not yet on GPU, or everything if the buffer had to be regrown
+        template <class Element>
+        void SubmitGrowingBufferToGPU(GrowingBufferPackage<Element>& package, const std::string& debugName);
+
+        template <class TableEntry>
+        void WriteDirtyTableEntries(Memory::Buffer& table, const std::vector<TableEntry>& entries, const std::vector<uint32_t>& tableIndices);
+
+        void UploadMeshInstances(bool forceFullUpload);
+        void UploadLights(bool forceFullUpload);
+        void UpdateTopAccelerationStructure(bool isLayoutChanged);
+
+        // Returns true if any light was enabled or disabled since the last call
+        bool UpdateLightEnabledStates();
 
         EntityID GetNextEntityID();
 
         GPULightTableEntry CreateLightGPUTableEntry(const FlatLight& light) const;
         GPULightTableEntry CreateLightGPUTableEntry(const SphericalLight& light) const;
 
+        // Separates visible instances whose meshlets are culled on GPU, the rest is left for batching
+        void UploadClusteredInstances(const std::vector<uint32_t>& visibleInstances);
+        void UploadVisibleInstanceDrawCommands(const std::vector<uint32_t>& visibleInstances);
+        void UploadOcclusionCandidates(const std::vector<uint32_t>& occludedInstances);
+
         template <class Vertex>
         VertexStorageLocation WriteToTemporaryBuffers(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices = nullptr, uint32_t indexCount = 0);
 
         std::tuple<UploadBufferPackage<Vertex1P1N1UV1T1BT>, UploadBufferPackage<Vertex1P1N1UV>, UploadBufferPackage<Vertex1P3>> mUploadBuffers;
         std::tuple<FinalBufferPackage<Vertex1P1N1UV1T1BT>, FinalBufferPackage<Vertex1P1N1UV>, FinalBufferPackage<Vertex1P3>> mFinalBuffers;
 
+        // Packed vertices are used for rasterization only, acceleration structures and lights need full precision ones
+        GrowingBufferPackage<Vertex1P1N1UV1T1BTPacked> mPackedVertices;
+
+        GrowingBufferPackage<GPUMeshletTableEntry> mMeshletTable;
+        GrowingBufferPackage<uint32_t> mMeshletVertexIndices;
+        GrowingBufferPackage<uint32_t> mMeshletTriangles;
+        uint32_t mMaxMeshletTriangleCount = 0;
+
         std::vector<BottomRTAS> mBottomAccelerationStructures;
+        std::vector<const BottomRTAS*> mScheduledBottomRTASes;
+        std::vector<uint16_t> mBottomRTASesAwaitingCompactedSize;
+        std::vector<uint16_t> mBottomRTASesReadyForCompaction;
+        std::vector<uint16_t> mBottomRTASesBeingCompacted;
         TopRTAS mTopAccelerationStructure;
 
+        // Amount of triangles bottom structures are built for in a single frame
+        uint64_t mBottomRTASBuildBudget = 1000000;
+
         Memory::GPUResourceProducer::BufferPtr mMeshInstanceTable;
         Memory::GPUResourceProducer::BufferPtr mLightTable;
         Memory::GPUResourceProducer::BufferPtr mMaterialTable;
+        Memory::GPUResourceProducer::BufferPtr mMeshInstanceDrawCommandBuffer;
+        Memory::GPUResourceProducer::BufferPtr mMeshInstanceBatchListBuffer;
+        std::vector<GPUMeshInstanceDrawCommand> mMeshInstanceDrawCommands;
+        std::vector<uint32_t> mMeshInstanceBatchList;
+        MeshInstanceBatcher mMeshInstanceBatcher;
+
+        // Visible LOD 0 instances of meshes with meshlets, by instance table index, and visible instances of the rest
+        Memory::GPUResourceProducer::BufferPtr mClusteredInstanceBuffer;
+        std::vector<uint32_t> mClusteredInstances;
+        uint32_t mClusteredMeshletCount = 0;
+        std::vector<uint32_t> mBatchedVisibleInstances;
+
+        // Candidates are ordered as the batch list of their commands
+        Memory::GPUResourceProducer::BufferPtr mOcclusionCandidateBuffer;
+        Memory::GPUResourceProducer::BufferPtr mOcclusionCandidateDrawCommandBuffer;
+        std::vector<GPUOcclusionCandidate> mOcclusionCandidates;
+        std::vector<GPUMeshInstanceDrawCommand> mOcclusionCandidateDrawCommands;
+        std::vector<uint32_t> mOcclusionCandidateBatchList;
+        MeshInstanceBatcher mOcclusionCandidateBatcher;
 
         VertexStorageLocation mUnitQuadVertexLocation;
         VertexStorageLocation mUnitCubeVertexLocation;
         VertexStorageLocation mUnitSphereVertexLocation;
+        bool mArePrimitivesUploaded = false;
         GPULightTablePartitionInfo mLightTablePartitionInfo;
 
+        std::vector<EntityUploadState> mMeshInstanceUploadStates;
+        std::vector<EntityUploadState> mSphericalLightUploadStates;
+        std::vector<EntityUploadState> mFlatLightUploadStates;
+        std::vector<std::pair<const Light*, EntityUploadState*>> mLightsInTableOrder;
+
+        TopRTASBuildPolicy mTopRTASBuildPolicy;
+        TopRTASBuildStatistics mTopRTASStatistics;
+
+        // Scene layout version GPU tables were built for. Empty when tables need a full rebuild.
+        std::optional<uint64_t> mUploadedSceneLayoutVersion;
+
         Scene* mScene;
         const HAL::Device* mDevice;
         Memory::GPUResourceProducer* mResourceProducer;
@@ -198,12 +413,35 @@ namespace PathFinder
     public:
         inline const auto UnifiedVertexBuffer() const { return std::get<FinalBufferPackage<Vertex1P1N1UV1T1BT>>(mFinalBuffers).VertexBuffer.get(); }
         inline const auto UnifiedIndexBuffer() const { return std::get<FinalBufferPackage<Vertex1P1N1UV1T1BT>>(mFinalBuffers).IndexBuffer.get(); }
+        inline const auto UnifiedPackedVertexBuffer() const { return mPackedVertices.Buffer.get(); }
         inline const auto MeshInstanceTable() const { return mMeshInstanceTable.get(); }
+        inline const auto MeshletTable() const { return mMeshletTable.Buffer.get(); }
+        inline const auto MeshletVertexIndexBuffer() const { return mMeshletVertexIndices.Buffer.get(); }
+        inline const auto MeshletTriangleBuffer() const { return mMeshletTriangles.Buffer.get(); }
+        inline auto MaxMeshletTriangleCount() const { return mMaxMeshletTriangleCount; }
         inline const auto LightTable() const { return mLightTable.get(); }
         inline const auto MaterialTable() const { return mMaterialTable.get(); }
+        inline const auto MeshInstanceDrawCommandBuffer() const { return mMeshInstanceDrawCommandBuffer.get(); }
+        inline const auto MeshInstanceBatchListBuffer() const { return mMeshInstanceBatchListBuffer.get(); }
+        inline auto MeshInstanceDrawCommandCount() const { return (uint32_t)mMeshInstanceDrawCommands.size(); }
+        inline const auto& MeshInstanceBatchingStatistics() const { return mMeshInstanceBatcher.GetStatistics(); }
+        inline const auto ClusteredInstanceBuffer() const { return mClusteredInstanceBuffer.get(); }
+        inline auto ClusteredInstanceCount() const { return (uint32_t)mClusteredInstances.size(); }
+        inline auto ClusteredMeshletCount() const { return mClusteredMeshletCount; }
+        inline const auto OcclusionCandidateBuffer() const { return mOcclusionCandidateBuffer.get(); }
+        inline const auto OcclusionCandidateDrawCommandBuffer() const { return mOcclusionCandidateDrawCommandBuffer.get(); }
+        inline auto OcclusionCandidateCount() const { return (uint32_t)mOcclusionCandidates.size(); }
+        inline auto OcclusionCandidateDrawCommandCount() const { return (uint32_t)mOcclusionCandidateDrawCommands.size(); }
         inline const auto& LightTablePartitionInfo() const { return mLightTablePartitionInfo; }
         inline const auto& TopAccelerationStructure() const { return mTopAccelerationStructure; }
         inline const auto& BottomAccelerationStructures() const { return mBottomAccelerationStructures; }
+        inline const auto& ScheduledBottomAccelerationStructures() const { return mScheduledBottomRTASes; }
+        inline auto BottomAccelerationStructureBuildBudget() const { return mBottomRTASBuildBudget; }
+        inline const auto& TopAccelerationStructureStatistics() const { return mTopRTASStatistics; }
+        inline const auto& TopAccelerationStructureBuildPolicy() const { return mTopRTASBuildPolicy; }
+
+        inline void SetTopAccelerationStructureBuildPolicy(const TopRTASBuildPolicy& policy) { mTopRTASBuildPolicy = policy; }
+        inline void SetBottomAccelerationStructureBuildBudget(uint64_t primitiveCount) { mBottomRTASBuildBudget = primitiveCount; }
     };
 
 }
@@ -31,27 +31,46 @@ namespace PathFinder
         auto& uploadBuffers = std::get<UploadBufferPackage<Vertex>>(mUploadBuffers);
         auto& finalBuffers = std::get<FinalBufferPackage<Vertex>>(mFinalBuffers);
 
-        if (!uploadBuffers.Vertices.empty())
+        if (uploadBuffers.Locations.empty()) return;
+
+        bool areBuffersReallocated = false;
+
+        if (!finalBuffers.VertexBuffer || finalBuffers.VertexBuffer->Capacity<Vertex>() < uploadBuffers.Vertices.size())
         {
             auto properties = HAL::BufferProperties::Create<Vertex>(uploadBuffers.Vertices.size());
             finalBuffers.VertexBuffer = mResourceProducer->NewBuffer(properties);
-            finalBuffers.VertexBuffer->RequestWrite();
-            finalBuffers.VertexBuffer->Write(uploadBuffers.Vertices.data(), 0, uploadBuffers.Vertices.size());
             finalBuffers.VertexBuffer->SetDebugName("Unified Vertex Buffer");
-            uploadBuffers.Vertices.clear();
+            uploadBuffers.SubmittedVertexCount = 0;
+            areBuffersReallocated = true;
         }
 
-        if (!uploadBuffers.Indices.empty())
+        if (!uploadBuffers.Indices.empty() && (!finalBuffers.IndexBuffer || finalBuffers.IndexBuffer->Capacity<uint32_t>() < uploadBuffers.Indices.size()))
         {
             auto properties = HAL::BufferProperties::Create<uint32_t>(uploadBuffers.Indices.size());
             finalBuffers.IndexBuffer = mResourceProducer->NewBuffer(properties);
-            finalBuffers.IndexBuffer->RequestWrite();
-            finalBuffers.IndexBuffer->Write(uploadBuffers.Indices.data(), 0, uploadBuffers.Indices.size());
             finalBuffers.IndexBuffer->SetDebugName("Unified Index Buffer");
-            uploadBuffers.Indices.clear();
+            uploadBuffers.SubmittedIndexCount = 0;
+            areBuffersReallocated = true;
         }
 
-        for (const VertexStorageLocation& location : uploadBuffers.Locations)
+        // Only geometry that is not on GPU yet is uploaded, unless buffers were just reallocated
+        if (uploadBuffers.SubmittedVertexCount < uploadBuffers.Vertices.size())
+        {
+            uint64_t newVertexCount = uploadBuffers.Vertices.size() - uploadBuffers.SubmittedVertexCount;
+            finalBuffers.VertexBuffer->RequestWrite();
+            finalBuffers.VertexBuffer->Write(uploadBuffers.Vertices.data() + uploadBuffers.SubmittedVertexCount, uploadBuffers.SubmittedVertexCount, newVertexCount);
+            uploadBuffers.SubmittedVertexCount = uploadBuffers.Vertices.size();
+        }
+
+        if (uploadBuffers.SubmittedIndexCount < uploadBuffers.Indices.size())
+        {
+            uint64_t newIndexCount = uploadBuffers.Indices.size() - uploadBuffers.SubmittedIndexCount;
+            finalBuffers.IndexBuffer->RequestWrite();
+            finalBuffers.IndexBuffer->Write(uploadBuffers.Indices.data() + uploadBuffers.SubmittedIndexCount, uploadBuffers.SubmittedIndexCount, newIndexCount);
+            uploadBuffers.SubmittedIndexCount = uploadBuffers.Indices.size();
+        }
+
+        auto setGeometry = [&](const VertexStorageLocation& location)
         {
             BottomRTAS& blas = mBottomAccelerationStructures[location.BottomAccelerationStructureIndex];
 
@@ -61,12 +80,104 @@ namespace PathFinder
                 glm::mat4x4{}, true
             };
 
+            blas.Clear();
             blas.AddGeometry(blasGeometry);
-            blas.Build();
+        };
+
+        // Structures still waiting for a build reference buffers that were just replaced
+        if (areBuffersReallocated)
+        {
+            for (const VertexStorageLocation& location : uploadBuffers.PendingBottomRTASBuilds)
+            {
+                setGeometry(location);
+            }
+        }
+
+        // Builds are deferred and spread across frames by ScheduleBottomAccelerationStructures()
+        for (const VertexStorageLocation& location : uploadBuffers.Locations)
+        {
+            setGeometry(location);
+            uploadBuffers.PendingBottomRTASBuilds.push_back(location);
         }
 
         uploadBuffers.Locations.clear();
     }
 
+    template <class Vertex>
+    bool SceneGPUStorage::BuildPendingBottomAccelerationStructures(UploadBufferPackage<Vertex>& package, uint64_t& builtPrimitiveCount)
+    {
+        bool isAnyStructureBuilt = false;
+
+        while (!package.PendingBottomRTASBuilds.empty())
+        {
+            const VertexStorageLocation& location = package.PendingBottomRTASBuilds.front();
+            uint64_t primitiveCount = location.IndexCount / 3;
+
+            // At least one structure is built every frame, so that meshes exceeding the budget still get their turn
+            if (builtPrimitiveCount > 0 && builtPrimitiveCount + primitiveCount > mBottomRTASBuildBudget)
+            {
+                break;
+            }
+
+            BottomRTAS& blas = mBottomAccelerationStructures[location.BottomAccelerationStructureIndex];
+            blas.Build();
+
+            mScheduledBottomRTASes.push_back(&blas);
+            mBottomRTASesAwaitingCompactedSize.push_back(location.BottomAccelerationStructureIndex);
+
+            builtPrimitiveCount += primitiveCount;
+            isAnyStructureBuilt = true;
+
+            package.PendingBottomRTASBuilds.pop_front();
+        }
+
+        return isAnyStructureBuilt;
+    }
+
+    template <class Element>
+    void SceneGPUStorage::SubmitGrowingBufferToGPU(GrowingBufferPackage<Element>& package, const std::string& debugName)
+    {
+        if (package.Elements.empty()) return;
+
+        if (!package.Buffer || package.Buffer->Capacity<Element>() < package.Elements.size())
+        {
+            auto properties = HAL::BufferProperties::Create<Element>(package.Elements.size());
+            package.Buffer = mResourceProducer->NewBuffer(properties);
+            package.Buffer->SetDebugName(debugName);
+            package.SubmittedElementCount = 0;
+        }
+
+        if (package.SubmittedElementCount < package.Elements.size())
+        {
+            uint64_t newElementCount = package.Elements.size() - package.SubmittedElementCount;
+            package.Buffer->RequestWrite();
+            package.Buffer->Write(package.Elements.data() + package.SubmittedElementCount, package.SubmittedElementCount, newElementCount);
+            package.SubmittedElementCount = package.Elements.size();
+        }
+    }
+
+    template <class TableEntry>
+    void SceneGPUStorage::WriteDirtyTableEntries(Memory::Buffer& table, const std::vector<TableEntry>& entries, const std::vector<uint32_t>& tableIndices)
+    {
+        if (entries.empty()) return;
+
+        table.RequestWrite();
+
+        // Indices are expected to be in ascending order,
+        // so every run of adjacent table entries is written with a single copy
+        uint64_t runStart = 0;
+
+        for (uint64_t idx = 1; idx <= tableIndices.size(); ++idx)
+        {
+            bool isRunEnd = idx == tableIndices.size() || tableIndices[idx] != tableIndices[idx - 1] + 1;
+
+            if (isRunEnd)
+            {
+                table.Write(&entries[runStart], tableIndices[runStart], idx - runStart);
+                runStart = idx;
+            }
+        }
+    }
+
 }
 
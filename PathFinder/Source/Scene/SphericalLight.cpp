@@ -9,6 +9,7 @@ namespace PathFinder
     {
         mPosition = position;
         mModelMatrix[3] = glm::vec4{ position, 1.0f };
+        ++mVersion;
     }
 
     void SphericalLight::SetRadius(float radius)
@@ -17,6 +18,7 @@ namespace PathFinder
         mModelMatrix[0][0] = radius;
         mModelMatrix[1][1] = radius;
         mModelMatrix[2][2] = radius;
+        ++mVersion;
         UpdateArea();
     }
 
@@ -3,6 +3,7 @@
 #include "Light.hpp"
 
 #include <glm/vec3.hpp>
+#include <Foundation/SlotMap.hpp>
 
 namespace PathFinder
 {
@@ -26,4 +27,6 @@ namespace PathFinder
         inline const auto& Radius() const { return mRadius; }
     };
 
+    using SphericalLightHandle = Foundation::SlotMapHandle<SphericalLight>;
+
 }
\ No newline at end of file
@@ -0,0 +1,325 @@
+#include "TextureCooker.hpp"
+#include "DDSFileHeader.hpp"
+
+#include <Foundation/FileWriting.hpp>
+
+#include <robinhood/robin_hood.h>
+
+#include <sstream>
+#include <iomanip>
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+        uint32_t DXGIFormat(BlockCompressor::Format format)
+        {
+            switch (format)
+            {
+            case BlockCompressor::Format::BC1: return 71; // DXGI_FORMAT_BC1_UNORM
+            case BlockCompressor::Format::BC4: return 80; // DXGI_FORMAT_BC4_UNORM
+            case BlockCompressor::Format::BC5: return 83; // DXGI_FORMAT_BC5_UNORM
+            case BlockCompressor::Format::BC7: return 98; // DXGI_FORMAT_BC7_UNORM
+            default: return 0;
+            }
+        }
+
+        const std::array<float, 256>& SRGBToLinearTable()
+        {
+            static const std::array<float, 256> table = []
+            {
+                std::array<float, 256> values{};
+
+                for (uint32_t value = 0; value < 256; ++value)
+                {
+                    float color = value / 255.0f;
+                    values[value] = color <= 0.04045f ? color / 12.92f : std::pow((color + 0.055f) / 1.055f, 2.4f);
+                }
+
+                return values;
+            }();
+
+            return table;
+        }
+
+        uint8_t LinearToSRGB(float color)
+        {
+            color = std::clamp(color, 0.0f, 1.0f);
+            float encoded = color <= 0.0031308f ? color * 12.92f : 1.055f * std::pow(color, 1.0f / 2.4f) - 0.055f;
+            return uint8_t(std::lround(encoded * 255.0f));
+        }
+    }
+
+    TextureCooker::TextureCooker(const std::filesystem::path& rootPath, const std::string& cacheFolder)
+        : mRootPath{ rootPath }, mCacheFolder{ cacheFolder } {}
+
+    std::optional<std::string> TextureCooker::Cook(const std::string& relativeFilePath, Usage usage)
+    {
+        std::filesystem::path sourcePath = mRootPath;
+        sourcePath += relativeFilePath;
+
+        Foundation::MemoryMappedFile sourceFile{ sourcePath };
+        ddsktx_texture_info textureInfo{};
+        ddsktx_error error;
+
+        bool isParsed = sourceFile.IsOpen() && ddsktx_parse(&textureInfo, sourceFile.Data(), (int)sourceFile.Size(), &error);
+
+        // Block compressed textures must start with a block aligned mip. 
+        // Volumes, arrays and cubes are rare among material textures and are left as they are.
+        bool isCookable = isParsed &&
+            !ddsktx_format_compressed(textureInfo.format) &&
+            textureInfo.depth == 1 &&
+            textureInfo.num_layers == 1 &&
+            !(textureInfo.flags & DDSKTX_TEXTURE_FLAG_CUBEMAP) &&
+            textureInfo.width % 4 == 0 &&
+            textureInfo.height % 4 == 0;
+
+        if (!isCookable)
+        {
+            std::lock_guard lock{ mStatisticsMutex };
+            ++mStatistics.SkippedTextureCount;
+            return std::nullopt;
+        }
+
+        uint64_t sourceHash = robin_hood::hash_bytes(sourceFile.Data(), sourceFile.Size());
+
+        // A file per source contents and settings combination
+        std::stringstream fileName;
+        fileName << sourcePath.stem().string() << "." << std::hex << std::setfill('0') 
+            << std::setw(16) << sourceHash << "." << std::setw(16) << SettingsHash(usage) << ".dds";
+
+        std::string cookedRelativePath = mCacheFolder + "/" + fileName.str();
+        std::filesystem::path cookedPath = mRootPath;
+        cookedPath += cookedRelativePath;
+
+        std::error_code existenceError;
+
+        if (std::filesystem::exists(cookedPath, existenceError))
+        {
+            std::lock_guard lock{ mStatisticsMutex };
+            ++mStatistics.CacheHitCount;
+            return cookedRelativePath;
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        std::optional<Image> image = DecodeSource(textureInfo, sourceFile);
+
+        if (!image)
+        {
+            std::lock_guard lock{ mStatisticsMutex };
+            ++mStatistics.SkippedTextureCount;
+            return std::nullopt;
+        }
+
+        BlockCompressor::Format format = FormatForUsage(usage);
+        uint32_t width = image->Width;
+        uint32_t height = image->Height;
+
+        // Source mips are regenerated, since they're rarely filtered with respect to usage
+        std::vector<std::vector<uint8_t>> mips;
+        uint64_t cookedBytes = 0;
+
+        while (true)
+        {
+            mips.push_back(BlockCompressor::Compress(image->Texels.data(), image->Width, image->Height, format));
+            cookedBytes += mips.back().size();
+
+            if (image->Width == 1 && image->Height == 1) break;
+
+            image = Downsample(*image, usage);
+        }
+
+        // Failing to write a cooked file is not an error, the source is loaded instead
+        if (!WriteDDS(cookedPath, width, height, format, mips))
+        {
+            std::lock_guard lock{ mStatisticsMutex };
+            ++mStatistics.SkippedTextureCount;
+            return std::nullopt;
+        }
+
+        std::lock_guard lock{ mStatisticsMutex };
+
+        mStatistics.CookedTextureCount += 1;
+        mStatistics.SourceBytes += sourceFile.Size();
+        mStatistics.CookedBytes += cookedBytes;
+        mStatistics.CookTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+        return cookedRelativePath;
+    }
+
+    std::optional<TextureCooker::Image> TextureCooker::DecodeSource(const ddsktx_texture_info& textureInfo, const Foundation::MemoryMappedFile& file)
+    {
+        ddsktx_sub_data subData;
+        ddsktx_get_sub(&textureInfo, &subData, file.Data(), (int)file.Size(), 0, 0, 0);
+
+        Image image{ (uint32_t)textureInfo.width, (uint32_t)textureInfo.height };
+        image.Texels.resize(uint64_t(image.Width) * image.Height * 4);
+
+        for (uint32_t y = 0; y < image.Height; ++y)
+        {
+            const uint8_t* sourceRow = reinterpret_cast<const uint8_t*>(subData.buff) + uint64_t(y) * subData.row_pitch_bytes;
+            uint8_t* row = image.Texels.data() + uint64_t(y) * image.Width * 4;
+
+            for (uint32_t x = 0; x < image.Width; ++x)
+            {
+                uint8_t* texel = row + x * 4;
+
+                switch (textureInfo.format)
+                {
+                case DDSKTX_FORMAT_RGBA8: 
+                    std::memcpy(texel, sourceRow + x * 4, 4); 
+                    break;
+
+                case DDSKTX_FORMAT_BGRA8:
+                    texel[0] = sourceRow[x * 4 + 2];
+                    texel[1] = sourceRow[x * 4 + 1];
+                    texel[2] = sourceRow[x * 4 + 0];
+                    texel[3] = sourceRow[x * 4 + 3];
+                    break;
+
+                case DDSKTX_FORMAT_RG8:
+                    texel[0] = sourceRow[x * 2 + 0];
+                    texel[1] = sourceRow[x * 2 + 1];
+                    texel[2] = 0;
+                    texel[3] = 255;
+                    break;
+
+                case DDSKTX_FORMAT_R8:
+                    texel[0] = texel[1] = texel[2] = sourceRow[x];
+                    texel[3] = 255;
+                    break;
+
+                default:
+                    return std::nullopt;
+                }
+            }
+        }
+
+        return image;
+    }
+
+    TextureCooker::Image TextureCooker::Downsample(const Image& image, Usage usage)
+    {
+        Image result{ std::max(image.Width / 2, 1u), std::max(image.Height / 2, 1u) };
+        result.Texels.resize(uint64_t(result.Width) * result.Height * 4);
+
+        const std::array<float, 256>& toLinear = SRGBToLinearTable();
+
+        for (uint32_t y = 0; y < result.Height; ++y)
+        {
+            for (uint32_t x = 0; x < result.Width; ++x)
+            {
+                const uint8_t* sources[4];
+
+                for (uint32_t sample = 0; sample < 4; ++sample)
+                {
+                    uint32_t sourceX = std::min(x * 2 + (sample & 1), image.Width - 1);
+                    uint32_t sourceY = std::min(y * 2 + (sample >> 1), image.Height - 1);
+                    sources[sample] = image.Texels.data() + (uint64_t(sourceY) * image.Width + sourceX) * 4;
+                }
+
+                uint8_t* texel = result.Texels.data() + (uint64_t(y) * result.Width + x) * 4;
+                float sums[4]{};
+
+                for (const uint8_t* source : sources)
+                {
+                    for (uint32_t channel = 0; channel < 4; ++channel)
+                    {
+                        bool isSRGB = usage == Usage::Albedo && channel < 3;
+                        bool isVector = usage == Usage::Normal && channel < 3;
+
+                        sums[channel] += isSRGB ? toLinear[source[channel]] : (isVector ? source[channel] / 127.5f - 1.0f : float(source[channel]));
+                    }
+                }
+
+                if (usage == Usage::Normal)
+                {
+                    float length = std::sqrt(sums[0] * sums[0] + sums[1] * sums[1] + sums[2] * sums[2]);
+
+                    // Opposite normals cancel out, a flat one is the best guess then
+                    if (length < 1e-6f) { sums[0] = 0.0f; sums[1] = 0.0f; sums[2] = 1.0f; length = 1.0f; }
+
+                    for (uint32_t channel = 0; channel < 3; ++channel)
+                    {
+                        texel[channel] = uint8_t(std::lround(std::clamp((sums[channel] / length + 1.0f) * 127.5f, 0.0f, 255.0f)));
+                    }
+                }
+                else if (usage == Usage::Albedo)
+                {
+                    for (uint32_t channel = 0; channel < 3; ++channel)
+                    {
+                        texel[channel] = LinearToSRGB(sums[channel] * 0.25f);
+                    }
+                }
+                else
+                {
+                    for (uint32_t channel = 0; channel < 3; ++channel)
+                    {
+                        texel[channel] = uint8_t(std::lround(sums[channel] * 0.25f));
+                    }
+                }
+
+                texel[3] = uint8_t(std::lround(sums[3] * 0.25f));
+            }
+        }
+
+        return result;
+    }
+
+    bool TextureCooker::WriteDDS(const std::filesystem::path& destination, uint32_t width, uint32_t height, BlockCompressor::Format format, const std::vector<std::vector<uint8_t>>& mips)
+    {
+        DDSFileHeader header;
+        std::memset(&header, 0, sizeof(DDSFileHeader));
+
+        header.Magic = DDSMagic;
+        header.Size = DDSHeaderSize;
+        header.Flags = DDSDCaps | DDSDHeight | DDSDWidth | DDSDPixelFormat | DDSDMipCount | DDSDLinearSize;
+        header.Height = height;
+        header.Width = width;
+        header.LinearSize = (uint32_t)mips.front().size();
+        header.Depth = 1;
+        header.MipCount = (uint32_t)mips.size();
+        header.PixelFormatSize = 32;
+        header.PixelFormatFlags = DDPFFourCC;
+        header.FourCC = DX10FourCC;
+        header.Caps[0] = DDSCapsTexture | DDSCapsComplex | DDSCapsMipMap;
+        header.DXGIFormat = DXGIFormat(format);
+        header.ResourceDimension = D3D10ResourceDimensionTexture2D;
+        header.ArraySize = 1;
+
+        return Foundation::WriteFileAtomically(destination, [&header, &mips](std::ostream& stream)
+        {
+            stream.write(reinterpret_cast<const char*>(&header), sizeof(DDSFileHeader));
+
+            for (const std::vector<uint8_t>& mip : mips)
+            {
+                stream.write(reinterpret_cast<const char*>(mip.data()), mip.size());
+            }
+        });
+    }
+
+    BlockCompressor::Format TextureCooker::FormatForUsage(Usage usage) const
+    {
+        switch (usage)
+        {
+        case Usage::Albedo: return mSettings.AlbedoFormat;
+        case Usage::Normal: return BlockCompressor::Format::BC5;
+        case Usage::Scalar: return BlockCompressor::Format::BC4;
+        case Usage::Mask: 
+        default: return BlockCompressor::Format::BC1;
+        }
+    }
+
+    uint64_t TextureCooker::SettingsHash(Usage usage) const
+    {
+        uint32_t values[3] = { CookerVersion, uint32_t(usage), uint32_t(FormatForUsage(usage)) };
+        return robin_hood::hash_bytes(values, sizeof(values));
+    }
+
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "BlockCompressor.hpp"
+
+#include <Foundation/MemoryMappedFile.hpp>
+#include <ThirdParty/dds/dds-ktx.h>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Converts uncompressed material textures into block compressed DDS files with full mip chains.
+    /// Cooked files are named after hashes of source contents and cooking settings,
+    /// so sources are cooked once and every later request is served from the cache.
+    class TextureCooker
+    {
+    public:
+        // Decides block format and how mips are filtered
+        enum class Usage
+        {
+            // sRGB color, mips are averaged in linear space. BC7.
+            Albedo,
+
+            // Tangent space normals, mips are renormalized. BC5, so that shaders reconstruct Z.
+            Normal,
+
+            // Roughness, metalness, AO and other single channel maps stored in red. BC4.
+            Scalar,
+
+            // Multi-channel masks without alpha. BC1.
+            Mask
+        };
+
+        struct Settings
+        {
+            // BC1 halves memory of albedo maps at cost of quality and alpha
+            BlockCompressor::Format AlbedoFormat = BlockCompressor::Format::BC7;
+        };
+
+        struct Statistics
+        {
+            uint32_t CookedTextureCount = 0;
+            uint32_t CacheHitCount = 0;
+
+            // Already compressed, unreadable or of unsupported format or size
+            uint32_t SkippedTextureCount = 0;
+
+            // Of cooked textures only
+            uint64_t SourceBytes = 0;
+            uint64_t CookedBytes = 0;
+            std::chrono::microseconds CookTime{ 0 };
+        };
+
+        /// Cooked files are stored in 'cacheFolder', a path relative to the root the same way texture paths are
+        TextureCooker(const std::filesystem::path& rootPath, const std::string& cacheFolder);
+
+        /// Returns root relative path of the cooked texture, cooking it first if the cache has no up-to-date version.
+        /// Returns nothing for textures that are meant to be loaded as they are.
+        /// Safe to call from several threads at once.
+        std::optional<std::string> Cook(const std::string& relativeFilePath, Usage usage);
+
+    private:
+        // Incremented on every change of encoders or filtering that affects cooked files
+        inline static const uint32_t CookerVersion = 1;
+
+        struct Image
+        {
+            uint32_t Width = 0;
+            uint32_t Height = 0;
+
+            // RGBA8
+            std::vector<uint8_t> Texels;
+        };
+
+        // Expands the most detailed mip of the source to RGBA8. Returns nothing for unsupported formats.
+        static std::optional<Image> DecodeSource(const ddsktx_texture_info& textureInfo, const Foundation::MemoryMappedFile& file);
+
+        // Halves both dimensions with a box filter, odd edges repeat their last texels
+        static Image Downsample(const Image& image, Usage usage);
+
+        static bool WriteDDS(const std::filesystem::path& destination, uint32_t width, uint32_t height, BlockCompressor::Format format, const std::vector<std::vector<uint8_t>>& mips);
+
+        BlockCompressor::Format FormatForUsage(Usage usage) const;
+        uint64_t SettingsHash(Usage usage) const;
+
+        std::filesystem::path mRootPath;
+        std::string mCacheFolder;
+        Settings mSettings;
+        Statistics mStatistics;
+        std::mutex mStatisticsMutex;
+
+    public:
+        inline const auto& GetSettings() const { return mSettings; }
+        inline const auto& GetStatistics() const { return mStatistics; }
+
+        inline void SetSettings(const Settings& settings) { mSettings = settings; }
+    };
+
+}
@@ -0,0 +1,280 @@
+#include "TextureStreamer.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace PathFinder
+{
+
+    TextureStreamer::TextureStreamer(ResourceLoader* resourceLoader)
+        : mResourceLoader{ resourceLoader }
+    {
+        mPlanner.SetSettings(mSettings.Planner);
+    }
+
+    TextureStreamer::~TextureStreamer()
+    {
+        // Background reads refer to mapped files, which have to outlive them
+        for (StreamedTexture& texture : mTextures)
+        {
+            if (texture.PendingRead.valid()) texture.PendingRead.wait();
+        }
+    }
+
+    Memory::Texture* TextureStreamer::LoadTexture(const std::string& relativeFilePath)
+    {
+        auto pathIt = mPathIndices.find(relativeFilePath);
+
+        if (pathIt != mPathIndices.end())
+        {
+            return mTextures[pathIt->second].Texture.get();
+        }
+
+        std::optional<ResourceLoader::MappedTexture> file = mResourceLoader->MapTexture(relativeFilePath);
+
+        if (!file)
+        {
+            return nullptr;
+        }
+
+        return LoadTexture(relativeFilePath, std::move(*file));
+    }
+
+    Memory::Texture* TextureStreamer::LoadTexture(const std::string& relativeFilePath, ResourceLoader::MappedTexture&& file)
+    {
+        auto pathIt = mPathIndices.find(relativeFilePath);
+
+        if (pathIt != mPathIndices.end())
+        {
+            return mTextures[pathIt->second].Texture.get();
+        }
+
+        TextureStreamingPlanner::Texture residency{};
+        residency.Size = std::max(file.Info.width, file.Info.height);
+        residency.MipTailFirstMip = MipTailFirstMip(file.Info);
+        residency.ResidentMip = residency.MipTailFirstMip;
+
+        for (int mip = 0; mip < file.Info.num_mips; ++mip)
+        {
+            residency.MipSizes.push_back(ResourceLoader::MipSizeInBytes(file, mip));
+        }
+
+        uint32_t textureIdx = (uint32_t)mTextures.size();
+
+        StreamedTexture& texture = mTextures.emplace_back();
+        texture.File = std::make_shared<const ResourceLoader::MappedTexture>(std::move(file));
+        texture.Texture = mResourceLoader->CreateTexture(*texture.File, residency.MipTailFirstMip);
+
+        mResidencies.push_back(std::move(residency));
+        mPathIndices.emplace(relativeFilePath, textureIdx);
+        mTextureIndices.emplace(texture.Texture.get(), textureIdx);
+
+        return texture.Texture.get();
+    }
+
+    void TextureStreamer::PrefetchMipTail(const ResourceLoader::MappedTexture& file) const
+    {
+        ResourceLoader::Prefetch(file, MipTailFirstMip(file.Info));
+    }
+
+    void TextureStreamer::Release(const std::string& relativeFilePath)
+    {
+        auto pathIt = mPathIndices.find(relativeFilePath);
+
+        if (pathIt == mPathIndices.end()) return;
+
+        uint32_t textureIdx = pathIt->second;
+        uint32_t lastTextureIdx = (uint32_t)mTextures.size() - 1;
+
+        mPathIndices.erase(pathIt);
+        mTextureIndices.erase(mTextures[textureIdx].Texture.get());
+
+        if (mTextures[textureIdx].PendingRead.valid()) mTextures[textureIdx].PendingRead.wait();
+
+        // Materials may still reference the texture until they're patched
+        mReplacedTextures.emplace_back(std::move(mTextures[textureIdx].Texture));
+
+        // Last texture takes place of the released one
+        if (textureIdx != lastTextureIdx)
+        {
+            mTextures[textureIdx] = std::move(mTextures[lastTextureIdx]);
+            mResidencies[textureIdx] = std::move(mResidencies[lastTextureIdx]);
+            mTextureIndices[mTextures[textureIdx].Texture.get()] = textureIdx;
+
+            for (auto& [path, index] : mPathIndices)
+            {
+                if (index == lastTextureIdx) { index = textureIdx; break; }
+            }
+        }
+
+        mTextures.pop_back();
+        mResidencies.pop_back();
+    }
+
+    void TextureStreamer::ReportUsage(const Memory::Texture* texture, float projectedSize)
+    {
+        auto textureIt = mTextureIndices.find(texture);
+
+        if (textureIt == mTextureIndices.end()) return;
+
+        float& usage = mResidencies[textureIt->second].ProjectedSize;
+        usage = std::max(usage, projectedSize);
+    }
+
+    const std::vector<TextureStreamer::TextureReplacement>& TextureStreamer::Update()
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        // Users had a chance to apply replacements of the previous update
+        mReplacedTextures.clear();
+        mReplacements.clear();
+
+        mPlannedMips = mPlanner.Plan(mResidencies);
+
+        const TextureStreamingPlanner::Statistics& planStatistics = mPlanner.GetStatistics();
+
+        mStatistics.UpgradeCount = 0;
+        mStatistics.EvictionCount = 0;
+        mStatistics.RecreatedBytes = 0;
+        mStatistics.IsBudgetLimited = planStatistics.IsBudgetLimited;
+        mStatistics.PendingReadCount = 0;
+
+        for (uint32_t textureIdx = 0; textureIdx < mTextures.size(); ++textureIdx)
+        {
+            StreamedTexture& texture = mTextures[textureIdx];
+            uint32_t plannedMip = mPlannedMips[textureIdx];
+            uint32_t residentMip = mResidencies[textureIdx].ResidentMip;
+
+            if (texture.PendingRead.valid())
+            {
+                // Plan might have changed while mips were read in, only as much as it still affords is taken
+                uint32_t readMip = std::max(*texture.PendingMip, plannedMip);
+
+                // Complete reads that don't fit the budget stay pending and are applied by later updates
+                if (texture.PendingRead.wait_for(std::chrono::seconds{ 0 }) != std::future_status::ready ||
+                    (readMip < residentMip && !CanRecreate(textureIdx, readMip)))
+                {
+                    ++mStatistics.PendingReadCount;
+                    continue;
+                }
+
+                texture.PendingRead.get();
+                texture.PendingMip = std::nullopt;
+
+                if (readMip < residentMip)
+                {
+                    Recreate(textureIdx, readMip);
+                    ++mStatistics.UpgradeCount;
+                    continue;
+                }
+            }
+
+            // Coarser mips are already in memory, so evictions take effect as soon as the budget allows
+            if (plannedMip > residentMip && CanRecreate(textureIdx, plannedMip))
+            {
+                Recreate(textureIdx, plannedMip);
+                ++mStatistics.EvictionCount;
+            }
+        }
+
+        // Reads are started for textures that are the most visible on screen first
+        std::vector<uint32_t> readOrder;
+
+        for (uint32_t textureIdx = 0; textureIdx < mTextures.size(); ++textureIdx)
+        {
+            if (!mTextures[textureIdx].PendingRead.valid() && mPlannedMips[textureIdx] < mResidencies[textureIdx].ResidentMip)
+            {
+                readOrder.push_back(textureIdx);
+            }
+        }
+
+        std::stable_sort(readOrder.begin(), readOrder.end(), [this](uint32_t first, uint32_t second)
+        {
+            return mResidencies[first].ProjectedSize > mResidencies[second].ProjectedSize;
+        });
+
+        for (uint32_t textureIdx : readOrder)
+        {
+            if (mStatistics.PendingReadCount >= mSettings.MaxPendingReadCount) break;
+
+            StreamedTexture& texture = mTextures[textureIdx];
+            uint32_t mip = mPlannedMips[textureIdx];
+
+            texture.PendingMip = mip;
+            texture.PendingRead = std::async(std::launch::async, [file = texture.File, mip]
+            {
+                ResourceLoader::Prefetch(*file, mip);
+            });
+
+            ++mStatistics.PendingReadCount;
+        }
+
+        mStatistics.TextureCount = (uint32_t)mTextures.size();
+        mStatistics.ResidentBytes = 0;
+
+        for (TextureStreamingPlanner::Texture& residency : mResidencies)
+        {
+            mStatistics.ResidentBytes += std::accumulate(residency.MipSizes.begin() + residency.ResidentMip, residency.MipSizes.end(), uint64_t(0));
+
+            // Usage is reported anew every frame
+            residency.ProjectedSize = 0.0f;
+        }
+
+        mStatistics.UpdateTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+        return mReplacements;
+    }
+
+    void TextureStreamer::Recreate(uint32_t textureIdx, uint32_t mostDetailedMip)
+    {
+        StreamedTexture& texture = mTextures[textureIdx];
+
+        Memory::GPUResourceProducer::TexturePtr newTexture = mResourceLoader->CreateTexture(*texture.File, mostDetailedMip);
+
+        mReplacements.push_back({ texture.Texture.get(), newTexture.get() });
+        mTextureIndices.erase(texture.Texture.get());
+        mTextureIndices.emplace(newTexture.get(), textureIdx);
+
+        // Old texture may still be referenced by materials until replacements are applied
+        mReplacedTextures.emplace_back(std::move(texture.Texture));
+        texture.Texture = std::move(newTexture);
+
+        const std::vector<uint64_t>& mipSizes = mResidencies[textureIdx].MipSizes;
+
+        mStatistics.RecreatedBytes += std::accumulate(mipSizes.begin() + mostDetailedMip, mipSizes.end(), uint64_t(0));
+        mResidencies[textureIdx].ResidentMip = mostDetailedMip;
+    }
+
+    bool TextureStreamer::CanRecreate(uint32_t textureIdx, uint32_t mostDetailedMip) const
+    {
+        if (mStatistics.RecreatedBytes == 0) return true;
+
+        const std::vector<uint64_t>& mipSizes = mResidencies[textureIdx].MipSizes;
+        uint64_t textureBytes = std::accumulate(mipSizes.begin() + mostDetailedMip, mipSizes.end(), uint64_t(0));
+
+        return mStatistics.RecreatedBytes + textureBytes <= mSettings.MaxRecreatedBytesPerUpdate;
+    }
+
+    uint32_t TextureStreamer::MipTailFirstMip(const ddsktx_texture_info& textureInfo) const
+    {
+        uint32_t mipTailFirstMip = 0;
+
+        while (mipTailFirstMip + 1 < (uint32_t)textureInfo.num_mips &&
+            uint32_t(std::max(textureInfo.width, textureInfo.height)) >> mipTailFirstMip > mSettings.MipTailSize)
+        {
+            ++mipTailFirstMip;
+        }
+
+        if (ddsktx_format_compressed(textureInfo.format))
+        {
+            for (uint32_t mip = 0; mip <= mipTailFirstMip; ++mip)
+            {
+                bool isBlockAligned = ((textureInfo.width >> mip) % 4) == 0 && ((textureInfo.height >> mip) % 4) == 0;
+                if (!isBlockAligned) return 0;
+            }
+        }
+
+        return mipTailFirstMip;
+    }
+
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "ResourceLoader.hpp"
+#include "TextureStreamingPlanner.hpp"
+
+#include <Memory/GPUResourceProducer.hpp>
+#include <robinhood/robin_hood.h>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <future>
+#include <optional>
+#include <chrono>
+
+namespace PathFinder
+{
+
+    /// Keeps textures partially resident. Textures are created with their mip tails only,
+    /// finer mips are read in on background threads and textures are recreated with the new mip range
+    /// once the reads complete. Mips the plan no longer affords are evicted by recreating textures with fewer mips.
+    /// Recreated textures are reported as replacements so that their users can patch references.
+    class TextureStreamer
+    {
+    public:
+        struct Settings
+        {
+            TextureStreamingPlanner::Settings Planner;
+
+            // Mips of this size and smaller are loaded up front and are never evicted
+            uint32_t MipTailSize = 64;
+
+            // Textures being read in at the same time
+            uint32_t MaxPendingReadCount = 4;
+
+            // Recreation copies every resident mip into upload memory on the calling thread, so it's spread across updates.
+            // A single texture is recreated even if it alone exceeds the budget.
+            uint64_t MaxRecreatedBytesPerUpdate = 32 * 1024 * 1024;
+        };
+
+        struct Statistics
+        {
+            uint32_t TextureCount = 0;
+            uint64_t ResidentBytes = 0;
+            uint32_t PendingReadCount = 0;
+
+            // Of the last update
+            uint32_t UpgradeCount = 0;
+            uint32_t EvictionCount = 0;
+            uint64_t RecreatedBytes = 0;
+            bool IsBudgetLimited = false;
+            std::chrono::microseconds UpdateTime{ 0 };
+        };
+
+        struct TextureReplacement
+        {
+            const Memory::Texture* OldTexture = nullptr;
+            Memory::Texture* NewTexture = nullptr;
+        };
+
+        TextureStreamer(ResourceLoader* resourceLoader);
+        ~TextureStreamer();
+
+        /// Loads mip tail of the texture, or returns current version of an already loaded one.
+        /// Returns nullptr if the file can't be loaded.
+        Memory::Texture* LoadTexture(const std::string& relativeFilePath);
+
+        /// Same as above for a file that is already mapped
+        Memory::Texture* LoadTexture(const std::string& relativeFilePath, ResourceLoader::MappedTexture&& file);
+
+        /// Reads in mips that LoadTexture() creates the texture with. Safe to call from any thread.
+        void PrefetchMipTail(const ResourceLoader::MappedTexture& file) const;
+
+        /// Stops streaming of the texture. The texture stays alive until the next update.
+        void Release(const std::string& relativeFilePath);
+
+        /// Textures that aren't reported between updates are considered unused and are the first to be evicted.
+        /// Unknown textures are ignored.
+        void ReportUsage(const Memory::Texture* texture, float projectedSize);
+
+        /// Finishes complete reads, plans residency and starts new reads.
+        /// Replaced textures are destroyed on the next update, so returned replacements have to be applied before that.
+        const std::vector<TextureReplacement>& Update();
+
+    private:
+        struct StreamedTexture
+        {
+            // Shared with background reads
+            std::shared_ptr<const ResourceLoader::MappedTexture> File;
+
+            Memory::GPUResourceProducer::TexturePtr Texture;
+
+            std::optional<uint32_t> PendingMip;
+            std::future<void> PendingRead;
+        };
+
+        void Recreate(uint32_t textureIdx, uint32_t mostDetailedMip);
+
+        // Whether recreation with the mip range still fits the per update budget
+        bool CanRecreate(uint32_t textureIdx, uint32_t mostDetailedMip) const;
+
+        // Block compressed textures can only start at mips with dimensions divisible by block size,
+        // textures that have other mips in their streamed range are loaded in full
+        uint32_t MipTailFirstMip(const ddsktx_texture_info& textureInfo) const;
+
+        ResourceLoader* mResourceLoader;
+        TextureStreamingPlanner mPlanner;
+        std::vector<StreamedTexture> mTextures;
+
+        // Indexed the same way as textures, kept apart to be planned in place
+        std::vector<TextureStreamingPlanner::Texture> mResidencies;
+        std::vector<uint32_t> mPlannedMips;
+        robin_hood::unordered_flat_map<std::string, uint32_t> mPathIndices;
+        robin_hood::unordered_flat_map<const Memory::Texture*, uint32_t> mTextureIndices;
+        std::vector<Memory::GPUResourceProducer::TexturePtr> mReplacedTextures;
+        std::vector<TextureReplacement> mReplacements;
+        Settings mSettings;
+        Statistics mStatistics;
+
+    public:
+        inline const auto& GetSettings() const { return mSettings; }
+        inline const auto& GetStatistics() const { return mStatistics; }
+        inline const auto& Planner() const { return mPlanner; }
+
+        inline void SetSettings(const Settings& settings) { mSettings = settings; mPlanner.SetSettings(settings.Planner); }
+    };
+
+}
@@ -0,0 +1,124 @@
+#include "TextureStreamingPlanner.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <tuple>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    std::vector<uint32_t> TextureStreamingPlanner::Plan(const std::vector<Texture>& textures)
+    {
+        mStatistics = {};
+
+        std::vector<uint32_t> plannedMips(textures.size());
+        std::vector<uint32_t> desiredMips(textures.size());
+
+        for (uint32_t textureIdx = 0; textureIdx < textures.size(); ++textureIdx)
+        {
+            const Texture& texture = textures[textureIdx];
+
+            plannedMips[textureIdx] = texture.MipTailFirstMip;
+            desiredMips[textureIdx] = DesiredMip(texture, mSettings.MipBias);
+
+            mStatistics.PlannedBytes += MipRangeSize(texture, texture.MipTailFirstMip);
+            mStatistics.DesiredBytes += MipRangeSize(texture, desiredMips[textureIdx]);
+        }
+
+        // Texels of the next mip per pixel on screen, the lower it is the blurrier the texture looks.
+        // Ties are broken by index to keep plans deterministic.
+        using Upgrade = std::tuple<float, uint32_t>;
+
+        auto nextMipDensity = [&](uint32_t textureIdx)
+        {
+            const Texture& texture = textures[textureIdx];
+            float nextMipSize = float(std::max(texture.Size >> (plannedMips[textureIdx] - 1), 1u));
+            return nextMipSize / texture.ProjectedSize;
+        };
+
+        std::priority_queue<Upgrade, std::vector<Upgrade>, std::greater<Upgrade>> upgrades;
+
+        for (uint32_t textureIdx = 0; textureIdx < textures.size(); ++textureIdx)
+        {
+            if (plannedMips[textureIdx] > desiredMips[textureIdx])
+            {
+                upgrades.emplace(nextMipDensity(textureIdx), textureIdx);
+            }
+        }
+
+        while (!upgrades.empty())
+        {
+            uint32_t textureIdx = std::get<1>(upgrades.top());
+            upgrades.pop();
+
+            uint64_t mipSize = textures[textureIdx].MipSizes[plannedMips[textureIdx] - 1];
+
+            // Texture stays at its current mip, smaller mips of other textures may still fit
+            if (mStatistics.PlannedBytes + mipSize > mSettings.MemoryBudget)
+            {
+                mStatistics.IsBudgetLimited = true;
+                continue;
+            }
+
+            mStatistics.PlannedBytes += mipSize;
+            --plannedMips[textureIdx];
+
+            if (plannedMips[textureIdx] > desiredMips[textureIdx])
+            {
+                upgrades.emplace(nextMipDensity(textureIdx), textureIdx);
+            }
+        }
+
+        // Mips that are already resident are kept while they fit, most used textures first
+        std::vector<uint32_t> retainOrder(textures.size());
+        std::iota(retainOrder.begin(), retainOrder.end(), 0);
+
+        std::stable_sort(retainOrder.begin(), retainOrder.end(), [&textures](uint32_t first, uint32_t second)
+        {
+            return textures[first].ProjectedSize > textures[second].ProjectedSize;
+        });
+
+        for (uint32_t textureIdx : retainOrder)
+        {
+            const Texture& texture = textures[textureIdx];
+
+            while (plannedMips[textureIdx] > texture.ResidentMip)
+            {
+                uint64_t mipSize = texture.MipSizes[plannedMips[textureIdx] - 1];
+
+                if (mStatistics.PlannedBytes + mipSize > mSettings.MemoryBudget) break;
+
+                mStatistics.PlannedBytes += mipSize;
+                --plannedMips[textureIdx];
+            }
+        }
+
+        for (uint32_t textureIdx = 0; textureIdx < textures.size(); ++textureIdx)
+        {
+            mStatistics.UpgradeCount += plannedMips[textureIdx] < textures[textureIdx].ResidentMip;
+            mStatistics.EvictionCount += plannedMips[textureIdx] > textures[textureIdx].ResidentMip;
+        }
+
+        return plannedMips;
+    }
+
+    uint32_t TextureStreamingPlanner::DesiredMip(const Texture& texture, float mipBias)
+    {
+        if (texture.ProjectedSize <= 0.0f)
+        {
+            return texture.MipTailFirstMip;
+        }
+
+        float mip = std::floor(std::log2(float(texture.Size) / texture.ProjectedSize) + mipBias);
+
+        return std::min((uint32_t)std::max(mip, 0.0f), texture.MipTailFirstMip);
+    }
+
+    uint64_t TextureStreamingPlanner::MipRangeSize(const Texture& texture, uint32_t mostDetailedMip)
+    {
+        return std::accumulate(texture.MipSizes.begin() + mostDetailedMip, texture.MipSizes.end(), uint64_t(0));
+    }
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Decides which mips of streamed textures should be resident. Mip tails are always resident,
+    /// the rest of the budget is spent one mip at a time on the texture that is the most undersampled on screen.
+    /// Finer mips that are resident but no longer needed are kept for as long as they fit in the budget,
+    /// so they're only evicted under memory pressure, least used textures first.
+    /// Doesn't touch GPU resources.
+    class TextureStreamingPlanner
+    {
+    public:
+        struct Settings
+        {
+            // Memory all streamed textures may occupy, mip tails included
+            uint64_t MemoryBudget = 1ull << 30;
+
+            // Added to desired mips, positive values trade sharpness for memory
+            float MipBias = 0.0f;
+        };
+
+        struct Statistics
+        {
+            uint64_t PlannedBytes = 0;
+
+            // Memory needed for every texture to have its desired mip resident
+            uint64_t DesiredBytes = 0;
+
+            uint32_t UpgradeCount = 0;
+            uint32_t EvictionCount = 0;
+            bool IsBudgetLimited = false;
+        };
+
+        struct Texture
+        {
+            // Sizes of all mips in bytes, most detailed first
+            std::vector<uint64_t> MipSizes;
+
+            // Larger dimension of mip 0
+            uint32_t Size = 0;
+
+            // First mip of the mip tail
+            uint32_t MipTailFirstMip = 0;
+
+            // Most detailed resident mip
+            uint32_t ResidentMip = 0;
+
+            // Largest size of the texture on screen among its uses, in pixels. Zero for unused textures.
+            float ProjectedSize = 0.0f;
+        };
+
+        /// Returns the most detailed mip that should be resident for every texture
+        std::vector<uint32_t> Plan(const std::vector<Texture>& textures);
+
+        /// Mip with texel density closest to pixel density on screen
+        static uint32_t DesiredMip(const Texture& texture, float mipBias);
+
+    private:
+        static uint64_t MipRangeSize(const Texture& texture, uint32_t mostDetailedMip);
+
+        Settings mSettings;
+        Statistics mStatistics;
+
+    public:
+        inline const auto& GetSettings() const { return mSettings; }
+        inline const auto& GetStatistics() const { return mStatistics; }
+
+        inline void SetSettings(const Settings& settings) { mSettings = settings; }
+    };
+
+}
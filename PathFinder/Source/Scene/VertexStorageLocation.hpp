@@ -5,13 +5,24 @@
 namespace PathFinder
 {
 
+    struct IndexStorageLocation
+    {
+        uint32_t IndexBufferOffset = 0;
+        uint32_t IndexCount = 0;
+    };
+
     struct VertexStorageLocation
     {
+        inline static const uint32_t NoPackedVertices = 0xFFFFFFFF;
+
         uint32_t VertexBufferOffset = 0;
         uint32_t VertexCount = 0;
         uint32_t IndexBufferOffset = 0;
         uint32_t IndexCount = 0;
         uint16_t BottomAccelerationStructureIndex = 0;
+        uint32_t MeshletTableOffset = 0;
+        uint32_t MeshletCount = 0;
+        uint32_t PackedVertexBufferOffset = NoPackedVertices;
     };
 
 }
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+
+#include <bitsery/bitsery.h>
+#include <Utility/SerializationAdapters.hpp>
+
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /**
+     Compact counterpart of Vertex1P1N1UV1T1BT, 20 bytes instead of 60.
+
+     Position: 21 bits per axis, quantized relative to mesh bounding box,
+     bitangent sign in the highest bit of the second word
+     Normal, tangent: octahedral encoding, 2 x snorm16
+     UV: 2 x half
+     */
+    struct Vertex1P1N1UV1T1BTPacked
+    {
+        inline static const uint32_t PositionBitCount = 21;
+        inline static const uint32_t PositionQuantizationMax = (1u << PositionBitCount) - 1;
+
+        glm::uvec2 PositionAndBitangentSign;
+        uint32_t Normal;
+        uint32_t Tangent;
+        uint32_t UV;
+
+        template <typename S>
+        void serialize(S& s)
+        {
+            s.value4b(PositionAndBitangentSign.x);
+            s.value4b(PositionAndBitangentSign.y);
+            s.value4b(Normal);
+            s.value4b(Tangent);
+            s.value4b(UV);
+        }
+    };
+
+    static_assert(sizeof(Vertex1P1N1UV1T1BTPacked) == 20, "Packed vertex must match its HLSL counterpart");
+
+    /// Largest deviations of unpacked vertices from the source ones within a mesh
+    struct VertexPackingError
+    {
+        // In mesh space units
+        float MaxPositionError = 0.0f;
+
+        // Angles in radians
+        float MaxNormalError = 0.0f;
+        float MaxTangentError = 0.0f;
+
+        // Largest per-component difference
+        float MaxUVError = 0.0f;
+
+        template <typename S>
+        void serialize(S& s)
+        {
+            s.value4b(MaxPositionError);
+            s.value4b(MaxNormalError);
+            s.value4b(MaxTangentError);
+            s.value4b(MaxUVError);
+        }
+    };
+
+}
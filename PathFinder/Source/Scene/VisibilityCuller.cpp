@@ -0,0 +1,164 @@
+#include "VisibilityCuller.hpp"
+
+#include <emmintrin.h>
+#include <array>
+#include <algorithm>
+
+namespace PathFinder
+{
+
+    void VisibilityCuller::UpdateInstanceBounds(const Foundation::SlotMap<MeshInstance>& instances, const Foundation::SlotMap<Mesh>& meshes, uint64_t sceneLayoutVersion)
+    {
+        bool isLayoutChanged = mSceneLayoutVersion != sceneLayoutVersion;
+
+        if (isLayoutChanged)
+        {
+            mInstanceCount = (uint32_t)instances.size();
+            mBoxPackets.clear();
+            mBoxPackets.resize((mInstanceCount + PacketWidth - 1) / PacketWidth);
+            mInstanceVersions.resize(mInstanceCount);
+            mSceneLayoutVersion = sceneLayoutVersion;
+        }
+
+        for (auto denseIdx = 0u; denseIdx < mInstanceCount; ++denseIdx)
+        {
+            const MeshInstance& instance = instances.data()[denseIdx];
+
+            if (isLayoutChanged || mInstanceVersions[denseIdx] != instance.Version())
+            {
+                SetInstanceBox(denseIdx, instance.BoundingBox(meshes[instance.AssociatedMesh()]));
+                mInstanceVersions[denseIdx] = instance.Version();
+            }
+        }
+    }
+
+    const VisibilityCuller::ViewVisibility& VisibilityCuller::CullView(
+        Foundation::Name viewName, 
+        const Geometry::Frustum& frustum, 
+        const Geometry::HiZPyramid* occluders, 
+        const Geometry::BoundingVolumeHierarchy* instanceHierarchy)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        ViewVisibility& view = mViews[viewName];
+        view.VisibleInstances.clear();
+        view.OccludedInstances.clear();
+        view.Stats = {};
+
+        if (instanceHierarchy && !instanceHierarchy->IsEmpty() && instanceHierarchy->PrimitiveCount() == mInstanceCount)
+        {
+            instanceHierarchy->QueryFrustum(frustum, [&view](uint32_t instanceIdx) { view.VisibleInstances.push_back(instanceIdx); });
+
+            // Hierarchy visits instances in tree order, later stages expect storage order
+            std::sort(view.VisibleInstances.begin(), view.VisibleInstances.end());
+        }
+        else
+        {
+            CullPackets(frustum, view.VisibleInstances);
+        }
+
+        view.Stats.TestedInstanceCount = mInstanceCount;
+        view.Stats.FrustumCulledInstanceCount = mInstanceCount - (uint32_t)view.VisibleInstances.size();
+        view.Stats.CullingTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+        if (occluders && !occluders->IsEmpty())
+        {
+            auto occlusionStartTime = std::chrono::steady_clock::now();
+
+            auto occludedIt = std::stable_partition(view.VisibleInstances.begin(), view.VisibleInstances.end(), [&](uint32_t instanceIdx)
+            {
+                return !occluders->IsOccluded(GetInstanceBox(instanceIdx));
+            });
+
+            view.OccludedInstances.assign(occludedIt, view.VisibleInstances.end());
+            view.VisibleInstances.erase(occludedIt, view.VisibleInstances.end());
+            view.Stats.OccludedInstanceCount = (uint32_t)view.OccludedInstances.size();
+            view.Stats.OcclusionCullingTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - occlusionStartTime);
+        }
+
+        view.Stats.VisibleInstanceCount = (uint32_t)view.VisibleInstances.size();
+
+        return view;
+    }
+
+    void VisibilityCuller::CullPackets(const Geometry::Frustum& frustum, std::vector<uint32_t>& visibleInstances) const
+    {
+        // Plane data broadcasted to all lanes and plane-dependent choice of a box corner
+        // that is the farthest along plane normal, which is the same for every box in a packet
+        struct PacketPlane
+        {
+            __m128 NormalX, NormalY, NormalZ, Distance;
+            bool UseMaxX, UseMaxY, UseMaxZ;
+        };
+
+        std::array<PacketPlane, 6> planes;
+
+        for (auto planeIdx = 0u; planeIdx < planes.size(); ++planeIdx)
+        {
+            const Geometry::Plane& plane = frustum.Planes[planeIdx];
+
+            planes[planeIdx] = {
+                _mm_set1_ps(plane.normal.x), _mm_set1_ps(plane.normal.y), _mm_set1_ps(plane.normal.z), _mm_set1_ps(plane.distance),
+                plane.normal.x >= 0.0f, plane.normal.y >= 0.0f, plane.normal.z >= 0.0f
+            };
+        }
+
+        for (auto packetIdx = 0u; packetIdx < mBoxPackets.size(); ++packetIdx)
+        {
+            const BoxPacket& packet = mBoxPackets[packetIdx];
+            __m128 insideMask = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+            for (const PacketPlane& plane : planes)
+            {
+                __m128 x = _mm_load_ps(plane.UseMaxX ? packet.MaxX : packet.MinX);
+                __m128 y = _mm_load_ps(plane.UseMaxY ? packet.MaxY : packet.MinY);
+                __m128 z = _mm_load_ps(plane.UseMaxZ ? packet.MaxZ : packet.MinZ);
+
+                __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(plane.NormalX, x), _mm_mul_ps(plane.NormalY, y)), _mm_mul_ps(plane.NormalZ, z));
+                insideMask = _mm_and_ps(insideMask, _mm_cmpge_ps(dot, plane.Distance));
+            }
+
+            int laneMask = _mm_movemask_ps(insideMask);
+
+            // Last packet can be partially filled
+            uint32_t firstInstanceIdx = packetIdx * PacketWidth;
+            uint32_t laneCount = std::min(PacketWidth, mInstanceCount - firstInstanceIdx);
+
+            for (auto lane = 0u; lane < laneCount; ++lane)
+            {
+                if (laneMask & (1 << lane)) visibleInstances.push_back(firstInstanceIdx + lane);
+            }
+        }
+    }
+
+    const VisibilityCuller::ViewVisibility* VisibilityCuller::GetViewVisibility(Foundation::Name viewName) const
+    {
+        auto it = mViews.find(viewName);
+        return it != mViews.end() ? &it->second : nullptr;
+    }
+
+    void VisibilityCuller::SetInstanceBox(uint32_t instanceIndex, const Geometry::AxisAlignedBox3D& box)
+    {
+        BoxPacket& packet = mBoxPackets[instanceIndex / PacketWidth];
+        uint32_t lane = instanceIndex % PacketWidth;
+
+        packet.MinX[lane] = box.Min.x;
+        packet.MinY[lane] = box.Min.y;
+        packet.MinZ[lane] = box.Min.z;
+        packet.MaxX[lane] = box.Max.x;
+        packet.MaxY[lane] = box.Max.y;
+        packet.MaxZ[lane] = box.Max.z;
+    }
+
+    Geometry::AxisAlignedBox3D VisibilityCuller::GetInstanceBox(uint32_t instanceIndex) const
+    {
+        const BoxPacket& packet = mBoxPackets[instanceIndex / PacketWidth];
+        uint32_t lane = instanceIndex % PacketWidth;
+
+        return {
+            { packet.MinX[lane], packet.MinY[lane], packet.MinZ[lane] },
+            { packet.MaxX[lane], packet.MaxY[lane], packet.MaxZ[lane] }
+        };
+    }
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Mesh.hpp"
+#include "MeshInstance.hpp"
+
+#include <Geometry/Frustum.hpp>
+#include <Geometry/HiZPyramid.hpp>
+#include <Geometry/BoundingVolumeHierarchy.hpp>
+#include <Foundation/SlotMap.hpp>
+#include <Foundation/Name.hpp>
+#include <robinhood/robin_hood.h>
+
+#include <vector>
+#include <optional>
+#include <chrono>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Determines which mesh instances are visible from a set of views.
+    /// World-space boxes of instances are stored in packets of four in structure-of-arrays layout,
+    /// so that four boxes are tested against a frustum plane at once with SSE.
+    /// When a hierarchy over the same instances is available, its subtrees are accepted or rejected as a whole instead.
+    /// Instances inside of a frustum can then be tested for occlusion against a depth pyramid read back from GPU.
+    /// That pyramid is older than the frame and built from another camera, so occluded instances are only candidates
+    /// that GPU tests again against Hi-Z of the current frame.
+    class VisibilityCuller
+    {
+    public:
+        struct Statistics
+        {
+            uint32_t TestedInstanceCount = 0;
+            uint32_t VisibleInstanceCount = 0;
+            uint32_t FrustumCulledInstanceCount = 0;
+            uint32_t OccludedInstanceCount = 0;
+            std::chrono::microseconds CullingTime{ 0 };
+            std::chrono::microseconds OcclusionCullingTime{ 0 };
+        };
+
+        struct ViewVisibility
+        {
+            // Dense indices of visible instances in scene's instance storage
+            std::vector<uint32_t> VisibleInstances;
+            // Dense indices of instances inside of the frustum occluded in the provided pyramid, pending second phase test
+            std::vector<uint32_t> OccludedInstances;
+            Statistics Stats;
+        };
+
+        /// Repacks every box when instances were added or removed,
+        /// otherwise only boxes of instances that changed since last update
+        void UpdateInstanceBounds(const Foundation::SlotMap<MeshInstance>& instances, const Foundation::SlotMap<Mesh>& meshes, uint64_t sceneLayoutVersion);
+
+        /// Occlusion culling is performed when a non-empty pyramid is provided.
+        /// Hierarchy primitives have to be dense instance indices, hierarchies built for another instance count are ignored.
+        const ViewVisibility& CullView(
+            Foundation::Name viewName, 
+            const Geometry::Frustum& frustum, 
+            const Geometry::HiZPyramid* occluders = nullptr, 
+            const Geometry::BoundingVolumeHierarchy* instanceHierarchy = nullptr);
+
+        /// Returns nullptr for views that were never culled
+        const ViewVisibility* GetViewVisibility(Foundation::Name viewName) const;
+
+    private:
+        inline static const uint32_t PacketWidth = 4;
+
+        struct alignas(16) BoxPacket
+        {
+            float MinX[PacketWidth];
+            float MinY[PacketWidth];
+            float MinZ[PacketWidth];
+            float MaxX[PacketWidth];
+            float MaxY[PacketWidth];
+            float MaxZ[PacketWidth];
+        };
+
+        void CullPackets(const Geometry::Frustum& frustum, std::vector<uint32_t>& visibleInstances) const;
+
+        void SetInstanceBox(uint32_t instanceIndex, const Geometry::AxisAlignedBox3D& box);
+        Geometry::AxisAlignedBox3D GetInstanceBox(uint32_t instanceIndex) const;
+
+        std::vector<BoxPacket> mBoxPackets;
+        std::vector<uint64_t> mInstanceVersions;
+        std::optional<uint64_t> mSceneLayoutVersion;
+        uint32_t mInstanceCount = 0;
+
+        // Node map keeps references returned by CullView valid when new views are added
+        robin_hood::unordered_node_map<Foundation::Name, ViewVisibility> mViews;
+
+    public:
+        inline auto InstanceCount() const { return mInstanceCount; }
+    };
+
+}
@@ -54,6 +54,11 @@ namespace PathFinder
                 mRenderGraphVC = CreateViewController<RenderGraphViewController>();
             }
 
+            if (ImGui::MenuItem("Memory Telemetry", nullptr, false, mMemoryTelemetryVC == nullptr))
+            {
+                mMemoryTelemetryVC = CreateViewController<MemoryTelemetryViewController>();
+            }
+
             ImGui::EndMenu();
         }
     }
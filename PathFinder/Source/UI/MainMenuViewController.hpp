@@ -3,6 +3,7 @@
 #include "ViewController.hpp"
 #include "LuminanceMeterViewController.hpp"
 #include "RenderGraphViewController.hpp"
+#include "MemoryTelemetryViewController.hpp"
 
 namespace PathFinder
 {
@@ -18,6 +19,7 @@ namespace PathFinder
 
         std::shared_ptr<LuminanceMeterViewController> mLuminanceMeterVC;
         std::shared_ptr<RenderGraphViewController> mRenderGraphVC;
+        std::shared_ptr<MemoryTelemetryViewController> mMemoryTelemetryVC;
     };
 
 }
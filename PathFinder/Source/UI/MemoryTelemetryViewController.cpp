@@ -0,0 +1,95 @@
+#include "MemoryTelemetryViewController.hpp"
+#include "UIManager.hpp"
+
+#include <imgui/imgui.h>
+#include <implot/implot.h>
+
+namespace PathFinder
+{
+
+    void MemoryTelemetryViewController::OnCreated()
+    {
+        VM = GetViewModel<MemoryTelemetryViewModel>();
+    }
+
+    void MemoryTelemetryViewController::Draw()
+    {
+        VM->Import();
+
+        ImGui::Begin("Memory Telemetry");
+
+        if (ImGui::Button("Export CSV"))
+        {
+            mLastExportSucceeded = VM->ExportCSV();
+        }
+
+        if (!mLastExportSucceeded)
+        {
+            ImGui::SameLine();
+            ImGui::Text("Export failed");
+        }
+
+        if (!VM->Frames.empty())
+        {
+            DrawSeriesGroup("Allocator Pools", "MB", VM->PoolMemory);
+            DrawSeriesGroup("Transient Heaps", "MB", VM->TransientMemory);
+            DrawSeriesGroup("Copy Traffic", "MB / Frame", VM->Traffic);
+            DrawBars("Per-Pass Transient Footprint", "MB", VM->PassFootprints);
+            DrawBars("Descriptor Ranges", "Descriptors", VM->DescriptorUsage);
+        }
+
+        ImGui::End();
+
+        VM->Export();
+    }
+
+    void MemoryTelemetryViewController::DrawSeriesGroup(const char* title, const char* yLabel, const MemoryTelemetryViewModel::SeriesGroup& group)
+    {
+        if (!ImGui::CollapsingHeader(title, ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            return;
+        }
+
+        ImPlot::SetNextPlotLimitsX(VM->Frames.front(), std::max(VM->Frames.back(), VM->Frames.front() + 1.0f), ImGuiCond_Always);
+        ImPlot::SetNextPlotLimitsY(0.0, std::max(group.MaxValue * 1.1f, 1.0f), ImGuiCond_Always);
+
+        if (ImPlot::BeginPlot(title, "Frame", yLabel, ImVec2(-1, 250)))
+        {
+            for (const MemoryTelemetryViewModel::Series& series : group.Entries)
+            {
+                ImPlot::PlotLine(series.Name.c_str(), VM->Frames.data(), series.Values.data(), series.Values.size());
+            }
+
+            ImPlot::EndPlot();
+        }
+    }
+
+    void MemoryTelemetryViewController::DrawBars(const char* title, const char* xLabel, const MemoryTelemetryViewModel::Bars& bars)
+    {
+        if (bars.Values.empty() || !ImGui::CollapsingHeader(title, ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            return;
+        }
+
+        std::vector<const char*> labels;
+        std::vector<double> positions;
+
+        for (auto i = 0u; i < bars.Labels.size(); ++i)
+        {
+            labels.push_back(bars.Labels[i].c_str());
+            positions.push_back(i);
+        }
+
+        float plotHeight = 40.0f + 20.0f * bars.Values.size();
+
+        ImPlot::SetNextPlotLimits(0.0, std::max(bars.MaxValue * 1.1f, 1.0f), -0.5, bars.Values.size() - 0.5, ImGuiCond_Always);
+        ImPlot::SetNextPlotTicksY(positions.data(), positions.size(), labels.data());
+
+        if (ImPlot::BeginPlot(title, xLabel, nullptr, ImVec2(-1, plotHeight)))
+        {
+            ImPlot::PlotBarsH(title, bars.Values.data(), bars.Values.size(), 0.6);
+            ImPlot::EndPlot();
+        }
+    }
+
+}
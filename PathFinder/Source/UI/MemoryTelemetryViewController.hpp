@@ -0,0 +1,24 @@
+#pragma once
+
+#include "ViewController.hpp"
+#include "MemoryTelemetryViewModel.hpp"
+
+namespace PathFinder
+{
+   
+    class MemoryTelemetryViewController : public ViewController
+    {
+    public:
+        void Draw() override;
+        void OnCreated() override;
+
+        MemoryTelemetryViewModel* VM;
+
+    private:
+        void DrawSeriesGroup(const char* title, const char* yLabel, const MemoryTelemetryViewModel::SeriesGroup& group);
+        void DrawBars(const char* title, const char* xLabel, const MemoryTelemetryViewModel::Bars& bars);
+
+        bool mLastExportSucceeded = true;
+    };
+
+}
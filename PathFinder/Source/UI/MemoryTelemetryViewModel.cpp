@@ -0,0 +1,98 @@
+#include "MemoryTelemetryViewModel.hpp"
+
+namespace PathFinder
+{
+
+    void MemoryTelemetryViewModel::Import()
+    {
+        const MemoryTelemetry* telemetry = Dependencies->Telemetry;
+
+        Frames.clear();
+        PoolMemory = {};
+        TransientMemory = {};
+        Traffic = {};
+        PassFootprints = {};
+        DescriptorUsage = {};
+
+        for (const MemoryTelemetry::FrameSample& sample : telemetry->History())
+        {
+            Frames.push_back(sample.FrameNumber);
+
+            AddSample(PoolMemory, 0, "Committed", ToMB(sample.TotalPoolCommittedBytes()));
+            AddSample(PoolMemory, 1, "Upload Used", ToMB(sample.Pools.Upload.UsedBytes));
+            AddSample(PoolMemory, 2, "Readback Used", ToMB(sample.Pools.Readback.UsedBytes));
+            AddSample(PoolMemory, 3, "Universal/Buffer Used", ToMB(sample.Pools.DefaultUniversalOrBuffer.UsedBytes));
+            AddSample(PoolMemory, 4, "RT/DS Used", ToMB(sample.Pools.DefaultRTDS.UsedBytes));
+            AddSample(PoolMemory, 5, "Non RT/DS Used", ToMB(sample.Pools.DefaultNonRTDS.UsedBytes));
+
+            AddSample(TransientMemory, 0, "RT/DS Heap", ToMB(sample.Transient.RTDSHeap.CommittedBytes));
+            AddSample(TransientMemory, 1, "Non RT/DS Heap", ToMB(sample.Transient.NonRTDSHeap.CommittedBytes));
+            AddSample(TransientMemory, 2, "Buffer Heap", ToMB(sample.Transient.BufferHeap.CommittedBytes));
+            AddSample(TransientMemory, 3, "Universal Heap", ToMB(sample.Transient.UniversalHeap.CommittedBytes));
+            AddSample(TransientMemory, 4, "Without Aliasing", ToMB(sample.TotalTransientRequestedBytes()));
+            AddSample(TransientMemory, 5, "Aliasing Savings", ToMB(sample.AliasingSavingsBytes()));
+
+            AddSample(Traffic, 0, "Upload Copies", ToMB(sample.Traffic.UploadedBytes));
+            AddSample(Traffic, 1, "Direct Uploads", ToMB(sample.Traffic.DirectlyUploadedBytes));
+            AddSample(Traffic, 2, "Readbacks", ToMB(sample.Traffic.ReadbackBytes));
+        }
+
+        if (telemetry->History().empty())
+        {
+            return;
+        }
+
+        // Bar charts only show the latest frame
+        const MemoryTelemetry::FrameSample& latestSample = telemetry->History().back();
+
+        for (const PipelineResourceStorage::PassMemoryStatistics& passStatistics : latestSample.Transient.Passes)
+        {
+            float footprint = ToMB(passStatistics.TransientBytes);
+            PassFootprints.Labels.push_back(passStatistics.Name.ToString());
+            PassFootprints.Values.push_back(footprint);
+            PassFootprints.MaxValue = std::max(PassFootprints.MaxValue, footprint);
+        }
+
+        auto addDescriptorRange = [this](const char* name, const Memory::PoolDescriptorAllocator::RangeStatistics& range)
+        {
+            DescriptorUsage.Labels.push_back(name);
+            DescriptorUsage.Values.push_back(range.Used);
+            DescriptorUsage.MaxValue = std::max<float>(DescriptorUsage.MaxValue, range.Capacity);
+        };
+
+        addDescriptorRange("RT", latestSample.Descriptors.RT);
+        addDescriptorRange("DS", latestSample.Descriptors.DS);
+        addDescriptorRange("SR", latestSample.Descriptors.SR);
+        addDescriptorRange("UA", latestSample.Descriptors.UA);
+        addDescriptorRange("CB", latestSample.Descriptors.CB);
+        addDescriptorRange("Sampler", latestSample.Descriptors.Sampler);
+    }
+
+    void MemoryTelemetryViewModel::Export()
+    {
+
+    }
+
+    bool MemoryTelemetryViewModel::ExportCSV()
+    {
+        return Dependencies->Telemetry->ExportCSV(Dependencies->MemoryTelemetryCSVPath);
+    }
+
+    float MemoryTelemetryViewModel::ToMB(uint64_t bytes)
+    {
+        return bytes / (1024.0f * 1024.0f);
+    }
+
+    void MemoryTelemetryViewModel::AddSample(SeriesGroup& group, uint64_t seriesIndex, const char* name, float value)
+    {
+        if (seriesIndex >= group.Entries.size())
+        {
+            group.Entries.resize(seriesIndex + 1);
+            group.Entries[seriesIndex].Name = name;
+        }
+
+        group.Entries[seriesIndex].Values.push_back(value);
+        group.MaxValue = std::max(group.MaxValue, value);
+    }
+
+}
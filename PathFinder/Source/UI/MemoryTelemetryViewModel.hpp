@@ -0,0 +1,53 @@
+#pragma once
+
+#include "ViewModel.hpp"
+
+#include <vector>
+#include <string>
+
+namespace PathFinder
+{
+   
+    class MemoryTelemetryViewModel : public ViewModel
+    {
+    public:
+        struct Series
+        {
+            std::string Name;
+            std::vector<float> Values;
+        };
+
+        struct SeriesGroup
+        {
+            std::vector<Series> Entries;
+            float MaxValue = 0.0f;
+        };
+
+        struct Bars
+        {
+            std::vector<std::string> Labels;
+            std::vector<float> Values;
+            float MaxValue = 0.0f;
+        };
+
+        void Import() override;
+        void Export() override;
+
+        bool ExportCSV();
+
+        // Values are in megabytes, except for descriptors
+        std::vector<float> Frames;
+        SeriesGroup PoolMemory;
+        SeriesGroup TransientMemory;
+        SeriesGroup Traffic;
+        Bars PassFootprints;
+        // Bar limit is set to range capacity
+        Bars DescriptorUsage;
+
+    private:
+        static float ToMB(uint64_t bytes);
+
+        void AddSample(SeriesGroup& group, uint64_t seriesIndex, const char* name, float value);
+    };
+
+}
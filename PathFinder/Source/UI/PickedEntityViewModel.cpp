@@ -9,16 +9,16 @@ namespace PathFinder
 
     void PickedEntityViewModel::HandleClick()
     {
-        mMeshInstance = nullptr;
-        mSphericalLight = nullptr;
-        mFlatLight = nullptr;
+        mMeshInstanceHandle = {};
+        mSphericalLightHandle = {};
+        mFlatLightHandle = {};
 
         if (auto entity = mScene->GetEntityByID(mHoveredEntityID))
         {
             std::visit(Foundation::MakeVisitor(
-                [this](MeshInstance* instance) { mMeshInstance = instance; },
-                [this](SphericalLight* light) { mSphericalLight = light; },
-                [this](FlatLight* light) { mFlatLight = light; }),
+                [this](MeshInstanceHandle instance) { mMeshInstanceHandle = instance; },
+                [this](SphericalLightHandle light) { mSphericalLightHandle = light; },
+                [this](FlatLightHandle light) { mFlatLightHandle = light; }),
                 *entity);
         }
     }
@@ -33,6 +33,11 @@ namespace PathFinder
     {
         mScene = Dependencies->ScenePtr;
 
+        // Entities could have been removed since selection, in which case handles are stale
+        mMeshInstance = mScene->MeshInstances().Get(mMeshInstanceHandle);
+        mSphericalLight = mScene->SphericalLights().Get(mSphericalLightHandle);
+        mFlatLight = mScene->FlatLights().Get(mFlatLightHandle);
+
         mShouldDisplay = mMeshInstance != nullptr || mSphericalLight != nullptr || mFlatLight != nullptr;
         mAreRotationsAllowed = mSphericalLight == nullptr;
        
@@ -24,6 +24,11 @@ namespace PathFinder
         glm::mat4 mModelMatrix;
         glm::mat4 mModifiedModelMatrix;
         glm::mat4 mDeltaMatrix;
+        MeshInstanceHandle mMeshInstanceHandle;
+        SphericalLightHandle mSphericalLightHandle;
+        FlatLightHandle mFlatLightHandle;
+
+        // Resolved from handles on each import
         MeshInstance* mMeshInstance = nullptr;
         SphericalLight* mSphericalLight = nullptr;
         FlatLight* mFlatLight = nullptr;
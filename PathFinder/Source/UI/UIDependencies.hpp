@@ -1,10 +1,13 @@
 #pragma once
 
 #include <RenderPipeline/PipelineResourceStorage.hpp>
+#include <RenderPipeline/MemoryTelemetry.hpp>
 #include <RenderPipeline/RenderEngine.hpp>
 #include <RenderPipeline/RenderPassContentMediator.hpp>
 #include <Scene/Scene.hpp>
 
+#include <filesystem>
+
 namespace PathFinder
 {
    
@@ -13,16 +16,22 @@ namespace PathFinder
     {
         UIDependencies(
             const PipelineResourceStorage* resourceStorage, 
+            const MemoryTelemetry* memoryTelemetry,
+            const std::filesystem::path& memoryTelemetryCSVPath,
             RenderEngine<RenderPassContentMediator>::Event* preRenderEvent,
             RenderEngine<RenderPassContentMediator>::Event* postRenderEvent,
             Scene* scene)
             :
             ResourceStorage{ resourceStorage },
+            Telemetry{ memoryTelemetry },
+            MemoryTelemetryCSVPath{ memoryTelemetryCSVPath },
             PreRenderEvent{ preRenderEvent },
             PostRenderEvent{ postRenderEvent },
             ScenePtr{ scene } {}
 
         const PipelineResourceStorage* const ResourceStorage;
+        const MemoryTelemetry* const Telemetry;
+        const std::filesystem::path MemoryTelemetryCSVPath;
         RenderEngine<RenderPassContentMediator>::Event* const PreRenderEvent;
         RenderEngine<RenderPassContentMediator>::Event* const PostRenderEvent;
         Scene* const ScenePtr;
@@ -0,0 +1,122 @@
+#include <TestHelpers.hpp>
+
+#include <Foundation/SlotMap.hpp>
+#include <Geometry/Transformation.hpp>
+
+#include <algorithm>
+#include <list>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+    // Same footprint as a mesh instance: two handles, flags, current and previous transforms and bookkeeping
+    struct InstanceRecord
+    {
+        Foundation::SlotMapHandle<int> Mesh;
+        Foundation::SlotMapHandle<int> Material;
+        bool IsSelected = false;
+        bool IsHighlighted = false;
+        Geometry::Transformation Transformation;
+        Geometry::Transformation PrevTransformation;
+        uint32_t IndexInGPUTable = 0;
+        uint32_t LOD = 0;
+        uint64_t Version = 0;
+    };
+
+    InstanceRecord MakeRecord(uint32_t index)
+    {
+        InstanceRecord record;
+        record.Transformation.Translation = glm::vec3{ float(index % 1000), float(index / 1000), 1.0f };
+        record.PrevTransformation = record.Transformation;
+        record.IndexInGPUTable = index;
+        record.Version = index;
+        return record;
+    }
+
+    // Per-frame work scene systems do on every instance: read transform and bump bookkeeping
+    template <class Container>
+    uint64_t TouchEveryInstance(Container& instances)
+    {
+        uint64_t checksum = 0;
+
+        for (InstanceRecord& instance : instances)
+        {
+            checksum += instance.IndexInGPUTable + uint64_t(instance.Transformation.Translation.x);
+            instance.PrevTransformation = instance.Transformation;
+            ++instance.Version;
+        }
+
+        return checksum;
+    }
+
+    void RunBenchmark(uint32_t instanceCount, uint32_t frameCount)
+    {
+        std::mt19937 rng{ instanceCount };
+
+        // Both containers go through the same churn so the list ends up with nodes scattered over the heap
+        // the way a scene with added and removed entities does
+        std::list<InstanceRecord> list;
+        std::vector<std::list<InstanceRecord>::iterator> listIterators;
+        Foundation::SlotMap<InstanceRecord> slotMap;
+        std::vector<Foundation::SlotMap<InstanceRecord>::Handle> handles;
+
+        for (auto i = 0u; i < instanceCount; ++i)
+        {
+            listIterators.push_back(list.insert(list.end(), MakeRecord(i)));
+            handles.push_back(slotMap.Emplace(MakeRecord(i)));
+        }
+
+        std::vector<uint32_t> removalOrder(instanceCount);
+        std::iota(removalOrder.begin(), removalOrder.end(), 0);
+        std::shuffle(removalOrder.begin(), removalOrder.end(), rng);
+        removalOrder.resize(instanceCount / 2);
+
+        for (uint32_t index : removalOrder)
+        {
+            list.erase(listIterators[index]);
+            slotMap.Erase(handles[index]);
+        }
+
+        for (uint32_t index : removalOrder)
+        {
+            list.push_back(MakeRecord(index));
+            slotMap.Emplace(MakeRecord(index));
+        }
+
+        PF_CHECK(list.size() == slotMap.size());
+
+        uint64_t listChecksum = 0;
+        uint64_t slotMapChecksum = 0;
+
+        double listTime = Tests::MeasureMilliseconds([&] {
+            for (auto frame = 0u; frame < frameCount; ++frame) listChecksum += TouchEveryInstance(list);
+        });
+
+        double slotMapTime = Tests::MeasureMilliseconds([&] {
+            for (auto frame = 0u; frame < frameCount; ++frame) slotMapChecksum += TouchEveryInstance(slotMap);
+        });
+
+        // Same elements in different order
+        PF_CHECK(listChecksum == slotMapChecksum);
+
+        std::printf("%8u instances: std::list %8.3f ms/frame, SlotMap %8.3f ms/frame, %5.2fx\n",
+            instanceCount, listTime / frameCount, slotMapTime / frameCount, listTime / slotMapTime);
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<uint32_t> instanceCounts = Tests::IsQuickRun(argc, argv) ?
+        std::vector<uint32_t>{ 10000 } : std::vector<uint32_t>{ 10000, 100000, 1000000 };
+
+    for (uint32_t instanceCount : instanceCounts)
+    {
+        RunBenchmark(instanceCount, std::max(10000000u / instanceCount, 10u));
+    }
+
+    return Tests::Result();
+}
@@ -0,0 +1,160 @@
+#include <TestHelpers.hpp>
+
+#include <Geometry/BoundingVolumeHierarchy.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Geometry;
+
+namespace
+{
+
+    const uint32_t QueryCount = 16;
+
+    std::vector<AxisAlignedBox3D> MakeInstanceBounds(uint32_t instanceCount, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> position{ -1000.0f, 1000.0f };
+        std::uniform_real_distribution<float> extent{ 0.5f, 3.0f };
+        std::vector<AxisAlignedBox3D> bounds;
+        bounds.reserve(instanceCount);
+
+        for (auto i = 0u; i < instanceCount; ++i)
+        {
+            glm::vec3 center{ position(rng), position(rng), position(rng) };
+            glm::vec3 halfSize{ extent(rng), extent(rng), extent(rng) };
+            bounds.emplace_back(center - halfSize, center + halfSize);
+        }
+
+        return bounds;
+    }
+
+    std::vector<Frustum> MakeFrustums(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> position{ -800.0f, 800.0f };
+        std::vector<Frustum> frustums;
+
+        for (auto i = 0u; i < QueryCount; ++i)
+        {
+            glm::vec3 eye{ position(rng), position(rng), position(rng) };
+            glm::vec3 target{ position(rng), position(rng), position(rng) };
+            glm::mat4 viewProjection = glm::perspective(1.2f, 1.7f, 1.0f, 800.0f) * glm::lookAt(eye, target, glm::vec3{ 0.0f, 1.0f, 0.0f });
+            frustums.emplace_back(viewProjection);
+        }
+
+        return frustums;
+    }
+
+    void RunBenchmark(uint32_t instanceCount)
+    {
+        std::mt19937 rng{ instanceCount };
+        std::vector<AxisAlignedBox3D> bounds = MakeInstanceBounds(instanceCount, rng);
+        std::vector<Frustum> frustums = MakeFrustums(rng);
+
+        BoundingVolumeHierarchy hierarchy;
+        hierarchy.Build(bounds);
+        float builtCost = hierarchy.SAHCost();
+
+        // Move 1% of instances the way animated objects do between frames
+        std::uniform_real_distribution<float> offset{ -5.0f, 5.0f };
+        for (auto i = 0u; i < instanceCount / 100; ++i)
+        {
+            uint32_t instanceIdx = rng() % instanceCount;
+            glm::vec3 translation{ offset(rng), offset(rng), offset(rng) };
+            bounds[instanceIdx] = { bounds[instanceIdx].Min + translation, bounds[instanceIdx].Max + translation };
+            hierarchy.SetPrimitiveBounds(instanceIdx, bounds[instanceIdx]);
+        }
+
+        hierarchy.Refit();
+
+        std::vector<std::vector<uint32_t>> hierarchyResults(QueryCount);
+        std::vector<std::vector<uint32_t>> bruteForceResults(QueryCount);
+
+        double hierarchyFrustumTime = Tests::MeasureMilliseconds([&] {
+            for (auto q = 0u; q < QueryCount; ++q)
+                hierarchy.QueryFrustum(frustums[q], [&](uint32_t instanceIdx) { hierarchyResults[q].push_back(instanceIdx); });
+        });
+
+        double bruteForceFrustumTime = Tests::MeasureMilliseconds([&] {
+            for (auto q = 0u; q < QueryCount; ++q)
+                for (auto instanceIdx = 0u; instanceIdx < instanceCount; ++instanceIdx)
+                    if (Collision::FrustumAABB(frustums[q], bounds[instanceIdx])) bruteForceResults[q].push_back(instanceIdx);
+        });
+
+        for (auto q = 0u; q < QueryCount; ++q)
+        {
+            std::sort(hierarchyResults[q].begin(), hierarchyResults[q].end());
+            PF_CHECK(hierarchyResults[q] == bruteForceResults[q]);
+        }
+
+        // Overlap queries around random points
+        std::uniform_real_distribution<float> position{ -1000.0f, 1000.0f };
+        for (auto q = 0u; q < QueryCount; ++q)
+        {
+            glm::vec3 center{ position(rng), position(rng), position(rng) };
+            AxisAlignedBox3D queryBox{ center - glm::vec3{ 100.0f }, center + glm::vec3{ 100.0f } };
+            std::vector<uint32_t> hierarchyOverlaps;
+            std::vector<uint32_t> bruteForceOverlaps;
+
+            hierarchy.QueryOverlaps(queryBox, [&](uint32_t instanceIdx) { hierarchyOverlaps.push_back(instanceIdx); });
+
+            for (auto instanceIdx = 0u; instanceIdx < instanceCount; ++instanceIdx)
+                if (Collision::AABBAABB(queryBox, bounds[instanceIdx])) bruteForceOverlaps.push_back(instanceIdx);
+
+            std::sort(hierarchyOverlaps.begin(), hierarchyOverlaps.end());
+            PF_CHECK(hierarchyOverlaps == bruteForceOverlaps);
+        }
+
+        // Closest hits of rays crossing the whole scene
+        double hierarchyRayTime = 0.0;
+        double bruteForceRayTime = 0.0;
+
+        for (auto q = 0u; q < QueryCount; ++q)
+        {
+            glm::vec3 origin{ -1200.0f, position(rng) * 0.5f, position(rng) * 0.5f };
+            Ray3D ray{ origin, glm::normalize(glm::vec3{ 1.0f, position(rng) * 1e-4f, position(rng) * 1e-4f }) };
+
+            std::optional<BoundingVolumeHierarchy::RayHit> hit;
+            hierarchyRayTime += Tests::MeasureMilliseconds([&] {
+                hit = hierarchy.RaycastClosest(ray, [&](uint32_t instanceIdx, float& distance) { return Collision::RayAABB(ray, bounds[instanceIdx], distance); });
+            });
+
+            float closestDistance = std::numeric_limits<float>::max();
+            bruteForceRayTime += Tests::MeasureMilliseconds([&] {
+                for (const AxisAlignedBox3D& box : bounds)
+                {
+                    float distance = 0.0f;
+                    if (Collision::RayAABB(ray, box, distance)) closestDistance = std::min(closestDistance, distance);
+                }
+            });
+
+            PF_CHECK(hit.has_value() == (closestDistance != std::numeric_limits<float>::max()));
+            PF_CHECK(!hit || hit->Distance == closestDistance);
+        }
+
+        const BoundingVolumeHierarchy::Statistics& stats = hierarchy.GetStatistics();
+
+        std::printf("%8u instances: build %8.3f ms, refit %7.3f ms, depth %2u, SAH cost %.1f -> %.1f\n",
+            instanceCount, stats.BuildTime.count() / 1000.0, stats.RefitTime.count() / 1000.0, stats.Depth, builtCost, hierarchy.SAHCost());
+        std::printf("%8s frustum query %8.3f ms vs brute force %8.3f ms, closest ray %7.3f ms vs brute force %8.3f ms\n", "",
+            hierarchyFrustumTime / QueryCount, bruteForceFrustumTime / QueryCount, hierarchyRayTime / QueryCount, bruteForceRayTime / QueryCount);
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<uint32_t> instanceCounts = Tests::IsQuickRun(argc, argv) ?
+        std::vector<uint32_t>{ 10000 } : std::vector<uint32_t>{ 10000, 100000, 1000000 };
+
+    for (uint32_t instanceCount : instanceCounts)
+    {
+        RunBenchmark(instanceCount);
+    }
+
+    return Tests::Result();
+}
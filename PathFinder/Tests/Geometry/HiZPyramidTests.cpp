@@ -0,0 +1,246 @@
+#include <TestHelpers.hpp>
+
+#include <Geometry/HiZPyramid.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Geometry;
+
+namespace
+{
+
+    struct TestCamera
+    {
+        glm::mat4 View;
+        glm::mat4 ViewProjection;
+    };
+
+    TestCamera MakeCamera(uint32_t width, uint32_t height, const glm::vec3& position = glm::vec3{ 0.0f })
+    {
+        glm::mat4 view = glm::lookAtLH(position, position + glm::vec3{ 0.0f, 0.0f, 1.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f });
+        glm::mat4 projection = glm::perspectiveLH_ZO(glm::radians(60.0f), float(width) / height, 0.1f, 1000.0f);
+        return { view, projection * view };
+    }
+
+    // View depth of a wall at z = 10 spanning [-4, 4] on X and Y, nothing behind it
+    std::vector<float> RenderWallDepth(const TestCamera& camera, const glm::vec3& position, uint32_t width, uint32_t height)
+    {
+        glm::mat4 inverseViewProjection = glm::inverse(camera.ViewProjection);
+        std::vector<float> depth(width * height);
+
+        for (auto y = 0u; y < height; ++y)
+        {
+            for (auto x = 0u; x < width; ++x)
+            {
+                glm::vec2 ndc{ ((x + 0.5f) / width) * 2.0f - 1.0f, 1.0f - ((y + 0.5f) / height) * 2.0f };
+                glm::vec4 farPoint = inverseViewProjection * glm::vec4{ ndc, 1.0f, 1.0f };
+                glm::vec3 direction = glm::normalize(glm::vec3{ farPoint } / farPoint.w - position);
+                glm::vec3 hit = position + direction * ((10.0f - position.z) / direction.z);
+                bool hitsWall = std::abs(hit.x) <= 4.0f && std::abs(hit.y) <= 4.0f;
+                depth[y * width + x] = hitsWall ? 10.0f - position.z : std::numeric_limits<float>::max();
+            }
+        }
+
+        return depth;
+    }
+
+    void TestReduction()
+    {
+        const uint32_t width = 101, height = 57, texelSize = 8;
+
+        std::mt19937 rng{ 7 };
+        std::uniform_real_distribution<float> distribution{ 1.0f, 100.0f };
+        std::vector<float> depth(width * height);
+        for (float& d : depth) d = distribution(rng);
+
+        std::vector<float> base = HiZPyramid::ReduceViewDepth(depth.data(), { width, height }, texelSize);
+        uint32_t baseWidth = HiZPyramid::BaseLevelSize(width, texelSize);
+        uint32_t baseHeight = HiZPyramid::BaseLevelSize(height, texelSize);
+
+        PF_CHECK(base.size() == baseWidth * baseHeight);
+
+        for (auto y = 0u; y < baseHeight; ++y)
+        {
+            for (auto x = 0u; x < baseWidth; ++x)
+            {
+                float farthest = 0.0f;
+
+                for (auto py = y * texelSize; py < std::min((y + 1) * texelSize, height); ++py)
+                    for (auto px = x * texelSize; px < std::min((x + 1) * texelSize, width); ++px)
+                        farthest = std::max(farthest, depth[py * width + px]);
+
+                PF_CHECK(base[y * baseWidth + x] == farthest);
+            }
+        }
+    }
+
+    void TestWallOccluder()
+    {
+        const uint32_t width = 1920, height = 1080, texelSize = 8;
+        TestCamera camera = MakeCamera(width, height);
+        std::vector<float> depth = RenderWallDepth(camera, glm::vec3{ 0.0f }, width, height);
+
+        std::vector<float> base = HiZPyramid::ReduceViewDepth(depth.data(), { width, height }, texelSize);
+        HiZPyramid pyramid;
+        pyramid.Build(base.data(), { width, height }, texelSize, camera.View, camera.ViewProjection);
+
+        PF_CHECK(!pyramid.IsEmpty());
+        PF_CHECK(pyramid.Levels()[0].Width == HiZPyramid::BaseLevelSize(width, texelSize));
+        PF_CHECK(pyramid.Levels().back().Width == 1 && pyramid.Levels().back().Height == 1);
+
+        PF_CHECK(pyramid.IsOccluded({ { -1, -1, 20 }, { 1, 1, 22 } }));
+        PF_CHECK(pyramid.IsOccluded({ { 0, 0, 500 }, { 0.1f, 0.1f, 500.1f } }));
+        PF_CHECK(pyramid.IsOccluded({ { -3, -3, 11 }, { 3, 3, 12 } }));
+
+        PF_CHECK(!pyramid.IsOccluded({ { -1, -1, 5 }, { 1, 1, 6 } }));       // In front of the wall
+        PF_CHECK(!pyramid.IsOccluded({ { -1, -1, 20 }, { 9, 1, 22 } }));     // Sticks out from behind the wall
+        PF_CHECK(!pyramid.IsOccluded({ { -1, -1, 9 }, { 1, 1, 12 } }));      // Straddles the wall
+        PF_CHECK(!pyramid.IsOccluded({ { -1, -1, -1 }, { 1, 1, 2 } }));      // Crosses near plane
+        PF_CHECK(!pyramid.IsOccluded({ { -100, -1, 20 }, { -90, 1, 22 } })); // Off screen
+
+        pyramid.Clear();
+        PF_CHECK(pyramid.IsEmpty());
+        PF_CHECK(!pyramid.IsOccluded({ { -1, -1, 20 }, { 1, 1, 22 } }));
+    }
+
+    // GPU addresses levels in a single buffer by these sizes, they have to match levels built on CPU
+    void TestLevelSizes()
+    {
+        for (Dimensions viewport : { Dimensions{ 1920, 1080 }, Dimensions{ 1000, 600 }, Dimensions{ 57, 9 }, Dimensions{ 8, 8 } })
+        {
+            const uint32_t texelSize = 8;
+            uint32_t baseWidth = HiZPyramid::BaseLevelSize(viewport.Width, texelSize);
+            uint32_t baseHeight = HiZPyramid::BaseLevelSize(viewport.Height, texelSize);
+
+            std::vector<float> base(baseWidth * baseHeight, 1.0f);
+            TestCamera camera = MakeCamera(uint32_t(viewport.Width), uint32_t(viewport.Height));
+            HiZPyramid pyramid;
+            pyramid.Build(base.data(), viewport, texelSize, camera.View, camera.ViewProjection);
+
+            std::vector<Dimensions> levelSizes = HiZPyramid::LevelSizes(baseWidth, baseHeight);
+
+            PF_CHECK(levelSizes.size() == pyramid.Levels().size());
+            PF_CHECK(levelSizes.back().Width == 1 && levelSizes.back().Height == 1);
+
+            for (auto level = 0u; level < std::min(levelSizes.size(), pyramid.Levels().size()); ++level)
+            {
+                PF_CHECK(levelSizes[level].Width == pyramid.Levels()[level].Width);
+                PF_CHECK(levelSizes[level].Height == pyramid.Levels()[level].Height);
+            }
+        }
+    }
+
+    // First phase rejects against a pyramid of an older camera, which can hide instances that became visible.
+    // Second phase retests them against a pyramid built with the current camera from depth of first phase survivors.
+    void TestTwoPhaseCulling()
+    {
+        const uint32_t width = 480, height = 270, texelSize = 8;
+
+        auto buildPyramid = [&](const glm::vec3& position)
+        {
+            TestCamera camera = MakeCamera(width, height, position);
+            std::vector<float> depth = RenderWallDepth(camera, position, width, height);
+            std::vector<float> base = HiZPyramid::ReduceViewDepth(depth.data(), { width, height }, texelSize);
+            HiZPyramid pyramid;
+            pyramid.Build(base.data(), { width, height }, texelSize, camera.View, camera.ViewProjection);
+            return pyramid;
+        };
+
+        // Built when the camera was at the origin
+        HiZPyramid olderPyramid = buildPyramid(glm::vec3{ 0.0f });
+        // Camera moved sideways since, only the wall survived the first phase and was drawn
+        HiZPyramid currentPyramid = buildPyramid(glm::vec3{ 8.0f, 0.0f, 0.0f });
+
+        AxisAlignedBox3D disoccludedBox{ { -1, -1, 20 }, { 1, 1, 22 } };
+        AxisAlignedBox3D hiddenBox{ { -17, -1, 30 }, { -15, 1, 31 } };
+
+        PF_CHECK(olderPyramid.IsOccluded(disoccludedBox));
+        PF_CHECK(!currentPyramid.IsOccluded(disoccludedBox));
+
+        PF_CHECK(currentPyramid.IsOccluded(hiddenBox));
+    }
+
+    // Every box the pyramid rejects must be behind every full resolution depth sample it covers
+    void TestConservativeAgainstFullResolution()
+    {
+        const uint32_t width = 1000, height = 600, texelSize = 8;
+        TestCamera camera = MakeCamera(width, height);
+
+        std::mt19937 rng{ 1 };
+        std::uniform_real_distribution<float> unit{ 0.0f, 1.0f };
+        std::vector<float> depth(width * height);
+
+        for (auto y = 0u; y < height; ++y)
+            for (auto x = 0u; x < width; ++x)
+                depth[y * width + x] = (x / 37 + y / 23) % 3 == 0 ? 1e30f : 5.0f + 10.0f * unit(rng);
+
+        std::vector<float> base = HiZPyramid::ReduceViewDepth(depth.data(), { width, height }, texelSize);
+        HiZPyramid pyramid;
+        pyramid.Build(base.data(), { width, height }, texelSize, camera.View, camera.ViewProjection);
+
+        uint32_t occludedCount = 0;
+        uint32_t unsoundCount = 0;
+
+        for (auto i = 0u; i < 50000; ++i)
+        {
+            glm::vec3 center{ (unit(rng) - 0.5f) * 30.0f, (unit(rng) - 0.5f) * 20.0f, unit(rng) * 40.0f };
+            glm::vec3 extent{ unit(rng) * 3.0f, unit(rng) * 3.0f, unit(rng) * 3.0f };
+            AxisAlignedBox3D box{ center - extent, center + extent };
+
+            if (!pyramid.IsOccluded(box)) continue;
+
+            ++occludedCount;
+
+            float nearestDepth = std::numeric_limits<float>::max();
+            glm::vec2 ndcMin{ std::numeric_limits<float>::max() };
+            glm::vec2 ndcMax{ std::numeric_limits<float>::lowest() };
+
+            for (auto corner = 0u; corner < 8; ++corner)
+            {
+                glm::vec4 point{ corner & 1 ? box.Max.x : box.Min.x, corner & 2 ? box.Max.y : box.Min.y, corner & 4 ? box.Max.z : box.Min.z, 1.0f };
+                glm::vec4 clip = camera.ViewProjection * point;
+                glm::vec2 ndc = glm::vec2{ clip } / clip.w;
+                nearestDepth = std::min(nearestDepth, (camera.View * point).z);
+                ndcMin = glm::min(ndcMin, ndc);
+                ndcMax = glm::max(ndcMax, ndc);
+            }
+
+            ndcMin = glm::clamp(ndcMin, glm::vec2{ -1.0f }, glm::vec2{ 1.0f });
+            ndcMax = glm::clamp(ndcMax, glm::vec2{ -1.0f }, glm::vec2{ 1.0f });
+
+            int x0 = int((ndcMin.x * 0.5f + 0.5f) * width);
+            int x1 = std::min(int((ndcMax.x * 0.5f + 0.5f) * width), int(width - 1));
+            int y0 = int((0.5f - ndcMax.y * 0.5f) * height);
+            int y1 = std::min(int((0.5f - ndcMin.y * 0.5f) * height), int(height - 1));
+
+            bool isVisibleSomewhere = false;
+
+            for (int y = y0; y <= y1 && !isVisibleSomewhere; ++y)
+                for (int x = x0; x <= x1 && !isVisibleSomewhere; ++x)
+                    isVisibleSomewhere = depth[y * width + x] >= nearestDepth;
+
+            unsoundCount += isVisibleSomewhere;
+        }
+
+        std::printf("Random boxes: %u occluded, %u wrongly occluded\n", occludedCount, unsoundCount);
+
+        PF_CHECK(occludedCount > 0);
+        PF_CHECK(unsoundCount == 0);
+    }
+
+}
+
+int main()
+{
+    TestReduction();
+    TestWallOccluder();
+    TestLevelSizes();
+    TestTwoPhaseCulling();
+    TestConservativeAgainstFullResolution();
+    return Tests::Result();
+}
@@ -0,0 +1,410 @@
+#define DDSKTX_IMPLEMENT
+
+#include <TestHelpers.hpp>
+
+#include <Scene/DistanceFieldBaker.hpp>
+#include <Scene/DDSFileHeader.hpp>
+
+#include <glm/geometric.hpp>
+#include <glm/vec3.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace PathFinder;
+
+namespace
+{
+
+    // Largest distance baked fields can store, distances are packed as unorms of this range
+    const float MaxVoxelDistance = std::sqrt(3.0f);
+    const float QuantizationError = MaxVoxelDistance / 65535.0f * 2.0f;
+
+    struct Displacement
+    {
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        std::vector<uint8_t> Texels;
+
+        float Value(uint32_t x, uint32_t y) const
+        {
+            return x < Width && y < Height ? Texels[uint64_t(y) * Width + x] / 255.0f : 0.0f;
+        }
+    };
+
+    Displacement MakeDisplacement(uint32_t width, uint32_t height, const std::function<float(float, float)>& heightAt)
+    {
+        Displacement displacement{ width, height, std::vector<uint8_t>(uint64_t(width) * height) };
+
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                float value = std::clamp(heightAt(float(x), float(y)), 0.0f, 1.0f);
+                displacement.Texels[uint64_t(y) * width + x] = uint8_t(value * 255.0f);
+            }
+        }
+
+        return displacement;
+    }
+
+    // Single mip R8 texture, the way displacement maps are usually stored
+    void WriteDDS(const std::filesystem::path& path, const Displacement& displacement)
+    {
+        DDSFileHeader header{};
+        header.Magic = DDSMagic;
+        header.Size = DDSHeaderSize;
+        header.Flags = DDSDCaps | DDSDHeight | DDSDWidth | DDSDPixelFormat;
+        header.Height = displacement.Height;
+        header.Width = displacement.Width;
+        header.Depth = 1;
+        header.MipCount = 1;
+        header.PixelFormatSize = 32;
+        header.PixelFormatFlags = DDPFFourCC;
+        header.FourCC = DX10FourCC;
+        header.Caps[0] = DDSCapsTexture;
+        header.DXGIFormat = 61; // DXGI_FORMAT_R8_UNORM
+        header.ResourceDimension = D3D10ResourceDimensionTexture2D;
+        header.ArraySize = 1;
+
+        std::ofstream stream{ path, std::ios::binary | std::ios::trunc };
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(displacement.Texels.data()), displacement.Texels.size());
+    }
+
+    // Octant of a direction as VectorOctant() of shaders picks it
+    uint32_t DirectionCone(int32_t x, int32_t y, int32_t z)
+    {
+        uint32_t cone = std::abs(x) > std::abs(z) ? (x < 0 ? 0 : 2) : (z < 0 ? 3 : 1);
+        return y < 0 ? cone + 4 : cone;
+    }
+
+    enum class VoxelKind { Free, Seed, Under };
+
+    // Seeds travel only along flood offsets of their cone, so a cone sees the part of its octant
+    // that sums of those offsets reach, which for some cones is a plane or a single diagonal.
+    // Reachable voxel offsets are found by a search over sums of flood offsets.
+    class ConeReach
+    {
+    public:
+        ConeReach(uint32_t width, uint32_t height, uint32_t depth)
+            : mExtent{ int32_t(width) - 1, int32_t(height) - 1, int32_t(depth) - 1 }
+        {
+            uint64_t boxSize = uint64_t(mExtent[0] * 2 + 1) * (mExtent[1] * 2 + 1) * (mExtent[2] * 2 + 1);
+
+            for (uint32_t cone = 0; cone < 8; ++cone)
+            {
+                std::vector<std::array<int32_t, 3>> offsets;
+
+                for (int32_t z = -1; z <= 1; ++z)
+                    for (int32_t y = -1; y <= 1; ++y)
+                        for (int32_t x = -1; x <= 1; ++x)
+                            if ((x != 0 || y != 0 || z != 0) && DirectionCone(x, y, z) == cone) offsets.push_back({ x, y, z });
+
+                std::vector<bool>& reachable = mReachable[cone];
+                reachable.resize(boxSize);
+
+                std::vector<std::array<int32_t, 3>> front{ { 0, 0, 0 } };
+
+                while (!front.empty())
+                {
+                    std::array<int32_t, 3> delta = front.back();
+                    front.pop_back();
+
+                    for (const std::array<int32_t, 3>& offset : offsets)
+                    {
+                        std::array<int32_t, 3> next{ delta[0] + offset[0], delta[1] + offset[1], delta[2] + offset[2] };
+
+                        if (IsInBox(next) && !reachable[BoxIndex(next)])
+                        {
+                            reachable[BoxIndex(next)] = true;
+                            front.push_back(next);
+                        }
+                    }
+                }
+            }
+        }
+
+        bool IsReachable(uint32_t cone, const std::array<int32_t, 3>& delta) const
+        {
+            return mReachable[cone][BoxIndex(delta)];
+        }
+
+    private:
+        bool IsInBox(const std::array<int32_t, 3>& delta) const
+        {
+            return std::abs(delta[0]) <= mExtent[0] && std::abs(delta[1]) <= mExtent[1] && std::abs(delta[2]) <= mExtent[2];
+        }
+
+        uint64_t BoxIndex(const std::array<int32_t, 3>& delta) const
+        {
+            return (uint64_t(delta[2] + mExtent[2]) * (mExtent[1] * 2 + 1) + (delta[1] + mExtent[1])) * (mExtent[0] * 2 + 1) + (delta[0] + mExtent[0]);
+        }
+
+        std::array<int32_t, 3> mExtent;
+        std::array<std::vector<bool>, 8> mReachable;
+    };
+
+    // Exact distances from every voxel to the closest seed each of its cones can reach, found by testing every seed.
+    // Voxels are classified by scanning displacement texels one by one, independently of the baker.
+    class BruteForceField
+    {
+    public:
+        BruteForceField(const Displacement& displacement, uint32_t width, uint32_t height, uint32_t depth)
+            : mWidth{ width }, mHeight{ height }, mDepth{ depth }, mKinds(uint64_t(width) * height * depth), mDistances(mKinds.size())
+        {
+            uint32_t texelCountX = uint32_t(1.0f / width * displacement.Width);
+            uint32_t texelCountY = uint32_t(1.0f / height * displacement.Height);
+
+            for (uint32_t z = 0; z < depth; ++z)
+            {
+                for (uint32_t y = 0; y < height; ++y)
+                {
+                    for (uint32_t x = 0; x < width; ++x)
+                    {
+                        uint32_t originX = uint32_t((x + 0.5f) / width * displacement.Width);
+                        uint32_t originY = uint32_t((y + 0.5f) / height * displacement.Height);
+                        float voxelBottom = (z + 0.5f) / depth;
+                        float voxelTop = voxelBottom + 1.0f / depth;
+
+                        bool isIntersected = false;
+                        bool isUnder = true;
+
+                        for (uint32_t texelY = originY; texelY < originY + texelCountY; ++texelY)
+                        {
+                            for (uint32_t texelX = originX; texelX < originX + texelCountX; ++texelX)
+                            {
+                                float value = displacement.Value(texelX, texelY);
+                                isIntersected = isIntersected || (value >= voxelBottom && value < voxelTop);
+                                isUnder = isUnder && value > voxelTop;
+                            }
+                        }
+
+                        VoxelKind kind = isIntersected ? VoxelKind::Seed : (isUnder ? VoxelKind::Under : VoxelKind::Free);
+                        mKinds[Index(x, y, z)] = kind;
+
+                        if (kind == VoxelKind::Seed)
+                        {
+                            mSeeds.push_back({ int32_t(x), int32_t(y), int32_t(z) });
+                        }
+                    }
+                }
+            }
+
+            ConeReach reach{ width, height, depth };
+
+            for (uint32_t z = 0; z < depth; ++z)
+            {
+                for (uint32_t y = 0; y < height; ++y)
+                {
+                    for (uint32_t x = 0; x < width; ++x)
+                    {
+                        std::array<float, 8>& distances = mDistances[Index(x, y, z)];
+                        distances.fill(std::numeric_limits<float>::infinity());
+
+                        if (mKinds[Index(x, y, z)] != VoxelKind::Free) continue;
+
+                        for (const std::array<int32_t, 3>& seed : mSeeds)
+                        {
+                            std::array<int32_t, 3> delta{ seed[0] - int32_t(x), seed[1] - int32_t(y), seed[2] - int32_t(z) };
+                            uint32_t cone = DirectionCone(delta[0], delta[1], delta[2]);
+
+                            if (reach.IsReachable(cone, delta))
+                            {
+                                distances[cone] = std::min(distances[cone], CentersDistance(x, y, z, seed));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        uint64_t Index(uint32_t x, uint32_t y, uint32_t z) const
+        {
+            return (uint64_t(z) * mHeight + y) * mWidth + x;
+        }
+
+        VoxelKind Kind(uint64_t voxelIndex) const { return mKinds[voxelIndex]; }
+        const std::array<float, 8>& Distances(uint64_t voxelIndex) const { return mDistances[voxelIndex]; }
+        uint64_t SeedCount() const { return mSeeds.size(); }
+
+    private:
+        float CentersDistance(uint32_t x, uint32_t y, uint32_t z, const std::array<int32_t, 3>& seed) const
+        {
+            float dx = (seed[0] - float(x)) / mWidth;
+            float dy = (seed[1] - float(y)) / mHeight;
+            float dz = (seed[2] - float(z)) / mDepth;
+            return std::sqrt(dx * dx + dy * dy + dz * dz);
+        }
+
+        uint32_t mWidth;
+        uint32_t mHeight;
+        uint32_t mDepth;
+        std::vector<VoxelKind> mKinds;
+        std::vector<std::array<float, 8>> mDistances;
+        std::vector<std::array<int32_t, 3>> mSeeds;
+    };
+
+    // Reverse of PackUnorm2x16() of the baker, the first cone of a pair is in the high half
+    std::array<float, 8> UnpackDistances(const glm::uvec4& voxel)
+    {
+        std::array<float, 8> distances{};
+
+        for (uint32_t pair = 0; pair < 4; ++pair)
+        {
+            distances[pair * 2] = (voxel[pair] >> 16) / 65535.0f * MaxVoxelDistance;
+            distances[pair * 2 + 1] = (voxel[pair] & 0xFFFFu) / 65535.0f * MaxVoxelDistance;
+        }
+
+        return distances;
+    }
+
+    struct ErrorBounds
+    {
+        // Share of cones with a seed whose baked distance isn't the exact one
+        float InexactConeShare = 0.0f;
+
+        // Relative to the diagonal of a voxel, averaged over all cones with a seed
+        float MeanError = 0.0f;
+    };
+
+    void CheckAgainstBruteForce(
+        const char* name,
+        const std::filesystem::path& folder,
+        const Displacement& displacement,
+        const Geometry::Dimensions& fieldSize,
+        const ErrorBounds& bounds)
+    {
+        std::filesystem::path path = folder / (std::string{ name } + ".dds");
+        WriteDDS(path, displacement);
+
+        Foundation::MemoryMappedFile file{ path };
+        ddsktx_texture_info info{};
+        ddsktx_error error{};
+        PF_CHECK(ddsktx_parse(&info, file.Data(), (int)file.Size(), &error));
+
+        uint32_t width = uint32_t(fieldSize.Width);
+        uint32_t height = uint32_t(fieldSize.Height);
+        uint32_t depth = uint32_t(fieldSize.Depth);
+
+        DistanceFieldBaker baker;
+        std::optional<std::vector<glm::uvec4>> field;
+        double bakeTime = Tests::MeasureMilliseconds([&] { field = baker.Bake(info, file, fieldSize); });
+
+        std::optional<BruteForceField> reference;
+        double referenceTime = Tests::MeasureMilliseconds([&] { reference.emplace(displacement, width, height, depth); });
+
+        if (!PF_CHECK(field && field->size() == uint64_t(width) * height * depth)) return;
+
+        PF_CHECK(baker.GetStatistics().BakedFieldCount == 1);
+
+        // Baking is deterministic regardless of how rows are spread across threads
+        PF_CHECK(baker.Bake(info, file, fieldSize) == field);
+
+        float voxelDiagonal = glm::length(glm::vec3{ 1.0f / width, 1.0f / height, 1.0f / depth });
+
+        uint64_t coneCount = 0;
+        uint64_t inexactConeCount = 0;
+        uint64_t closerThanExactCount = 0;
+        uint64_t misclassifiedCount = 0;
+        double errorSum = 0.0;
+        float maxError = 0.0f;
+
+        for (uint64_t voxelIdx = 0; voxelIdx < field->size(); ++voxelIdx)
+        {
+            std::array<float, 8> baked = UnpackDistances((*field)[voxelIdx]);
+            const std::array<float, 8>& exact = reference->Distances(voxelIdx);
+
+            for (uint32_t cone = 0; cone < 8; ++cone)
+            {
+                // Seeds, voxels under the surface and cones without seeds are stored as zero
+                if (reference->Kind(voxelIdx) != VoxelKind::Free || std::isinf(exact[cone]))
+                {
+                    misclassifiedCount += baked[cone] != 0.0f;
+                    continue;
+                }
+
+                // Distances beyond the packing range saturate
+                float expected = std::min(exact[cone], MaxVoxelDistance);
+                float coneError = baked[cone] - expected;
+
+                // A cone that never learned of its seed is stored as zero, which is worse than any found seed
+                if (baked[cone] == 0.0f)
+                {
+                    coneError = expected;
+                }
+
+                ++coneCount;
+                closerThanExactCount += coneError < -QuantizationError;
+
+                if (coneError > QuantizationError)
+                {
+                    ++inexactConeCount;
+                    errorSum += coneError / voxelDiagonal;
+                    maxError = std::max(maxError, coneError / voxelDiagonal);
+                }
+            }
+        }
+
+        float inexactShare = coneCount > 0 ? float(inexactConeCount) / coneCount : 0.0f;
+        float meanError = coneCount > 0 ? float(errorSum / coneCount) : 0.0f;
+
+        std::printf("%-10s %4ux%4ux%3u, %6llu seeds: bake %8.2f ms, brute force %9.2f ms, inexact cones %6.3f%%, mean error %.4f, max error %6.3f voxels\n",
+            name, width, height, depth, (unsigned long long)reference->SeedCount(), bakeTime, referenceTime, inexactShare * 100.0f, meanError, maxError);
+
+        // Flooding only ever moves seeds along their cones, it can't find seeds closer than the closest one
+        PF_CHECK(closerThanExactCount == 0);
+        PF_CHECK(misclassifiedCount == 0);
+        PF_CHECK(inexactShare <= bounds.InexactConeShare);
+        PF_CHECK(meanError <= bounds.MeanError);
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    bool isQuickRun = Tests::IsQuickRun(argc, argv);
+
+    std::filesystem::path folder = std::filesystem::temp_directory_path() / "PathFinderDistanceFieldBakerTests";
+    std::filesystem::create_directories(folder);
+
+    std::mt19937 rng{ 1 };
+    std::uniform_real_distribution<float> noise{ 0.0f, 0.05f };
+
+    Displacement plane = MakeDisplacement(256, 256, [](float, float) { return 0.3f; });
+    Displacement waves = MakeDisplacement(512, 384, [&](float x, float y) { return 0.5f + 0.3f * std::sin(x * 0.03f) * std::cos(y * 0.05f) + noise(rng); });
+    Displacement bumps = MakeDisplacement(512, 512, [](float x, float y)
+    {
+        float cellX = std::fmod(x, 64.0f) - 32.0f;
+        float cellY = std::fmod(y, 64.0f) - 32.0f;
+        return std::max(0.0f, 0.9f - std::sqrt(cellX * cellX + cellY * cellY) / 32.0f);
+    });
+
+    // Jump flooding can step over voxels under the surface, which block paths of single steps, and misses
+    // a few seeds that refinement passes don't recover. Those cones get a farther seed or none, hence bounds on how often
+    // and how much distances are off on average rather than on the worst cone.
+    CheckAgainstBruteForce("Plane", folder, plane, { 32, 32, 16 }, { 0.005f, 0.01f });
+    CheckAgainstBruteForce("Waves", folder, waves, { 32, 32, 16 }, { 0.02f, 0.05f });
+    CheckAgainstBruteForce("Bumps", folder, bumps, { 32, 32, 16 }, { 0.02f, 0.05f });
+
+    if (!isQuickRun)
+    {
+        CheckAgainstBruteForce("Waves", folder, waves, { 64, 64, 32 }, { 0.02f, 0.05f });
+        CheckAgainstBruteForce("Bumps", folder, bumps, { 64, 64, 32 }, { 0.02f, 0.05f });
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(folder, error);
+
+    return Tests::Result();
+}
@@ -0,0 +1,194 @@
+#include <TestHelpers.hpp>
+
+#include <Scene/MeshInstanceBatcher.hpp>
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace PathFinder;
+
+namespace
+{
+
+    const uint32_t MeshCount = 12;
+    const uint32_t MaterialCount = 5;
+    const uint32_t LODCount = 3;
+
+    uint32_t ExpectedIndexCount(uint32_t meshIdx, uint32_t lod)
+    {
+        return (meshIdx + 1) * 3000 / (lod + 1);
+    }
+
+    struct SyntheticScene
+    {
+        Foundation::SlotMap<Mesh> Meshes;
+        Foundation::SlotMap<Material> Materials;
+        Foundation::SlotMap<MeshInstance> Instances;
+        std::vector<MeshHandle> MeshHandles;
+        std::vector<MaterialHandle> MaterialHandles;
+    };
+
+    void BuildScene(SyntheticScene& scene, uint32_t instanceCount, std::mt19937& rng)
+    {
+        for (auto meshIdx = 0u; meshIdx < MeshCount; ++meshIdx)
+        {
+            Mesh mesh;
+            VertexStorageLocation location;
+            location.IndexBufferOffset = meshIdx * 100000;
+            location.IndexCount = ExpectedIndexCount(meshIdx, 0);
+            mesh.SetVertexStorageLocation(location);
+
+            std::vector<IndexStorageLocation> lodLocations;
+            for (auto lod = 1u; lod < LODCount; ++lod)
+            {
+                mesh.AddLOD(MeshLOD{});
+                lodLocations.push_back({ location.IndexBufferOffset + lod * 10000, ExpectedIndexCount(meshIdx, lod) });
+            }
+
+            mesh.SetLODIndexStorageLocations(std::move(lodLocations));
+            scene.MeshHandles.push_back(scene.Meshes.Insert(std::move(mesh)));
+        }
+
+        for (auto materialIdx = 0u; materialIdx < MaterialCount; ++materialIdx)
+        {
+            scene.MaterialHandles.push_back(scene.Materials.Emplace());
+        }
+
+        std::vector<MeshInstanceHandle> instanceHandles;
+
+        for (auto instanceIdx = 0u; instanceIdx < instanceCount; ++instanceIdx)
+        {
+            MeshInstance instance{ scene.MeshHandles[rng() % MeshCount], scene.MaterialHandles[rng() % MaterialCount] };
+            instance.SetLOD(rng() % LODCount);
+            instanceHandles.push_back(scene.Instances.Insert(std::move(instance)));
+        }
+
+        // Removals make dense order differ from insertion order
+        for (auto instanceIdx = 0u; instanceIdx < instanceCount; instanceIdx += 7)
+        {
+            scene.Instances.Erase(instanceHandles[instanceIdx]);
+        }
+
+        // Instance table indices are unrelated to dense indices
+        std::vector<uint32_t> tableIndices(scene.Instances.size());
+        std::iota(tableIndices.begin(), tableIndices.end(), 1000);
+        std::shuffle(tableIndices.begin(), tableIndices.end(), rng);
+
+        for (auto denseIdx = 0u; denseIdx < scene.Instances.size(); ++denseIdx)
+        {
+            scene.Instances.data()[denseIdx].SetIndexInGPUTable(tableIndices[denseIdx]);
+        }
+    }
+
+    std::vector<uint32_t> PickVisibleInstances(const SyntheticScene& scene, std::mt19937& rng)
+    {
+        std::vector<uint32_t> visibleInstances;
+
+        for (auto denseIdx = 0u; denseIdx < scene.Instances.size(); ++denseIdx)
+        {
+            if (rng() % 3 != 0) visibleInstances.push_back(denseIdx);
+        }
+
+        return visibleInstances;
+    }
+
+    void CheckCommands(const SyntheticScene& scene, const MeshInstanceBatcher& batcher, const std::vector<uint32_t>& visibleInstances)
+    {
+        // Commands are appended, so start with data already in the output
+        std::vector<GPUMeshInstanceDrawCommand> commands(2);
+        std::vector<uint32_t> batchInstanceList(5, 0xFFFFFFFF);
+
+        batcher.GenerateDrawCommands(scene.Instances, scene.Meshes, commands, batchInstanceList);
+
+        PF_CHECK(commands.size() == 2 + batcher.Batches().size());
+        PF_CHECK(batchInstanceList.size() == 5 + visibleInstances.size());
+
+        // Brute force grouping of visible instances by mesh, LOD and material
+        using BatchKey = std::tuple<uint32_t, uint32_t, uint32_t>;
+        std::map<BatchKey, std::vector<uint32_t>> expectedBatches;
+
+        for (uint32_t denseIdx : visibleInstances)
+        {
+            const MeshInstance& instance = scene.Instances.data()[denseIdx];
+            BatchKey key{ instance.AssociatedMesh().Index, instance.LOD(), instance.AssociatedMaterial().Index };
+            expectedBatches[key].push_back(instance.IndexInGPUTable());
+        }
+
+        PF_CHECK(batcher.Batches().size() == expectedBatches.size());
+
+        uint32_t expectedOffset = 5;
+
+        for (auto batchIdx = 0u; batchIdx < batcher.Batches().size(); ++batchIdx)
+        {
+            const MeshInstanceBatcher::Batch& batch = batcher.Batches()[batchIdx];
+            const GPUMeshInstanceDrawCommand& command = commands[2 + batchIdx];
+
+            PF_CHECK(command.BatchInstanceListOffset == expectedOffset);
+            PF_CHECK(command.Draw.VertexCountPerInstance == ExpectedIndexCount(batch.Mesh.Index, batch.LOD));
+            PF_CHECK(command.Draw.InstanceCount == batch.InstanceCount);
+            PF_CHECK(command.Draw.StartVertexLocation == 0);
+            PF_CHECK(command.Draw.StartInstanceLocation == 0);
+
+            auto expectedIt = expectedBatches.find({ batch.Mesh.Index, batch.LOD, batch.Material.Index });
+
+            if (PF_CHECK(expectedIt != expectedBatches.end()))
+            {
+                std::vector<uint32_t> listed{
+                    batchInstanceList.begin() + command.BatchInstanceListOffset,
+                    batchInstanceList.begin() + command.BatchInstanceListOffset + command.Draw.InstanceCount };
+
+                std::vector<uint32_t> expected = expectedIt->second;
+                std::sort(listed.begin(), listed.end());
+                std::sort(expected.begin(), expected.end());
+                PF_CHECK(listed == expected);
+            }
+
+            expectedOffset += command.Draw.InstanceCount;
+        }
+
+        PF_CHECK(expectedOffset == batchInstanceList.size());
+    }
+
+    void TestDrawCommands()
+    {
+        std::mt19937 rng{ 11 };
+        SyntheticScene scene;
+        BuildScene(scene, 5000, rng);
+
+        std::vector<uint32_t> visibleInstances = PickVisibleInstances(scene, rng);
+        MeshInstanceBatcher batcher;
+
+        PF_CHECK(batcher.Update(scene.Instances, visibleInstances, 1));
+        CheckCommands(scene, batcher, visibleInstances);
+
+        // Same input keeps batches
+        PF_CHECK(!batcher.Update(scene.Instances, visibleInstances, 1));
+
+        // A level of detail change of a single visible instance regroups
+        MeshInstance& changedInstance = scene.Instances.data()[visibleInstances[visibleInstances.size() / 2]];
+        changedInstance.SetLOD((changedInstance.LOD() + 1) % LODCount);
+        PF_CHECK(batcher.Update(scene.Instances, visibleInstances, 1));
+        CheckCommands(scene, batcher, visibleInstances);
+
+        // So does a different visible set
+        visibleInstances = PickVisibleInstances(scene, rng);
+        PF_CHECK(batcher.Update(scene.Instances, visibleInstances, 1));
+        CheckCommands(scene, batcher, visibleInstances);
+
+        // Nothing visible produces no commands
+        visibleInstances.clear();
+        PF_CHECK(batcher.Update(scene.Instances, visibleInstances, 1));
+        CheckCommands(scene, batcher, visibleInstances);
+    }
+
+}
+
+int main()
+{
+    TestDrawCommands();
+    return Tests::Result();
+}
@@ -0,0 +1,143 @@
+#include <TestHelpers.hpp>
+#include "SyntheticAssimpImporter.hpp"
+
+#include <Scene/MeshLoader.hpp>
+
+#include <tbb/global_control.h>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace PathFinder;
+
+namespace
+{
+
+    template <class T>
+    bool HaveSameBytes(const std::vector<T>& first, const std::vector<T>& second)
+    {
+        return first.size() == second.size() && std::memcmp(first.data(), second.data(), first.size() * sizeof(T)) == 0;
+    }
+
+    bool AreIdentical(const Mesh& first, const Mesh& second)
+    {
+        bool areLODsIdentical = first.LODs().size() == second.LODs().size();
+
+        for (uint32_t lod = 0; areLODsIdentical && lod < first.LODs().size(); ++lod)
+        {
+            areLODsIdentical = first.LODs()[lod].Indices == second.LODs()[lod].Indices && first.LODs()[lod].Error == second.LODs()[lod].Error;
+        }
+
+        return areLODsIdentical &&
+            first.Name() == second.Name() &&
+            first.SourceFile() == second.SourceFile() &&
+            first.IndexInSourceFile() == second.IndexInSourceFile() &&
+            first.Indices() == second.Indices() &&
+            first.MeshletVertexIndices() == second.MeshletVertexIndices() &&
+            first.MeshletTriangles() == second.MeshletTriangles() &&
+            HaveSameBytes(first.Vertices(), second.Vertices()) &&
+            HaveSameBytes(first.PackedVertices(), second.PackedVertices()) &&
+            HaveSameBytes(first.Meshlets(), second.Meshlets());
+    }
+
+    bool AreIdentical(const std::vector<std::vector<Mesh>>& first, const std::vector<std::vector<Mesh>>& second)
+    {
+        if (first.size() != second.size()) return false;
+
+        for (uint32_t fileIdx = 0; fileIdx < first.size(); ++fileIdx)
+        {
+            if (first[fileIdx].size() != second[fileIdx].size()) return false;
+
+            for (uint32_t meshIdx = 0; meshIdx < first[fileIdx].size(); ++meshIdx)
+            {
+                if (!AreIdentical(first[fileIdx][meshIdx], second[fileIdx][meshIdx])) return false;
+            }
+        }
+
+        return true;
+    }
+
+    void RunBenchmark(uint32_t fileCount, uint32_t meshesPerFile, uint32_t segmentCount, const std::vector<uint32_t>& threadCounts)
+    {
+        std::vector<std::string> fileNames;
+
+        for (uint32_t fileIdx = 0; fileIdx < fileCount; ++fileIdx)
+        {
+            fileNames.push_back(Tests::SyntheticMeshFileName("Scene" + std::to_string(fileIdx), meshesPerFile, segmentCount));
+        }
+
+        // Files are imported one by one on a single thread, the way loading worked before it was parallel
+        std::vector<std::vector<Mesh>> serialMeshes;
+        double serialTime = 0.0;
+
+        {
+            tbb::global_control parallelism{ tbb::global_control::max_allowed_parallelism, 1 };
+            MeshLoader loader{ "Synthetic" };
+
+            serialTime = Tests::MeasureMilliseconds([&] {
+                for (const std::string& fileName : fileNames)
+                    serialMeshes.push_back(loader.Load(fileName));
+            });
+        }
+
+        uint64_t triangleCount = 0;
+
+        for (const std::vector<Mesh>& fileMeshes : serialMeshes)
+            for (const Mesh& mesh : fileMeshes)
+                triangleCount += mesh.Indices().size() / 3;
+
+        std::printf("%3u files x %2u meshes, %9llu triangles: serial %9.2f ms\n",
+            fileCount, meshesPerFile, (unsigned long long)triangleCount, serialTime);
+
+        for (uint32_t threadCount : threadCounts)
+        {
+            tbb::global_control parallelism{ tbb::global_control::max_allowed_parallelism, threadCount };
+            MeshLoader loader{ "Synthetic" };
+
+            uint32_t importCount = Tests::SyntheticImportCount();
+            std::vector<std::vector<Mesh>> meshes;
+            double loadTime = Tests::MeasureMilliseconds([&] { meshes = loader.LoadFiles(fileNames); });
+
+            // Concurrency must not change what is loaded nor the order of files and meshes
+            PF_CHECK(AreIdentical(meshes, serialMeshes));
+            PF_CHECK(Tests::SyntheticImportCount() - importCount == fileCount);
+            PF_CHECK(loader.GetStatistics().FileCount == fileCount);
+            PF_CHECK(loader.GetStatistics().MeshCount == uint64_t(fileCount) * meshesPerFile);
+
+            const MeshLoader::Statistics& stats = loader.GetStatistics();
+
+            std::printf("%47s %2u threads %9.2f ms, %5.2fx serial (optimization %8.2f ms, LODs %8.2f ms, meshlets %7.2f ms summed over meshes)\n", "",
+                threadCount, loadTime, serialTime / loadTime,
+                stats.OptimizationTime.count() / 1000.0, stats.LODGenerationTime.count() / 1000.0, stats.MeshletGenerationTime.count() / 1000.0);
+        }
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    bool isQuickRun = Tests::IsQuickRun(argc, argv);
+
+    std::vector<uint32_t> threadCounts{ 1, 2, 4 };
+    uint32_t hardwareThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    if (std::find(threadCounts.begin(), threadCounts.end(), hardwareThreadCount) == threadCounts.end())
+    {
+        threadCounts.push_back(hardwareThreadCount);
+    }
+
+    if (isQuickRun)
+    {
+        RunBenchmark(6, 4, 24, threadCounts);
+    }
+    else
+    {
+        // Many small meshes, then few large ones, which leaves less work to spread across threads
+        RunBenchmark(64, 8, 48, threadCounts);
+        RunBenchmark(4, 2, 256, threadCounts);
+    }
+
+    return Tests::Result();
+}
@@ -0,0 +1,202 @@
+#include <TestHelpers.hpp>
+#include "SyntheticAssimpImporter.hpp"
+
+#include <Scene/MeshLoader.hpp>
+#include <Geometry/Frustum.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace PathFinder;
+
+namespace
+{
+
+    const uint32_t MaxVertexCount = 64;
+    const uint32_t MaxTriangleCount = 124;
+    const uint32_t ViewCount = 64;
+
+    glm::vec3 MeshletVertex(const Mesh& mesh, const Meshlet& meshlet, uint32_t triangle, uint32_t corner)
+    {
+        uint32_t localIndex = (mesh.MeshletTriangles()[meshlet.TriangleOffset + triangle] >> (corner * 8)) & 0xFF;
+        return mesh.Vertices()[mesh.MeshletVertexIndices()[meshlet.VertexOffset + localIndex]].Position;
+    }
+
+    // Same test as IsMeshletBackFacing of Meshlet.hlsl for an instance with identity transform
+    bool IsBackFacing(const Meshlet& meshlet, const glm::vec3& viewer)
+    {
+        return meshlet.ConeCutoff < 1.0f && glm::dot(glm::normalize(meshlet.ConeApex - viewer), meshlet.ConeAxis) >= meshlet.ConeCutoff;
+    }
+
+    // Same test as IsMeshletOutsideFrustum of Meshlet.hlsl
+    bool IsOutsideFrustum(const Meshlet& meshlet, const Geometry::Frustum& frustum)
+    {
+        for (const Geometry::Plane& plane : frustum.Planes)
+        {
+            if (glm::dot(plane.normal, meshlet.BoundingSphereCenter) - plane.distance < -meshlet.BoundingSphereRadius) return true;
+        }
+        return false;
+    }
+
+    void CheckMeshlets(const Mesh& mesh)
+    {
+        // Meshlets cover the index buffer in its order, within vertex and triangle limits
+        uint64_t triangleIdx = 0;
+        bool isWithinLimits = true;
+        bool isInIndexOrder = true;
+        bool isInsideSphere = true;
+
+        for (const Meshlet& meshlet : mesh.Meshlets())
+        {
+            isWithinLimits &= meshlet.VertexCount <= MaxVertexCount && meshlet.TriangleCount <= MaxTriangleCount && meshlet.TriangleCount > 0;
+
+            for (uint32_t triangle = 0; triangle < meshlet.TriangleCount; ++triangle, ++triangleIdx)
+            {
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    uint32_t localIndex = (mesh.MeshletTriangles()[meshlet.TriangleOffset + triangle] >> (corner * 8)) & 0xFF;
+                    isWithinLimits &= localIndex < meshlet.VertexCount;
+                    isInIndexOrder &= mesh.MeshletVertexIndices()[meshlet.VertexOffset + localIndex] == mesh.Indices()[triangleIdx * 3 + corner];
+
+                    glm::vec3 position = MeshletVertex(mesh, meshlet, triangle, corner);
+                    isInsideSphere &= glm::distance(position, meshlet.BoundingSphereCenter) <= meshlet.BoundingSphereRadius * 1.0001f + 1e-5f;
+                }
+            }
+        }
+
+        PF_CHECK(isWithinLimits);
+        PF_CHECK(isInIndexOrder);
+        PF_CHECK(isInsideSphere);
+        PF_CHECK(triangleIdx * 3 == mesh.Indices().size());
+    }
+
+    // Culling may keep invisible meshlets, but must never drop one with a visible triangle
+    void CheckCulling(const Mesh& mesh, std::mt19937& rng, uint64_t& testedMeshlets, uint64_t& coneCulledMeshlets, uint64_t& frustumCulledMeshlets)
+    {
+        const Geometry::AxisAlignedBox3D& bounds = mesh.BoundingBox();
+        glm::vec3 center = (bounds.Min + bounds.Max) * 0.5f;
+        float size = glm::length(bounds.Max - bounds.Min);
+
+        std::uniform_real_distribution<float> offset{ -size, size };
+        bool isConeConservative = true;
+        bool isFrustumConservative = true;
+
+        for (uint32_t view = 0; view < ViewCount; ++view)
+        {
+            glm::vec3 viewer = center + glm::vec3{ offset(rng), offset(rng), offset(rng) };
+            glm::vec3 target = center + glm::vec3{ offset(rng), offset(rng), offset(rng) } * 0.25f;
+            Geometry::Frustum frustum{ glm::perspective(1.0f, 1.7f, 0.1f, 4.0f * size) * glm::lookAt(viewer, target, glm::vec3{ 0.0f, 1.0f, 0.0f }) };
+
+            for (const Meshlet& meshlet : mesh.Meshlets())
+            {
+                ++testedMeshlets;
+
+                if (IsOutsideFrustum(meshlet, frustum))
+                {
+                    ++frustumCulledMeshlets;
+
+                    for (uint32_t triangle = 0; triangle < meshlet.TriangleCount; ++triangle)
+                        for (uint32_t corner = 0; corner < 3; ++corner)
+                            isFrustumConservative &= !frustum.Contains(MeshletVertex(mesh, meshlet, triangle, corner));
+                }
+
+                if (IsBackFacing(meshlet, viewer))
+                {
+                    ++coneCulledMeshlets;
+
+                    // Front faces have the cross product pointing at the viewer
+                    for (uint32_t triangle = 0; triangle < meshlet.TriangleCount; ++triangle)
+                    {
+                        glm::vec3 p0 = MeshletVertex(mesh, meshlet, triangle, 0);
+                        glm::vec3 normal = glm::cross(MeshletVertex(mesh, meshlet, triangle, 1) - p0, MeshletVertex(mesh, meshlet, triangle, 2) - p0);
+                        isConeConservative &= glm::dot(viewer - p0, normal) <= 1e-6f * glm::length(normal) * size;
+                    }
+                }
+            }
+        }
+
+        PF_CHECK(isConeConservative);
+        PF_CHECK(isFrustumConservative);
+    }
+
+    void RunBenchmark(uint32_t segmentCount, uint32_t repeatCount)
+    {
+        // Meshes are imported the way engine does it, except for meshlets, which are built below
+        MeshLoader::ImportSettings settings{};
+        settings.GenerateLODs = false;
+        settings.BuildMeshlets = false;
+
+        MeshLoader loader{ "Synthetic" };
+        loader.SetSettings(settings);
+
+        std::vector<Mesh> meshes = loader.Load(Tests::SyntheticMeshFileName("Meshlets", 2, segmentCount));
+        std::mt19937 rng{ segmentCount };
+
+        uint64_t triangleCount = 0;
+        uint64_t meshletCount = 0;
+        uint64_t meshletTriangleCount = 0;
+        uint64_t testedMeshlets = 0;
+        uint64_t coneCulledMeshlets = 0;
+        uint64_t frustumCulledMeshlets = 0;
+        double buildTime = 0.0;
+
+        for (Mesh& mesh : meshes)
+        {
+            for (uint32_t repeat = 0; repeat < repeatCount; ++repeat)
+            {
+                buildTime += Tests::MeasureMilliseconds([&] { MeshLoader::BuildMeshlets(mesh, MaxVertexCount, MaxTriangleCount); });
+            }
+
+            CheckMeshlets(mesh);
+            CheckCulling(mesh, rng, testedMeshlets, coneCulledMeshlets, frustumCulledMeshlets);
+
+            // Output depends on geometry alone, cooked meshes rely on it
+            Mesh rebuiltMesh = mesh;
+            MeshLoader::BuildMeshlets(rebuiltMesh, MaxVertexCount, MaxTriangleCount);
+
+            PF_CHECK(rebuiltMesh.MeshletVertexIndices() == mesh.MeshletVertexIndices());
+            PF_CHECK(rebuiltMesh.MeshletTriangles() == mesh.MeshletTriangles());
+            PF_CHECK(rebuiltMesh.Meshlets().size() == mesh.Meshlets().size() &&
+                std::memcmp(rebuiltMesh.Meshlets().data(), mesh.Meshlets().data(), mesh.Meshlets().size() * sizeof(Meshlet)) == 0);
+
+            triangleCount += mesh.Indices().size() / 3;
+            meshletCount += mesh.Meshlets().size();
+
+            for (const Meshlet& meshlet : mesh.Meshlets())
+            {
+                meshletTriangleCount += meshlet.TriangleCount;
+            }
+        }
+
+        double millionTrianglesPerSecond = triangleCount * repeatCount / (buildTime * 1000.0);
+
+        // GBuffer draws every meshlet with vertices for the largest one, the rest is degenerate
+        double drawEfficiency = double(meshletTriangleCount) / double(meshletCount * MaxTriangleCount);
+
+        std::printf("%9llu triangles: build %8.3f ms (%6.1f Mtri/s), %6llu meshlets, %5.1f triangles per meshlet, %5.1f%% of draw triangles used\n",
+            (unsigned long long)triangleCount, buildTime / repeatCount, millionTrianglesPerSecond, (unsigned long long)meshletCount,
+            double(meshletTriangleCount) / meshletCount, drawEfficiency * 100.0);
+        std::printf("%20s culled by normal cone %5.1f%%, by frustum %5.1f%% of meshlets over %u random views\n", "",
+            coneCulledMeshlets * 100.0 / testedMeshlets, frustumCulledMeshlets * 100.0 / testedMeshlets, ViewCount);
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    bool isQuickRun = Tests::IsQuickRun(argc, argv);
+
+    std::vector<uint32_t> segmentCounts = isQuickRun ?
+        std::vector<uint32_t>{ 64 } : std::vector<uint32_t>{ 64, 256, 1024 };
+
+    for (uint32_t segmentCount : segmentCounts)
+    {
+        RunBenchmark(segmentCount, isQuickRun ? 1 : 5);
+    }
+
+    return Tests::Result();
+}
@@ -0,0 +1,531 @@
+#include <TestHelpers.hpp>
+
+#include <Scene/SceneArchive.hpp>
+#include <Scene/SceneArchiveRecords.hpp>
+#include <Scene/Camera.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace PathFinder;
+
+namespace
+{
+
+    const std::array<SceneChunk, 6> ChunkTypes{
+        SceneChunk::Camera, SceneChunk::Materials, SceneChunk::Meshes,
+        SceneChunk::MeshInstances, SceneChunk::FlatLights, SceneChunk::SphericalLights
+    };
+
+    // Everything Scene::Serialize puts into a file
+    struct SceneRecords
+    {
+        Camera SceneCamera;
+        SerializedList<Material> Materials;
+        SerializedList<SerializedMesh> Meshes;
+        SerializedList<SerializedMeshInstance> MeshInstances;
+        SerializedList<SerializedFlatLight> FlatLights;
+        SerializedList<SerializedSphericalLight> SphericalLights;
+    };
+
+    SerializedLight MakeLight(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> distribution{ 0.0f, 100.0f };
+
+        SerializedLight light;
+        light.Color = { distribution(rng) / 100.0f, distribution(rng) / 100.0f, distribution(rng) / 100.0f, 1.0f };
+        light.ColorSpace = rng() % 2;
+        light.LuminousPower = distribution(rng) * 1000.0f;
+        light.Position = { distribution(rng), distribution(rng), distribution(rng) };
+        return light;
+    }
+
+    SceneRecords MakeRecords(uint32_t instanceCount, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> distribution{ -500.0f, 500.0f };
+
+        SceneRecords records;
+        records.SceneCamera.MoveTo({ 1.0f, 2.0f, 3.0f });
+        records.SceneCamera.LookAt({ -4.0f, 0.5f, 10.0f });
+        records.SceneCamera.SetFieldOfView(77.0f);
+        records.SceneCamera.SetNearPlane(0.25f);
+        records.SceneCamera.SetFarPlane(2000.0f);
+
+        uint32_t meshCount = std::max(instanceCount / 64, 1u);
+        uint32_t materialCount = 32;
+
+        for (uint32_t materialIdx = 0; materialIdx < materialCount; ++materialIdx)
+        {
+            Material& material = records.Materials.Items.emplace_back();
+            std::string folder = "/MediaResources/Textures/Material" + std::to_string(materialIdx);
+            material.AlbedoMapPath = folder + "/Albedo.dds";
+            material.NormalMapPath = folder + "/Normal.dds";
+            material.RoughnessMapPath = folder + "/Roughness.dds";
+            material.MetalnessMapPath = folder + "/Metalness.dds";
+            material.AOMapPath = materialIdx % 3 == 0 ? "" : folder + "/AO.dds";
+            material.DisplacementMapPath = materialIdx % 4 == 0 ? folder + "/Displacement.dds" : "";
+            material.DistanceFieldPath = materialIdx % 4 == 0 ? folder + "/DistanceField.dds" : "";
+        }
+
+        for (uint32_t meshIdx = 0; meshIdx < meshCount; ++meshIdx)
+        {
+            records.Meshes.Items.push_back({ "/MediaResources/Models/Model" + std::to_string(meshIdx / 8) + ".fbx", meshIdx % 8 });
+        }
+
+        for (uint32_t instanceIdx = 0; instanceIdx < instanceCount; ++instanceIdx)
+        {
+            SerializedMeshInstance& instance = records.MeshInstances.Items.emplace_back();
+            instance.MeshIndex = rng() % meshCount;
+            instance.MaterialIndex = rng() % materialCount;
+            instance.Transformation.Translation = { distribution(rng), distribution(rng), distribution(rng) };
+            instance.Transformation.Scale = glm::vec3{ 1.0f + (rng() % 4) };
+            instance.Transformation.Rotation = glm::normalize(glm::quat{ distribution(rng), distribution(rng), distribution(rng), distribution(rng) });
+        }
+
+        for (uint32_t lightIdx = 0; lightIdx < 64; ++lightIdx)
+        {
+            SerializedFlatLight& flatLight = records.FlatLights.Items.emplace_back();
+            flatLight.Light = MakeLight(rng);
+            flatLight.Type = lightIdx % 2;
+            flatLight.Normal = glm::normalize(glm::vec3{ distribution(rng), distribution(rng), distribution(rng) });
+            flatLight.Width = 1.0f + lightIdx;
+            flatLight.Height = 2.0f + lightIdx;
+
+            SerializedSphericalLight& sphericalLight = records.SphericalLights.Items.emplace_back();
+            sphericalLight.Light = MakeLight(rng);
+            sphericalLight.Radius = 0.5f + lightIdx;
+        }
+
+        return records;
+    }
+
+    void AddChunks(SceneArchiveWriter& writer, const SceneRecords& records)
+    {
+        writer.AddChunk(SceneChunk::Camera, records.SceneCamera);
+        writer.AddChunk(SceneChunk::Materials, records.Materials);
+        writer.AddChunk(SceneChunk::Meshes, records.Meshes);
+        writer.AddChunk(SceneChunk::MeshInstances, records.MeshInstances);
+        writer.AddChunk(SceneChunk::FlatLights, records.FlatLights);
+        writer.AddChunk(SceneChunk::SphericalLights, records.SphericalLights);
+    }
+
+    bool WriteRecords(const std::filesystem::path& path, const SceneRecords& records)
+    {
+        SceneArchiveWriter writer;
+        AddChunks(writer, records);
+        return writer.Write(path);
+    }
+
+    bool ReadRecords(const SceneArchiveReader& reader, SceneRecords& records)
+    {
+        return
+            reader.ReadChunk(SceneChunk::Camera, records.SceneCamera) &&
+            reader.ReadChunk(SceneChunk::Materials, records.Materials) &&
+            reader.ReadChunk(SceneChunk::Meshes, records.Meshes) &&
+            reader.ReadChunk(SceneChunk::MeshInstances, records.MeshInstances) &&
+            reader.ReadChunk(SceneChunk::FlatLights, records.FlatLights) &&
+            reader.ReadChunk(SceneChunk::SphericalLights, records.SphericalLights);
+    }
+
+    // Records are compared by their serialized form, which covers every serialized field including camera internals
+    template <class T>
+    std::vector<uint8_t> ToBytes(const T& object)
+    {
+        std::vector<uint8_t> bytes;
+        size_t size = bitsery::quickSerialization(bitsery::OutputBufferAdapter<std::vector<uint8_t>>{ bytes }, object);
+        bytes.resize(size);
+        return bytes;
+    }
+
+    bool AreIdentical(const SceneRecords& first, const SceneRecords& second)
+    {
+        return
+            ToBytes(first.SceneCamera) == ToBytes(second.SceneCamera) &&
+            ToBytes(first.Materials) == ToBytes(second.Materials) &&
+            ToBytes(first.Meshes) == ToBytes(second.Meshes) &&
+            ToBytes(first.MeshInstances) == ToBytes(second.MeshInstances) &&
+            ToBytes(first.FlatLights) == ToBytes(second.FlatLights) &&
+            ToBytes(first.SphericalLights) == ToBytes(second.SphericalLights);
+    }
+
+    std::vector<uint8_t> ReadBytes(const std::filesystem::path& path)
+    {
+        std::ifstream stream{ path, std::ios::binary };
+        return { std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+    }
+
+    void WriteBytes(const std::filesystem::path& path, const std::vector<uint8_t>& bytes, uint64_t size)
+    {
+        std::ofstream stream{ path, std::ios::binary | std::ios::trunc };
+        stream.write(reinterpret_cast<const char*>(bytes.data()), size);
+    }
+
+    template <class T>
+    void Patch(std::vector<uint8_t>& bytes, uint64_t offset, const T& value)
+    {
+        std::memcpy(bytes.data() + offset, &value, sizeof(T));
+    }
+
+    uint64_t ChunkEntryOffset(uint32_t chunkIdx)
+    {
+        return sizeof(SceneArchiveFormat::FileHeader) + chunkIdx * sizeof(SceneArchiveFormat::ChunkEntry);
+    }
+
+    SceneArchiveFormat::ChunkEntry FindEntry(const std::filesystem::path& path, SceneChunk chunk, uint32_t& chunkIdx)
+    {
+        SceneArchiveReader reader;
+        reader.Open(path);
+
+        for (chunkIdx = 0; chunkIdx < reader.ChunkTable().size(); ++chunkIdx)
+        {
+            if (reader.ChunkTable()[chunkIdx].Type == std::underlying_type_t<SceneChunk>(chunk)) return reader.ChunkTable()[chunkIdx];
+        }
+
+        return {};
+    }
+
+    template <class T>
+    void CheckSingleChunkRoundTrip(const std::filesystem::path& path, SceneChunk chunk, const T& object)
+    {
+        SceneArchiveWriter writer;
+        writer.AddChunk(chunk, object);
+        PF_CHECK(writer.Write(path));
+
+        SceneArchiveReader reader;
+        PF_CHECK(reader.Open(path));
+        PF_CHECK(reader.ChunkTable().size() == 1);
+
+        for (SceneChunk otherChunk : ChunkTypes)
+        {
+            PF_CHECK(reader.HasChunk(otherChunk) == (otherChunk == chunk));
+        }
+
+        T readObject{};
+        PF_CHECK(reader.ReadChunk(chunk, readObject));
+        PF_CHECK(ToBytes(readObject) == ToBytes(object));
+
+        // Reading a chunk the file doesn't have fails without touching the object
+        SerializedList<SerializedMesh> missing;
+        missing.Items.resize(3);
+        PF_CHECK(chunk == SceneChunk::Meshes || !reader.ReadChunk(SceneChunk::Meshes, missing));
+        PF_CHECK(chunk == SceneChunk::Meshes || missing.Items.size() == 3);
+    }
+
+    void TestRoundTrip(const std::filesystem::path& folder)
+    {
+        std::mt19937 rng{ 7 };
+        SceneRecords records = MakeRecords(1000, rng);
+        std::filesystem::path path = folder / "RoundTrip.pfscene";
+
+        PF_CHECK(WriteRecords(path, records));
+
+        SceneArchiveReader reader;
+        PF_CHECK(reader.Open(path));
+        PF_CHECK(reader.ChunkTable().size() == ChunkTypes.size());
+        PF_CHECK(reader.FileSize() == std::filesystem::file_size(path));
+
+        for (const SceneArchiveFormat::ChunkEntry& entry : reader.ChunkTable())
+        {
+            PF_CHECK(entry.Offset % SceneArchiveFormat::ChunkAlignment == 0);
+        }
+
+        SceneRecords readRecords;
+        PF_CHECK(ReadRecords(reader, readRecords));
+        PF_CHECK(AreIdentical(records, readRecords));
+
+        // Spot checks on values, in case serialization of some field is symmetric but lossy
+        PF_CHECK(readRecords.SceneCamera.Position() == glm::vec3(1.0f, 2.0f, 3.0f));
+        PF_CHECK(readRecords.SceneCamera.FOVH() == 77.0f);
+        PF_CHECK(readRecords.SceneCamera.FarClipPlane() == 2000.0f);
+        PF_CHECK(readRecords.SceneCamera.Front() == records.SceneCamera.Front());
+        PF_CHECK(readRecords.Materials.Items[4].DistanceFieldPath == "/MediaResources/Textures/Material4/DistanceField.dds");
+        PF_CHECK(readRecords.Materials.Items[3].AOMapPath.empty());
+        PF_CHECK(readRecords.Meshes.Items[13].SourceFile == "/MediaResources/Models/Model1.fbx");
+        PF_CHECK(readRecords.Meshes.Items[13].IndexInSourceFile == 5);
+        PF_CHECK(readRecords.MeshInstances.Items.size() == 1000);
+        PF_CHECK(readRecords.MeshInstances.Items[777].Transformation.Rotation == records.MeshInstances.Items[777].Transformation.Rotation);
+        PF_CHECK(readRecords.MeshInstances.Items[777].MaterialIndex == records.MeshInstances.Items[777].MaterialIndex);
+        PF_CHECK(readRecords.FlatLights.Items[9].Type == 1);
+        PF_CHECK(readRecords.FlatLights.Items[9].Light.Color == records.FlatLights.Items[9].Light.Color);
+        PF_CHECK(readRecords.SphericalLights.Items[9].Radius == 9.5f);
+        PF_CHECK(readRecords.SphericalLights.Items[9].Light.LuminousPower == records.SphericalLights.Items[9].Light.LuminousPower);
+
+        // Writing what was read reproduces the file byte for byte, the same property the runtime round-trip check relies on
+        std::filesystem::path rewrittenPath = folder / "RoundTripRewritten.pfscene";
+        PF_CHECK(WriteRecords(rewrittenPath, readRecords));
+        PF_CHECK(ReadBytes(rewrittenPath) == ReadBytes(path));
+
+        // Each chunk type on its own
+        std::filesystem::path singleChunkPath = folder / "SingleChunk.pfscene";
+        CheckSingleChunkRoundTrip(singleChunkPath, SceneChunk::Camera, records.SceneCamera);
+        CheckSingleChunkRoundTrip(singleChunkPath, SceneChunk::Materials, records.Materials);
+        CheckSingleChunkRoundTrip(singleChunkPath, SceneChunk::Meshes, records.Meshes);
+        CheckSingleChunkRoundTrip(singleChunkPath, SceneChunk::MeshInstances, records.MeshInstances);
+        CheckSingleChunkRoundTrip(singleChunkPath, SceneChunk::FlatLights, records.FlatLights);
+        CheckSingleChunkRoundTrip(singleChunkPath, SceneChunk::SphericalLights, records.SphericalLights);
+
+        // Empty scene
+        SceneRecords emptyRecords;
+        SceneRecords readEmptyRecords = records;
+        PF_CHECK(WriteRecords(path, emptyRecords));
+        PF_CHECK(reader.Open(path));
+        PF_CHECK(ReadRecords(reader, readEmptyRecords));
+        PF_CHECK(AreIdentical(emptyRecords, readEmptyRecords));
+
+        // An archive without chunks is valid too
+        PF_CHECK(SceneArchiveWriter{}.Write(path));
+        PF_CHECK(reader.Open(path));
+        PF_CHECK(reader.ChunkTable().empty());
+        PF_CHECK(!reader.HasChunk(SceneChunk::Camera));
+
+        // Adding a chunk of the same type again replaces it
+        SceneArchiveWriter writer;
+        writer.AddChunk(SceneChunk::SphericalLights, records.SphericalLights);
+        writer.AddChunk(SceneChunk::SphericalLights, emptyRecords.SphericalLights);
+        PF_CHECK(writer.Write(path));
+        PF_CHECK(reader.Open(path));
+        PF_CHECK(reader.ChunkTable().size() == 1);
+        SerializedList<SerializedSphericalLight> sphericalLights = records.SphericalLights;
+        PF_CHECK(reader.ReadChunk(SceneChunk::SphericalLights, sphericalLights));
+        PF_CHECK(sphericalLights.Items.empty());
+
+        // Chunks of types unknown to the reader are skipped
+        SceneArchiveWriter futureWriter;
+        futureWriter.AddChunk(SceneChunk(1u << 20), records.Materials);
+        AddChunks(futureWriter, records);
+        PF_CHECK(futureWriter.Write(path));
+        PF_CHECK(reader.Open(path));
+        PF_CHECK(ReadRecords(reader, readRecords));
+        PF_CHECK(AreIdentical(records, readRecords));
+
+        reader.Close();
+        PF_CHECK(!reader.IsOpen());
+        PF_CHECK(reader.ChunkTable().empty());
+    }
+
+    void TestTruncatedFiles(const std::filesystem::path& folder)
+    {
+        std::mt19937 rng{ 11 };
+        SceneRecords records = MakeRecords(200, rng);
+        std::filesystem::path path = folder / "Truncated.pfscene";
+        std::filesystem::path damagedPath = folder / "TruncatedDamaged.pfscene";
+
+        PF_CHECK(WriteRecords(path, records));
+        std::vector<uint8_t> bytes = ReadBytes(path);
+
+        uint64_t payloadStart = ChunkEntryOffset((uint32_t)ChunkTypes.size());
+
+        // Header and chunk table are checked byte by byte, payloads at a stride
+        for (uint64_t size = 0; size < bytes.size(); size += size < payloadStart ? 1 : 13)
+        {
+            SceneArchiveReader reader;
+
+            WriteBytes(damagedPath, bytes, size);
+            PF_CHECK(!reader.Open(damagedPath));
+
+            // File size in the header agrees with the truncated file, chunks still point past its end
+            if (size >= sizeof(SceneArchiveFormat::FileHeader))
+            {
+                std::vector<uint8_t> patchedBytes = bytes;
+                Patch(patchedBytes, offsetof(SceneArchiveFormat::FileHeader, FileSize), uint64_t(size));
+                WriteBytes(damagedPath, patchedBytes, size);
+                PF_CHECK(!reader.Open(damagedPath));
+            }
+        }
+
+        // Payloads shorter than their serialized objects, which the chunk table can't reveal
+        for (SceneChunk chunk : ChunkTypes)
+        {
+            uint32_t chunkIdx = 0;
+            SceneArchiveFormat::ChunkEntry entry = FindEntry(path, chunk, chunkIdx);
+            uint64_t sizeOffset = ChunkEntryOffset(chunkIdx) + offsetof(SceneArchiveFormat::ChunkEntry, Size);
+
+            for (uint64_t payloadSize = 0; payloadSize < entry.Size; payloadSize += std::max(entry.Size / 64, uint64_t(1)))
+            {
+                std::vector<uint8_t> patchedBytes = bytes;
+                Patch(patchedBytes, sizeOffset, payloadSize);
+                WriteBytes(damagedPath, patchedBytes, patchedBytes.size());
+
+                SceneArchiveReader reader;
+                SceneRecords readRecords;
+                PF_CHECK(reader.Open(damagedPath));
+                PF_CHECK(!ReadRecords(reader, readRecords));
+            }
+
+            // Trailing bytes after the object are damage as well
+            if (entry.Offset + entry.Size < bytes.size())
+            {
+                std::vector<uint8_t> patchedBytes = bytes;
+                Patch(patchedBytes, sizeOffset, entry.Size + 1);
+                WriteBytes(damagedPath, patchedBytes, patchedBytes.size());
+
+                SceneArchiveReader reader;
+                SceneRecords readRecords;
+                PF_CHECK(reader.Open(damagedPath));
+                PF_CHECK(!ReadRecords(reader, readRecords));
+            }
+        }
+    }
+
+    void TestDamagedFiles(const std::filesystem::path& folder)
+    {
+        std::mt19937 rng{ 13 };
+        SceneRecords records = MakeRecords(200, rng);
+        std::filesystem::path path = folder / "Damaged.pfscene";
+        std::filesystem::path damagedPath = folder / "DamagedPatched.pfscene";
+
+        PF_CHECK(WriteRecords(path, records));
+        std::vector<uint8_t> bytes = ReadBytes(path);
+
+        SceneArchiveReader reader;
+        PF_CHECK(!reader.Open(folder / "Missing.pfscene"));
+        PF_CHECK(!reader.IsOpen());
+
+        auto opensWith = [&](auto patch)
+        {
+            std::vector<uint8_t> patchedBytes = bytes;
+            patch(patchedBytes);
+            WriteBytes(damagedPath, patchedBytes, patchedBytes.size());
+
+            SceneArchiveReader damagedReader;
+            return damagedReader.Open(damagedPath);
+        };
+
+        using Header = SceneArchiveFormat::FileHeader;
+        using Entry = SceneArchiveFormat::ChunkEntry;
+
+        PF_CHECK(opensWith([](auto&) {}));
+        PF_CHECK(!opensWith([](auto& b) { Patch(b, offsetof(Header, Magic), uint32_t(0x4E435351)); }));
+        PF_CHECK(!opensWith([](auto& b) { Patch(b, offsetof(Header, Version), SceneArchiveFormat::Version + 1); }));
+        PF_CHECK(!opensWith([](auto& b) { Patch(b, offsetof(Header, FileSize), uint64_t(b.size() + 1)); }));
+        PF_CHECK(!opensWith([](auto& b) { Patch(b, offsetof(Header, ChunkCount), uint32_t(ChunkTypes.size() + 1000)); }));
+        PF_CHECK(!opensWith([](auto& b) { Patch(b, offsetof(Header, ChunkCount), std::numeric_limits<uint32_t>::max()); }));
+
+        for (uint32_t chunkIdx = 0; chunkIdx < ChunkTypes.size(); ++chunkIdx)
+        {
+            uint64_t offsetOffset = ChunkEntryOffset(chunkIdx) + offsetof(Entry, Offset);
+            uint64_t sizeOffset = ChunkEntryOffset(chunkIdx) + offsetof(Entry, Size);
+
+            PF_CHECK(!opensWith([&](auto& b) { Patch(b, offsetOffset, uint64_t(b.size() + 1)); }));
+            PF_CHECK(!opensWith([&](auto& b) { Patch(b, offsetOffset, std::numeric_limits<uint64_t>::max() - 8); }));
+            PF_CHECK(!opensWith([&](auto& b) { Patch(b, sizeOffset, std::numeric_limits<uint64_t>::max()); }));
+            PF_CHECK(!opensWith([&](auto& b) { Patch(b, sizeOffset, uint64_t(b.size())); }));
+        }
+
+        // Damaged payloads are reported per chunk, the rest of the file stays readable
+        auto readAfterPatch = [&](SceneChunk damagedChunk, uint64_t payloadOffset, std::vector<uint8_t> patch)
+        {
+            uint32_t chunkIdx = 0;
+            SceneArchiveFormat::ChunkEntry entry = FindEntry(path, damagedChunk, chunkIdx);
+
+            std::vector<uint8_t> patchedBytes = bytes;
+            std::copy(patch.begin(), patch.end(), patchedBytes.begin() + entry.Offset + payloadOffset);
+            WriteBytes(damagedPath, patchedBytes, patchedBytes.size());
+
+            SceneArchiveReader damagedReader;
+            SceneRecords readRecords;
+            PF_CHECK(damagedReader.Open(damagedPath));
+
+            for (SceneChunk chunk : ChunkTypes)
+            {
+                bool isRead = false;
+
+                switch (chunk)
+                {
+                case SceneChunk::Camera: isRead = damagedReader.ReadChunk(chunk, readRecords.SceneCamera); break;
+                case SceneChunk::Materials: isRead = damagedReader.ReadChunk(chunk, readRecords.Materials); break;
+                case SceneChunk::Meshes: isRead = damagedReader.ReadChunk(chunk, readRecords.Meshes); break;
+                case SceneChunk::MeshInstances: isRead = damagedReader.ReadChunk(chunk, readRecords.MeshInstances); break;
+                case SceneChunk::FlatLights: isRead = damagedReader.ReadChunk(chunk, readRecords.FlatLights); break;
+                case SceneChunk::SphericalLights: isRead = damagedReader.ReadChunk(chunk, readRecords.SphericalLights); break;
+                default: break;
+                }
+
+                PF_CHECK(isRead == (chunk != damagedChunk));
+            }
+        };
+
+        // List sizes are variable-length integers, 0xC1 0x00 0x0001 is one item more than SerializedList allows
+        std::vector<uint8_t> oversizedList{ 0xC1, 0x00, 0x01, 0x00 };
+
+        for (SceneChunk chunk : { SceneChunk::Materials, SceneChunk::Meshes, SceneChunk::MeshInstances, SceneChunk::FlatLights, SceneChunk::SphericalLights })
+        {
+            readAfterPatch(chunk, 0, oversizedList);
+        }
+
+        // First path of a list follows the one-byte list size, 0x84 0x01 is one character more than a path may have
+        std::vector<uint8_t> oversizedPath{ 0x84, 0x01 };
+        readAfterPatch(SceneChunk::Meshes, 1, oversizedPath);
+        readAfterPatch(SceneChunk::Materials, 1, oversizedPath);
+    }
+
+    void RunLoadBenchmark(const std::filesystem::path& folder, uint32_t instanceCount)
+    {
+        std::mt19937 rng{ instanceCount };
+        SceneRecords records = MakeRecords(instanceCount, rng);
+        std::filesystem::path path = folder / ("Benchmark" + std::to_string(instanceCount) + ".pfscene");
+
+        bool isWritten = false;
+        double writeTime = Tests::MeasureMilliseconds([&] { isWritten = WriteRecords(path, records); });
+        PF_CHECK(isWritten);
+
+        SceneArchiveReader reader;
+        bool isOpen = false;
+        double openTime = Tests::MeasureMilliseconds([&] { isOpen = reader.Open(path); });
+        PF_CHECK(isOpen);
+
+        // Chunks are deserialized on request, a camera-only read must not pay for instances
+        Camera camera;
+        bool isCameraRead = false;
+        double cameraTime = Tests::MeasureMilliseconds([&] { isCameraRead = reader.ReadChunk(SceneChunk::Camera, camera); });
+        PF_CHECK(isCameraRead);
+
+        SceneRecords readRecords;
+        bool isRead = false;
+        double readTime = Tests::MeasureMilliseconds([&] { isRead = ReadRecords(reader, readRecords); });
+        PF_CHECK(isRead);
+        PF_CHECK(AreIdentical(records, readRecords));
+
+        double megabytes = reader.FileSize() / (1024.0 * 1024.0);
+
+        std::printf("%8u instances, %8.2f MB: write %8.2f ms, open %6.3f ms, camera %6.3f ms, all chunks %8.2f ms (%7.1f MB/s)\n",
+            instanceCount, megabytes, writeTime, openTime, cameraTime, readTime, megabytes / (readTime / 1000.0));
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    bool isQuickRun = Tests::IsQuickRun(argc, argv);
+
+    std::filesystem::path folder = std::filesystem::temp_directory_path() / "PathFinderSceneArchiveTests";
+    std::filesystem::create_directories(folder);
+
+    TestRoundTrip(folder);
+    TestTruncatedFiles(folder);
+    TestDamagedFiles(folder);
+
+    if (isQuickRun)
+    {
+        RunLoadBenchmark(folder, 10000);
+    }
+    else
+    {
+        RunLoadBenchmark(folder, 10000);
+        RunLoadBenchmark(folder, 100000);
+        RunLoadBenchmark(folder, 1000000);
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(folder, error);
+
+    return Tests::Result();
+}
@@ -0,0 +1,206 @@
+#include "SyntheticAssimpImporter.hpp"
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <memory>
+
+namespace Tests
+{
+
+    namespace
+    {
+
+        std::atomic<uint32_t> ImportCount{ 0 };
+
+        aiMesh* BuildSphere(uint32_t segmentCount, float radius, const aiVector3D& center, const std::string& name)
+        {
+            const float Pi = 3.14159265f;
+            uint32_t rowLength = segmentCount + 1;
+
+            aiMesh* mesh = new aiMesh{};
+            mesh->mName.Set(name);
+            mesh->mNumVertices = rowLength * rowLength;
+            mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+            mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+            mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+            mesh->mNumUVComponents[0] = 2;
+
+            for (uint32_t ring = 0; ring <= segmentCount; ++ring)
+            {
+                for (uint32_t segment = 0; segment <= segmentCount; ++segment)
+                {
+                    float theta = Pi * ring / segmentCount;
+                    float phi = 2.0f * Pi * segment / segmentCount;
+                    aiVector3D normal{ std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+                    uint32_t vertexIdx = ring * rowLength + segment;
+
+                    mesh->mNormals[vertexIdx] = normal;
+                    mesh->mVertices[vertexIdx] = center + normal * radius;
+                    mesh->mTextureCoords[0][vertexIdx] = aiVector3D{ float(segment) / segmentCount, float(ring) / segmentCount, 0.0f };
+                }
+            }
+
+            mesh->mNumFaces = segmentCount * segmentCount * 2;
+            mesh->mFaces = new aiFace[mesh->mNumFaces];
+
+            uint32_t faceIdx = 0;
+
+            auto addFace = [&](uint32_t i0, uint32_t i1, uint32_t i2)
+            {
+                // Wound so that cross(p1 - p0, p2 - p0) points away from the center
+                aiVector3D p0 = mesh->mVertices[i0] - center;
+                aiVector3D normal = (mesh->mVertices[i1] - mesh->mVertices[i0]) ^ (mesh->mVertices[i2] - mesh->mVertices[i0]);
+
+                if (normal * p0 < 0.0f) std::swap(i1, i2);
+
+                aiFace& face = mesh->mFaces[faceIdx++];
+                face.mNumIndices = 3;
+                face.mIndices = new unsigned int[3]{ i0, i1, i2 };
+            };
+
+            for (uint32_t ring = 0; ring < segmentCount; ++ring)
+            {
+                for (uint32_t segment = 0; segment < segmentCount; ++segment)
+                {
+                    uint32_t topLeft = ring * rowLength + segment;
+                    uint32_t bottomLeft = topLeft + rowLength;
+
+                    addFace(topLeft, topLeft + 1, bottomLeft);
+                    addFace(topLeft + 1, bottomLeft + 1, bottomLeft);
+                }
+            }
+
+            return mesh;
+        }
+
+        aiScene* BuildScene(const std::string& fileName)
+        {
+            std::string stem = std::filesystem::path{ fileName }.stem().string();
+
+            uint32_t meshCount = 0;
+            uint32_t segmentCount = 0;
+            size_t separator = stem.rfind('_');
+
+            if (separator == std::string::npos || std::sscanf(stem.c_str() + separator + 1, "%ux%u", &meshCount, &segmentCount) != 2 || meshCount == 0 || segmentCount < 3)
+            {
+                return nullptr;
+            }
+
+            // Name picks sizes and placement, so different files produce different geometry
+            size_t nameHash = std::hash<std::string>{}(stem.substr(0, separator));
+
+            aiScene* scene = new aiScene{};
+            scene->mNumMeshes = meshCount;
+            scene->mMeshes = new aiMesh*[meshCount];
+
+            for (uint32_t meshIdx = 0; meshIdx < meshCount; ++meshIdx)
+            {
+                float radius = 1.0f + float((nameHash >> (meshIdx % 16)) % 8);
+                aiVector3D center{ 20.0f * meshIdx, float(nameHash % 13), 0.0f };
+                scene->mMeshes[meshIdx] = BuildSphere(segmentCount, radius, center, stem + "_Sphere" + std::to_string(meshIdx));
+            }
+
+            uint32_t rootMeshCount = (meshCount + 1) / 2;
+
+            scene->mRootNode = new aiNode{};
+            scene->mRootNode->mNumMeshes = rootMeshCount;
+            scene->mRootNode->mMeshes = new unsigned int[rootMeshCount];
+
+            aiNode* child = new aiNode{};
+            child->mParent = scene->mRootNode;
+            child->mNumMeshes = meshCount - rootMeshCount;
+            child->mMeshes = new unsigned int[child->mNumMeshes];
+
+            for (uint32_t meshIdx = 0; meshIdx < meshCount; ++meshIdx)
+            {
+                uint32_t reversedIdx = meshCount - 1 - meshIdx;
+
+                if (meshIdx < rootMeshCount) scene->mRootNode->mMeshes[meshIdx] = reversedIdx;
+                else child->mMeshes[meshIdx - rootMeshCount] = reversedIdx;
+            }
+
+            scene->mRootNode->mNumChildren = 1;
+            scene->mRootNode->mChildren = new aiNode*[1]{ child };
+
+            return scene;
+        }
+
+    }
+
+    std::string SyntheticMeshFileName(const std::string& name, uint32_t meshCount, uint32_t segmentCount)
+    {
+        return name + "_" + std::to_string(meshCount) + "x" + std::to_string(segmentCount) + ".synthetic";
+    }
+
+    uint32_t SyntheticImportCount()
+    {
+        return ImportCount.load();
+    }
+
+}
+
+// Definitions normally provided by the assimp library, limited to what mesh loading uses
+
+aiNode::aiNode()
+    : mName{}, mParent{ nullptr }, mNumChildren{ 0 }, mChildren{ nullptr }, mNumMeshes{ 0 }, mMeshes{ nullptr }, mMetaData{ nullptr } {}
+
+aiNode::~aiNode()
+{
+    for (unsigned int childIdx = 0; childIdx < mNumChildren; ++childIdx)
+    {
+        delete mChildren[childIdx];
+    }
+
+    delete[] mChildren;
+    delete[] mMeshes;
+}
+
+aiScene::aiScene()
+    : mFlags{ 0 }, mRootNode{ nullptr }, mNumMeshes{ 0 }, mMeshes{ nullptr }, mNumMaterials{ 0 }, mMaterials{ nullptr },
+    mNumAnimations{ 0 }, mAnimations{ nullptr }, mNumTextures{ 0 }, mTextures{ nullptr }, mNumLights{ 0 }, mLights{ nullptr },
+    mNumCameras{ 0 }, mCameras{ nullptr }, mMetaData{ nullptr }, mPrivate{ nullptr } {}
+
+aiScene::~aiScene()
+{
+    delete mRootNode;
+
+    for (unsigned int meshIdx = 0; meshIdx < mNumMeshes; ++meshIdx)
+    {
+        delete mMeshes[meshIdx];
+    }
+
+    delete[] mMeshes;
+}
+
+namespace Assimp
+{
+
+    class ImporterPimpl
+    {
+    public:
+        std::unique_ptr<aiScene> Scene;
+    };
+
+    Importer::Importer()
+        : pimpl{ new ImporterPimpl{} } {}
+
+    Importer::~Importer()
+    {
+        delete pimpl;
+    }
+
+    const aiScene* Importer::ReadFile(const char* pFile, unsigned int pFlags)
+    {
+        ++Tests::ImportCount;
+
+        pimpl->Scene.reset(Tests::BuildScene(pFile));
+        return pimpl->Scene.get();
+    }
+
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+namespace Tests
+{
+
+    /// Tests that load meshes link against a stand-in for the assimp library, which this project doesn't build.
+    /// Instead of parsing files it generates a scene from the file name, so no model files are needed.
+    /// Scene of a name holds 'meshCount' UV spheres of 'segmentCount' segments and rings, whose sizes
+    /// and placement depend on the name. Meshes are split between the root node and its child in reverse order,
+    /// so that node traversal order differs from scene mesh order.
+    std::string SyntheticMeshFileName(const std::string& name, uint32_t meshCount, uint32_t segmentCount);
+
+    /// Number of files imported so far, files loaded from cooked mesh cache are not imported
+    uint32_t SyntheticImportCount();
+
+}
@@ -0,0 +1,290 @@
+#include <TestHelpers.hpp>
+
+#include <Scene/TextureStreamingPlanner.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <vector>
+
+using namespace PathFinder;
+
+namespace
+{
+
+    using Texture = TextureStreamingPlanner::Texture;
+
+    const uint32_t MipTailSize = 64;
+
+    // Square RGBA8 texture with mips of 64 texels and less in the mip tail, resident down to the tail unless told otherwise
+    Texture MakeTexture(uint32_t size, float projectedSize, std::optional<uint32_t> residentMip = std::nullopt)
+    {
+        Texture texture;
+        texture.Size = size;
+        texture.ProjectedSize = projectedSize;
+
+        for (uint32_t mipSize = size; mipSize >= 1; mipSize >>= 1)
+        {
+            texture.MipSizes.push_back(uint64_t(mipSize) * mipSize * 4);
+        }
+
+        while ((size >> texture.MipTailFirstMip) > MipTailSize)
+        {
+            ++texture.MipTailFirstMip;
+        }
+
+        texture.ResidentMip = residentMip.value_or(texture.MipTailFirstMip);
+
+        return texture;
+    }
+
+    uint64_t MipRangeSize(const Texture& texture, uint32_t mostDetailedMip)
+    {
+        return std::accumulate(texture.MipSizes.begin() + mostDetailedMip, texture.MipSizes.end(), uint64_t(0));
+    }
+
+    uint64_t PlanSize(const std::vector<Texture>& textures, const std::vector<uint32_t>& plannedMips)
+    {
+        uint64_t size = 0;
+
+        for (uint32_t textureIdx = 0; textureIdx < textures.size(); ++textureIdx)
+        {
+            size += MipRangeSize(textures[textureIdx], plannedMips[textureIdx]);
+        }
+
+        return size;
+    }
+
+    std::vector<uint32_t> Plan(TextureStreamingPlanner& planner, const std::vector<Texture>& textures, uint64_t budget, float mipBias = 0.0f)
+    {
+        TextureStreamingPlanner::Settings settings;
+        settings.MemoryBudget = budget;
+        settings.MipBias = mipBias;
+        planner.SetSettings(settings);
+
+        return planner.Plan(textures);
+    }
+
+    void TestDesiredMip()
+    {
+        PF_CHECK(TextureStreamingPlanner::DesiredMip(MakeTexture(4096, 4096.0f), 0.0f) == 0);
+        PF_CHECK(TextureStreamingPlanner::DesiredMip(MakeTexture(4096, 8192.0f), 0.0f) == 0);
+        PF_CHECK(TextureStreamingPlanner::DesiredMip(MakeTexture(4096, 2048.0f), 0.0f) == 1);
+        PF_CHECK(TextureStreamingPlanner::DesiredMip(MakeTexture(4096, 1500.0f), 0.0f) == 1);
+        PF_CHECK(TextureStreamingPlanner::DesiredMip(MakeTexture(4096, 1000.0f), 0.0f) == 2);
+
+        // Unused and tiny textures need nothing beyond their mip tails
+        Texture texture = MakeTexture(4096, 0.0f);
+        PF_CHECK(texture.MipTailFirstMip == 6);
+        PF_CHECK(TextureStreamingPlanner::DesiredMip(texture, 0.0f) == 6);
+        PF_CHECK(TextureStreamingPlanner::DesiredMip(MakeTexture(4096, 1.0f), 0.0f) == 6);
+        PF_CHECK(TextureStreamingPlanner::DesiredMip(MakeTexture(4096, 0.0f), -4.0f) == 6);
+
+        // Bias shifts desired mips and is clamped to the mip chain
+        PF_CHECK(TextureStreamingPlanner::DesiredMip(MakeTexture(4096, 2048.0f), 1.0f) == 2);
+        PF_CHECK(TextureStreamingPlanner::DesiredMip(MakeTexture(4096, 2048.0f), 0.5f) == 1);
+        PF_CHECK(TextureStreamingPlanner::DesiredMip(MakeTexture(4096, 2048.0f), -1.0f) == 0);
+        PF_CHECK(TextureStreamingPlanner::DesiredMip(MakeTexture(4096, 2048.0f), -3.0f) == 0);
+        PF_CHECK(TextureStreamingPlanner::DesiredMip(MakeTexture(4096, 2048.0f), 10.0f) == 6);
+    }
+
+    void TestUnlimitedBudget()
+    {
+        TextureStreamingPlanner planner;
+        std::vector<Texture> textures{ MakeTexture(4096, 2000.0f), MakeTexture(2048, 300.0f), MakeTexture(1024, 0.0f), MakeTexture(4096, 100.0f) };
+
+        std::vector<uint32_t> plannedMips = Plan(planner, textures, 1ull << 40);
+        const TextureStreamingPlanner::Statistics& stats = planner.GetStatistics();
+
+        PF_CHECK((plannedMips == std::vector<uint32_t>{ 1, 2, 4, 5 }));
+        PF_CHECK(stats.PlannedBytes == PlanSize(textures, plannedMips));
+        PF_CHECK(stats.PlannedBytes == stats.DesiredBytes);
+        PF_CHECK(!stats.IsBudgetLimited);
+        PF_CHECK(stats.UpgradeCount == 3);
+        PF_CHECK(stats.EvictionCount == 0);
+    }
+
+    void TestBudget()
+    {
+        TextureStreamingPlanner planner;
+        std::vector<Texture> textures{ MakeTexture(4096, 2000.0f), MakeTexture(2048, 300.0f), MakeTexture(1024, 0.0f), MakeTexture(4096, 100.0f) };
+
+        std::vector<uint32_t> tailMips;
+        uint64_t tailBytes = 0;
+
+        for (const Texture& texture : textures)
+        {
+            tailMips.push_back(texture.MipTailFirstMip);
+            tailBytes += MipRangeSize(texture, texture.MipTailFirstMip);
+        }
+
+        // Mip tails stay resident even when they alone don't fit
+        PF_CHECK(Plan(planner, textures, 0) == tailMips);
+        PF_CHECK(planner.GetStatistics().PlannedBytes == tailBytes);
+        PF_CHECK(planner.GetStatistics().IsBudgetLimited);
+
+        PF_CHECK(Plan(planner, textures, tailBytes) == tailMips);
+        PF_CHECK(planner.GetStatistics().UpgradeCount == 0);
+
+        // The most undersampled texture is upgraded first, a 4096 texture drawn at 2000 pixels over a 2048 one at 300
+        std::vector<uint32_t> plannedMips = Plan(planner, textures, tailBytes + textures[0].MipSizes[5]);
+        PF_CHECK((plannedMips == std::vector<uint32_t>{ 5, 5, 4, 6 }));
+
+        // Upgrades that don't fit are skipped, cheaper ones of other textures still happen
+        plannedMips = Plan(planner, textures, 10'000'000);
+        PF_CHECK(planner.GetStatistics().PlannedBytes <= 10'000'000);
+        PF_CHECK(planner.GetStatistics().IsBudgetLimited);
+        PF_CHECK(plannedMips[1] == 2);
+        PF_CHECK(plannedMips[0] > 1);
+
+        // Random scenes under random budgets
+        std::mt19937 rng{ 3 };
+        std::uniform_real_distribution<float> projectedSizes{ 0.0f, 3000.0f };
+
+        for (uint32_t sceneIdx = 0; sceneIdx < 200; ++sceneIdx)
+        {
+            std::vector<Texture> randomTextures;
+            uint32_t textureCount = 1 + rng() % 64;
+
+            for (uint32_t textureIdx = 0; textureIdx < textureCount; ++textureIdx)
+            {
+                randomTextures.push_back(MakeTexture(128u << (rng() % 6), rng() % 8 == 0 ? 0.0f : projectedSizes(rng)));
+            }
+
+            uint64_t budget = (rng() % 256) << 20;
+            plannedMips = Plan(planner, randomTextures, budget);
+            const TextureStreamingPlanner::Statistics& stats = planner.GetStatistics();
+
+            uint64_t randomTailBytes = 0;
+
+            for (const Texture& texture : randomTextures)
+            {
+                randomTailBytes += MipRangeSize(texture, texture.MipTailFirstMip);
+            }
+
+            PF_CHECK(stats.PlannedBytes == PlanSize(randomTextures, plannedMips));
+            PF_CHECK(stats.PlannedBytes <= std::max(budget, randomTailBytes));
+            PF_CHECK(stats.PlannedBytes <= stats.DesiredBytes);
+            PF_CHECK(stats.IsBudgetLimited == (stats.PlannedBytes < stats.DesiredBytes));
+
+            for (uint32_t textureIdx = 0; textureIdx < textureCount; ++textureIdx)
+            {
+                const Texture& texture = randomTextures[textureIdx];
+                uint32_t desiredMip = TextureStreamingPlanner::DesiredMip(texture, 0.0f);
+
+                PF_CHECK(plannedMips[textureIdx] >= desiredMip && plannedMips[textureIdx] <= texture.MipTailFirstMip);
+
+                // Budget is used up: each texture short of its desired mip can't take one more
+                if (plannedMips[textureIdx] > desiredMip)
+                {
+                    PF_CHECK(stats.PlannedBytes + texture.MipSizes[plannedMips[textureIdx] - 1] > budget);
+                }
+            }
+        }
+
+        // Equally undersampled textures are upgraded in index order
+        std::vector<Texture> twins{ MakeTexture(1024, 1024.0f), MakeTexture(1024, 1024.0f) };
+        uint64_t twinTailBytes = 2 * MipRangeSize(twins[0], twins[0].MipTailFirstMip);
+        PF_CHECK((Plan(planner, twins, twinTailBytes + twins[0].MipSizes[3]) == std::vector<uint32_t>{ 3, 4 }));
+    }
+
+    void TestRetentionAndEviction()
+    {
+        TextureStreamingPlanner planner;
+
+        // Unused texture that is fully resident keeps its mips while memory is plentiful
+        std::vector<Texture> textures{ MakeTexture(4096, 2000.0f, 1), MakeTexture(1024, 0.0f, 0) };
+        std::vector<uint32_t> plannedMips = Plan(planner, textures, 1ull << 30);
+
+        PF_CHECK((plannedMips == std::vector<uint32_t>{ 1, 0 }));
+        PF_CHECK(planner.GetStatistics().EvictionCount == 0);
+        PF_CHECK(planner.GetStatistics().UpgradeCount == 0);
+        PF_CHECK(!planner.GetStatistics().IsBudgetLimited);
+        PF_CHECK(planner.GetStatistics().PlannedBytes > planner.GetStatistics().DesiredBytes);
+
+        // Under pressure the retained mips go first, the visible texture keeps its desired mip
+        uint64_t neededBytes = MipRangeSize(textures[0], 1) + MipRangeSize(textures[1], textures[1].MipTailFirstMip);
+        plannedMips = Plan(planner, textures, neededBytes + textures[1].MipSizes[1]);
+
+        PF_CHECK((plannedMips == std::vector<uint32_t>{ 1, 2 }));
+        PF_CHECK(planner.GetStatistics().EvictionCount == 1);
+        PF_CHECK(!planner.GetStatistics().IsBudgetLimited);
+
+        plannedMips = Plan(planner, textures, neededBytes);
+        PF_CHECK((plannedMips == std::vector<uint32_t>{ 1, textures[1].MipTailFirstMip }));
+
+        // Visible texture evicts its own finer mips when the budget shrinks below what it needs
+        textures[0].ResidentMip = 0;
+        plannedMips = Plan(planner, textures, neededBytes - textures[0].MipSizes[1]);
+        PF_CHECK(plannedMips[0] == 2);
+        PF_CHECK(planner.GetStatistics().EvictionCount == 2);
+        PF_CHECK(planner.GetStatistics().IsBudgetLimited);
+
+        // Textures that are used the least lose retained mips first
+        std::vector<Texture> retained{ MakeTexture(1024, 10.0f, 0), MakeTexture(1024, 20.0f, 0), MakeTexture(1024, 5.0f, 0) };
+        uint64_t tailBytes = 3 * MipRangeSize(retained[0], retained[0].MipTailFirstMip);
+        uint64_t fullBytes = MipRangeSize(retained[0], 0);
+
+        plannedMips = Plan(planner, retained, tailBytes + 2 * (fullBytes - MipRangeSize(retained[0], retained[0].MipTailFirstMip)));
+        PF_CHECK((plannedMips == std::vector<uint32_t>{ 0, 0, retained[2].MipTailFirstMip }));
+        PF_CHECK(planner.GetStatistics().EvictionCount == 1);
+
+        plannedMips = Plan(planner, retained, tailBytes + fullBytes - MipRangeSize(retained[0], retained[0].MipTailFirstMip));
+        PF_CHECK((plannedMips == std::vector<uint32_t>{ retained[0].MipTailFirstMip, 0, retained[2].MipTailFirstMip }));
+        PF_CHECK(planner.GetStatistics().EvictionCount == 2);
+
+        // Resident mips coarser than the plan count as upgrades
+        std::vector<Texture> streamingIn{ MakeTexture(2048, 2048.0f), MakeTexture(2048, 2048.0f, 2) };
+        Plan(planner, streamingIn, 1ull << 30);
+        PF_CHECK(planner.GetStatistics().UpgradeCount == 2);
+    }
+
+    void TestMipBias()
+    {
+        TextureStreamingPlanner planner;
+        std::vector<Texture> textures{ MakeTexture(4096, 2000.0f), MakeTexture(2048, 300.0f), MakeTexture(1024, 0.0f), MakeTexture(4096, 100.0f) };
+
+        std::vector<uint32_t> plannedMips = Plan(planner, textures, 1ull << 30, 1.0f);
+        PF_CHECK((plannedMips == std::vector<uint32_t>{ 2, 3, 4, 6 }));
+
+        // Positive bias never needs more memory, negative bias never less
+        uint64_t previousDesiredBytes = std::numeric_limits<uint64_t>::max();
+
+        for (float mipBias : { -2.0f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 2.0f, 8.0f })
+        {
+            Plan(planner, textures, 1ull << 30, mipBias);
+            PF_CHECK(planner.GetStatistics().DesiredBytes <= previousDesiredBytes);
+            PF_CHECK(planner.GetStatistics().PlannedBytes == planner.GetStatistics().DesiredBytes);
+            previousDesiredBytes = planner.GetStatistics().DesiredBytes;
+        }
+
+        // Bias large enough leaves only mip tails
+        PF_CHECK(Plan(planner, textures, 1ull << 30, 8.0f) == (std::vector<uint32_t>{ 6, 5, 4, 6 }));
+
+        // Under the same budget a biased plan fits where an unbiased one is limited
+        uint64_t budget = 8'000'000;
+        Plan(planner, textures, budget, 0.0f);
+        PF_CHECK(planner.GetStatistics().IsBudgetLimited);
+        Plan(planner, textures, budget, 2.0f);
+        PF_CHECK(!planner.GetStatistics().IsBudgetLimited);
+
+        // Bias doesn't evict resident mips that still fit
+        textures[2].ResidentMip = 0;
+        plannedMips = Plan(planner, textures, 1ull << 30, 2.0f);
+        PF_CHECK(plannedMips[2] == 0);
+    }
+
+}
+
+int main()
+{
+    TestDesiredMip();
+    TestUnlimitedBudget();
+    TestBudget();
+    TestRetentionAndEviction();
+    TestMipBias();
+
+    return Tests::Result();
+}
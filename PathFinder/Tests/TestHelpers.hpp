@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace Tests
+{
+
+    /// Failed checks are counted rather than aborting, so a single run reports every broken case
+    inline int& FailedCheckCount()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    inline bool Check(bool condition, const char* expression, const char* file, int line)
+    {
+        if (!condition)
+        {
+            std::printf("Check failed: %s in %s:%d\n", expression, file, line);
+            ++FailedCheckCount();
+        }
+        return condition;
+    }
+
+    inline int Result()
+    {
+        if (FailedCheckCount() > 0)
+        {
+            std::printf("%d check(s) failed\n", FailedCheckCount());
+            return 1;
+        }
+
+        std::printf("All checks passed\n");
+        return 0;
+    }
+
+    /// Benchmarks run reduced sizes when launched by ctest with --quick
+    inline bool IsQuickRun(int argc, char** argv)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            if (std::strcmp(argv[i], "--quick") == 0) return true;
+        }
+        return false;
+    }
+
+    template <class Func>
+    double MeasureMilliseconds(Func&& func)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+        func();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+}
+
+#define PF_CHECK(EXPRESSION) Tests::Check((EXPRESSION), #EXPRESSION, __FILE__, __LINE__)